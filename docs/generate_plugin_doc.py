@@ -10,6 +10,7 @@ import re
 SHAPE_ORDERING = ['obj',
                   'ply',
                   'serialized',
+                  'compiled',
                   'sphere',
                   'cylinder',
                   'disk',
@@ -51,6 +52,7 @@ SAMPLER_ORDERING = ['independent']
 
 INTEGRATOR_ORDERING = ['direct',
                        'path',
+                       'guided',
                        'aov']
 
 FILM_ORDERING = ['hdrfilm']
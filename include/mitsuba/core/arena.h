@@ -0,0 +1,147 @@
+#pragma once
+
+#include <mitsuba/mitsuba.h>
+#include <mitsuba/core/statistics.h>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Bump allocator for transient scratch memory
+ *
+ * Allocations are carved out of large chunks by advancing a pointer, and they
+ * are never released individually. Instead, \ref reset() releases all of them
+ * at once, and \ref ScopedMemoryArena releases the allocations made within a
+ * scope (e.g. an image block or a single sample).
+ *
+ * When the allocations between two resets did not fit into a single chunk,
+ * \ref reset() merges the chunks into one (the render loop of \ref
+ * SamplingIntegrator does so whenever a thread starts rendering). After a short warm-up phase, the
+ * arena therefore no longer performs any heap allocations, which can be
+ * verified using \ref heap_allocation_count().
+ *
+ * Each thread has its own arena, see \ref thread(). Only trivially
+ * destructible types may be stored, since destructors are never run.
+ */
+class MTS_EXPORT_CORE MemoryArena {
+public:
+    /// Position within the arena, see \ref mark() and \ref rewind()
+    struct Marker {
+        size_t chunk;
+        uint8_t *head;
+    };
+
+    /// Create an empty arena, whose chunks have at least the given size
+    MemoryArena(size_t chunk_size = 256 * 1024);
+
+    /// Release all chunks
+    ~MemoryArena();
+
+    MemoryArena(const MemoryArena &) = delete;
+    MemoryArena &operator=(const MemoryArena &) = delete;
+
+    /// Allocate \c size bytes of uninitialized memory with the given alignment
+    void *allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        uint8_t *ptr = (uint8_t *) (((uintptr_t) m_head + alignment - 1) &
+                                    ~(uintptr_t) (alignment - 1));
+        m_allocation_count++;
+        statistics_add(StatisticsCounter::ScratchAllocations);
+        if (unlikely(!m_head || ptr + size > m_end))
+            return allocate_slow(size, alignment);
+        m_head = ptr + size;
+        return ptr;
+    }
+
+    /// Allocate and default-initialize an array of \c count entries
+    template <typename T> T *allocate(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "MemoryArena: only trivially destructible types are supported!");
+        T *ptr = (T *) allocate(sizeof(T) * count, alignof(T));
+        for (size_t i = 0; i < count; ++i)
+            new (ptr + i) T;
+        return ptr;
+    }
+
+    /// Return the current position, which can be restored using \ref rewind()
+    Marker mark() const { return { m_chunk, m_head }; }
+
+    /// Release all allocations made since \ref mark() returned \c marker
+    void rewind(const Marker &marker);
+
+    /**
+     * \brief Release all allocations
+     *
+     * When more than one chunk is in use, they are replaced by a single chunk
+     * of the combined size.
+     */
+    void reset();
+
+    /// Return the number of bytes allocated since the last reset (including padding)
+    size_t used() const;
+
+    /// Return the combined size of all chunks in bytes
+    size_t capacity() const;
+
+    /// Return the number of chunks
+    size_t chunk_count() const { return m_chunks.size(); }
+
+    /// Return the number of calls to \ref allocate() over the lifetime of the arena
+    size_t allocation_count() const { return m_allocation_count; }
+
+    /// Return the number of chunks that were allocated on the heap over the lifetime of the arena
+    size_t heap_allocation_count() const { return m_heap_allocation_count; }
+
+    /**
+     * \brief Return the arena of the calling thread
+     *
+     * The lookup is cached per thread, so that it is cheap enough to be
+     * performed in inner loops (e.g. once per sample).
+     */
+    static MemoryArena &thread();
+
+    /// Create the per-thread arenas (called by \ref Thread::static_initialization())
+    static void static_initialization();
+
+    /// Release the per-thread arenas (called by \ref Thread::static_shutdown())
+    static void static_shutdown();
+
+protected:
+    void *allocate_slow(size_t size, size_t alignment);
+
+    struct Chunk {
+        uint8_t *data;
+        size_t size;
+    };
+
+protected:
+    std::vector<Chunk> m_chunks;
+    size_t m_chunk = 0;
+    uint8_t *m_head = nullptr, *m_end = nullptr;
+    size_t m_chunk_size;
+    size_t m_allocation_count = 0;
+    size_t m_heap_allocation_count = 0;
+};
+
+/// RAII helper that releases the allocations made from an arena within a scope
+class ScopedMemoryArena {
+public:
+    ScopedMemoryArena(MemoryArena &arena = MemoryArena::thread())
+        : m_arena(arena), m_marker(arena.mark()) { }
+
+    ~ScopedMemoryArena() { m_arena.rewind(m_marker); }
+
+    ScopedMemoryArena(const ScopedMemoryArena &) = delete;
+    ScopedMemoryArena &operator=(const ScopedMemoryArena &) = delete;
+
+    /// Return the underlying arena
+    MemoryArena &arena() { return m_arena; }
+
+private:
+    MemoryArena &m_arena;
+    MemoryArena::Marker m_marker;
+};
+
+NAMESPACE_END(mitsuba)
@@ -4,6 +4,8 @@
 #include <mitsuba/core/vector.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/rfilter.h>
+#include <mitsuba/core/writequeue.h>
+#include <functional>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -376,9 +378,49 @@ public:
     void write(const fs::path &path, FileFormat format = FileFormat::Auto,
                int quality = -1) const;
 
-    /// Equivalent to \ref write(), but executes asynchronously on a different thread
-    void write_async(const fs::path &path, FileFormat format = FileFormat::Auto,
-                     int quality = -1) const;
+    /**
+     * \brief Equivalent to \ref write(), but executes asynchronously on a
+     * different thread
+     *
+     * The write operation is submitted to the process-wide \ref WriteQueue,
+     * which blocks when too many writes are already pending. The bitmap
+     * must not be modified until the write has finished.
+     *
+     * \return A handle that can be used to wait for completion
+     */
+    ref<WriteHandle> write_async(const fs::path &path, FileFormat format = FileFormat::Auto,
+                                 int quality = -1) const;
+
+    /**
+     * \brief Incrementally write an OpenEXR file, one band of scanlines at a time
+     *
+     * This bitmap specifies the width, channel layout, and metadata of the
+     * output image and serves as a staging buffer for up to \ref height()
+     * scanlines. For every band, \c fill is invoked with the index of the
+     * first scanline and the number of scanlines, and must write the
+     * corresponding pixels to the top rows of this bitmap. Peak memory usage
+     * is thus proportional to the band rather than to the full image.
+     *
+     * \param stream
+     *    Target stream that will receive the encoded output
+     *
+     * \param height
+     *    Total number of scanlines of the output image
+     *
+     * \param fill
+     *    Callback that provides the contents of each band
+     *
+     * \param quality
+     *    Quality level of the DWAB compressor (see \ref write())
+     */
+    void write_openexr_bands(Stream *stream, uint32_t height,
+                             const std::function<void(uint32_t, uint32_t)> &fill,
+                             int quality = -1);
+
+    /// Equivalent to the above, but writes to a file
+    void write_openexr_bands(const fs::path &path, uint32_t height,
+                             const std::function<void(uint32_t, uint32_t)> &fill,
+                             int quality = -1);
 
     /**
      * \brief Up- or down-sample this image to a different resolution
@@ -596,6 +638,14 @@ public:
      /// Write a file using the OpenEXR file format
      void write_openexr(Stream *stream, int compression = -1) const;
 
+     /**
+      * Write an OpenEXR file with \c height scanlines, which are supplied in
+      * bands by \c fill (see \ref write_openexr_bands())
+      */
+     void write_openexr(Stream *stream, uint32_t height,
+                        const std::function<void(uint32_t, uint32_t)> &fill,
+                        int compression) const;
+
      /// Read a file encoded using the JPEG file format
      void read_jpeg(Stream *stream);
 
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <mitsuba/core/platform.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/// Feature image (e.g. normals or depth) that steers the weights of \ref denoise_atrous()
+struct DenoiserGuide {
+    /// Planar storage: \c channels consecutive images of <tt>width * height</tt> values
+    const float *data;
+
+    /// Number of channels
+    size_t channels;
+
+    /**
+     * \brief Tolerance for feature differences between neighboring pixels,
+     * relative to the standard deviation of the feature over the image
+     */
+    float sigma;
+};
+
+/**
+ * \brief Denoise an image using the edge-avoiding À-Trous wavelet transform
+ *
+ * This filter (Dammertz et al., "Edge-Avoiding À-Trous Wavelet Transform for
+ * fast Global Illumination Filtering", HPG 2010) repeatedly convolves the
+ * image with a 5x5 B3 spline kernel, whose taps are spread apart by a factor
+ * of two in every iteration. Each tap is weighted by the similarity of its
+ * color and of the provided feature images (e.g. normals or depth computed by
+ * the \c aov integrator) to the center pixel, which avoids blurring across
+ * geometric edges. Five iterations thus reach a radius of 62 pixels while only
+ * evaluating 125 taps per pixel.
+ *
+ * Rows are processed in parallel, and each row is vectorized using SIMD
+ * packets.
+ *
+ * \param color
+ *     Planar image with three color channels (i.e. three consecutive images
+ *     of <tt>width * height</tt> values), which is filtered in place.
+ *
+ * \param guides
+ *     Feature images with the same resolution as \c color.
+ *
+ * \param iterations
+ *     Number of iterations of the wavelet transform.
+ *
+ * \param sigma_color
+ *     Tolerance for relative color differences in the first iteration. The
+ *     tolerance is halved in each following iteration, as the image becomes
+ *     smoother.
+ */
+extern MTS_EXPORT_CORE void denoise_atrous(float *color, uint32_t width, uint32_t height,
+                                           const std::vector<DenoiserGuide> &guides,
+                                           uint32_t iterations = 5,
+                                           float sigma_color = 1.f);
+
+NAMESPACE_END(mitsuba)
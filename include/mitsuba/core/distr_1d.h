@@ -243,6 +243,247 @@ private:
     ScalarVector2u m_valid;
 };
 
+/**
+ * \brief Discrete 1D probability distribution with constant-time sampling
+ *
+ * This data structure represents the same kind of distribution as \ref
+ * DiscreteDistribution, but samples it using Walker's alias method: every
+ * entry stores a probability of accepting its own index, and the index of an
+ * "alias" that is chosen otherwise. Sampling thus requires two memory accesses
+ * regardless of the size of the distribution, whereas the binary search of
+ * \ref DiscreteDistribution::sample() performs a chain of dependent accesses
+ * that grows logarithmically. The resulting mapping of samples to indices is
+ * not monotonic, which does not matter for Monte Carlo integration but makes
+ * the distribution unsuitable for stratified or low-discrepancy samples that
+ * rely on preserving the relative position of samples.
+ */
+template <typename Float> struct AliasDistribution {
+    using FloatStorage = DynamicBuffer<Float>;
+    using Index = uint32_array_t<Float>;
+    using IndexStorage = DynamicBuffer<Index>;
+    using Mask = mask_t<Float>;
+
+    using ScalarFloat = scalar_t<Float>;
+
+public:
+    /// Create an unitialized AliasDistribution instance
+    AliasDistribution() { }
+
+    /// Initialize from a given probability mass function
+    AliasDistribution(const FloatStorage &pmf)
+        : m_pmf(pmf) {
+        update();
+    }
+
+    /// Initialize from a given probability mass function (rvalue version)
+    AliasDistribution(FloatStorage &&pmf)
+        : m_pmf(std::move(pmf)) {
+        update();
+    }
+
+    /// Initialize from a given floating point array
+    AliasDistribution(const ScalarFloat *values, size_t size)
+        : AliasDistribution(FloatStorage::copy(values, size)) {
+    }
+
+    /// Update the internal state. Must be invoked when changing the pmf.
+    void update() {
+        size_t size = m_pmf.size();
+
+        if (size == 0)
+            Throw("AliasDistribution: empty distribution!");
+
+        if (m_prob.size() != size) {
+            m_prob = enoki::empty<FloatStorage>(size);
+            m_alias = enoki::empty<IndexStorage>(size);
+        }
+
+        // Ensure that we can access these arrays on the CPU
+        m_pmf.managed();
+        m_prob.managed();
+        m_alias.managed();
+
+        const ScalarFloat *pmf_ptr = m_pmf.data();
+        ScalarFloat *prob_ptr = m_prob.data();
+        uint32_t *alias_ptr = m_alias.data();
+
+        double sum = 0.0;
+        for (size_t i = 0; i < size; ++i) {
+            double value = (double) pmf_ptr[i];
+            if (value < 0.0)
+                Throw("AliasDistribution: entries must be non-negative!");
+            sum += value;
+        }
+
+        if (!(sum > 0.0))
+            Throw("AliasDistribution: no probability mass found!");
+
+        m_sum = ScalarFloat(sum);
+        m_normalization = ScalarFloat(1.0 / sum);
+
+        /* Vose's algorithm: repeatedly fill up an entry with less than the
+           average probability mass using the excess of a larger entry */
+        std::unique_ptr<double[]> scaled(new double[size]);
+        std::vector<uint32_t> small, large;
+        for (size_t i = 0; i < size; ++i) {
+            scaled[i] = pmf_ptr[i] * (size / sum);
+            (scaled[i] < 1.0 ? small : large).push_back((uint32_t) i);
+        }
+
+        while (!small.empty() && !large.empty()) {
+            uint32_t s = small.back(), l = large.back();
+            small.pop_back();
+
+            prob_ptr[s] = (ScalarFloat) scaled[s];
+            alias_ptr[s] = l;
+
+            scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+            if (scaled[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        // Remaining entries (up to round-off) hold exactly the average mass
+        for (auto list : { &small, &large }) {
+            for (uint32_t i : *list) {
+                prob_ptr[i] = 1.f;
+                alias_ptr[i] = i;
+            }
+        }
+    }
+
+    /// Return the unnormalized probability mass function
+    FloatStorage &pmf() { return m_pmf; }
+
+    /// Return the unnormalized probability mass function (const version)
+    const FloatStorage &pmf() const { return m_pmf; }
+
+    /// \brief Return the original sum of PMF entries before normalization
+    ScalarFloat sum() const { return m_sum; }
+
+    /// \brief Return the normalization factor (i.e. the inverse of \ref sum())
+    ScalarFloat normalization() const { return m_normalization; }
+
+    /// Return the number of entries
+    size_t size() const { return m_pmf.size(); }
+
+    /// Is the distribution object empty/uninitialized?
+    bool empty() const { return m_pmf.empty(); }
+
+    /// Evaluate the unnormalized probability mass function (PMF) at index \c index
+    Float eval_pmf(Index index, Mask active = true) const {
+        return gather<Float>(m_pmf, index, active);
+    }
+
+    /// Evaluate the normalized probability mass function (PMF) at index \c index
+    Float eval_pmf_normalized(Index index, Mask active = true) const {
+        return gather<Float>(m_pmf, index, active) * m_normalization;
+    }
+
+    /**
+     * \brief %Transform a uniformly distributed sample to the stored
+     * distribution
+     *
+     * \param value
+     *     A uniformly distributed sample on the interval [0, 1].
+     *
+     * \return
+     *     The discrete index associated with the sample
+     */
+    Index sample(Float value, Mask active = true) const {
+        MTS_MASK_ARGUMENT(active);
+
+        return sample_reuse(value, active).first;
+    }
+
+    /**
+     * \brief %Transform a uniformly distributed sample to the stored
+     * distribution
+     *
+     * \param value
+     *     A uniformly distributed sample on the interval [0, 1].
+     *
+     * \return
+     *     A tuple consisting of
+     *
+     *     1. the discrete index associated with the sample, and
+     *     2. the normalized probability value of the sample.
+     */
+    std::pair<Index, Float> sample_pmf(Float value, Mask active = true) const {
+        MTS_MASK_ARGUMENT(active);
+
+        Index index = sample(value, active);
+        return { index, eval_pmf_normalized(index, active) };
+    }
+
+    /**
+     * \brief %Transform a uniformly distributed sample to the stored
+     * distribution
+     *
+     * The original sample is value adjusted so that it can be reused as a
+     * uniform variate.
+     *
+     * \param value
+     *     A uniformly distributed sample on the interval [0, 1].
+     *
+     * \return
+     *     A tuple consisting of
+     *
+     *     1. the discrete index associated with the sample, and
+     *     2. the re-scaled sample value.
+     */
+    std::pair<Index, Float>
+    sample_reuse(Float value, Mask active = true) const {
+        MTS_MASK_ARGUMENT(active);
+
+        value *= ScalarFloat(m_pmf.size());
+        Index index = clamp(Index(value), 0u, uint32_t(m_pmf.size() - 1));
+        value = min(value - Float(index), math::OneMinusEpsilon<Float>);
+
+        Float prob = gather<Float>(m_prob, index, active);
+        Index alias = gather<Index>(m_alias, index, active);
+        Mask accept = value < prob;
+
+        return {
+            select(accept, index, alias),
+            select(accept, value / prob, (value - prob) / (1.f - prob))
+        };
+    }
+
+    /**
+     * \brief %Transform a uniformly distributed sample to the stored
+     * distribution.
+     *
+     * The original sample is value adjusted so that it can be reused as a
+     * uniform variate.
+     *
+     * \param value
+     *     A uniformly distributed sample on the interval [0, 1].
+     *
+     * \return
+     *     A tuple consisting of
+     *
+     *     1. the discrete index associated with the sample
+     *     2. the re-scaled sample value
+     *     3. the normalized probability value of the sample
+     */
+    std::tuple<Index, Float, Float>
+    sample_reuse_pmf(Float value, Mask active = true) const {
+        MTS_MASK_ARGUMENT(active);
+
+        auto [index, value_2] = sample_reuse(value, active);
+        return { index, value_2, eval_pmf_normalized(index, active) };
+    }
+
+private:
+    FloatStorage m_pmf;
+    FloatStorage m_prob;
+    IndexStorage m_alias;
+    ScalarFloat m_sum = 0.f;
+    ScalarFloat m_normalization = 0.f;
+};
+
 /**
  * \brief Continuous 1D probability distribution defined in terms of a regularly
  * sampled linear interpolant
@@ -816,6 +1057,16 @@ std::ostream &operator<<(std::ostream &os, const DiscreteDistribution<Float> &di
     return os;
 }
 
+template <typename Float>
+std::ostream &operator<<(std::ostream &os, const AliasDistribution<Float> &distr) {
+    os << "AliasDistribution[" << std::endl
+        << "  size = " << distr.size() << "," << std::endl
+        << "  sum = " << distr.sum() << "," << std::endl
+        << "  pmf = " << distr.pmf() << std::endl
+        << "]";
+    return os;
+}
+
 template <typename Float>
 std::ostream &operator<<(std::ostream &os, const ContinuousDistribution<Float> &distr) {
     os << "ContinuousDistribution[" << std::endl
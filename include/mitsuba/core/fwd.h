@@ -31,6 +31,7 @@ class FileResolver;
 class FileStream;
 class Formatter;
 class Logger;
+class MemoryMappedFile;
 class MemoryStream;
 class Mutex;
 class PluginManager;
@@ -43,6 +44,8 @@ class StructConverter;
 class Thread;
 class ThreadLocalBase;
 class TraversalCallback;
+class WriteHandle;
+class WriteQueue;
 class ZStream;
 enum LogLevel : int;
 
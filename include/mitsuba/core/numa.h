@@ -0,0 +1,91 @@
+#pragma once
+
+#include <mitsuba/mitsuba.h>
+#include <functional>
+#include <vector>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief NUMA-aware thread placement and memory allocation
+ *
+ * On machines with several sockets, memory accesses to the RAM attached to
+ * another socket are considerably slower. The functions in this namespace
+ * pin worker threads to the processors of a NUMA node, run parallel loops on
+ * one TBB task arena per node, and control where the pages of large
+ * (read-only) scene data structures are placed.
+ *
+ * All of this is disabled by default, in which case \ref numa::parallel_for()
+ * simply forwards to <tt>tbb::parallel_for()</tt>. The topology is only
+ * detected on Linux; other platforms are treated as a single node.
+ */
+NAMESPACE_BEGIN(numa)
+
+/// Policies for the placement of the pages of large scene buffers
+enum class AllocationPolicy {
+    /**
+     * Leave pages on the node of the thread that first wrote them (the
+     * operating system's default). Buffers initialized by \ref parallel_for()
+     * with thread pinning enabled are thereby split across the nodes.
+     */
+    FirstTouch,
+
+    /// Spread the pages of a buffer across all nodes in a round-robin fashion
+    Interleave
+};
+
+/// Return the number of NUMA nodes with processors that are usable by this process
+extern MTS_EXPORT_CORE size_t node_count();
+
+/// Return the (operating system) indices of the usable processors of a node
+extern MTS_EXPORT_CORE const std::vector<int> &node_cpus(size_t node);
+
+/**
+ * \brief Specify whether TBB worker threads should be pinned to processors
+ *
+ * Threads are distributed over the nodes in a round-robin fashion. When
+ * there is more than one node, \ref parallel_for() furthermore runs on one
+ * task arena per node, whose threads are confined to the node's processors.
+ * Must be called before the first parallel region to affect all threads.
+ */
+extern MTS_EXPORT_CORE void set_thread_pinning(bool value);
+
+/// Are TBB worker threads pinned to processors?
+extern MTS_EXPORT_CORE bool thread_pinning();
+
+/// Set the placement policy used by \ref distribute()
+extern MTS_EXPORT_CORE void set_allocation_policy(AllocationPolicy policy);
+
+/// Return the placement policy used by \ref distribute()
+extern MTS_EXPORT_CORE AllocationPolicy allocation_policy();
+
+/**
+ * \brief Place the pages of a large buffer according to the allocation policy
+ *
+ * Only complete pages within the buffer are affected, and buffers smaller
+ * than 1 MiB are ignored. Pages that are already populated are migrated, and
+ * the contents of the buffer are preserved.
+ */
+extern MTS_EXPORT_CORE void distribute(const void *ptr, size_t size);
+
+/// Pin the calling thread to the processors of a node (or of all nodes, if \c node is -1)
+extern MTS_EXPORT_CORE void pin_thread(int node = -1);
+
+/**
+ * \brief Parallel loop over the range <tt>[0, size)</tt>
+ *
+ * When thread pinning is enabled on a NUMA machine, the range is split into
+ * contiguous parts that are proportional to the number of threads per node,
+ * and each part is processed by the task arena of its node. Otherwise, this
+ * is equivalent to a <tt>tbb::parallel_for()</tt> over a
+ * <tt>tbb::blocked_range</tt> with the given grain size.
+ */
+extern MTS_EXPORT_CORE void
+parallel_for(size_t size, size_t grain_size,
+             const std::function<void(size_t begin, size_t end)> &func);
+
+/// Release the per-node task arenas (called by \ref Thread::static_shutdown())
+extern MTS_EXPORT_CORE void static_shutdown();
+
+NAMESPACE_END(numa)
+NAMESPACE_END(mitsuba)
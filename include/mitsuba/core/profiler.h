@@ -3,11 +3,18 @@
 #pragma once
 
 #include <mitsuba/core/object.h>
+#include <atomic>
+#include <map>
 
 #if !defined(MTS_PROFILE_HASH_SIZE)
 #  define MTS_PROFILE_HASH_SIZE 256
 #endif
 
+/// Capacity (number of events) of the per-thread ring buffers used for tracing
+#if !defined(MTS_PROFILE_TRACE_SIZE)
+#  define MTS_PROFILE_TRACE_SIZE 262144
+#endif
+
 NAMESPACE_BEGIN(mitsuba)
 
 /**
@@ -21,6 +28,7 @@ enum class ProfilerPhase : int {
     LoadTexture,                /* Texture loading */
     InitKDTree,                 /* kd-tree construction */
     Render,                     /* Integrator::render() */
+    RenderBlock,                /* SamplingIntegrator::render_block() */
     SamplingIntegratorSample,   /* SamplingIntegrator::sample() */
     SampleEmitterRay,           /* Scene::sample_emitter_ray() */
     SampleEmitterDirection,     /* Scene::sample_emitter_direction() */
@@ -50,6 +58,7 @@ constexpr const char
         "Texture loading",
         "kd-tree construction",
         "Integrator::render()",
+        "SamplingIntegrator::render_block()",
         "SamplingIntegrator::sample()",
         "Scene::sample_emitter_ray()",
         "Scene::sample_emitter_direction()",
@@ -78,6 +87,36 @@ static_assert(std::extent_v<decltype(profiler_phase_id)> ==
                   int(ProfilerPhase::ProfilerPhaseCount),
               "Profiler phases and descriptions don't have matching length!");
 
+/**
+ * \brief Hardware performance counter totals that were attributed to a phase
+ * by the sampling profiler (see \ref Profiler::enable_counters())
+ */
+struct ProfilerCounters {
+    /// Number of profiler samples
+    uint64_t samples = 0;
+    /// Elapsed CPU cycles
+    uint64_t cycles = 0;
+    /// Retired instructions
+    uint64_t instructions = 0;
+    /// Last level cache misses
+    uint64_t cache_misses = 0;
+    /// Mispredicted branches
+    uint64_t branch_misses = 0;
+
+    /// Instructions per cycle
+    double ipc() const { return cycles == 0 ? 0.0 : instructions / (double) cycles; }
+
+    /// Last level cache misses per thousand instructions
+    double cache_mpki() const {
+        return instructions == 0 ? 0.0 : cache_misses * 1000.0 / instructions;
+    }
+
+    /// Branch mispredictions per thousand instructions
+    double branch_mpki() const {
+        return instructions == 0 ? 0.0 : branch_misses * 1000.0 / instructions;
+    }
+};
+
 #if defined(MTS_ENABLE_PROFILER)
 /* Inlining the access to a thread_local variable produces *awful* machine code
    with Clang on OSX. The combination of weak and noinline is needed to prevent
@@ -87,16 +126,27 @@ static_assert(std::extent_v<decltype(profiler_phase_id)> ==
 extern MTS_EXPORT_CORE uint64_t *profiler_flags()
     __attribute__((noinline, weak, const));
 
+/// Set of phases whose begin/end events are currently traced (see \ref Profiler::start_tracing())
+extern MTS_EXPORT_CORE std::atomic<uint64_t> profiler_trace_mask;
+
+/// Record a begin/end event of a traced phase in the ring buffer of the current thread
+extern MTS_EXPORT_CORE void profiler_trace_event(ProfilerPhase phase, bool begin);
+
 struct ScopedPhase {
     ScopedPhase(ProfilerPhase phase)
-        : m_target(profiler_flags()), m_flag(1ull << int(phase)) {
-        if ((*m_target & m_flag) == 0)
+        : m_target(profiler_flags()), m_flag(1ull << int(phase)), m_phase(phase) {
+        if ((*m_target & m_flag) == 0) {
             *m_target |= m_flag;
-        else
+            if (unlikely(profiler_trace_mask.load(std::memory_order_relaxed) & m_flag))
+                profiler_trace_event(m_phase, true);
+        } else {
             m_flag = 0;
+        }
     }
 
     ~ScopedPhase() {
+        if (unlikely(profiler_trace_mask.load(std::memory_order_relaxed) & m_flag))
+            profiler_trace_event(m_phase, false);
         *m_target &= ~m_flag;
     }
 
@@ -106,13 +156,96 @@ struct ScopedPhase {
 private:
     uint64_t* m_target;
     uint64_t  m_flag;
+    ProfilerPhase m_phase;
 };
 
+/**
+ * \brief Builtin profiler
+ *
+ * The profiler has two complementary modes of operation:
+ *
+ * 1. A sampling profiler, which periodically (100 times per second by
+ *    default, see \ref set_sampling_rate()) records the set of active
+ *    phases of the interrupted thread. It has negligible overhead and
+ *    produces a global histogram (\ref print_report()). Optionally, hardware
+ *    performance counters are attributed to the sampled phases as well
+ *    (\ref enable_counters()).
+ *
+ * 2. A tracing profiler, which records the begin and end time of each
+ *    selected phase (\ref start_tracing()) on every thread. Events are
+ *    appended to a fixed-size ring buffer per thread without any locking, and
+ *    the resulting timelines can be exported in the Chrome trace event format
+ *    (\ref write_trace()) to reveal load imbalance and stalls across threads.
+ */
 class MTS_EXPORT_CORE Profiler : public Object {
 public:
     static void static_initialization();
     static void static_shutdown();
     static void print_report();
+
+    /// Set the rate (in Hz) of the sampling profiler
+    static void set_sampling_rate(uint32_t rate);
+
+    /**
+     * \brief Attribute hardware performance counters to the phases recorded
+     * by the sampling profiler
+     *
+     * Every thread reads its cycle, instruction, last level cache miss and
+     * branch miss counters (via Linux' \c perf_event_open()) whenever it is
+     * sampled, and the increase since its previous sample is attributed to
+     * the currently active phases. The results are included in \ref
+     * print_report() and can be queried using \ref counters().
+     *
+     * The counters are opened for the calling thread and for all threads
+     * that are registered afterwards (see \ref register_thread()).
+     *
+     * Returns \c false when hardware counters are unavailable (e.g. on other
+     * platforms, in virtual machines, or when prohibited by
+     * <tt>/proc/sys/kernel/perf_event_paranoid</tt>).
+     */
+    static bool enable_counters();
+
+    /**
+     * \brief Prepare the calling thread for sampling
+     *
+     * Opens the hardware counters of the thread if they are enabled, which
+     * cannot be done from within the signal handler of the sampling profiler.
+     * Called by \ref Thread when a thread starts.
+     */
+    static void register_thread();
+
+    /// Release the resources of the calling thread, see \ref register_thread()
+    static void unregister_thread();
+
+    /// Return the counter totals per (innermost) phase, see \ref enable_counters()
+    static std::map<std::string, ProfilerCounters> counters();
+
+    /**
+     * \brief Start recording per-thread timelines
+     *
+     * \param phase_mask
+     *     Bit mask of the phases that should be traced (bit \c i corresponds
+     *     to <tt>ProfilerPhase(i)</tt>). Fine-grained phases (e.g. BSDF
+     *     evaluations) produce events at a very high rate, which adds overhead
+     *     and quickly wraps around the ring buffers.
+     *
+     * Previously recorded events are discarded.
+     */
+    static void start_tracing(uint64_t phase_mask = (uint64_t) -1);
+
+    /// Stop recording per-thread timelines
+    static void stop_tracing();
+
+    /**
+     * \brief Write the recorded timelines to a JSON file in the Chrome trace
+     * event format, which can be opened using \c chrome://tracing or
+     * https://ui.perfetto.dev
+     *
+     * Should be called after \ref stop_tracing(). Returns the number of
+     * exported events.
+     */
+    static size_t write_trace(const fs::path &filename);
+
     MTS_DECLARE_CLASS()
 private:
     Profiler() = delete;
@@ -127,6 +260,14 @@ public:
     static void static_initialization() { }
     static void static_shutdown() { }
     static void print_report() { }
+    static void set_sampling_rate(uint32_t) { }
+    static bool enable_counters() { return false; }
+    static void register_thread() { }
+    static void unregister_thread() { }
+    static std::map<std::string, ProfilerCounters> counters() { return { }; }
+    static void start_tracing(uint64_t = (uint64_t) -1) { }
+    static void stop_tracing() { }
+    static size_t write_trace(const fs::path &) { return 0; }
 };
 
 #endif
@@ -3,12 +3,19 @@
 #include <mitsuba/core/object.h>
 #include <mitsuba/core/math.h>
 #include <mitsuba/core/logger.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
 
 NAMESPACE_BEGIN(mitsuba)
 
 /// Reconstruction filters will be tabulated at this resolution
 #define MTS_FILTER_RESOLUTION 31
 
+/// Maximum number of weight tables kept by \ref Resampler
+#define MTS_RESAMPLER_CACHE_SIZE 64
+
 /**
  * \brief When resampling data to a different resolution using \ref
  * Resampler::resample(), this enumeration specifies how lookups
@@ -58,6 +65,9 @@ public:
     /// Evaluate the filter function
     virtual Float eval(Float x, Mask active = true) const = 0;
 
+    /// Return the tabulated filter values used by \ref eval_discretized()
+    const std::vector<ScalarFloat> &values() const { return m_values; }
+
     /// Evaluate a discretized version of the filter (generally faster than 'eval')
     MTS_INLINE Float eval_discretized(Float x, Mask active = true) const {
         Int32 index = min(Int32(abs(x * m_scale_factor)), MTS_FILTER_RESOLUTION);
@@ -110,96 +120,12 @@ template <typename Scalar_> struct Resampler {
         if (source_res == 0 || target_res == 0)
             Throw("Resampler::Resampler(): source or target resolution == 0!");
 
-        Float filter_radius_orig = rfilter->radius(),
-              filter_radius = filter_radius_orig,
-              scale = 1, inv_scale = 1;
-
-        /* Low-pass filter: scale reconstruction filters when downsampling */
-        if (target_res < source_res) {
-            scale = (Float) source_res / (Float) target_res;
-            inv_scale = rcp(scale);
-            filter_radius *= scale;
-        }
-
-        m_taps = enoki::ceil2int<uint32_t>(filter_radius * 2);
-        if (source_res == target_res && (m_taps % 2) != 1)
-            --m_taps;
-
-        if (filter_radius_orig < 1)
-            m_taps = std::min(m_taps, source_res);
-
-        if (source_res != target_res) { /* Resampling mode */
-            m_start = std::unique_ptr<int32_t[]>(new int32_t[target_res]);
-            m_weights = std::unique_ptr<Scalar[]>(new Scalar[m_taps * target_res]);
-            m_fast_start = 0;
-            m_fast_end = m_target_res;
-
-            for (uint32_t i = 0; i < target_res; i++) {
-                /* Compute the fractional coordinates of the new sample i
-                   in the original coordinates */
-                Float center = (i + Float(0.5)) / target_res * source_res;
-
-                /* Determine the index of the first original sample
-                   that might contribute */
-                m_start[i] = enoki::floor2int<uint32_t>(center - filter_radius + Float(0.5));
-
-                /* Determine the size of center region, on which to run
-                   the fast non condition-aware code */
-                if (m_start[i] < 0)
-                    m_fast_start = std::max(m_fast_start, i + 1);
-                else if (m_start[i] + m_taps - 1 >= m_source_res)
-                    m_fast_end = std::min(m_fast_end, i);
-
-                double sum = 0.0;
-                for (uint32_t j = 0; j < m_taps; j++) {
-                    /* Compute the position where the filter should be evaluated */
-                    Float pos = m_start[i] + (int32_t) j + Float(0.5) - center;
-
-                    /* Perform the evaluation and record the weight */
-                    auto weight = rfilter->eval(pos * inv_scale);
-                    m_weights[i * m_taps + j] = static_cast<Scalar>(weight);
-                    sum += double(weight);
-                }
-
-                Assert(sum != 0, "Resampler(): filter footprint is too small; the "
-                                 "support of some output samples does not contain "
-                                 "any input samples!");
-
-                /* Normalize the contribution of each sample */
-                double normalization = 1.0 / sum;
-                for (uint32_t j = 0; j < m_taps; j++) {
-                    Scalar &value = m_weights[i * m_taps + j];
-                    value = Scalar(double(value) * normalization);
-                }
-            }
-        } else { /* Filtering mode */
-            uint32_t half_taps = m_taps / 2;
-            m_weights = std::unique_ptr<Scalar[]>(new Scalar[m_taps]);
-
-            double sum = 0.0;
-            for (uint32_t i = 0; i < m_taps; i++) {
-                auto weight = rfilter->eval(Float((int32_t) i - (int32_t) half_taps));
-                m_weights[i] = Scalar(weight);
-                sum += double(weight);
-            }
-
-            Assert(sum != 0, "Resampler(): filter footprint is too small; the "
-                             "support of some output samples does not contain "
-                             "any input samples!");
-
-            double normalization = 1.0 / sum;
-            for (uint32_t i = 0; i < m_taps; i++) {
-                Scalar &value = m_weights[i];
-                value = Scalar(double(value) * normalization);
-            }
-            m_fast_start = std::min(half_taps, m_target_res - 1);
-            m_fast_end   = (uint32_t) std::max(
-                (ssize_t) m_target_res - (ssize_t) half_taps - 1, (ssize_t) 0);
-        }
-
-        /* Avoid overlapping fast start/end intervals when the
-           target image is very small compared to the source image */
-        m_fast_start = std::min(m_fast_start, m_fast_end);
+        m_table = weight_table(rfilter, source_res, target_res);
+        m_start = m_table->start.get();
+        m_weights = m_table->weights.get();
+        m_taps = m_table->taps;
+        m_fast_start = m_table->fast_start;
+        m_fast_end = m_table->fast_end;
     }
 
     /// Return the reconstruction filter's source resolution
@@ -277,6 +203,87 @@ template <typename Scalar_> struct Resampler {
     }
 
 
+    /**
+     * \brief Resample a batch of \c count independent signals stored next to
+     * each other, and clamp the results to the valid range
+     *
+     * Sample \c i of signal \c k is located at <tt>source[i * source_stride + k]</tt>
+     * (and analogously for the target). This is the layout of the vertical
+     * pass of an image resampling operation, where \c k ranges over all
+     * columns and channels of a block of pixels. Adjacent signals are
+     * processed together using SIMD packets.
+     *
+     * \param source
+     *     Source array of samples
+     * \param source_stride
+     *     Distance between consecutive samples of a signal in the source array
+     * \param target
+     *     Target array of samples
+     * \param target_stride
+     *     Distance between consecutive samples of a signal in the target array
+     * \param count
+     *     Number of signals to be resampled
+     */
+    void resample_batch(const Scalar *source, size_t source_stride,
+                        Scalar *target, size_t target_stride, size_t count) const {
+        const uint32_t taps = m_taps, half_taps = m_taps / 2;
+        const Scalar min = std::get<0>(m_clamp);
+        const Scalar max = std::get<1>(m_clamp);
+        const bool clamp = m_clamp != std::make_pair(-std::numeric_limits<Scalar>::infinity(),
+                                                      std::numeric_limits<Scalar>::infinity());
+
+        std::unique_ptr<const Scalar *[]> rows(new const Scalar *[taps]);
+        std::unique_ptr<Scalar[]> row_weights(new Scalar[taps]);
+
+        for (uint32_t i = 0; i < m_target_res; ++i) {
+            const int32_t offset =
+                m_start ? m_start[i] : ((int32_t) i - (int32_t) half_taps);
+            const Scalar *weights = m_weights + (m_start ? (size_t) i * taps : 0);
+
+            /* Resolve the boundary conditions once for the whole batch */
+            Scalar bias = 0;
+            uint32_t n = 0;
+            for (uint32_t j = 0; j < taps; ++j) {
+                int32_t pos = offset + (int32_t) j;
+                if (unlikely(pos < 0 || pos >= (int32_t) m_source_res)) {
+                    pos = boundary_index(pos);
+                    if (pos == BoundaryOne)
+                        bias += weights[j];
+                    if (pos < 0)
+                        continue;
+                }
+                rows[n] = source + (size_t) pos * source_stride;
+                row_weights[n++] = weights[j];
+            }
+
+            Scalar *t = target + (size_t) i * target_stride;
+            size_t k = 0;
+
+            if constexpr (std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>) {
+                using ScalarP = Packet<Scalar>;
+                constexpr size_t Size = array_size_v<ScalarP>;
+
+                for (; k + Size <= count; k += Size) {
+                    ScalarP result(bias);
+                    for (uint32_t j = 0; j < n; ++j)
+                        result = fmadd(load_unaligned<ScalarP>(rows[j] + k),
+                                       ScalarP(row_weights[j]), result);
+
+                    if (clamp)
+                        result = enoki::clamp(result, ScalarP(min), ScalarP(max));
+                    store_unaligned(t + k, result);
+                }
+            }
+
+            for (; k < count; ++k) {
+                Scalar result = bias;
+                for (uint32_t j = 0; j < n; ++j)
+                    result += rows[j][k] * row_weights[j];
+                t[k] = clamp ? enoki::template clamp<Scalar>(result, min, max) : result;
+            }
+        }
+    }
+
     /// Return a human-readable summary
     std::string to_string() const {
         return tfm::format("Resampler[source_res=%i, target_res=%i]",
@@ -284,13 +291,162 @@ template <typename Scalar_> struct Resampler {
     }
 
 private:
+    /// Filter weights for a given filter and pair of resolutions
+    struct WeightTable {
+        std::unique_ptr<int32_t[]> start;
+        std::unique_ptr<Scalar[]> weights;
+        uint32_t taps;
+        uint32_t fast_start;
+        uint32_t fast_end;
+    };
+
+    /**
+     * \brief Return the weight table for the given configuration
+     *
+     * Tables are cached process-wide, since e.g. texture and environment
+     * map loading repeatedly resample images of the same size. They are
+     * keyed by the two resolutions and by the filter's type, radius, and
+     * tabulated values, which capture its parameters at full precision. Keys
+     * don't refer to the filter object, which may be freed in the meantime.
+     */
+    static std::shared_ptr<const WeightTable>
+    weight_table(const ReconstructionFilter *rfilter, uint32_t source_res,
+                 uint32_t target_res) {
+        using Key = std::tuple<std::string, Float, std::vector<Float>,
+                               uint32_t, uint32_t>;
+        static std::mutex mutex;
+        static std::map<Key, std::shared_ptr<const WeightTable>> cache;
+
+        Key key(rfilter->class_()->name(), rfilter->radius(), rfilter->values(),
+                source_res, target_res);
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            auto it = cache.find(key);
+            if (it != cache.end())
+                return it->second;
+        }
+
+        std::shared_ptr<const WeightTable> table =
+            compute_weight_table(rfilter, source_res, target_res);
+
+        std::lock_guard<std::mutex> guard(mutex);
+        if (cache.size() >= MTS_RESAMPLER_CACHE_SIZE)
+            cache.clear();
+        return cache.emplace(key, table).first->second;
+    }
+
+    static std::shared_ptr<const WeightTable>
+    compute_weight_table(const ReconstructionFilter *rfilter,
+                         uint32_t source_res, uint32_t target_res) {
+        std::shared_ptr<WeightTable> table = std::make_shared<WeightTable>();
+        uint32_t &taps = table->taps,
+                 &fast_start = table->fast_start,
+                 &fast_end = table->fast_end;
+
+        Float filter_radius_orig = rfilter->radius(),
+              filter_radius = filter_radius_orig,
+              scale = 1, inv_scale = 1;
+
+        /* Low-pass filter: scale reconstruction filters when downsampling */
+        if (target_res < source_res) {
+            scale = (Float) source_res / (Float) target_res;
+            inv_scale = rcp(scale);
+            filter_radius *= scale;
+        }
+
+        taps = enoki::ceil2int<uint32_t>(filter_radius * 2);
+        if (source_res == target_res && (taps % 2) != 1)
+            --taps;
+
+        if (filter_radius_orig < 1)
+            taps = std::min(taps, source_res);
+
+        if (source_res != target_res) { /* Resampling mode */
+            table->start = std::unique_ptr<int32_t[]>(new int32_t[target_res]);
+            table->weights = std::unique_ptr<Scalar[]>(new Scalar[taps * target_res]);
+            int32_t *start = table->start.get();
+            Scalar *weights = table->weights.get();
+            fast_start = 0;
+            fast_end = target_res;
+
+            for (uint32_t i = 0; i < target_res; i++) {
+                /* Compute the fractional coordinates of the new sample i
+                   in the original coordinates */
+                Float center = (i + Float(0.5)) / target_res * source_res;
+
+                /* Determine the index of the first original sample
+                   that might contribute */
+                start[i] = enoki::floor2int<uint32_t>(center - filter_radius + Float(0.5));
+
+                /* Determine the size of center region, on which to run
+                   the fast non condition-aware code */
+                if (start[i] < 0)
+                    fast_start = std::max(fast_start, i + 1);
+                else if (start[i] + taps - 1 >= source_res)
+                    fast_end = std::min(fast_end, i);
+
+                double sum = 0.0;
+                for (uint32_t j = 0; j < taps; j++) {
+                    /* Compute the position where the filter should be evaluated */
+                    Float pos = start[i] + (int32_t) j + Float(0.5) - center;
+
+                    /* Perform the evaluation and record the weight */
+                    auto weight = rfilter->eval(pos * inv_scale);
+                    weights[i * taps + j] = static_cast<Scalar>(weight);
+                    sum += double(weight);
+                }
+
+                Assert(sum != 0, "Resampler(): filter footprint is too small; the "
+                                 "support of some output samples does not contain "
+                                 "any input samples!");
+
+                /* Normalize the contribution of each sample */
+                double normalization = 1.0 / sum;
+                for (uint32_t j = 0; j < taps; j++) {
+                    Scalar &value = weights[i * taps + j];
+                    value = Scalar(double(value) * normalization);
+                }
+            }
+        } else { /* Filtering mode */
+            uint32_t half_taps = taps / 2;
+            table->weights = std::unique_ptr<Scalar[]>(new Scalar[taps]);
+            Scalar *weights = table->weights.get();
+
+            double sum = 0.0;
+            for (uint32_t i = 0; i < taps; i++) {
+                auto weight = rfilter->eval(Float((int32_t) i - (int32_t) half_taps));
+                weights[i] = Scalar(weight);
+                sum += double(weight);
+            }
+
+            Assert(sum != 0, "Resampler(): filter footprint is too small; the "
+                             "support of some output samples does not contain "
+                             "any input samples!");
+
+            double normalization = 1.0 / sum;
+            for (uint32_t i = 0; i < taps; i++) {
+                Scalar &value = weights[i];
+                value = Scalar(double(value) * normalization);
+            }
+            fast_start = std::min(half_taps, target_res - 1);
+            fast_end   = (uint32_t) std::max(
+                (ssize_t) target_res - (ssize_t) half_taps - 1, (ssize_t) 0);
+        }
+
+        /* Avoid overlapping fast start/end intervals when the
+           target image is very small compared to the source image */
+        fast_start = std::min(fast_start, fast_end);
+
+        return table;
+    }
+
     template <bool Clamp, bool Resample>
     void resample_internal(const Scalar *source, uint32_t source_stride,
                            Scalar *target, uint32_t target_stride,
                            uint32_t channels) const {
         const uint32_t taps = m_taps, half_taps = m_taps / 2;
-        const Scalar *weights = m_weights.get();
-        const int32_t *start = m_start.get();
+        const Scalar *weights = m_weights;
+        const int32_t *start = m_start;
         const Scalar min = std::get<0>(m_clamp);
         const Scalar max = std::get<1>(m_clamp);
 
@@ -318,7 +474,49 @@ private:
         }
 
         /* Use a faster branch-free loop for resampling the main portion */
-        for (uint32_t i = m_fast_start; i < m_fast_end; ++i) {
+        uint32_t i_packet = m_fast_start;
+
+        if constexpr (std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>) {
+            /* Process several target samples at once using SIMD gathers from
+               the interleaved channels of the source */
+            using ScalarP = Packet<Scalar>;
+            using Int32P = int32_array_t<ScalarP>;
+            constexpr uint32_t Size = (uint32_t) array_size_v<ScalarP>;
+
+            const Int32P lane = arange<Int32P>();
+            const int32_t sample_stride = (int32_t) (target_stride + channels);
+
+            for (; i_packet + Size <= m_fast_end; i_packet += Size) {
+                Int32P offset = Resample ? load_unaligned<Int32P>(start)
+                                         : Int32P((int32_t) i_packet - (int32_t) half_taps) + lane;
+                Int32P weight_index = lane * (int32_t) taps;
+
+                for (uint32_t ch = 0; ch < channels; ++ch) {
+                    ScalarP result = zero<ScalarP>();
+                    Int32P index = offset * (int32_t) source_stride + (int32_t) ch;
+
+                    for (uint32_t j = 0; j < taps; ++j) {
+                        ScalarP weight = Resample ? gather<ScalarP>(weights + j, weight_index)
+                                                  : ScalarP(weights[j]);
+                        result = fmadd(gather<ScalarP>(source, index), weight, result);
+                        index += (int32_t) source_stride;
+                    }
+
+                    if (Clamp)
+                        result = enoki::clamp(result, ScalarP(min), ScalarP(max));
+                    scatter(target + ch, result, lane * sample_stride);
+                }
+
+                target += Size * sample_stride;
+
+                if (Resample) {
+                    start += Size;
+                    weights += Size * taps;
+                }
+            }
+        }
+
+        for (uint32_t i = i_packet; i < m_fast_end; ++i) {
             const int32_t offset =
                 Resample ? (*start++) : ((int32_t) i - half_taps);
 
@@ -361,35 +559,49 @@ private:
 
     Scalar lookup(const Scalar *source, int32_t pos, uint32_t stride, uint32_t ch) const {
         if (unlikely(pos < 0 || pos >= (int32_t) m_source_res)) {
-            switch (m_bc) {
-                case FilterBoundaryCondition::Clamp:
-                    pos = enoki::clamp(pos, 0, (int32_t) m_source_res - 1);
-                    break;
-
-                case FilterBoundaryCondition::Repeat:
-                    pos = math::modulo(pos, (int32_t) m_source_res);
-                    break;
-
-                case FilterBoundaryCondition::Mirror:
-                    pos = math::modulo(pos, 2 * (int32_t) m_source_res - 2);
-                    if (pos >= (int32_t) m_source_res - 1)
-                        pos = 2 * m_source_res - 2 - pos;
-                    break;
-
-                case FilterBoundaryCondition::One:
-                    return Scalar(1);
-
-                case FilterBoundaryCondition::Zero:
-                    return Scalar(0);
-            }
+            pos = boundary_index(pos);
+            if (pos == BoundaryOne)
+                return Scalar(1);
+            else if (pos == BoundaryZero)
+                return Scalar(0);
         }
 
         return source[pos * stride + ch];
     }
 
+    /// Special return values of \ref boundary_index()
+    static constexpr int32_t BoundaryZero = -1, BoundaryOne = -2;
+
+    /// Map an out-of-range sample position into the input domain
+    int32_t boundary_index(int32_t pos) const {
+        switch (m_bc) {
+            case FilterBoundaryCondition::Clamp:
+                pos = enoki::clamp(pos, 0, (int32_t) m_source_res - 1);
+                break;
+
+            case FilterBoundaryCondition::Repeat:
+                pos = math::modulo(pos, (int32_t) m_source_res);
+                break;
+
+            case FilterBoundaryCondition::Mirror:
+                pos = math::modulo(pos, 2 * (int32_t) m_source_res - 2);
+                if (pos >= (int32_t) m_source_res - 1)
+                    pos = 2 * m_source_res - 2 - pos;
+                break;
+
+            case FilterBoundaryCondition::One:
+                return BoundaryOne;
+
+            case FilterBoundaryCondition::Zero:
+                return BoundaryZero;
+        }
+        return pos;
+    }
+
 private:
-    std::unique_ptr<int32_t[]> m_start;
-    std::unique_ptr<Scalar[]> m_weights;
+    std::shared_ptr<const WeightTable> m_table;
+    const int32_t *m_start;
+    const Scalar *m_weights;
     uint32_t m_source_res;
     uint32_t m_target_res;
     uint32_t m_fast_start;
@@ -0,0 +1,188 @@
+/* Builtin render statistics (counters and histograms) */
+
+#pragma once
+
+#include <mitsuba/core/object.h>
+#include <enoki/array.h>
+#include <vector>
+
+/// Number of bins of the histograms (the last bin also collects all larger values)
+#if !defined(MTS_STATISTICS_HISTOGRAM_BINS)
+#  define MTS_STATISTICS_HISTOGRAM_BINS 64
+#endif
+
+NAMESPACE_BEGIN(mitsuba)
+
+/// List of event counters that are maintained by the statistics registry
+enum class StatisticsCounter : int {
+    RaysTraced = 0,             /* Scene::ray_intersect() */
+    ShadowRaysTraced,           /* Scene::ray_test() */
+    KDTreeNodesVisited,         /* ShapeKDTree::ray_intersect_scalar() */
+    KDTreePrimitiveTests,       /* ShapeKDTree::ray_intersect_scalar() */
+    PathsTraced,                /* Path tracers */
+    MediumNullCollisions,       /* Volumetric path tracers */
+    MediumRealCollisions,       /* Volumetric path tracers */
+    StructConverterCacheHits,   /* StructConverter */
+    StructConverterCacheMisses, /* StructConverter */
+    CompiledMeshCacheHits,      /* Compiled scene files */
+    CompiledMeshCacheMisses,    /* Compiled scene files */
+    ScratchAllocations,         /* MemoryArena::allocate() */
+    ScratchHeapAllocations,     /* MemoryArena: chunks allocated on the heap */
+
+    StatisticsCounterCount
+};
+
+constexpr const char
+    *statistics_counter_id[int(StatisticsCounter::StatisticsCounterCount)] = {
+        "Rays traced",
+        "Shadow rays traced",
+        "kd-tree nodes visited",
+        "kd-tree primitive tests",
+        "Paths traced",
+        "Medium null collisions",
+        "Medium real collisions",
+        "StructConverter cache hits",
+        "StructConverter cache misses",
+        "Compiled mesh cache hits",
+        "Compiled mesh cache misses",
+        "Scratch allocations",
+        "Scratch heap allocations"
+    };
+
+/// List of histograms that are maintained by the statistics registry
+enum class StatisticsHistogram : int {
+    PathLength = 0,             /* Path tracers: number of bounces */
+    KDTreeNodesPerRay,          /* ShapeKDTree::ray_intersect_scalar() */
+
+    StatisticsHistogramCount
+};
+
+constexpr const char
+    *statistics_histogram_id[int(StatisticsHistogram::StatisticsHistogramCount)] = {
+        "Path length",
+        "kd-tree nodes visited per ray"
+    };
+
+/// Range of values that is covered by each histogram bin
+constexpr uint32_t
+    statistics_histogram_bin_width[int(StatisticsHistogram::StatisticsHistogramCount)] = {
+        1, 4
+    };
+
+static_assert(std::extent_v<decltype(statistics_counter_id)> ==
+                  int(StatisticsCounter::StatisticsCounterCount),
+              "Statistics counters and descriptions don't have matching length!");
+
+static_assert(std::extent_v<decltype(statistics_histogram_id)> ==
+                  int(StatisticsHistogram::StatisticsHistogramCount),
+              "Statistics histograms and descriptions don't have matching length!");
+
+#if defined(MTS_ENABLE_STATISTICS)
+
+/// Counters and histograms of a single thread
+struct StatisticsData {
+    uint64_t counters[int(StatisticsCounter::StatisticsCounterCount)];
+
+    struct Histogram {
+        uint64_t bins[MTS_STATISTICS_HISTOGRAM_BINS];
+        uint64_t count, sum;
+    } histograms[int(StatisticsHistogram::StatisticsHistogramCount)];
+};
+
+/* Return the statistics of the current thread. The entries of a thread are
+   registered on first use and remain valid after the thread has exited. See
+   \ref profiler_flags() regarding the attributes. */
+extern MTS_EXPORT_CORE StatisticsData *statistics_data()
+    __attribute__((noinline, weak, const));
+
+/// Increase an event counter of the current thread
+inline void statistics_add(StatisticsCounter counter, uint64_t value = 1) {
+    statistics_data()->counters[int(counter)] += value;
+}
+
+/// Record a value in a histogram of the current thread
+inline void statistics_record(StatisticsHistogram histogram, uint64_t value) {
+    auto &h = statistics_data()->histograms[int(histogram)];
+    uint64_t bin = value / statistics_histogram_bin_width[int(histogram)];
+    h.bins[std::min(bin, (uint64_t) MTS_STATISTICS_HISTOGRAM_BINS - 1)]++;
+    h.count++;
+    h.sum += value;
+}
+
+#else
+
+inline void statistics_add(StatisticsCounter, uint64_t = 1) { }
+inline void statistics_record(StatisticsHistogram, uint64_t) { }
+
+#endif
+
+/**
+ * \brief Increase an event counter by the number of active entries of \c mask
+ *
+ * Does nothing on the GPU, where counting would require a costly
+ * synchronization.
+ */
+template <typename Mask> void statistics_count(StatisticsCounter counter, const Mask &mask) {
+#if defined(MTS_ENABLE_STATISTICS)
+    if constexpr (!enoki::is_array_v<Mask>) {
+        if (mask)
+            statistics_add(counter);
+    } else if constexpr (!enoki::is_cuda_array_v<Mask>) {
+        statistics_add(counter, (uint64_t) enoki::count(mask));
+    }
+#else
+    ENOKI_MARK_USED(counter);
+    ENOKI_MARK_USED(mask);
+#endif
+}
+
+/**
+ * \brief Builtin registry of render statistics
+ *
+ * Performance-relevant events (e.g. traced rays, visited kd-tree nodes or
+ * null collisions in participating media) are counted using \ref
+ * statistics_add() and \ref statistics_record(). The counters are stored
+ * per thread, hence recording an event does not involve any locking or atomic
+ * operations. The registry is only compiled when Mitsuba is configured with
+ * the <tt>MTS_ENABLE_STATISTICS</tt> CMake option; otherwise, all of these
+ * functions compile to nothing.
+ *
+ * Histograms are only recorded by the scalar variants, since the lanes of a
+ * packet generally correspond to different values.
+ */
+class MTS_EXPORT_CORE Statistics {
+public:
+    /// Was Mitsuba compiled with support for render statistics?
+    static bool enabled();
+
+    /**
+     * \brief Reset all counters and histograms, and restart the clock that
+     * is used to compute event rates
+     *
+     * Should not be called while other threads are recording events.
+     */
+    static void reset();
+
+    /// Return the total of an event counter over all threads
+    static uint64_t counter(StatisticsCounter counter);
+
+    /// Return the bins of a histogram summed over all threads
+    static std::vector<uint64_t> histogram(StatisticsHistogram histogram);
+
+    /// Return the mean of the values that were recorded in a histogram
+    static double histogram_mean(StatisticsHistogram histogram);
+
+    /// Return the time (in seconds) since the last call to \ref reset()
+    static double elapsed();
+
+    /// Print the counters, event rates and histogram summaries
+    static void print_report();
+
+    /// Write all counters and histograms to a JSON file
+    static void write_json(const fs::path &filename);
+
+private:
+    Statistics() = delete;
+};
+
+NAMESPACE_END(mitsuba)
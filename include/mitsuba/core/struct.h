@@ -398,6 +398,8 @@ public:
 #if MTS_STRUCTCONVERTER_USE_JIT == 1
     bool convert_2d(size_t width, size_t height, const void *src,
                     void *dest) const {
+        if (m_vectorized)
+            return convert_2d_packet(width, height, src, dest);
         return m_func(width, height, src, dest);
     }
 #else
@@ -411,11 +413,51 @@ public:
     /// Return the target \c Struct descriptor
     const Struct *target() const { return m_target.get(); }
 
+    /**
+     * \brief Does this conversion use the wide SIMD backend?
+     *
+     * Common conversions (8/16 bit integer and half/single precision fields,
+     * gamma correction, weight division, and dithering) are processed
+     * several records at a time using the widest available Enoki packet
+     * (e.g. 8 lanes on AVX2, 16 lanes on AVX512). Everything else is handled
+     * by the per-record conversion routine.
+     */
+    bool vectorized() const { return m_vectorized; }
+
     /// Return a string representation
     std::string to_string() const override;
 
+    /**
+     * \brief Return the number of hits and misses of the process-wide cache
+     * of compiled conversion kernels
+     *
+     * Kernels are keyed by the source and target descriptors and the dither
+     * flag, and they are shared by all converters and threads. Conversions
+     * handled by the wide SIMD backend (see \ref vectorized()) don't compile a
+     * kernel. Both counts remain zero when the JIT compiler is disabled.
+     */
+    static std::pair<size_t, size_t> cache_statistics();
+
     MTS_DECLARE_CLASS()
 protected:
+    /// Per-field plan of the wide SIMD conversion backend
+    struct PacketField {
+        /// Target field
+        Struct::Field target;
+        /// Source field (only valid if \c has_source is set)
+        Struct::Field source;
+        /// Is there a corresponding source field? (otherwise, use the default)
+        bool has_source;
+        /// Can the field be copied without any conversion?
+        bool passthrough;
+    };
+
+    /// Check whether the wide SIMD backend can handle this conversion
+    void prepare_packet();
+
+    /// Wide SIMD conversion backend (see \ref vectorized())
+    bool convert_2d_packet(size_t width, size_t height, const void *src,
+                           void *dest) const;
 
 #if MTS_STRUCTCONVERTER_USE_JIT == 0
     // Support data structures/functions for non-accelerated conversion backend
@@ -442,9 +484,12 @@ protected:
     ref<const Struct> m_target;
 #if MTS_STRUCTCONVERTER_USE_JIT == 1
     FuncType m_func;
-#else
-    bool m_dither;
 #endif
+    bool m_dither;
+    bool m_vectorized = false;
+    std::vector<PacketField> m_packet_fields;
+    Struct::Field m_packet_weight;
+    bool m_packet_has_weight = false;
 };
 
 extern MTS_EXPORT_CORE std::ostream &operator<<(std::ostream &os, Struct::Type value);
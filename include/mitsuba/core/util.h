@@ -28,6 +28,9 @@ extern MTS_EXPORT_CORE std::string time_string(float time, bool precise = false)
 /// Turn a memory size into a human-readable string
 extern MTS_EXPORT_CORE std::string mem_string(size_t size, bool precise = false);
 
+/// Return the resident set size of the current process in bytes (or 0 if unsupported)
+extern MTS_EXPORT_CORE size_t resident_memory();
+
 /// Returns 'true' if the application is running inside a debugger
 extern MTS_EXPORT_CORE bool detect_debugger();
 
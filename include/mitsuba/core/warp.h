@@ -498,6 +498,221 @@ MTS_INLINE Value square_to_uniform_cone_pdf(const Vector<Value, 3> &v,
 
 // =======================================================================
 
+/**
+ * \brief Solid angle of the spherical triangle with the given vertices
+ *
+ * Uses the formula by Van Oosterom and Strackee. The vertices must have unit
+ * length.
+ */
+template <typename Value>
+MTS_INLINE Value spherical_triangle_solid_angle(const Vector<Value, 3> &a,
+                                                const Vector<Value, 3> &b,
+                                                const Vector<Value, 3> &c) {
+    return 2.f * atan2(abs(dot(a, cross(b, c))),
+                       1.f + dot(a, b) + dot(b, c) + dot(c, a));
+}
+
+/**
+ * \brief Uniformly sample a direction within a spherical triangle
+ *
+ * Implements the method from "Stratified sampling of spherical triangles" by
+ * James Arvo (SIGGRAPH 1995). The vertices \c a, \c b, and \c c of the
+ * spherical triangle must have unit length. Triangles that subtend a very
+ * small solid angle lead to numerical instabilities, in which case area
+ * sampling is preferable.
+ *
+ * \param sample A uniformly distributed sample on \f$[0,1]^2\f$
+ */
+template <typename Value>
+MTS_INLINE Vector<Value, 3> square_to_spherical_triangle(const Point<Value, 2> &sample,
+                                                         const Vector<Value, 3> &a,
+                                                         const Vector<Value, 3> &b,
+                                                         const Vector<Value, 3> &c) {
+    using Vector3 = Vector<Value, 3>;
+
+    // Angle between two unit vectors, robust for nearly (anti-)parallel ones
+    auto angle_between = [](const Vector3 &v1, const Vector3 &v2) {
+        return select(dot(v1, v2) < 0.f,
+                      math::Pi<Value> - 2.f * safe_asin(.5f * norm(v1 + v2)),
+                      2.f * safe_asin(.5f * norm(v2 - v1)));
+    };
+
+    // Normals of the planes containing the edges of the spherical triangle
+    Vector3 n_ab = normalize(cross(a, b)),
+            n_bc = normalize(cross(b, c)),
+            n_ca = normalize(cross(c, a));
+
+    // Interior angles at the vertices
+    Value alpha = angle_between(n_ab, -n_ca),
+          beta  = angle_between(n_bc, -n_ab),
+          gamma = angle_between(n_ca, -n_bc);
+
+    // Uniformly sample the area of the sub-triangle (plus pi)
+    Value area_pi = math::Pi<Value> + sample.x() * (alpha + beta + gamma - math::Pi<Value>);
+
+    // Find the cosine of the arc length between 'a' and the new vertex
+    auto [sin_alpha, cos_alpha] = sincos(alpha);
+    auto [sin_area, cos_area]   = sincos(area_pi);
+    Value sin_phi = sin_area * cos_alpha - cos_area * sin_alpha,
+          cos_phi = cos_area * cos_alpha + sin_area * sin_alpha,
+          k1 = cos_phi + cos_alpha,
+          k2 = sin_phi - sin_alpha * dot(a, b),
+          cos_bp = (k2 + (k2 * cos_phi - k1 * sin_phi) * cos_alpha) /
+                   ((k2 * sin_phi + k1 * cos_phi) * sin_alpha);
+    cos_bp = clamp(cos_bp, -1.f, 1.f);
+
+    // New vertex on the arc between 'a' and 'c'
+    Vector3 cp = cos_bp * a + safe_sqrt(1.f - sqr(cos_bp)) *
+                 normalize(c - dot(c, a) * a);
+
+    // Sample a direction on the arc between 'b' and the new vertex
+    Value cos_theta = 1.f - sample.y() * (1.f - dot(cp, b));
+    return cos_theta * b + safe_sqrt(1.f - sqr(cos_theta)) *
+                           normalize(cp - dot(cp, b) * b);
+}
+
+/// Density of \ref square_to_spherical_triangle() with respect to solid angles
+template <typename Value>
+MTS_INLINE Value square_to_spherical_triangle_pdf(const Vector<Value, 3> &a,
+                                                  const Vector<Value, 3> &b,
+                                                  const Vector<Value, 3> &c) {
+    return rcp(spherical_triangle_solid_angle(a, b, c));
+}
+
+// =======================================================================
+
+namespace detail {
+    /* Precomputation for the spherical rectangle sampling routines. Returns
+       the z-components 'b0' and 'b1' of the normals of the two edges along
+       the X axis, the constant 'k', and the solid angle 'S' */
+    template <typename Value>
+    MTS_INLINE std::tuple<Value, Value, Value, Value>
+    spherical_rectangle_setup(const Point<Value, 2> &p0,
+                              const Point<Value, 2> &p1,
+                              const Value &z0) {
+        using Vector3 = Vector<Value, 3>;
+
+        Vector3 v00(p0.x(), p0.y(), z0), v01(p0.x(), p1.y(), z0),
+                v10(p1.x(), p0.y(), z0), v11(p1.x(), p1.y(), z0);
+
+        // Normals of the planes containing the edges of the spherical rectangle
+        Vector3 n0 = normalize(cross(v00, v10)),
+                n1 = normalize(cross(v10, v11)),
+                n2 = normalize(cross(v11, v01)),
+                n3 = normalize(cross(v01, v00));
+
+        // Interior angles at the vertices
+        Value g0 = safe_acos(-dot(n0, n1)),
+              g1 = safe_acos(-dot(n1, n2)),
+              g2 = safe_acos(-dot(n2, n3)),
+              g3 = safe_acos(-dot(n3, n0));
+
+        Value k = math::TwoPi<Value> - g2 - g3;
+        return { n0.z(), n2.z(), k, g0 + g1 - k };
+    }
+}
+
+/**
+ * \brief Solid angle of an axis-aligned rectangle as seen from the origin
+ *
+ * The rectangle covers the range \f$[p_0, p_1]\f$ of the plane with the
+ * given Z coordinate.
+ */
+template <typename Value>
+MTS_INLINE Value spherical_rectangle_solid_angle(const Point<Value, 2> &p0,
+                                                 const Point<Value, 2> &p1,
+                                                 const Value &z) {
+    return std::get<3>(detail::spherical_rectangle_setup(p0, p1, -abs(z)));
+}
+
+/**
+ * \brief Uniformly sample the solid angle subtended by a rectangle
+ *
+ * Implements the method from "An Area-Preserving Parametrization for
+ * Spherical Rectangles" by Ureña, Fajardo, and King (EGSR 2013). The
+ * rectangle covers the range \f$[p_0, p_1]\f$ of the plane with the given Z
+ * coordinate, and it is observed from the origin. Instead of a direction, the
+ * function returns the position on the rectangle, whose direction is
+ * uniformly distributed within the subtended solid angle. Rectangles that
+ * subtend a very small solid angle or that are seen at grazing angles lead
+ * to numerical instabilities, in which case area sampling is preferable.
+ *
+ * \param sample A uniformly distributed sample on \f$[0,1]^2\f$
+ */
+template <typename Value>
+MTS_INLINE Point<Value, 3> square_to_spherical_rectangle(const Point<Value, 2> &sample,
+                                                         const Point<Value, 2> &p0,
+                                                         const Point<Value, 2> &p1,
+                                                         const Value &z) {
+    // The mapping is symmetric with respect to the plane Z=0
+    Value z0 = -abs(z), z0_2 = sqr(z0);
+    auto [b0, b1, k, solid_angle] = detail::spherical_rectangle_setup(p0, p1, z0);
+
+    // Sample the X coordinate so that the sub-rectangle has the desired solid angle
+    auto [sin_au, cos_au] = sincos(fmadd(sample.x(), solid_angle, k));
+    Value fu = (cos_au * b0 - b1) / sin_au,
+          cu = clamp(mulsign(rsqrt(fmadd(fu, fu, sqr(b0))), fu), -1.f, 1.f),
+          xu = clamp(-(cu * z0) * rsqrt(fnmadd(cu, cu, 1.f)), p0.x(), p1.x());
+
+    // Sample the Y coordinate along the resulting vertical segment
+    Value d_2 = fmadd(xu, xu, z0_2),
+          d   = sqrt(d_2),
+          h0  = p0.y() * rsqrt(d_2 + sqr(p0.y())),
+          h1  = p1.y() * rsqrt(d_2 + sqr(p1.y())),
+          hv  = fmadd(sample.y(), h1 - h0, h0),
+          hv_2 = sqr(hv),
+          yv  = select(hv_2 < 1.f - math::RayEpsilon<Value>,
+                       hv * d * rsqrt(1.f - hv_2), p1.y());
+
+    return Point<Value, 3>(xu, yv, z);
+}
+
+/// Density of \ref square_to_spherical_rectangle() with respect to solid angles
+template <typename Value>
+MTS_INLINE Value square_to_spherical_rectangle_pdf(const Point<Value, 2> &p0,
+                                                   const Point<Value, 2> &p1,
+                                                   const Value &z) {
+    return rcp(spherical_rectangle_solid_angle(p0, p1, z));
+}
+
+/**
+ * \brief Solid angle below which \ref use_spherical_sampling() prefers area
+ * sampling
+ *
+ * Polygons that subtend a tiny solid angle are sampled just as well by area
+ * sampling, which does not suffer from the cancellation errors of the
+ * spherical mappings.
+ */
+template <typename T> constexpr auto SphericalSamplingMinSolidAngle = scalar_t<T>(3e-4);
+
+/**
+ * \brief Solid angle above which \ref use_spherical_sampling() prefers area
+ * sampling
+ *
+ * Slightly below \f$2\pi\f$: the spherical mappings become unstable when a
+ * polygon covers almost the entire hemisphere.
+ */
+template <typename T> constexpr auto SphericalSamplingMaxSolidAngle = scalar_t<T>(6.22);
+
+/**
+ * \brief Decide whether a polygon that subtends the given solid angle should be
+ * sampled using \ref square_to_spherical_triangle() or \ref
+ * square_to_spherical_rectangle() rather than by area
+ *
+ * \param min_solid_angle
+ *     Lower bound of the solid angle, which shapes can raise when spherical
+ *     sampling has additional costs (e.g. rejected samples)
+ */
+template <typename Value>
+MTS_INLINE mask_t<Value> use_spherical_sampling(
+    const Value &solid_angle,
+    scalar_t<Value> min_solid_angle = SphericalSamplingMinSolidAngle<Value>) {
+    return solid_angle > min_solid_angle &&
+           solid_angle < SphericalSamplingMaxSolidAngle<Value>;
+}
+
+// =======================================================================
+
 /// Warp a uniformly distributed square sample to a Beckmann distribution
 template <typename Value>
 MTS_INLINE Vector<Value, 3> square_to_beckmann(const Point<Value, 2> &sample,
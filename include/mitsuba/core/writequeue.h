@@ -0,0 +1,143 @@
+#pragma once
+
+#include <mitsuba/core/object.h>
+#include <mitsuba/core/thread.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Completion handle of a write operation that was submitted to a
+ * \ref WriteQueue
+ */
+class MTS_EXPORT_CORE WriteHandle : public Object {
+public:
+    /// Has the write operation finished (successfully or not)?
+    bool done() const;
+
+    /**
+     * \brief Block until the write operation has finished
+     *
+     * Re-throws the exception raised by the write operation, if any.
+     */
+    void wait() const;
+
+    /// Return a human-readable description of the write operation
+    const std::string &description() const { return m_description; }
+
+    /// Return a string representation
+    std::string to_string() const override;
+
+    MTS_DECLARE_CLASS()
+protected:
+    friend class WriteQueue;
+
+    WriteHandle(const std::string &description, std::shared_future<void> future);
+
+    /// Protected destructor
+    virtual ~WriteHandle();
+
+protected:
+    std::string m_description;
+    std::shared_future<void> m_future;
+};
+
+/**
+ * \brief Bounded queue of asynchronous write operations
+ *
+ * Write operations (e.g. \ref Bitmap::write_async()) are executed by a small
+ * set of dedicated I/O threads that are separate from the TBB worker pool,
+ * hence pending writes never steal threads from the renderer. The queue holds
+ * at most \ref capacity() pending operations; further submissions block until
+ * space becomes available, which bounds the memory held by queued images
+ * during bursts of writes (e.g. AOVs or progressive snapshots).
+ */
+class MTS_EXPORT_CORE WriteQueue : public Object {
+public:
+    /// Write operation; returns the number of bytes that were written
+    using Task = std::function<size_t()>;
+
+    /**
+     * \brief Create a new write queue
+     *
+     * \param thread_count
+     *     Number of dedicated I/O threads
+     *
+     * \param capacity
+     *     Maximum number of write operations that are queued (i.e. submitted
+     *     but not yet started) at any time
+     */
+    WriteQueue(size_t thread_count = 1, size_t capacity = 8);
+
+    /**
+     * \brief Submit a write operation
+     *
+     * Blocks while the queue is full. The returned handle can be used to wait
+     * for the completion of this specific operation.
+     */
+    ref<WriteHandle> enqueue(const std::string &description, Task task);
+
+    /// Block until all submitted write operations have finished
+    void wait();
+
+    /// Return the number of write operations that are queued or running
+    size_t pending() const;
+
+    /// Return the maximum number of queued write operations
+    size_t capacity() const { return m_capacity; }
+
+    /// Return the number of dedicated I/O threads
+    size_t thread_count() const { return m_threads.size(); }
+
+    /// Return the number of write operations that have finished successfully
+    size_t writes_completed() const;
+
+    /// Return the total number of bytes written by finished operations
+    size_t bytes_written() const;
+
+    /// Return the average throughput (in MiB/s) while the I/O threads were busy
+    double throughput() const;
+
+    /// Return a string representation
+    std::string to_string() const override;
+
+    /// Return the process-wide queue used by \ref Bitmap::write_async()
+    static WriteQueue *instance();
+
+    /// Wait for pending writes and release the process-wide queue
+    static void static_shutdown();
+
+    MTS_DECLARE_CLASS()
+protected:
+    class WorkerThread;
+
+    /// Protected destructor (waits for all pending write operations)
+    virtual ~WriteQueue();
+
+    /// Main loop of the I/O threads
+    void run();
+
+protected:
+    struct Entry {
+        std::string description;
+        Task task;
+        std::promise<void> promise;
+    };
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_task_cv, m_space_cv, m_idle_cv;
+    std::deque<Entry> m_queue;
+    std::vector<ref<Thread>> m_threads;
+    size_t m_capacity;
+    size_t m_running = 0;
+    bool m_shutdown = false;
+    size_t m_writes_completed = 0;
+    size_t m_bytes_written = 0;
+    double m_busy_time = 0.0;
+};
+
+NAMESPACE_END(mitsuba)
@@ -1,12 +1,19 @@
 #pragma once
 
 #include <mitsuba/mitsuba.h>
+#include <mitsuba/core/properties.h>
 #include <string>
 #include <vector>
 
 /// Max level of nested <include> directives
 #define MTS_XML_INCLUDE_MAX_RECURSION 15
 
+/// Alignment (in bytes) of the data blocks stored in compiled scene files
+#define MTS_XML_COMPILED_ALIGNMENT 64
+
+/// Number of individual objects listed in the load report (see \ref load_file())
+#define MTS_XML_LOAD_REPORT_ENTRIES 25
+
 NAMESPACE_BEGIN(mitsuba)
 NAMESPACE_BEGIN(xml)
 
@@ -14,7 +21,29 @@ NAMESPACE_BEGIN(xml)
 using ParameterList = std::vector<std::pair<std::string, std::string>>;
 
 /**
- * Load a Mitsuba scene from an XML file
+ * \brief Fully resolved description of a scene object
+ *
+ * This is the intermediate representation produced by \ref parse_file(): all
+ * includes, default values, parameter substitutions and transformations have
+ * been applied, and nested objects are referenced by their identifier.
+ */
+struct ObjectDescription {
+    /// Unique identifier (generated automatically for unnamed objects)
+    std::string id;
+    /// Tag name of the object's class (e.g. "bsdf" or "shape")
+    std::string tag;
+    /// When nonempty, this object is an alias of the object with the given identifier
+    std::string alias;
+    /// Plugin name and parameters. Nested objects are stored as named references.
+    Properties props;
+};
+
+/// Raw data block (pointer and size in bytes) that is stored in a compiled scene file
+using CompiledBlob = std::pair<const void *, size_t>;
+
+/**
+ * Load a Mitsuba scene from an XML file (or a compiled scene file, see \ref
+ * write_compiled())
  *
  * \param path
  *     Filename of the scene XML file
@@ -29,11 +58,59 @@ using ParameterList = std::vector<std::pair<std::string, std::string>>;
  * \param update_scene
  *     When Mitsuba updates scene to a newer version, should the
  *     updated XML file be written back to disk?
+ *
+ * \param load_report
+ *     Log the time and memory spent on instantiating each plugin
+ *     type, as well as the most expensive individual objects.
  */
 extern MTS_EXPORT_CORE ref<Object> load_file(const fs::path &path,
                                              const std::string &variant,
                                              ParameterList parameters = ParameterList(),
-                                             bool update_scene = false);
+                                             bool update_scene = false,
+                                             bool load_report = false);
+
+/**
+ * \brief Parse a Mitsuba scene XML file without instantiating any objects
+ *
+ * \param objects
+ *     Receives the descriptions of all objects in the scene
+ *
+ * \return
+ *     The identifier of the root object (usually the scene)
+ */
+extern MTS_EXPORT_CORE std::string parse_file(const fs::path &path,
+                                              const std::string &variant,
+                                              std::vector<ObjectDescription> &objects,
+                                              ParameterList parameters = ParameterList());
+
+/// Instantiate the object \c root_id from a set of object descriptions
+extern MTS_EXPORT_CORE ref<Object> instantiate(const std::vector<ObjectDescription> &objects,
+                                               const std::string &root_id,
+                                               const std::string &variant);
+
+/**
+ * \brief Write a compiled scene file
+ *
+ * Compiled scene files (extension <tt>.mtsc</tt>) store the resolved object
+ * descriptions of a scene along with a set of raw data blocks (e.g. mesh
+ * buffers) that are aligned so that plugins can map them into memory and use
+ * them without further processing (see \ref compiled_blob()). They are
+ * specific to the variant they were compiled for and can be passed to \ref
+ * load_file() in place of an XML file.
+ */
+extern MTS_EXPORT_CORE void write_compiled(const fs::path &path,
+                                           const std::string &variant,
+                                           const std::string &root_id,
+                                           const std::vector<ObjectDescription> &objects,
+                                           const std::vector<CompiledBlob> &blobs);
+
+/**
+ * \brief Look up a data block within a memory-mapped compiled scene file
+ *
+ * Returns a pointer to the block with the given index and its size in bytes.
+ */
+extern MTS_EXPORT_CORE CompiledBlob compiled_blob(const MemoryMappedFile *file,
+                                                  size_t index);
 
 /// Load a Mitsuba scene from an XML string
 extern MTS_EXPORT_CORE ref<Object> load_string(const std::string &string,
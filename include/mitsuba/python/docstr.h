@@ -25,6 +25,112 @@
 
 static const char *__doc_enoki_operator_lshift = R"doc(Prints the canonical representation of a PCG32 object.)doc";
 
+static const char *__doc_mitsuba_AliasDistribution =
+R"doc(Discrete 1D probability distribution with constant-time sampling
+
+This data structure represents the same kind of distribution as
+DiscreteDistribution, but samples it using Walker's alias method:
+every entry stores a probability of accepting its own index, and the
+index of an "alias" that is chosen otherwise. Sampling thus requires
+two memory accesses regardless of the size of the distribution,
+whereas the binary search of DiscreteDistribution::sample() performs a
+chain of dependent accesses that grows logarithmically. The resulting
+mapping of samples to indices is not monotonic, which does not matter
+for Monte Carlo integration but makes the distribution unsuitable for
+stratified or low-discrepancy samples that rely on preserving the
+relative position of samples.)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_AliasDistribution = R"doc(Create an unitialized AliasDistribution instance)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_AliasDistribution_2 = R"doc(Initialize from a given probability mass function)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_AliasDistribution_3 = R"doc(Initialize from a given probability mass function (rvalue version))doc";
+
+static const char *__doc_mitsuba_AliasDistribution_AliasDistribution_4 = R"doc(Initialize from a given floating point array)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_empty = R"doc(Is the distribution object empty/uninitialized?)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_eval_pmf =
+R"doc(Evaluate the unnormalized probability mass function (PMF) at index
+``index``)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_eval_pmf_normalized =
+R"doc(Evaluate the normalized probability mass function (PMF) at index
+``index``)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_m_alias = R"doc()doc";
+
+static const char *__doc_mitsuba_AliasDistribution_m_normalization = R"doc()doc";
+
+static const char *__doc_mitsuba_AliasDistribution_m_pmf = R"doc()doc";
+
+static const char *__doc_mitsuba_AliasDistribution_m_prob = R"doc()doc";
+
+static const char *__doc_mitsuba_AliasDistribution_m_sum = R"doc()doc";
+
+static const char *__doc_mitsuba_AliasDistribution_normalization = R"doc(Return the normalization factor (i.e. the inverse of sum()))doc";
+
+static const char *__doc_mitsuba_AliasDistribution_pmf = R"doc(Return the unnormalized probability mass function)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_pmf_2 = R"doc(Return the unnormalized probability mass function (const version))doc";
+
+static const char *__doc_mitsuba_AliasDistribution_sample =
+R"doc(%Transform a uniformly distributed sample to the stored distribution
+
+Parameter ``value``:
+    A uniformly distributed sample on the interval [0, 1].
+
+Returns:
+    The discrete index associated with the sample)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_sample_pmf =
+R"doc(%Transform a uniformly distributed sample to the stored distribution
+
+Parameter ``value``:
+    A uniformly distributed sample on the interval [0, 1].
+
+Returns:
+    A tuple consisting of
+
+1. the discrete index associated with the sample, and 2. the
+normalized probability value of the sample.)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_sample_reuse =
+R"doc(%Transform a uniformly distributed sample to the stored distribution
+
+The original sample is value adjusted so that it can be reused as a
+uniform variate.
+
+Parameter ``value``:
+    A uniformly distributed sample on the interval [0, 1].
+
+Returns:
+    A tuple consisting of
+
+1. the discrete index associated with the sample, and 2. the re-scaled
+sample value.)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_sample_reuse_pmf =
+R"doc(%Transform a uniformly distributed sample to the stored distribution.
+
+The original sample is value adjusted so that it can be reused as a
+uniform variate.
+
+Parameter ``value``:
+    A uniformly distributed sample on the interval [0, 1].
+
+Returns:
+    A tuple consisting of
+
+1. the discrete index associated with the sample 2. the re-scaled
+sample value 3. the normalized probability value of the sample)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_size = R"doc(Return the number of entries)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_sum = R"doc(Return the original sum of PMF entries before normalization)doc";
+
+static const char *__doc_mitsuba_AliasDistribution_update = R"doc(Update the internal state. Must be invoked when changing the pmf.)doc";
+
 static const char *__doc_mitsuba_AnimatedTransform =
 R"doc(Encapsulates an animated 4x4 homogeneous coordinate transformation
 
@@ -440,6 +546,33 @@ Parameter ``si``:
     surface position. The incident direction is obtained from the
     field ``si.wi``.)doc";
 
+static const char *__doc_mitsuba_BSDF_eval_pdf =
+R"doc(Jointly evaluate the BSDF f(wi, wo) and the probability per unit solid
+angle of sampling the given direction
+
+This is equivalent to separate calls to eval() and pdf(), but
+implementations can share intermediate quantities (e.g. texture
+lookups, Fresnel terms or microfacet distribution values) between the
+two. It is intended for next event estimation, where both values are
+needed for the same direction. The default implementation simply calls
+eval() and pdf().
+
+Parameter ``ctx``:
+    A context data structure describing which lobes to evalute, and
+    whether radiance or importance are being transported.
+
+Parameter ``si``:
+    A surface interaction data structure describing the underlying
+    surface position. The incident direction is obtained from the
+    field ``si.wi``.
+
+Parameter ``wo``:
+    The outgoing direction
+
+Returns:
+    A pair (value, pdf) containing the BSDF value (multiplied by the
+    cosine foreshortening factor) and the sampling density.)doc";
+
 static const char *__doc_mitsuba_BSDF_flags = R"doc(Flags for all components combined.)doc";
 
 static const char *__doc_mitsuba_BSDF_flags_2 = R"doc(Flags for a specific component of this BSDF.)doc";
@@ -1029,12 +1162,47 @@ compressor.)doc";
 
 static const char *__doc_mitsuba_Bitmap_write_async =
 R"doc(Equivalent to write(), but executes asynchronously on a different
-thread)doc";
+thread
+
+The write operation is submitted to the process-wide WriteQueue, which
+blocks when too many writes are already pending. The bitmap must not
+be modified until the write has finished.
+
+Returns:
+    A handle that can be used to wait for completion)doc";
 
 static const char *__doc_mitsuba_Bitmap_write_jpeg = R"doc(Save a file using the JPEG file format)doc";
 
 static const char *__doc_mitsuba_Bitmap_write_openexr = R"doc(Write a file using the OpenEXR file format)doc";
 
+static const char *__doc_mitsuba_Bitmap_write_openexr_2 =
+R"doc(Write an OpenEXR file with ``height`` scanlines, which are supplied in
+bands by ``fill`` (see write_openexr_bands()))doc";
+
+static const char *__doc_mitsuba_Bitmap_write_openexr_bands =
+R"doc(Incrementally write an OpenEXR file, one band of scanlines at a time
+
+This bitmap specifies the width, channel layout, and metadata of the
+output image and serves as a staging buffer for up to height()
+scanlines. For every band, ``fill`` is invoked with the index of the
+first scanline and the number of scanlines, and must write the
+corresponding pixels to the top rows of this bitmap. Peak memory usage
+is thus proportional to the band rather than to the full image.
+
+Parameter ``stream``:
+    Target stream that will receive the encoded output
+
+Parameter ``height``:
+    Total number of scanlines of the output image
+
+Parameter ``fill``:
+    Callback that provides the contents of each band
+
+Parameter ``quality``:
+    Quality level of the DWAB compressor (see write()))doc";
+
+static const char *__doc_mitsuba_Bitmap_write_openexr_bands_2 = R"doc(Equivalent to the above, but writes to a file)doc";
+
 static const char *__doc_mitsuba_Bitmap_write_pfm = R"doc(Save a file using the PFM file format)doc";
 
 static const char *__doc_mitsuba_Bitmap_write_png = R"doc(Save a file using the PNG file format)doc";
@@ -1503,6 +1671,20 @@ static const char *__doc_mitsuba_DefaultFormatter_set_has_log_level = R"doc(Shou
 
 static const char *__doc_mitsuba_DefaultFormatter_set_has_thread = R"doc(Should thread information be included? The default is yes.)doc";
 
+static const char *__doc_mitsuba_DenoiserGuide =
+R"doc(Feature image (e.g. normals or depth) that steers the weights of
+denoise_atrous())doc";
+
+static const char *__doc_mitsuba_DenoiserGuide_channels = R"doc(Number of channels)doc";
+
+static const char *__doc_mitsuba_DenoiserGuide_data =
+R"doc(Planar storage: ``channels`` consecutive images of ``width * height``
+values)doc";
+
+static const char *__doc_mitsuba_DenoiserGuide_sigma =
+R"doc(Tolerance for feature differences between neighboring pixels,
+relative to the standard deviation of the feature over the image)doc";
+
 static const char *__doc_mitsuba_DirectionSample =
 R"doc(Record for solid-angle based area sampling techniques
 
@@ -1976,6 +2158,12 @@ function is invoked by the Scene constructor.)doc";
 
 static const char *__doc_mitsuba_Endpoint_set_shape = R"doc(Set the shape associated with this endpoint.)doc";
 
+static const char *__doc_mitsuba_Endpoint_set_world_transform =
+R"doc(Replace the local space to world space transformation
+
+This is e.g. used to move cameras and light sources between the frames
+of an animated sequence without reloading the scene.)doc";
+
 static const char *__doc_mitsuba_Endpoint_shape = R"doc(Return the shape, to which the emitter is currently attached)doc";
 
 static const char *__doc_mitsuba_Endpoint_shape_2 =
@@ -2153,6 +2341,15 @@ image)
 Returns:
     ``True`` upon success)doc";
 
+static const char *__doc_mitsuba_Film_develop_async =
+R"doc(Develop the film and submit the result to the asynchronous
+WriteQueue
+
+The film contents are captured before this function returns, hence
+the film can immediately be reused (e.g. to render the next view of a
+batch) while the file is being written. The default implementation
+develops synchronously and returns ``nullptr``.)doc";
+
 static const char *__doc_mitsuba_Film_has_high_quality_edges =
 R"doc(Should regions slightly outside the image plane be sampled to improve
 the quality of the reconstruction at the edges? This only makes sense
@@ -3121,6 +3318,93 @@ static const char *__doc_mitsuba_Medium_to_string = R"doc(Return a human-readabl
 
 static const char *__doc_mitsuba_Medium_use_emitter_sampling = R"doc(Returns whether this specific medium instance uses emitter sampling)doc";
 
+static const char *__doc_mitsuba_MemoryArena =
+R"doc(Bump allocator for transient scratch memory
+
+Allocations are carved out of large chunks by advancing a pointer, and
+they are never released individually. Instead, reset() releases all of
+them at once, and ScopedMemoryArena releases the allocations made
+within a scope (e.g. an image block or a single sample).
+
+When the allocations between two resets did not fit into a single
+chunk, reset() merges the chunks into one (the render loop of
+SamplingIntegrator does so whenever a thread starts rendering). After a short warm-up phase,
+the arena therefore no longer performs any heap allocations, which can
+be verified using heap_allocation_count().
+
+Each thread has its own arena, see thread(). Only trivially
+destructible types may be stored, since destructors are never run.)doc";
+
+static const char *__doc_mitsuba_MemoryArena_Chunk = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_Chunk_data = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_Chunk_size = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_Marker = R"doc(Position within the arena, see mark() and rewind())doc";
+
+static const char *__doc_mitsuba_MemoryArena_Marker_chunk = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_Marker_head = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_MemoryArena = R"doc(Create an empty arena, whose chunks have at least the given size)doc";
+
+static const char *__doc_mitsuba_MemoryArena_MemoryArena_2 = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_allocate = R"doc(Allocate ``size`` bytes of uninitialized memory with the given alignment)doc";
+
+static const char *__doc_mitsuba_MemoryArena_allocate_2 = R"doc(Allocate and default-initialize an array of ``count`` entries)doc";
+
+static const char *__doc_mitsuba_MemoryArena_allocate_slow = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_allocation_count = R"doc(Return the number of calls to allocate() over the lifetime of the arena)doc";
+
+static const char *__doc_mitsuba_MemoryArena_capacity = R"doc(Return the combined size of all chunks in bytes)doc";
+
+static const char *__doc_mitsuba_MemoryArena_chunk_count = R"doc(Return the number of chunks)doc";
+
+static const char *__doc_mitsuba_MemoryArena_heap_allocation_count =
+R"doc(Return the number of chunks that were allocated on the heap over the
+lifetime of the arena)doc";
+
+static const char *__doc_mitsuba_MemoryArena_m_allocation_count = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_m_chunk = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_m_chunk_size = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_m_chunks = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_m_end = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_m_head = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_m_heap_allocation_count = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_mark = R"doc(Return the current position, which can be restored using rewind())doc";
+
+static const char *__doc_mitsuba_MemoryArena_operator_assign = R"doc()doc";
+
+static const char *__doc_mitsuba_MemoryArena_reset =
+R"doc(Release all allocations
+
+When more than one chunk is in use, they are replaced by a single chunk
+of the combined size.)doc";
+
+static const char *__doc_mitsuba_MemoryArena_rewind = R"doc(Release all allocations made since mark() returned ``marker``)doc";
+
+static const char *__doc_mitsuba_MemoryArena_static_initialization = R"doc(Create the per-thread arenas (called by Thread::static_initialization()))doc";
+
+static const char *__doc_mitsuba_MemoryArena_static_shutdown = R"doc(Release the per-thread arenas (called by Thread::static_shutdown()))doc";
+
+static const char *__doc_mitsuba_MemoryArena_thread =
+R"doc(Return the arena of the calling thread
+
+The lookup is cached per thread, so that it is cheap enough to be
+performed in inner loops (e.g. once per sample).)doc";
+
+static const char *__doc_mitsuba_MemoryArena_used = R"doc(Return the number of bytes allocated since the last reset (including padding))doc";
+
 static const char *__doc_mitsuba_MemoryMappedFile =
 R"doc(Basic cross-platform abstraction for memory mapped files
 
@@ -3266,14 +3550,34 @@ static const char *__doc_mitsuba_Mesh_3 = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_4 = R"doc()doc";
 
+static const char *__doc_mitsuba_Mesh_BufferDeleter =
+R"doc(Deleter that only releases buffers which were allocated by the mesh
+itself)doc";
+
+static const char *__doc_mitsuba_Mesh_BufferDeleter_owned = R"doc()doc";
+
+static const char *__doc_mitsuba_Mesh_BufferDeleter_operator_call = R"doc()doc";
+
 static const char *__doc_mitsuba_Mesh_Mesh = R"doc(Create a new mesh with the given vertex and face data structures)doc";
 
 static const char *__doc_mitsuba_Mesh_Mesh_2 = R"doc(Create a new mesh from a blender mesh)doc";
 
-static const char *__doc_mitsuba_Mesh_Mesh_3 = R"doc()doc";
+static const char *__doc_mitsuba_Mesh_Mesh_3 =
+R"doc(Create a new mesh that wraps existing vertex and face buffers
+
+No copy of the geometry is made. The buffers must be laid out as
+specified by ``vertex_struct`` and ``face_struct`` and must provide
+storage for one additional (padding) record beyond ``vertex_count`` and
+``face_count``, respectively, which is used by vectorized loads.
+
+Parameter ``owner``:
+    Handle that keeps the underlying memory alive. It is retained for
+    the lifetime of the mesh and released when the mesh is destroyed.)doc";
 
 static const char *__doc_mitsuba_Mesh_Mesh_4 = R"doc()doc";
 
+static const char *__doc_mitsuba_Mesh_Mesh_5 = R"doc()doc";
+
 static const char *__doc_mitsuba_Mesh_area_distr_build =
 R"doc(Build internal tables for sampling uniformly wrt. area.
 
@@ -3290,6 +3594,29 @@ static const char *__doc_mitsuba_Mesh_bbox_3 = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_class = R"doc()doc";
 
+static const char *__doc_mitsuba_Mesh_compact_vertices =
+R"doc(Convert the vertex data into a compact, non-interleaved layout
+
+Afterwards, the vertex buffer only contains tightly packed positions,
+which is all that ray intersection requires. Vertex normals are stored
+in a separate buffer using a 32 bit octahedral encoding, and texture
+coordinates are moved into a separate buffer in single or (when
+``half_texcoords`` is set) half precision. The accessors
+vertex_normal() and vertex_texcoord() decode them transparently.
+
+Meshes with additional per-vertex attributes (e.g. colors) are left
+unchanged.)doc";
+
+static const char *__doc_mitsuba_Mesh_emission_distr_build =
+R"doc(Build the table for sampling triangles proportionally to the power
+they emit
+
+Invoked by area emitters with a spatially varying radiance texture.
+The texture is integrated over each triangle using a fixed set of
+quadrature points, and sample_direction() subsequently picks triangles
+according to the resulting power instead of their area. Not supported
+by GPU variants, which keep sampling triangles by area.)doc";
+
 static const char *__doc_mitsuba_Mesh_face = R"doc(Return a pointer (or packet of pointers) to a specific face)doc";
 
 static const char *__doc_mitsuba_Mesh_face_2 =
@@ -3312,22 +3639,39 @@ static const char *__doc_mitsuba_Mesh_faces_2 = R"doc(Return a pointer to the ra
 
 static const char *__doc_mitsuba_Mesh_fill_surface_interaction = R"doc()doc";
 
+static const char *__doc_mitsuba_Mesh_has_compact_vertices =
+R"doc(Does the mesh use the compact vertex layout? (see compact_vertices()))doc";
+
 static const char *__doc_mitsuba_Mesh_has_vertex_colors = R"doc(Does this mesh have per-vertex texture colors?)doc";
 
 static const char *__doc_mitsuba_Mesh_has_vertex_normals = R"doc(Does this mesh have per-vertex normals?)doc";
 
 static const char *__doc_mitsuba_Mesh_has_vertex_texcoords = R"doc(Does this mesh have per-vertex texture coordinates?)doc";
 
+static const char *__doc_mitsuba_Mesh_init_structs = R"doc(Validate the vertex and face layouts and compute the attribute offsets)doc";
+
+static const char *__doc_mitsuba_Mesh_is_external = R"doc(Does the mesh reference externally owned vertex and face buffers?)doc";
+
 static const char *__doc_mitsuba_Mesh_m_area_distr = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_m_bbox = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_m_color_offset = R"doc(Byte offset of the color data within the vertex buffer)doc";
 
+static const char *__doc_mitsuba_Mesh_m_compact_requested =
+R"doc(Should plugins convert the vertex data into the compact layout after
+loading?)doc";
+
+static const char *__doc_mitsuba_Mesh_m_compact_vertices = R"doc(Is the vertex data stored in the compact layout?)doc";
+
 static const char *__doc_mitsuba_Mesh_m_disable_vertex_normals =
 R"doc(Flag that can be set by the user to disable loading/computation of
 vertex normals)doc";
 
+static const char *__doc_mitsuba_Mesh_m_emission_distr = R"doc(Distribution of the emitted power over the triangles (see emission_distr_build()))doc";
+
+static const char *__doc_mitsuba_Mesh_m_external_owner = R"doc(Keeps externally provided vertex/face buffers alive (if applicable))doc";
+
 static const char *__doc_mitsuba_Mesh_m_face_count = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_m_face_size = R"doc()doc";
@@ -3336,12 +3680,21 @@ static const char *__doc_mitsuba_Mesh_m_face_struct = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_m_faces = R"doc()doc";
 
+static const char *__doc_mitsuba_Mesh_m_half_texcoords =
+R"doc(Are the texture coordinates in m_packed_texcoords stored in half
+precision? Before compaction, this records the precision requested by
+the user.)doc";
+
 static const char *__doc_mitsuba_Mesh_m_mutex = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_m_name = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_m_normal_offset = R"doc(Byte offset of the normal data within the vertex buffer)doc";
 
+static const char *__doc_mitsuba_Mesh_m_packed_normals = R"doc(Octahedrally encoded vertex normals (compact vertex layout only))doc";
+
+static const char *__doc_mitsuba_Mesh_m_packed_texcoords = R"doc(Separately stored texture coordinates (compact vertex layout only))doc";
+
 static const char *__doc_mitsuba_Mesh_m_texcoord_offset = R"doc(Byte offset of the texture coordinate data within the vertex buffer)doc";
 
 static const char *__doc_mitsuba_Mesh_m_to_world = R"doc()doc";
@@ -3358,6 +3711,8 @@ static const char *__doc_mitsuba_Mesh_normal_derivative = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_parameters_changed = R"doc()doc";
 
+static const char *__doc_mitsuba_Mesh_pdf_direction = R"doc()doc";
+
 static const char *__doc_mitsuba_Mesh_pdf_position = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_primitive_count = R"doc()doc";
@@ -3385,6 +3740,15 @@ static const char *__doc_mitsuba_Mesh_recompute_bbox = R"doc(Recompute the bound
 
 static const char *__doc_mitsuba_Mesh_recompute_vertex_normals = R"doc(Compute smooth vertex normals and replace the current normal values)doc";
 
+static const char *__doc_mitsuba_Mesh_sample_direction =
+R"doc(Sample a direction towards the mesh
+
+Picks a triangle proportionally to its emitted power (see
+emission_distr_build()) or otherwise its area, and then samples the
+solid angle that it subtends as seen from the reference position.
+Triangles that appear very small are sampled by area instead, since
+spherical triangle sampling is numerically unstable for them.)doc";
+
 static const char *__doc_mitsuba_Mesh_sample_position = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_surface_area = R"doc()doc";
@@ -3405,6 +3769,14 @@ static const char *__doc_mitsuba_Mesh_vertex_normal = R"doc(Returns the normal d
 
 static const char *__doc_mitsuba_Mesh_vertex_position = R"doc(Returns the world-space position of the vertex with index ``index``)doc";
 
+static const char *__doc_mitsuba_Mesh_vertex_positions_changed =
+R"doc(Update the data derived from the vertex positions after they were
+modified (CPU variants)
+
+Recomputes the bounding box and vertex normals (if present), rebuilds
+the sampling tables that were already built, and notifies the attached
+emitter (if any), which may depend on the surface area.)doc";
+
 static const char *__doc_mitsuba_Mesh_vertex_struct =
 R"doc(Return a ``Struct`` instance describing the contents of the vertex
 buffer)doc";
@@ -3938,6 +4310,13 @@ static const char *__doc_mitsuba_PositionSample_p = R"doc(Sampled position)doc";
 
 static const char *__doc_mitsuba_PositionSample_pdf = R"doc(Probability density at the sample)doc";
 
+static const char *__doc_mitsuba_PositionSample_prim_index =
+R"doc(Optional: index of the primitive on which the position lies
+
+Set by shapes consisting of several primitives (e.g. the triangle
+index of a mesh), whose sampling density may differ from one primitive
+to the next.)doc";
+
 static const char *__doc_mitsuba_PositionSample_time = R"doc(Associated time value)doc";
 
 static const char *__doc_mitsuba_PositionSample_uv =
@@ -3948,7 +4327,43 @@ an important 2D quantity, such as the texture coordinates on a
 triangle mesh or a position on the aperture of a sensor. When
 applicable, such positions are stored in the ``uv`` attribute.)doc";
 
-static const char *__doc_mitsuba_Profiler = R"doc()doc";
+static const char *__doc_mitsuba_Profiler =
+R"doc(Builtin profiler
+
+The profiler has two complementary modes of operation:
+
+1. A sampling profiler, which periodically (100 times per second by
+default, see set_sampling_rate()) records the set of active phases of
+the interrupted thread. It has negligible overhead and produces a
+global histogram (print_report()). Optionally, hardware performance
+counters are attributed to the sampled phases as well
+(enable_counters()).
+
+2. A tracing profiler, which records the begin and end time of each
+selected phase (start_tracing()) on every thread. Events are appended
+to a fixed-size ring buffer per thread without any locking, and the
+resulting timelines can be exported in the Chrome trace event format
+(write_trace()) to reveal load imbalance and stalls across threads.)doc";
+
+static const char *__doc_mitsuba_ProfilerCounters =
+R"doc(Hardware performance counter totals that were attributed to a phase by
+the sampling profiler (see Profiler::enable_counters()))doc";
+
+static const char *__doc_mitsuba_ProfilerCounters_branch_misses = R"doc(Mispredicted branches)doc";
+
+static const char *__doc_mitsuba_ProfilerCounters_branch_mpki = R"doc(Branch mispredictions per thousand instructions)doc";
+
+static const char *__doc_mitsuba_ProfilerCounters_cache_misses = R"doc(Last level cache misses)doc";
+
+static const char *__doc_mitsuba_ProfilerCounters_cache_mpki = R"doc(Last level cache misses per thousand instructions)doc";
+
+static const char *__doc_mitsuba_ProfilerCounters_cycles = R"doc(Elapsed CPU cycles)doc";
+
+static const char *__doc_mitsuba_ProfilerCounters_instructions = R"doc(Retired instructions)doc";
+
+static const char *__doc_mitsuba_ProfilerCounters_ipc = R"doc(Instructions per cycle)doc";
+
+static const char *__doc_mitsuba_ProfilerCounters_samples = R"doc(Number of profiler samples)doc";
 
 static const char *__doc_mitsuba_ProfilerPhase =
 R"doc(List of 'phases' that are handled by the profiler. Note that a partial
@@ -3993,6 +4408,8 @@ static const char *__doc_mitsuba_ProfilerPhase_RayTest = R"doc()doc";
 
 static const char *__doc_mitsuba_ProfilerPhase_Render = R"doc()doc";
 
+static const char *__doc_mitsuba_ProfilerPhase_RenderBlock = R"doc()doc";
+
 static const char *__doc_mitsuba_ProfilerPhase_SampleEmitterDirection = R"doc()doc";
 
 static const char *__doc_mitsuba_ProfilerPhase_SampleEmitterRay = R"doc()doc";
@@ -4007,12 +4424,63 @@ static const char *__doc_mitsuba_Profiler_Profiler = R"doc()doc";
 
 static const char *__doc_mitsuba_Profiler_class = R"doc()doc";
 
+static const char *__doc_mitsuba_Profiler_counters = R"doc(Return the counter totals per (innermost) phase, see enable_counters())doc";
+
+static const char *__doc_mitsuba_Profiler_enable_counters =
+R"doc(Attribute hardware performance counters to the phases recorded by the
+sampling profiler
+
+Every thread reads its cycle, instruction, last level cache miss and
+branch miss counters (via Linux' ``perf_event_open()``) whenever it is
+sampled, and the increase since its previous sample is attributed to
+the currently active phases. The results are included in
+print_report() and can be queried using counters().
+
+The counters are opened for the calling thread and for all threads
+that are registered afterwards (see register_thread()).
+
+Returns ``False`` when hardware counters are unavailable (e.g. on
+other platforms, in virtual machines, or when prohibited by
+``/proc/sys/kernel/perf_event_paranoid``).)doc";
+
 static const char *__doc_mitsuba_Profiler_print_report = R"doc()doc";
 
+static const char *__doc_mitsuba_Profiler_register_thread =
+R"doc(Prepare the calling thread for sampling
+
+Opens the hardware counters of the thread if they are enabled, which
+cannot be done from within the signal handler of the sampling
+profiler. Called by Thread when a thread starts.)doc";
+
+static const char *__doc_mitsuba_Profiler_set_sampling_rate = R"doc(Set the rate (in Hz) of the sampling profiler)doc";
+
+static const char *__doc_mitsuba_Profiler_start_tracing =
+R"doc(Start recording per-thread timelines
+
+Parameter ``phase_mask``:
+    Bit mask of the phases that should be traced (bit ``i``
+    corresponds to ``ProfilerPhase(i)``). Fine-grained phases (e.g.
+    BSDF evaluations) produce events at a very high rate, which adds
+    overhead and quickly wraps around the ring buffers.
+
+Previously recorded events are discarded.)doc";
+
 static const char *__doc_mitsuba_Profiler_static_initialization = R"doc()doc";
 
 static const char *__doc_mitsuba_Profiler_static_shutdown = R"doc()doc";
 
+static const char *__doc_mitsuba_Profiler_stop_tracing = R"doc(Stop recording per-thread timelines)doc";
+
+static const char *__doc_mitsuba_Profiler_unregister_thread = R"doc(Release the resources of the calling thread, see register_thread())doc";
+
+static const char *__doc_mitsuba_Profiler_write_trace =
+R"doc(Write the recorded timelines to a JSON file in the Chrome trace event
+format, which can be opened using ``chrome://tracing`` or
+https://ui.perfetto.dev
+
+Should be called after stop_tracing(). Returns the number of exported
+events.)doc";
+
 static const char *__doc_mitsuba_ProgressReporter =
 R"doc(General-purpose progress reporter
 
@@ -4553,6 +5021,139 @@ static const char *__doc_mitsuba_ReconstructionFilter_m_values = R"doc()doc";
 
 static const char *__doc_mitsuba_ReconstructionFilter_radius = R"doc(Return the filter's width)doc";
 
+static const char *__doc_mitsuba_ReconstructionFilter_values = R"doc(Return the tabulated filter values used by eval_discretized())doc";
+
+static const char *__doc_mitsuba_RenderClient =
+R"doc(Worker side of distributed rendering: a connection to a RenderServer
+
+Each client owns a separate socket and must only be used by a single
+thread at a time.)doc";
+
+static const char *__doc_mitsuba_RenderClient_RenderClient =
+R"doc(Connect to the server at the given address
+
+Parameter ``timeout``:
+    Time (in seconds) to wait for a reply before the connection to the
+    server is considered lost.)doc";
+
+static const char *__doc_mitsuba_RenderClient_class = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderClient_m_address = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderClient_m_socket = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderClient_m_timeout = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderClient_send =
+R"doc(Send a message (optionally followed by the image block ``data`` of
+``size`` bytes) and wait for the reply
+
+Throws an exception when the server does not reply within the
+timeout.)doc";
+
+static const char *__doc_mitsuba_RenderClient_to_string = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderMessage =
+R"doc(Header of the messages exchanged between a RenderServer and its
+RenderClient instances
+
+Workers send ``Request`` messages to lease a tile, and ``Result``
+messages (followed by a second frame containing the image block) to
+return a rendered tile and lease the next one. The server answers with
+a ``Lease``, ``Wait`` (no tile is available at the moment), or
+``Shutdown`` message.)doc";
+
+static const char *__doc_mitsuba_RenderMessage_Type = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderMessage_channel_count = R"doc(Number of image block channels)doc";
+
+static const char *__doc_mitsuba_RenderMessage_film_size = R"doc(Size of the film (used to detect workers that loaded a different scene))doc";
+
+static const char *__doc_mitsuba_RenderMessage_job = R"doc(Identifier of the render job on the server)doc";
+
+static const char *__doc_mitsuba_RenderMessage_offset = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderMessage_seed = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderMessage_sensor = R"doc(Index of the sensor that is being rendered)doc";
+
+static const char *__doc_mitsuba_RenderMessage_size = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderMessage_spp = R"doc(Samples per pixel and pass)doc";
+
+static const char *__doc_mitsuba_RenderMessage_tile = R"doc(The leased or returned tile)doc";
+
+static const char *__doc_mitsuba_RenderMessage_type = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer =
+R"doc(Master side of distributed rendering
+
+The server binds a ZeroMQ socket (e.g. ``tcp://*:5555``) and leases
+the tiles of the currently active render job to remote workers, whose
+results are handed to a callback that accumulates them into the film.
+Between render jobs, workers are asked to wait, and they are shut down
+when the server is destroyed. The destructor keeps answering until
+every worker has been told to exit (or the lease timeout has passed),
+so that workers returning a last result are not left without a reply.
+Requires a build with the ``MTS_ENABLE_ZMQ`` CMake option.)doc";
+
+static const char *__doc_mitsuba_RenderServer_Job = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_RenderServer =
+R"doc(Bind the server to the given address and start answering requests of
+workers in a background thread
+
+Parameter ``lease_timeout``:
+    Time (in seconds) after which tiles leased by workers that did not
+    respond are handed out again, see TileQueue.)doc";
+
+static const char *__doc_mitsuba_RenderServer_class = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_enabled = R"doc(Was Mitsuba compiled with support for distributed rendering?)doc";
+
+static const char *__doc_mitsuba_RenderServer_finish_job =
+R"doc(Stop leasing tiles, and wait until pending results have been
+accumulated)doc";
+
+static const char *__doc_mitsuba_RenderServer_instance = R"doc(Return the server used by SamplingIntegrator::render() (if any))doc";
+
+static const char *__doc_mitsuba_RenderServer_lease_timeout = R"doc(Return the lease timeout in seconds)doc";
+
+static const char *__doc_mitsuba_RenderServer_m_address = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_m_job = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_m_job_id = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_m_job_mutex = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_m_lease_timeout = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_m_result_count = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_m_shutdown = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_m_socket = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_m_thread = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_result_count =
+R"doc(Return the number of results accumulated over the lifetime of the
+server)doc";
+
+static const char *__doc_mitsuba_RenderServer_run = R"doc()doc";
+
+static const char *__doc_mitsuba_RenderServer_set_instance = R"doc(Set the server used by SamplingIntegrator::render())doc";
+
+static const char *__doc_mitsuba_RenderServer_start_job =
+R"doc(Start leasing the tiles of ``queue`` to workers
+
+Parameter ``payload_size``:
+    Callback returning the expected size (in bytes) of the image block
+    of a tile. Results of other sizes are discarded.)doc";
+
+static const char *__doc_mitsuba_RenderServer_to_string = R"doc()doc";
+
 static const char *__doc_mitsuba_Resampler =
 R"doc(Utility class for efficiently resampling discrete datasets to
 different resolutions
@@ -4576,15 +5177,31 @@ Parameter ``source_res``:
 Parameter ``target_res``:
     Desired target resolution)doc";
 
+static const char *__doc_mitsuba_Resampler_WeightTable = R"doc(Filter weights for a given filter and pair of resolutions)doc";
+
+static const char *__doc_mitsuba_Resampler_WeightTable_fast_end = R"doc()doc";
+
+static const char *__doc_mitsuba_Resampler_WeightTable_fast_start = R"doc()doc";
+
+static const char *__doc_mitsuba_Resampler_WeightTable_start = R"doc()doc";
+
+static const char *__doc_mitsuba_Resampler_WeightTable_taps = R"doc()doc";
+
+static const char *__doc_mitsuba_Resampler_WeightTable_weights = R"doc()doc";
+
 static const char *__doc_mitsuba_Resampler_boundary_condition =
 R"doc(Return the boundary condition that should be used when looking up
 samples outside of the defined input domain)doc";
 
+static const char *__doc_mitsuba_Resampler_boundary_index = R"doc(Map an out-of-range sample position into the input domain)doc";
+
 static const char *__doc_mitsuba_Resampler_clamp =
 R"doc(Returns the range to which resampled values will be clamped
 
 The default is -infinity to infinity (i.e. no clamping is used))doc";
 
+static const char *__doc_mitsuba_Resampler_compute_weight_table = R"doc()doc";
+
 static const char *__doc_mitsuba_Resampler_lookup = R"doc()doc";
 
 static const char *__doc_mitsuba_Resampler_m_bc = R"doc()doc";
@@ -4601,6 +5218,8 @@ static const char *__doc_mitsuba_Resampler_m_start = R"doc()doc";
 
 static const char *__doc_mitsuba_Resampler_m_taps = R"doc()doc";
 
+static const char *__doc_mitsuba_Resampler_m_table = R"doc()doc";
+
 static const char *__doc_mitsuba_Resampler_m_target_res = R"doc()doc";
 
 static const char *__doc_mitsuba_Resampler_m_weights = R"doc()doc";
@@ -4626,6 +5245,33 @@ Parameter ``target_stride``:
 Parameter ``channels``:
     Number of channels to be resampled)doc";
 
+static const char *__doc_mitsuba_Resampler_resample_batch =
+R"doc(Resample a batch of ``count`` independent signals stored next to each
+other, and clamp the results to the valid range
+
+Sample ``i`` of signal ``k`` is located at ``source[i * source_stride +
+k]`` (and analogously for the target). This is the layout of the
+vertical pass of an image resampling operation, where ``k`` ranges
+over all columns and channels of a block of pixels. Adjacent signals
+are processed together using SIMD packets.
+
+Parameter ``source``:
+    Source array of samples
+
+Parameter ``source_stride``:
+    Distance between consecutive samples of a signal in the source
+    array
+
+Parameter ``target``:
+    Target array of samples
+
+Parameter ``target_stride``:
+    Distance between consecutive samples of a signal in the target
+    array
+
+Parameter ``count``:
+    Number of signals to be resampled)doc";
+
 static const char *__doc_mitsuba_Resampler_resample_internal = R"doc()doc";
 
 static const char *__doc_mitsuba_Resampler_set_boundary_condition =
@@ -4644,6 +5290,15 @@ static const char *__doc_mitsuba_Resampler_target_resolution = R"doc(Return the
 
 static const char *__doc_mitsuba_Resampler_to_string = R"doc(Return a human-readable summary)doc";
 
+static const char *__doc_mitsuba_Resampler_weight_table =
+R"doc(Return the weight table for the given configuration
+
+Tables are cached process-wide, since e.g. texture and environment map
+loading repeatedly resample images of the same size. They are keyed by
+the two resolutions and by the filter's type, radius, and tabulated
+values, which capture its parameters at full precision. Keys don't
+refer to the filter object, which may be freed in the meantime.)doc";
+
 static const char *__doc_mitsuba_Sampler = R"doc()doc";
 
 static const char *__doc_mitsuba_Sampler_2 = R"doc()doc";
@@ -4736,6 +5391,18 @@ static const char *__doc_mitsuba_SamplingIntegrator_render_block = R"doc()doc";
 
 static const char *__doc_mitsuba_SamplingIntegrator_render_sample = R"doc()doc";
 
+static const char *__doc_mitsuba_SamplingIntegrator_render_worker =
+R"doc(Render image blocks leased from a RenderServer
+
+This function connects one worker per thread to the server running at
+``address`` (e.g. ``tcp://host:5555``), and renders the blocks of all
+jobs started by the server until it shuts down. The scene must match
+the one loaded by the server process. Since blocks are seeded
+identically, the result matches a local rendering.
+
+render() in turn uses the server set via RenderServer::set_instance()
+(if any) to distribute its blocks.)doc";
+
 static const char *__doc_mitsuba_SamplingIntegrator_sample =
 R"doc(Sample the incident radiance along a ray.
 
@@ -4787,6 +5454,29 @@ reset at the beginning of the rendering phase.)doc";
 
 static const char *__doc_mitsuba_Scene = R"doc()doc";
 
+static const char *__doc_mitsuba_SceneCompiler =
+R"doc(Converts scene XML files into compiled scene files
+
+A compiled scene file (extension ``.mtsc``) contains the fully resolved
+object descriptions of a scene (see xml::parse_file()), which skips XML
+parsing, include processing and scene upgrades upon loading.
+Furthermore, the decoded and transformed vertex and face buffers of
+all PLY, OBJ and serialized meshes are embedded into the file. These
+meshes are replaced by instances of the ``compiled`` shape plugin,
+which maps the buffers directly from the file instead of decoding them
+again.
+
+Compiled files are loaded by passing them to xml::load_file(). They
+are specific to the variant they were compiled for. Other external
+files (e.g. textures) are referenced using absolute paths.)doc";
+
+static const char *__doc_mitsuba_SceneCompiler_compile =
+R"doc(Compile the scene XML file ``path`` into the file ``output``
+
+Parameter ``parameters``:
+    Optional list of parameters that can be referenced as ``$varname``
+    in the scene. Their values are baked into the compiled file.)doc";
+
 static const char *__doc_mitsuba_Scene_2 = R"doc()doc";
 
 static const char *__doc_mitsuba_Scene_3 = R"doc()doc";
@@ -4931,6 +5621,20 @@ static const char *__doc_mitsuba_Scene_to_string = R"doc(Return a human-readable
 
 static const char *__doc_mitsuba_Scene_traverse = R"doc(Perform a custom traversal over the scene graph)doc";
 
+static const char *__doc_mitsuba_ScopedMemoryArena = R"doc(RAII helper that releases the allocations made from an arena within a scope)doc";
+
+static const char *__doc_mitsuba_ScopedMemoryArena_ScopedMemoryArena = R"doc()doc";
+
+static const char *__doc_mitsuba_ScopedMemoryArena_ScopedMemoryArena_2 = R"doc()doc";
+
+static const char *__doc_mitsuba_ScopedMemoryArena_arena = R"doc(Return the underlying arena)doc";
+
+static const char *__doc_mitsuba_ScopedMemoryArena_m_arena = R"doc()doc";
+
+static const char *__doc_mitsuba_ScopedMemoryArena_m_marker = R"doc()doc";
+
+static const char *__doc_mitsuba_ScopedMemoryArena_operator_assign = R"doc()doc";
+
 static const char *__doc_mitsuba_ScopedPhase = R"doc()doc";
 
 static const char *__doc_mitsuba_ScopedPhase_ScopedPhase = R"doc()doc";
@@ -4939,6 +5643,8 @@ static const char *__doc_mitsuba_ScopedPhase_ScopedPhase_2 = R"doc()doc";
 
 static const char *__doc_mitsuba_ScopedPhase_m_flag = R"doc()doc";
 
+static const char *__doc_mitsuba_ScopedPhase_m_phase = R"doc()doc";
+
 static const char *__doc_mitsuba_ScopedPhase_m_target = R"doc()doc";
 
 static const char *__doc_mitsuba_ScopedPhase_operator_assign = R"doc()doc";
@@ -5155,6 +5861,14 @@ static const char *__doc_mitsuba_Shape_bsdf = R"doc(Return the shape's BSDF)doc"
 
 static const char *__doc_mitsuba_Shape_class = R"doc()doc";
 
+static const char *__doc_mitsuba_Shape_dirty =
+R"doc(Has the geometry of this shape been modified since the scene last
+updated its acceleration data structure?
+
+Set by implementations of parameters_changed() that modify the
+geometry (even if its bounding box stays the same), and cleared by
+Scene::parameters_changed().)doc";
+
 static const char *__doc_mitsuba_Shape_effective_primitive_count =
 R"doc(Return the number of primitives (triangles, hairs, ..) contributed to
 the scene by this shape
@@ -5198,6 +5912,8 @@ static const char *__doc_mitsuba_Shape_is_sensor = R"doc(Is this shape also an a
 
 static const char *__doc_mitsuba_Shape_m_bsdf = R"doc()doc";
 
+static const char *__doc_mitsuba_Shape_m_dirty = R"doc()doc";
+
 static const char *__doc_mitsuba_Shape_m_emitter = R"doc()doc";
 
 static const char *__doc_mitsuba_Shape_m_exterior_medium = R"doc()doc";
@@ -5367,6 +6083,8 @@ static const char *__doc_mitsuba_Shape_sensor = R"doc(Return the area sensor ass
 
 static const char *__doc_mitsuba_Shape_sensor_2 = R"doc(Return the area sensor associated with this shape (if any))doc";
 
+static const char *__doc_mitsuba_Shape_set_dirty = R"doc(Mark the geometry of this shape as modified (or unmodified), see dirty())doc";
+
 static const char *__doc_mitsuba_Shape_surface_area =
 R"doc(Return the shape's surface area.
 
@@ -5455,6 +6173,48 @@ static const char *__doc_mitsuba_Spiral_set_passes =
 R"doc(Sets the number of time the spiral should automatically reset. Not
 affected by a call to reset.)doc";
 
+static const char *__doc_mitsuba_Statistics =
+R"doc(Builtin registry of render statistics
+
+Performance-relevant events (e.g. traced rays, visited kd-tree nodes
+or null collisions in participating media) are counted using
+statistics_add() and statistics_record(). The counters are stored per
+thread, hence recording an event does not involve any locking or
+atomic operations. The registry is only compiled when Mitsuba is
+configured with the ``MTS_ENABLE_STATISTICS`` CMake option; otherwise,
+all of these functions compile to nothing.
+
+Histograms are only recorded by the scalar variants, since the lanes
+of a packet generally correspond to different values.)doc";
+
+static const char *__doc_mitsuba_StatisticsCounter = R"doc(List of event counters that are maintained by the statistics registry)doc";
+
+static const char *__doc_mitsuba_StatisticsData = R"doc(Counters and histograms of a single thread)doc";
+
+static const char *__doc_mitsuba_StatisticsHistogram = R"doc(List of histograms that are maintained by the statistics registry)doc";
+
+static const char *__doc_mitsuba_Statistics_Statistics = R"doc()doc";
+
+static const char *__doc_mitsuba_Statistics_counter = R"doc(Return the total of an event counter over all threads)doc";
+
+static const char *__doc_mitsuba_Statistics_elapsed = R"doc(Return the time (in seconds) since the last call to reset())doc";
+
+static const char *__doc_mitsuba_Statistics_enabled = R"doc(Was Mitsuba compiled with support for render statistics?)doc";
+
+static const char *__doc_mitsuba_Statistics_histogram = R"doc(Return the bins of a histogram summed over all threads)doc";
+
+static const char *__doc_mitsuba_Statistics_histogram_mean = R"doc(Return the mean of the values that were recorded in a histogram)doc";
+
+static const char *__doc_mitsuba_Statistics_print_report = R"doc(Print the counters, event rates and histogram summaries)doc";
+
+static const char *__doc_mitsuba_Statistics_reset =
+R"doc(Reset all counters and histograms, and restart the clock that is used
+to compute event rates
+
+Should not be called while other threads are recording events.)doc";
+
+static const char *__doc_mitsuba_Statistics_write_json = R"doc(Write all counters and histograms to a JSON file)doc";
+
 static const char *__doc_mitsuba_Stream =
 R"doc(Abstract seekable stream class
 
@@ -5694,24 +6454,66 @@ static const char *__doc_mitsuba_StructConverter_StructConverter =
 R"doc(Construct an optimized conversion routine going from ``source`` to
 ``target``)doc";
 
+static const char *__doc_mitsuba_StructConverter_cache_statistics =
+R"doc(Return the number of hits and misses of the process-wide cache of
+compiled conversion kernels
+
+Kernels are keyed by the source and target descriptors and the dither
+flag, and they are shared by all converters and threads. Conversions
+handled by the wide SIMD backend (see vectorized()) don't compile a
+kernel. Both counts remain zero when the JIT compiler is disabled.)doc";
+
 static const char *__doc_mitsuba_StructConverter_class = R"doc()doc";
 
 static const char *__doc_mitsuba_StructConverter_convert = R"doc(Convert ``count`` elements. Returns ``True`` upon success)doc";
 
 static const char *__doc_mitsuba_StructConverter_convert_2d = R"doc()doc";
 
+static const char *__doc_mitsuba_StructConverter_convert_2d_packet = R"doc(Wide SIMD conversion backend (see vectorized()))doc";
+
+static const char *__doc_mitsuba_StructConverter_PacketField = R"doc(Per-field plan of the wide SIMD conversion backend)doc";
+
+static const char *__doc_mitsuba_StructConverter_PacketField_has_source = R"doc(Is there a corresponding source field? (otherwise, use the default))doc";
+
+static const char *__doc_mitsuba_StructConverter_PacketField_passthrough = R"doc(Can the field be copied without any conversion?)doc";
+
+static const char *__doc_mitsuba_StructConverter_PacketField_source = R"doc(Source field (only valid if ``has_source`` is set))doc";
+
+static const char *__doc_mitsuba_StructConverter_PacketField_target = R"doc(Target field)doc";
+
+static const char *__doc_mitsuba_StructConverter_m_dither = R"doc()doc";
+
 static const char *__doc_mitsuba_StructConverter_m_func = R"doc()doc";
 
+static const char *__doc_mitsuba_StructConverter_m_packet_fields = R"doc()doc";
+
+static const char *__doc_mitsuba_StructConverter_m_packet_has_weight = R"doc()doc";
+
+static const char *__doc_mitsuba_StructConverter_m_packet_weight = R"doc()doc";
+
 static const char *__doc_mitsuba_StructConverter_m_source = R"doc()doc";
 
 static const char *__doc_mitsuba_StructConverter_m_target = R"doc()doc";
 
+static const char *__doc_mitsuba_StructConverter_m_vectorized = R"doc()doc";
+
+static const char *__doc_mitsuba_StructConverter_prepare_packet = R"doc(Check whether the wide SIMD backend can handle this conversion)doc";
+
 static const char *__doc_mitsuba_StructConverter_source = R"doc(Return the source ``Struct`` descriptor)doc";
 
 static const char *__doc_mitsuba_StructConverter_target = R"doc(Return the target ``Struct`` descriptor)doc";
 
 static const char *__doc_mitsuba_StructConverter_to_string = R"doc(Return a string representation)doc";
 
+static const char *__doc_mitsuba_StructConverter_vectorized =
+R"doc(Does this conversion use the wide SIMD backend?
+
+Common conversions (8/16 bit integer and half/single precision fields,
+gamma correction, weight division, and dithering) are processed
+several records at a time using the widest available Enoki packet
+(e.g. 8 lanes on AVX2, 16 lanes on AVX512). Everything else is handled
+by the per-record conversion routine.)doc";
+
 static const char *__doc_mitsuba_Struct_ByteOrder = R"doc(Byte order of the fields in the ``Struct``)doc";
 
 static const char *__doc_mitsuba_Struct_ByteOrder_BigEndian = R"doc()doc";
@@ -6892,6 +7694,97 @@ static const char *__doc_mitsuba_Thread_unregister_external_thread = R"doc(Unreg
 
 static const char *__doc_mitsuba_Thread_yield = R"doc(Yield to another processor)doc";
 
+static const char *__doc_mitsuba_TileQueue =
+R"doc(Thread-safe queue of image tiles that are leased to local render
+threads and remote workers
+
+The queue is populated with all blocks (including multiple passes) of
+a Spiral. Leased tiles must be reported as complete within the lease
+timeout, otherwise they are handed out again (e.g. when the worker
+that leased them has crashed or lost its connection). The first
+completion of a tile wins, and subsequent (duplicate) completions must
+be discarded by the caller, which ensures that every tile is
+accumulated into the film exactly once.)doc";
+
+static const char *__doc_mitsuba_TileQueue_Entry = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_Entry_deadline = R"doc(Time (in milliseconds, see m_timer) when the lease expires)doc";
+
+static const char *__doc_mitsuba_TileQueue_Entry_state = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_Entry_tile = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_State = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_State_Complete = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_State_Leased = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_State_Pending = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_Status = R"doc(Result of lease())doc";
+
+static const char *__doc_mitsuba_TileQueue_Status_Done = R"doc(All tiles have been completed)doc";
+
+static const char *__doc_mitsuba_TileQueue_Status_Leased = R"doc(A tile was leased)doc";
+
+static const char *__doc_mitsuba_TileQueue_Status_Wait = R"doc(All remaining tiles are currently leased, try again later)doc";
+
+static const char *__doc_mitsuba_TileQueue_Tile = R"doc(Image tile handed out by lease())doc";
+
+static const char *__doc_mitsuba_TileQueue_TileQueue =
+R"doc(Create a queue containing all blocks generated by ``spiral``
+
+Parameter ``lease_timeout``:
+    Time (in seconds) after which a leased tile that has not been
+    completed is handed out again.)doc";
+
+static const char *__doc_mitsuba_TileQueue_Tile_id = R"doc(Index of the tile within the queue)doc";
+
+static const char *__doc_mitsuba_TileQueue_Tile_offset = R"doc(Offset and size of the block in pixels)doc";
+
+static const char *__doc_mitsuba_TileQueue_Tile_seed = R"doc(Unique identifier of the block, which is used to seed the sampler)doc";
+
+static const char *__doc_mitsuba_TileQueue_Tile_size = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_class = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_complete =
+R"doc(Mark a tile as complete
+
+Returns ``True`` if this is the first completion of the tile, in which
+case the caller should accumulate its result.)doc";
+
+static const char *__doc_mitsuba_TileQueue_completed_count = R"doc(Return the number of completed tiles)doc";
+
+static const char *__doc_mitsuba_TileQueue_done = R"doc(Have all tiles been completed?)doc";
+
+static const char *__doc_mitsuba_TileQueue_lease = R"doc(Lease the next tile)doc";
+
+static const char *__doc_mitsuba_TileQueue_lease_timeout = R"doc(Return the lease timeout in seconds)doc";
+
+static const char *__doc_mitsuba_TileQueue_m_completed = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_m_lease_timeout = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_m_mutex = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_m_pending = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_m_tiles = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_m_timer = R"doc()doc";
+
+static const char *__doc_mitsuba_TileQueue_release =
+R"doc(Hand a leased tile back to the queue (e.g. when its rendering was
+aborted))doc";
+
+static const char *__doc_mitsuba_TileQueue_tile = R"doc(Return the tile with the given index)doc";
+
+static const char *__doc_mitsuba_TileQueue_tile_count = R"doc(Return the total number of tiles)doc";
+
+static const char *__doc_mitsuba_TileQueue_to_string = R"doc()doc";
+
 static const char *__doc_mitsuba_Timer = R"doc()doc";
 
 static const char *__doc_mitsuba_Timer_Timer = R"doc()doc";
@@ -7145,6 +8038,86 @@ static const char *__doc_mitsuba_Volume_to_string = R"doc(Returns a human-reable
 
 static const char *__doc_mitsuba_Volume_update_bbox = R"doc()doc";
 
+static const char *__doc_mitsuba_WriteHandle = R"doc(Completion handle of a write operation that was submitted to a WriteQueue)doc";
+
+static const char *__doc_mitsuba_WriteHandle_WriteHandle = R"doc()doc";
+
+static const char *__doc_mitsuba_WriteHandle_class = R"doc()doc";
+
+static const char *__doc_mitsuba_WriteHandle_description = R"doc(Return a human-readable description of the write operation)doc";
+
+static const char *__doc_mitsuba_WriteHandle_done = R"doc(Has the write operation finished (successfully or not)?)doc";
+
+static const char *__doc_mitsuba_WriteHandle_m_description = R"doc()doc";
+
+static const char *__doc_mitsuba_WriteHandle_m_future = R"doc()doc";
+
+static const char *__doc_mitsuba_WriteHandle_to_string = R"doc(Return a string representation)doc";
+
+static const char *__doc_mitsuba_WriteHandle_wait =
+R"doc(Block until the write operation has finished
+
+Re-throws the exception raised by the write operation, if any.)doc";
+
+static const char *__doc_mitsuba_WriteQueue =
+R"doc(Bounded queue of asynchronous write operations
+
+Write operations (e.g. Bitmap::write_async()) are executed by a small
+set of dedicated I/O threads that are separate from the TBB worker
+pool, hence pending writes never steal threads from the renderer. The
+queue holds at most capacity() pending operations; further submissions
+block until space becomes available, which bounds the memory held by
+queued images during bursts of writes (e.g. AOVs or progressive
+snapshots).)doc";
+
+static const char *__doc_mitsuba_WriteQueue_Entry = R"doc()doc";
+
+static const char *__doc_mitsuba_WriteQueue_Entry_description = R"doc()doc";
+
+static const char *__doc_mitsuba_WriteQueue_Entry_promise = R"doc()doc";
+
+static const char *__doc_mitsuba_WriteQueue_Entry_task = R"doc()doc";
+
+static const char *__doc_mitsuba_WriteQueue_WriteQueue =
+R"doc(Create a new write queue
+
+Parameter ``thread_count``:
+    Number of dedicated I/O threads
+
+Parameter ``capacity``:
+    Maximum number of write operations that are queued (i.e.
+    submitted but not yet started) at any time)doc";
+
+static const char *__doc_mitsuba_WriteQueue_bytes_written = R"doc(Return the total number of bytes written by finished operations)doc";
+
+static const char *__doc_mitsuba_WriteQueue_capacity = R"doc(Return the maximum number of queued write operations)doc";
+
+static const char *__doc_mitsuba_WriteQueue_class = R"doc()doc";
+
+static const char *__doc_mitsuba_WriteQueue_enqueue =
+R"doc(Submit a write operation
+
+Blocks while the queue is full. The returned handle can be used to
+wait for the completion of this specific operation.)doc";
+
+static const char *__doc_mitsuba_WriteQueue_instance = R"doc(Return the process-wide queue used by Bitmap::write_async())doc";
+
+static const char *__doc_mitsuba_WriteQueue_pending = R"doc(Return the number of write operations that are queued or running)doc";
+
+static const char *__doc_mitsuba_WriteQueue_run = R"doc(Main loop of the I/O threads)doc";
+
+static const char *__doc_mitsuba_WriteQueue_static_shutdown = R"doc(Wait for pending writes and release the process-wide queue)doc";
+
+static const char *__doc_mitsuba_WriteQueue_thread_count = R"doc(Return the number of dedicated I/O threads)doc";
+
+static const char *__doc_mitsuba_WriteQueue_throughput = R"doc(Return the average throughput (in MiB/s) while the I/O threads were busy)doc";
+
+static const char *__doc_mitsuba_WriteQueue_to_string = R"doc(Return a string representation)doc";
+
+static const char *__doc_mitsuba_WriteQueue_wait = R"doc(Block until all submitted write operations have finished)doc";
+
+static const char *__doc_mitsuba_WriteQueue_writes_completed = R"doc(Return the number of write operations that have finished successfully)doc";
+
 static const char *__doc_mitsuba_ZStream =
 R"doc(Transparent compression/decompression stream based on ``zlib``.
 
@@ -7278,6 +8251,37 @@ Parameter ``frame``:
 
 static const char *__doc_mitsuba_coordinate_system = R"doc(Complete the set {a} to an orthonormal basis {a, b, c})doc";
 
+static const char *__doc_mitsuba_denoise_atrous =
+R"doc(Denoise an image using the edge-avoiding À-Trous wavelet transform
+
+This filter (Dammertz et al., "Edge-Avoiding À-Trous Wavelet Transform
+for fast Global Illumination Filtering", HPG 2010) repeatedly convolves
+the image with a 5x5 B3 spline kernel, whose taps are spread apart by
+a factor of two in every iteration. Each tap is weighted by the
+similarity of its color and of the provided feature images (e.g.
+normals or depth computed by the ``aov`` integrator) to the center
+pixel, which avoids blurring across geometric edges. Five iterations
+thus reach a radius of 62 pixels while only evaluating 125 taps per
+pixel.
+
+Rows are processed in parallel, and each row is vectorized using SIMD
+packets.
+
+Parameter ``color``:
+    Planar image with three color channels (i.e. three consecutive
+    images of ``width * height`` values), which is filtered in place.
+
+Parameter ``guides``:
+    Feature images with the same resolution as ``color``.
+
+Parameter ``iterations``:
+    Number of iterations of the wavelet transform.
+
+Parameter ``sigma_color``:
+    Tolerance for relative color differences in the first iteration.
+    The tolerance is halved in each following iteration, as the image
+    becomes smoother.)doc";
+
 static const char *__doc_mitsuba_depolarize =
 R"doc(Return the (1,1) entry of a Mueller matrix. Identity function for all
 other-types.)doc";
@@ -8220,6 +9224,54 @@ Returns:
     The (implicitly defined) reference coordinate system basis for the
     Stokes vector travelling along w.)doc";
 
+static const char *__doc_mitsuba_numa_AllocationPolicy = R"doc(Policies for the placement of the pages of large scene buffers)doc";
+
+static const char *__doc_mitsuba_numa_AllocationPolicy_FirstTouch =
+R"doc(Leave pages on the node of the thread that first wrote them (the
+operating system's default). Buffers initialized by parallel_for()
+with thread pinning enabled are thereby split across the nodes.)doc";
+
+static const char *__doc_mitsuba_numa_AllocationPolicy_Interleave = R"doc(Spread the pages of a buffer across all nodes in a round-robin fashion)doc";
+
+static const char *__doc_mitsuba_numa_allocation_policy = R"doc(Return the placement policy used by distribute())doc";
+
+static const char *__doc_mitsuba_numa_distribute =
+R"doc(Place the pages of a large buffer according to the allocation policy
+
+Only complete pages within the buffer are affected, and buffers smaller
+than 1 MiB are ignored. Pages that are already populated are migrated,
+and the contents of the buffer are preserved.)doc";
+
+static const char *__doc_mitsuba_numa_node_count = R"doc(Return the number of NUMA nodes with processors that are usable by this process)doc";
+
+static const char *__doc_mitsuba_numa_node_cpus = R"doc(Return the (operating system) indices of the usable processors of a node)doc";
+
+static const char *__doc_mitsuba_numa_parallel_for =
+R"doc(Parallel loop over the range ``[0, size)``
+
+When thread pinning is enabled on a NUMA machine, the range is split
+into contiguous parts that are proportional to the number of threads
+per node, and each part is processed by the task arena of its node.
+Otherwise, this is equivalent to a ``tbb::parallel_for()`` over a
+``tbb::blocked_range`` with the given grain size.)doc";
+
+static const char *__doc_mitsuba_numa_pin_thread = R"doc(Pin the calling thread to the processors of a node (or of all nodes, if ``node`` is -1))doc";
+
+static const char *__doc_mitsuba_numa_set_allocation_policy = R"doc(Set the placement policy used by distribute())doc";
+
+static const char *__doc_mitsuba_numa_set_thread_pinning =
+R"doc(Specify whether TBB worker threads should be pinned to processors
+
+Threads are distributed over the nodes in a round-robin fashion. When
+there is more than one node, parallel_for() furthermore runs on one
+task arena per node, whose threads are confined to the node's
+processors. Must be called before the first parallel region to affect
+all threads.)doc";
+
+static const char *__doc_mitsuba_numa_static_shutdown = R"doc(Release the per-node task arenas (called by Thread::static_shutdown()))doc";
+
+static const char *__doc_mitsuba_numa_thread_pinning = R"doc(Are TBB worker threads pinned to processors?)doc";
+
 static const char *__doc_mitsuba_operator_add = R"doc()doc";
 
 static const char *__doc_mitsuba_operator_add_2 = R"doc(Adding a vector to a point should always yield a point)doc";
@@ -8352,6 +9404,10 @@ static const char *__doc_mitsuba_pdf_uniform_spectrum_2 = R"doc()doc";
 
 static const char *__doc_mitsuba_profiler_flags = R"doc()doc";
 
+static const char *__doc_mitsuba_profiler_trace_event = R"doc(Record a begin/end event of a traced phase in the ring buffer of the current thread)doc";
+
+static const char *__doc_mitsuba_profiler_trace_mask = R"doc(Set of phases whose begin/end events are currently traced (see Profiler::start_tracing()))doc";
+
 static const char *__doc_mitsuba_quad_composite_simpson =
 R"doc(Computes the nodes and weights of a composite Simpson quadrature rule
 with the given number of evaluations.
@@ -9110,6 +10166,16 @@ static const char *__doc_mitsuba_srgb_to_xyz = R"doc(Convert ITU-R Rec. BT.709 l
 
 static const char *__doc_mitsuba_srgb_to_xyz_2 = R"doc(Convert ITU-R Rec. BT.709 linear RGB to XYZ tristimulus values)doc";
 
+static const char *__doc_mitsuba_statistics_add = R"doc(Increase an event counter of the current thread)doc";
+
+static const char *__doc_mitsuba_statistics_count =
+R"doc(Increase an event counter by the number of active entries of ``mask``
+
+Does nothing on the GPU, where counting would require a costly
+synchronization.)doc";
+
+static const char *__doc_mitsuba_statistics_record = R"doc(Record a value in a histogram of the current thread)doc";
+
 static const char *__doc_mitsuba_string_ends_with = R"doc(Check if the given string ends with a specified suffix)doc";
 
 static const char *__doc_mitsuba_string_indent = R"doc(Indent every line of a string by some number of spaces)doc";
@@ -9172,6 +10238,10 @@ static const char *__doc_mitsuba_util_library_path = R"doc(Return the absolute p
 
 static const char *__doc_mitsuba_util_mem_string = R"doc(Turn a memory size into a human-readable string)doc";
 
+static const char *__doc_mitsuba_util_resident_memory =
+R"doc(Return the resident set size of the current process in bytes (or 0 if
+unsupported))doc";
+
 static const char *__doc_mitsuba_util_terminal_width = R"doc(Determine the width of the terminal window that is used to run Mitsuba)doc";
 
 static const char *__doc_mitsuba_util_time_string =
@@ -9252,6 +10322,18 @@ static const char *__doc_mitsuba_warp_interval_to_tent = R"doc(Warp a uniformly
 
 static const char *__doc_mitsuba_warp_linear_to_interval = R"doc(Inverse of interval_to_linear)doc";
 
+static const char *__doc_mitsuba_warp_spherical_rectangle_solid_angle =
+R"doc(Solid angle of an axis-aligned rectangle as seen from the origin
+
+The rectangle covers the range :math:`[p_0, p_1]` of the plane with
+the given Z coordinate.)doc";
+
+static const char *__doc_mitsuba_warp_spherical_triangle_solid_angle =
+R"doc(Solid angle of the spherical triangle with the given vertices
+
+Uses the formula by Van Oosterom and Strackee. The vertices must have
+unit length.)doc";
+
 static const char *__doc_mitsuba_warp_square_to_beckmann = R"doc(Warp a uniformly distributed square sample to a Beckmann distribution)doc";
 
 static const char *__doc_mitsuba_warp_square_to_beckmann_pdf = R"doc(Probability density of square_to_beckmann())doc";
@@ -9285,6 +10367,38 @@ distribution)doc";
 
 static const char *__doc_mitsuba_warp_square_to_rough_fiber_pdf = R"doc(Probability density of square_to_rough_fiber())doc";
 
+static const char *__doc_mitsuba_warp_square_to_spherical_rectangle =
+R"doc(Uniformly sample the solid angle subtended by a rectangle
+
+Implements the method from "An Area-Preserving Parametrization for
+Spherical Rectangles" by Ureña, Fajardo, and King (EGSR 2013). The
+rectangle covers the range :math:`[p_0, p_1]` of the plane with the
+given Z coordinate, and it is observed from the origin. Instead of a
+direction, the function returns the position on the rectangle, whose
+direction is uniformly distributed within the subtended solid angle.
+Rectangles that subtend a very small solid angle or that are seen at
+grazing angles lead to numerical instabilities, in which case area
+sampling is preferable.
+
+Parameter ``sample``:
+    A uniformly distributed sample on :math:`[0,1]^2`)doc";
+
+static const char *__doc_mitsuba_warp_square_to_spherical_rectangle_pdf = R"doc(Density of square_to_spherical_rectangle() with respect to solid angles)doc";
+
+static const char *__doc_mitsuba_warp_square_to_spherical_triangle =
+R"doc(Uniformly sample a direction within a spherical triangle
+
+Implements the method from "Stratified sampling of spherical
+triangles" by James Arvo (SIGGRAPH 1995). The vertices ``a``, ``b``,
+and ``c`` of the spherical triangle must have unit length. Triangles
+that subtend a very small solid angle lead to numerical instabilities,
+in which case area sampling is preferable.
+
+Parameter ``sample``:
+    A uniformly distributed sample on :math:`[0,1]^2`)doc";
+
+static const char *__doc_mitsuba_warp_square_to_spherical_triangle_pdf = R"doc(Density of square_to_spherical_triangle() with respect to solid angles)doc";
+
 static const char *__doc_mitsuba_warp_square_to_std_normal =
 R"doc(Sample a point on a 2D standard normal distribution. Internally uses
 the Box-Muller transformation)doc";
@@ -9363,10 +10477,48 @@ static const char *__doc_mitsuba_warp_uniform_sphere_to_square = R"doc(Inverse o
 
 static const char *__doc_mitsuba_warp_uniform_triangle_to_square = R"doc(Inverse of the mapping square_to_uniform_triangle)doc";
 
+static const char *__doc_mitsuba_warp_use_spherical_sampling =
+R"doc(Decide whether a polygon that subtends the given solid angle should be
+sampled using square_to_spherical_triangle() or
+square_to_spherical_rectangle() rather than by area
+
+Parameter ``min_solid_angle``:
+    Lower bound of the solid angle, which shapes can raise when
+    spherical sampling has additional costs (e.g. rejected samples))doc";
+
 static const char *__doc_mitsuba_warp_von_mises_fisher_to_square = R"doc(Inverse of the mapping von_mises_fisher_to_square)doc";
 
+static const char *__doc_mitsuba_xml_ObjectDescription =
+R"doc(Fully resolved description of a scene object
+
+This is the intermediate representation produced by parse_file(): all
+includes, default values, parameter substitutions and transformations
+have been applied, and nested objects are referenced by their
+identifier.)doc";
+
+static const char *__doc_mitsuba_xml_ObjectDescription_alias =
+R"doc(When nonempty, this object is an alias of the object with the given
+identifier)doc";
+
+static const char *__doc_mitsuba_xml_ObjectDescription_id = R"doc(Unique identifier (generated automatically for unnamed objects))doc";
+
+static const char *__doc_mitsuba_xml_ObjectDescription_props =
+R"doc(Plugin name and parameters. Nested objects are stored as named
+references.)doc";
+
+static const char *__doc_mitsuba_xml_ObjectDescription_tag = R"doc(Tag name of the object's class (e.g. "bsdf" or "shape"))doc";
+
+static const char *__doc_mitsuba_xml_compiled_blob =
+R"doc(Look up a data block within a memory-mapped compiled scene file
+
+Returns a pointer to the block with the given index and its size in
+bytes.)doc";
+
+static const char *__doc_mitsuba_xml_instantiate = R"doc(Instantiate the object ``root_id`` from a set of object descriptions)doc";
+
 static const char *__doc_mitsuba_xml_load_file =
-R"doc(Load a Mitsuba scene from an XML file
+R"doc(Load a Mitsuba scene from an XML file (or a compiled scene file, see
+write_compiled())
 
 Parameter ``path``:
     Filename of the scene XML file
@@ -9381,10 +10533,33 @@ Parameter ``variant``:
 
 Parameter ``update_scene``:
     When Mitsuba updates scene to a newer version, should the updated
-    XML file be written back to disk?)doc";
+    XML file be written back to disk?
+
+Parameter ``load_report``:
+    Log the time and memory spent on instantiating each plugin type,
+    as well as the most expensive individual objects.)doc";
 
 static const char *__doc_mitsuba_xml_load_string = R"doc(Load a Mitsuba scene from an XML string)doc";
 
+static const char *__doc_mitsuba_xml_parse_file =
+R"doc(Parse a Mitsuba scene XML file without instantiating any objects
+
+Parameter ``objects``:
+    Receives the descriptions of all objects in the scene
+
+Returns:
+    The identifier of the root object (usually the scene))doc";
+
+static const char *__doc_mitsuba_xml_write_compiled =
+R"doc(Write a compiled scene file
+
+Compiled scene files (extension ``.mtsc``) store the resolved object
+descriptions of a scene along with a set of raw data blocks (e.g. mesh
+buffers) that are aligned so that plugins can map them into memory and
+use them without further processing (see compiled_blob()). They are
+specific to the variant they were compiled for and can be passed to
+load_file() in place of an XML file.)doc";
+
 static const char *__doc_mitsuba_xyz_to_srgb = R"doc(Convert XYZ tristimulus values to ITU-R Rec. BT.709 linear RGB)doc";
 
 static const char *__doc_mitsuba_xyz_to_srgb_2 = R"doc(Convert XYZ tristimulus values to ITU-R Rec. BT.709 linear RGB)doc";
@@ -393,6 +393,37 @@ public:
                       const Vector3f &wo,
                       Mask active = true) const = 0;
 
+    /**
+     * \brief Jointly evaluate the BSDF f(wi, wo) and the probability per unit
+     * solid angle of sampling the given direction
+     *
+     * This is equivalent to separate calls to \ref eval() and \ref pdf(), but
+     * implementations can share intermediate quantities (e.g. texture lookups,
+     * Fresnel terms or microfacet distribution values) between the two. It is
+     * intended for next event estimation, where both values are needed for the
+     * same direction. The default implementation simply calls \ref eval() and
+     * \ref pdf().
+     *
+     * \param ctx
+     *     A context data structure describing which lobes to evalute,
+     *     and whether radiance or importance are being transported.
+     *
+     * \param si
+     *     A surface interaction data structure describing the underlying
+     *     surface position. The incident direction is obtained from
+     *     the field <tt>si.wi</tt>.
+     *
+     * \param wo
+     *     The outgoing direction
+     *
+     * \return A pair (value, pdf) containing the BSDF value (multiplied by the
+     *     cosine foreshortening factor) and the sampling density.
+     */
+    virtual std::pair<Spectrum, Float> eval_pdf(const BSDFContext &ctx,
+                                                const SurfaceInteraction3f &si,
+                                                const Vector3f &wo,
+                                                Mask active = true) const;
+
     /**
      * \brief Evaluate un-scattered transmission component of the BSDF
      *
@@ -523,6 +554,7 @@ ENOKI_CALL_SUPPORT_TEMPLATE_BEGIN(mitsuba::BSDF)
     ENOKI_CALL_SUPPORT_METHOD(eval)
     ENOKI_CALL_SUPPORT_METHOD(eval_null_transmission)
     ENOKI_CALL_SUPPORT_METHOD(pdf)
+    ENOKI_CALL_SUPPORT_METHOD(eval_pdf)
     ENOKI_CALL_SUPPORT_GETTER(flags, m_flags)
 
     auto needs_differentials() const {
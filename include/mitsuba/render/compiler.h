@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mitsuba/core/xml.h>
+#include <mitsuba/render/fwd.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Converts scene XML files into compiled scene files
+ *
+ * A compiled scene file (extension <tt>.mtsc</tt>) contains the fully
+ * resolved object descriptions of a scene (see \ref xml::parse_file()), which
+ * skips XML parsing, include processing and scene upgrades upon loading.
+ * Furthermore, the decoded and transformed vertex and face buffers of all PLY,
+ * OBJ and serialized meshes are embedded into the file. These meshes are
+ * replaced by instances of the \c compiled shape plugin, which maps the
+ * buffers directly from the file instead of decoding them again.
+ *
+ * Compiled files are loaded by passing them to \ref xml::load_file(). They
+ * are specific to the variant they were compiled for. Other external files
+ * (e.g. textures) are referenced using absolute paths.
+ */
+template <typename Float, typename Spectrum>
+class MTS_EXPORT_RENDER SceneCompiler {
+public:
+    MTS_IMPORT_TYPES(Shape, Mesh)
+
+    /**
+     * \brief Compile the scene XML file \c path into the file \c output
+     *
+     * \param parameters
+     *     Optional list of parameters that can be referenced as
+     *     <tt>$varname</tt> in the scene. Their values are baked into the
+     *     compiled file.
+     */
+    static void compile(const fs::path &path, const fs::path &output,
+                        xml::ParameterList parameters = xml::ParameterList());
+};
+
+MTS_EXTERN_CLASS_RENDER(SceneCompiler)
+NAMESPACE_END(mitsuba)
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <mitsuba/core/object.h>
+#include <mitsuba/core/thread.h>
+#include <mitsuba/core/timer.h>
+#include <mitsuba/core/vector.h>
+#include <mitsuba/render/spiral.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace zmq { class socket; }
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Thread-safe queue of image tiles that are leased to local render
+ * threads and remote workers
+ *
+ * The queue is populated with all blocks (including multiple passes) of a
+ * \ref Spiral. Leased tiles must be reported as complete within the lease
+ * timeout, otherwise they are handed out again (e.g. when the worker that
+ * leased them has crashed or lost its connection). The first completion of a
+ * tile wins, and subsequent (duplicate) completions must be discarded by the
+ * caller, which ensures that every tile is accumulated into the film exactly
+ * once.
+ */
+class MTS_EXPORT_RENDER TileQueue : public Object {
+public:
+    using Float = float;
+    MTS_IMPORT_CORE_TYPES()
+
+    /// Image tile handed out by \ref lease()
+    struct Tile {
+        /// Index of the tile within the queue
+        uint32_t id;
+        /// Unique identifier of the block, which is used to seed the sampler
+        uint64_t seed;
+        /// Offset and size of the block in pixels
+        Point2i offset;
+        Vector2i size;
+    };
+
+    /// Result of \ref lease()
+    enum class Status {
+        /// A tile was leased
+        Leased,
+        /// All remaining tiles are currently leased, try again later
+        Wait,
+        /// All tiles have been completed
+        Done
+    };
+
+    /**
+     * \brief Create a queue containing all blocks generated by \c spiral
+     *
+     * \param lease_timeout
+     *     Time (in seconds) after which a leased tile that has not been
+     *     completed is handed out again.
+     */
+    TileQueue(Spiral *spiral, float lease_timeout = 60.f);
+
+    /// Lease the next tile
+    std::pair<Status, Tile> lease();
+
+    /**
+     * \brief Mark a tile as complete
+     *
+     * Returns \c true if this is the first completion of the tile, in which
+     * case the caller should accumulate its result.
+     */
+    bool complete(uint32_t id);
+
+    /// Hand a leased tile back to the queue (e.g. when its rendering was aborted)
+    void release(uint32_t id);
+
+    /// Return the tile with the given index
+    const Tile &tile(uint32_t id) const;
+
+    /// Return the total number of tiles
+    size_t tile_count() const { return m_tiles.size(); }
+
+    /// Return the number of completed tiles
+    size_t completed_count() const { return m_completed; }
+
+    /// Have all tiles been completed?
+    bool done() const { return m_completed == m_tiles.size(); }
+
+    /// Return the lease timeout in seconds
+    float lease_timeout() const { return m_lease_timeout; }
+
+    std::string to_string() const override;
+
+    MTS_DECLARE_CLASS()
+protected:
+    ~TileQueue();
+
+    enum class State : uint8_t { Pending, Leased, Complete };
+
+    struct Entry {
+        Tile tile;
+        State state;
+        /// Time (in milliseconds, see \ref m_timer) when the lease expires
+        float deadline;
+    };
+
+    std::vector<Entry> m_tiles;
+    std::deque<uint32_t> m_pending;
+    std::atomic<size_t> m_completed { 0 };
+    float m_lease_timeout;
+    Timer m_timer;
+    std::mutex m_mutex;
+};
+
+/**
+ * \brief Header of the messages exchanged between a \ref RenderServer and its
+ * \ref RenderClient instances
+ *
+ * Workers send \c Request messages to lease a tile, and \c Result messages
+ * (followed by a second frame containing the image block) to return a
+ * rendered tile and lease the next one. The server answers with a \c Lease,
+ * \c Wait (no tile is available at the moment), or \c Shutdown message.
+ */
+struct RenderMessage {
+    enum Type : uint32_t { Request = 0, Result, Lease, Wait, Shutdown };
+
+    uint32_t type = Request;
+    /// Identifier of the render job on the server
+    uint32_t job = 0;
+    /// Index of the sensor that is being rendered
+    uint32_t sensor = 0;
+    /// Samples per pixel and pass
+    uint32_t spp = 0;
+    /// Number of image block channels
+    uint32_t channel_count = 0;
+    /// Size of the film (used to detect workers that loaded a different scene)
+    int32_t film_size[2] = { 0, 0 };
+    /// The leased or returned tile
+    uint32_t tile = 0;
+    uint64_t seed = 0;
+    int32_t offset[2] = { 0, 0 };
+    int32_t size[2] = { 0, 0 };
+};
+
+/**
+ * \brief Master side of distributed rendering
+ *
+ * The server binds a ZeroMQ socket (e.g. <tt>tcp://\*:5555</tt>) and leases
+ * the tiles of the currently active render job to remote workers, whose
+ * results are handed to a callback that accumulates them into the film.
+ * Between render jobs, workers are asked to wait, and they are shut down when
+ * the server is destroyed. The destructor keeps answering until every worker
+ * has been told to exit (or the lease timeout has passed), so that workers
+ * returning a last result are not left without a reply. Requires a build with
+ * the \c MTS_ENABLE_ZMQ CMake option.
+ */
+class MTS_EXPORT_RENDER RenderServer : public Object {
+public:
+    /// Callback that accumulates a rendered tile (the payload is an image block)
+    using ResultCallback = std::function<void(const TileQueue::Tile &tile,
+                                              const void *data)>;
+
+    /**
+     * \brief Bind the server to the given address and start answering
+     * requests of workers in a background thread
+     *
+     * \param lease_timeout
+     *     Time (in seconds) after which tiles leased by workers that did not
+     *     respond are handed out again, see \ref TileQueue.
+     */
+    RenderServer(const std::string &address, float lease_timeout = 60.f);
+
+    /**
+     * \brief Start leasing the tiles of \c queue to workers
+     *
+     * \param payload_size
+     *     Callback returning the expected size (in bytes) of the image block
+     *     of a tile. Results of other sizes are discarded.
+     */
+    void start_job(TileQueue *queue, const RenderMessage &job,
+                   std::function<size_t(const TileQueue::Tile &)> payload_size,
+                   ResultCallback callback);
+
+    /// Stop leasing tiles, and wait until pending results have been accumulated
+    void finish_job();
+
+    /// Return the lease timeout in seconds
+    float lease_timeout() const { return m_lease_timeout; }
+
+    /// Return the number of results accumulated over the lifetime of the server
+    size_t result_count() const { return m_result_count; }
+
+    /// Was Mitsuba compiled with support for distributed rendering?
+    static bool enabled();
+
+    /// Return the server used by \ref SamplingIntegrator::render() (if any)
+    static RenderServer *instance();
+
+    /// Set the server used by \ref SamplingIntegrator::render()
+    static void set_instance(RenderServer *server);
+
+    std::string to_string() const override;
+
+    MTS_DECLARE_CLASS()
+protected:
+    ~RenderServer();
+    void run();
+
+    class ServerThread;
+    struct Job;
+
+protected:
+    std::string m_address;
+    float m_lease_timeout;
+    ref<Thread> m_thread;
+    std::unique_ptr<Job> m_job;
+    uint32_t m_job_id = 0;
+    std::mutex m_job_mutex;
+    std::atomic<bool> m_shutdown { false };
+    std::atomic<size_t> m_result_count { 0 };
+    std::unique_ptr<zmq::socket> m_socket;
+};
+
+/**
+ * \brief Worker side of distributed rendering: a connection to a \ref
+ * RenderServer
+ *
+ * Each client owns a separate socket and must only be used by a single
+ * thread at a time.
+ */
+class MTS_EXPORT_RENDER RenderClient : public Object {
+public:
+    /**
+     * \brief Connect to the server at the given address
+     *
+     * \param timeout
+     *     Time (in seconds) to wait for a reply before the connection to the
+     *     server is considered lost.
+     */
+    RenderClient(const std::string &address, float timeout = 30.f);
+
+    /**
+     * \brief Send a message (optionally followed by the image block \c data
+     * of \c size bytes) and wait for the reply
+     *
+     * Throws an exception when the server does not reply within the timeout.
+     */
+    RenderMessage send(const RenderMessage &message, const void *data = nullptr,
+                       size_t size = 0);
+
+    std::string to_string() const override;
+
+    MTS_DECLARE_CLASS()
+protected:
+    ~RenderClient();
+
+protected:
+    std::string m_address;
+    float m_timeout;
+    std::unique_ptr<zmq::socket> m_socket;
+};
+
+NAMESPACE_END(mitsuba)
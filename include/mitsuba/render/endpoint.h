@@ -162,6 +162,14 @@ public:
         return m_world_transform.get();
     }
 
+    /**
+     * \brief Replace the local space to world space transformation
+     *
+     * This is e.g. used to move cameras and light sources between the frames
+     * of an animated sequence without reloading the scene.
+     */
+    virtual void set_world_transform(const AnimatedTransform *transform);
+
     /**
      * \brief Does the method \ref sample_ray() require a uniformly distributed
      * 2D sample for the \c sample2 parameter?
@@ -31,6 +31,17 @@ public:
     /// Develop the film and write the result to the previously specified filename
     virtual void develop() = 0;
 
+    /**
+     * \brief Develop the film and submit the result to the asynchronous
+     * \ref WriteQueue
+     *
+     * The film contents are captured before this function returns, hence the
+     * film can immediately be reused (e.g. to render the next view of a batch)
+     * while the file is being written. The default implementation develops
+     * synchronously and returns \c nullptr.
+     */
+    virtual ref<WriteHandle> develop_async();
+
     /**
      * \brief Develop the contents of a subregion of the film and store
      * it inside the given bitmap
@@ -148,6 +148,20 @@ public:
     //! @}
     // =========================================================================
 
+    /**
+     * \brief Render image blocks leased from a \ref RenderServer
+     *
+     * This function connects one worker per thread to the server running at
+     * \c address (e.g. <tt>tcp://host:5555</tt>), and renders the blocks of
+     * all jobs started by the server until it shuts down. The scene must
+     * match the one loaded by the server process. Since blocks are seeded
+     * identically, the result matches a local rendering.
+     *
+     * \c render() in turn uses the server set via \ref
+     * RenderServer::set_instance() (if any) to distribute its blocks.
+     */
+    bool render_worker(Scene *scene, const std::string &address);
+
     MTS_DECLARE_CLASS()
 protected:
     SamplingIntegrator(const Properties &props);
@@ -196,6 +210,15 @@ protected:
 
     /// Flag for disabling direct visibility of emitters
     bool m_hide_emitters;
+
+    /**
+     * \brief Set up the per-thread render state (sampler, image block) for
+     * every block rather than once per thread.
+     *
+     * This reproduces the overheads of the former per-range setup and is
+     * only meant for A/B comparisons in benchmarks.
+     */
+    bool m_per_block_setup;
 };
 
 /*
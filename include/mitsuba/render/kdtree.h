@@ -5,8 +5,10 @@
 #include <mitsuba/core/fwd.h>
 #include <mitsuba/core/logger.h>
 #include <mitsuba/core/math.h>
+#include <mitsuba/core/numa.h>
 #include <mitsuba/core/object.h>
 #include <mitsuba/core/ray.h>
+#include <mitsuba/core/statistics.h>
 #include <mitsuba/core/timer.h>
 #include <mitsuba/core/tls.h>
 #include <mitsuba/core/util.h>
@@ -1785,25 +1787,29 @@ protected:
         m_node_count = Size(ctx.node_storage.size());
         m_index_count = Size(ctx.index_storage.size());
 
+        /* The copies are first touched by the NUMA-aware parallel loop, which
+           spreads their pages over the nodes when thread pinning is enabled */
         m_indices.reset(new Index[m_index_count]);
-        tbb::parallel_for(
-            tbb::blocked_range<Size>(0u, m_index_count, MTS_KD_GRAIN_SIZE),
-            [&](const tbb::blocked_range<Size> &range) {
-                for (Size i = range.begin(); i != range.end(); ++i)
+        numa::parallel_for(
+            m_index_count, MTS_KD_GRAIN_SIZE,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i != end; ++i)
                     m_indices[i] = ctx.index_storage[i];
             }
         );
+        numa::distribute(m_indices.get(), sizeof(Index) * m_index_count);
 
         tbb::concurrent_vector<Index>().swap(ctx.index_storage);
 
         m_nodes.reset(new KDNode[m_node_count]);
-        tbb::parallel_for(
-            tbb::blocked_range<Size>(0u, m_node_count, MTS_KD_GRAIN_SIZE),
-            [&](const tbb::blocked_range<Size> &range) {
-                for (Size i = range.begin(); i != range.end(); ++i)
+        numa::parallel_for(
+            m_node_count, MTS_KD_GRAIN_SIZE,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i != end; ++i)
                     m_nodes[i] = ctx.node_storage[i];
             }
         );
+        numa::distribute(m_nodes.get(), sizeof(KDNode) * m_node_count);
         tbb::concurrent_vector<KDNode>().swap(ctx.node_storage);
 
         /* Slightly avoid the bounding box to avoid numerical issues
@@ -2041,6 +2047,12 @@ public:
     /// Build the kd-tree
     void build();
 
+    /**
+     * \brief Discard the current tree and build it again from the bounding
+     * boxes of the registered shapes (e.g. after some of them were moved)
+     */
+    void rebuild();
+
     /// Return the number of registered shapes
     Size shape_count() const { return Size(m_shapes.size()); }
 
@@ -2094,6 +2106,14 @@ public:
         // True if an intersection has been found
         bool hit = false;
 
+        // Traversal statistics (unused unless MTS_ENABLE_STATISTICS is set)
+        uint32_t nodes_visited = 0, prims_tested = 0;
+        auto record_statistics = [&]() {
+            statistics_add(StatisticsCounter::KDTreeNodesVisited, nodes_visited);
+            statistics_add(StatisticsCounter::KDTreePrimitiveTests, prims_tested);
+            statistics_record(StatisticsHistogram::KDTreeNodesPerRay, nodes_visited);
+        };
+
         // Intersect against the scene bounding box
         auto bbox_result = m_bbox.ray_intersect(ray);
 
@@ -2102,6 +2122,7 @@ public:
 
         const KDNode *node = m_nodes.get();
         while (mint <= maxt) {
+            nodes_visited++;
             if (likely(!node->leaf())) { // Inner node
                 const Float split   = node->split();
                 const uint32_t axis = node->axis();
@@ -2148,10 +2169,13 @@ public:
                     Float prim_t;
                     std::tie(prim_hit, prim_t) =
                         intersect_prim<ShadowRay>(prim_index, ray, cache, true);
+                    prims_tested++;
 
                     if (unlikely(prim_hit)) {
-                        if (ShadowRay)
+                        if (ShadowRay) {
+                            record_statistics();
                             return { true, prim_t };
+                        }
 
                         Assert(prim_t >= ray.mint && prim_t <= ray.maxt);
                         ray.maxt = prim_t;
@@ -2170,6 +2194,7 @@ public:
                 break;
             }
         }
+        record_statistics();
         return { hit, hit ? ray.maxt : math::Infinity<Float> };
     }
 
@@ -10,6 +10,51 @@
 
 NAMESPACE_BEGIN(mitsuba)
 
+NAMESPACE_BEGIN(detail)
+/**
+ * \brief Decode a unit vector that was stored using a 32 bit octahedral
+ * encoding (two 16 bit signed normalized integers, x in the low half).
+ */
+template <typename UInt32>
+MTS_INLINE auto octahedral_decode(const UInt32 &packed) {
+    using Int32 = int32_array_t<UInt32>;
+    using Value = float_array_t<UInt32>;
+
+    // Sign-extend the two 16 bit components
+    Int32 xi = reinterpret_array<Int32>(packed << 16) >> 16,
+          yi = reinterpret_array<Int32>(packed) >> 16;
+
+    Value x = max(Value(xi) * (1.f / 32767.f), -1.f),
+          y = max(Value(yi) * (1.f / 32767.f), -1.f),
+          z = 1.f - abs(x) - abs(y),
+          t = max(-z, 0.f);
+
+    x = select(x >= 0.f, x - t, x + t);
+    y = select(y >= 0.f, y - t, y + t);
+
+    return normalize(Normal<Value, 3>(x, y, z));
+}
+
+/// Convert the IEEE half precision value stored in the low 16 bits of \c h
+template <typename UInt32>
+MTS_INLINE auto half_decode(const UInt32 &h) {
+    using Value = float_array_t<UInt32>;
+
+    UInt32 o = (h & 0x7fffu) << 13,
+           e = o & 0x0f800000u;
+
+    o += (127u - 15u) << 23;
+    o = select(eq(e, 0x0f800000u), o + ((128u - 16u) << 23), o);
+
+    // Denormals: renormalize using the FPU
+    Value denormal = reinterpret_array<Value>(UInt32(o + (1u << 23))) -
+                     reinterpret_array<Value>(UInt32(113u << 23));
+    o = select(eq(e, 0u), reinterpret_array<UInt32>(denormal), o);
+
+    return reinterpret_array<Value>(UInt32(o | ((h & 0x8000u) << 16)));
+}
+NAMESPACE_END(detail)
+
 template <typename Float, typename Spectrum>
 class MTS_EXPORT_RENDER Mesh : public Shape<Float, Spectrum> {
 public:
@@ -25,8 +70,14 @@ public:
     using typename Base::ScalarSize;
     using typename Base::ScalarIndex;
 
-    using FaceHolder   = std::unique_ptr<uint8_t[]>;
-    using VertexHolder = std::unique_ptr<uint8_t[]>;
+    /// Deleter that only releases buffers which were allocated by the mesh itself
+    struct BufferDeleter {
+        bool owned = true;
+        void operator()(uint8_t *ptr) const { if (owned) delete[] ptr; }
+    };
+
+    using FaceHolder   = std::unique_ptr<uint8_t[], BufferDeleter>;
+    using VertexHolder = std::unique_ptr<uint8_t[], BufferDeleter>;
 
     /// Create a new mesh with the given vertex and face data structures
     Mesh(const std::string &name,
@@ -39,6 +90,24 @@ public:
         uintptr_t loop_ptr, uintptr_t vertex_count, uintptr_t vertex_ptr,
         uintptr_t poly_ptr, uintptr_t uv_ptr, uintptr_t col_ptr,
         short mat_nr, const ScalarMatrix4f &to_world);
+
+    /**
+     * \brief Create a new mesh that wraps existing vertex and face buffers
+     *
+     * No copy of the geometry is made. The buffers must be laid out as
+     * specified by \c vertex_struct and \c face_struct and must provide
+     * storage for one additional (padding) record beyond \c vertex_count and
+     * \c face_count, respectively, which is used by vectorized loads.
+     *
+     * \param owner
+     *    Handle that keeps the underlying memory alive. It is retained for
+     *    the lifetime of the mesh and released when the mesh is destroyed.
+     */
+    Mesh(const std::string &name,
+         Struct *vertex_struct, ScalarSize vertex_count, void *vertices,
+         Struct *face_struct, ScalarSize face_count, void *faces,
+         const std::shared_ptr<void> &owner);
+
     // =========================================================================
     //! @{ \name Accessors (vertices, faces, normals, etc)
     // =========================================================================
@@ -53,6 +122,9 @@ public:
     /// Return a \c Struct instance describing the contents of the face buffer
     const Struct *face_struct() const { return m_face_struct.get(); }
 
+    /// Does the mesh reference externally owned vertex and face buffers?
+    bool is_external() const { return (bool) m_external_owner; }
+
     /// Return a pointer to the raw vertex buffer
     uint8_t *vertices() { return m_vertices.get(); }
     /// Const variant of \ref vertices.
@@ -136,8 +208,14 @@ public:
         ENOKI_MARK_USED(active);
 
         if constexpr (!is_array_v<Index>) {
+            if (unlikely(m_packed_normals))
+                return Result(detail::octahedral_decode(
+                    ((const uint32_t *) m_packed_normals.get())[index]));
             return load_unaligned<Result>(vertex(index) + m_normal_offset);
         } else if constexpr (!is_cuda_array_v<Index>) {
+            if (unlikely(m_packed_normals))
+                return Result(detail::octahedral_decode(gather<uint32_array_t<Index>>(
+                    m_packed_normals.get(), index, active)));
             index *= m_vertex_size / ScalarSize(sizeof(InputFloat));
             return gather<Result, sizeof(InputFloat)>(
                 m_vertices.get() + m_normal_offset, Index3(index, index + 1u, index + 2u), active);
@@ -156,8 +234,24 @@ public:
         ENOKI_MARK_USED(active);
 
         if constexpr (!is_array_v<Index>) {
+            if (unlikely(m_packed_texcoords)) {
+                if (m_half_texcoords) {
+                    uint32_t uv = ((const uint32_t *) m_packed_texcoords.get())[index];
+                    return Result(detail::half_decode(uv), detail::half_decode(uv >> 16));
+                }
+                return load_unaligned<Result>(m_packed_texcoords.get() + index * sizeof(Result));
+            }
             return load_unaligned<Result>(vertex(index) + m_texcoord_offset);
         } else if constexpr (!is_cuda_array_v<Index>) {
+            if (unlikely(m_packed_texcoords)) {
+                if (m_half_texcoords) {
+                    auto uv = gather<uint32_array_t<Index>>(m_packed_texcoords.get(), index, active);
+                    return Result(detail::half_decode(uv), detail::half_decode(uv >> 16));
+                }
+                index *= 2u;
+                return gather<Result, sizeof(InputFloat)>(
+                    m_packed_texcoords.get(), Array<Index, 2>(index, index + 1u), active);
+            }
             index *= m_vertex_size / ScalarSize(sizeof(InputFloat));
             return gather<Result, sizeof(InputFloat)>(
                 m_vertices.get() + m_texcoord_offset, Array<Index, 2>(index, index + 1u), active);
@@ -182,10 +276,10 @@ public:
     }
 
     /// Does this mesh have per-vertex normals?
-    bool has_vertex_normals() const { return m_normal_offset != 0; }
+    bool has_vertex_normals() const { return m_normal_offset != 0 || m_packed_normals; }
 
     /// Does this mesh have per-vertex texture coordinates?
-    bool has_vertex_texcoords() const { return m_texcoord_offset != 0; }
+    bool has_vertex_texcoords() const { return m_texcoord_offset != 0 || m_packed_texcoords; }
 
     /// Does this mesh have per-vertex texture colors?
     bool has_vertex_colors() const { return m_color_offset != 0; }
@@ -202,6 +296,48 @@ public:
     /// Recompute the bounding box (e.g. after modifying the vertex positions)
     void recompute_bbox();
 
+    /**
+     * \brief Ensure that the tables for sampling positions wrt. area are ready
+     *
+     * The tables are otherwise built lazily upon the first sampling query.
+     * The scene invokes this function for emissive meshes at initialization
+     * time so that render threads do not stall on the first emitter sample.
+     */
+    ENOKI_INLINE void area_distr_ensure() const {
+        if (unlikely(m_area_distr.empty()))
+            const_cast<Mesh *>(this)->area_distr_build();
+    }
+
+    /**
+     * \brief Build the table for sampling triangles proportionally to the
+     * power they emit
+     *
+     * Invoked by area emitters with a spatially varying radiance texture. The
+     * texture is integrated over each triangle using a fixed set of
+     * quadrature points, and \ref sample_direction() subsequently picks
+     * triangles according to the resulting power instead of their area.
+     * Not supported by GPU variants, which keep sampling triangles by area.
+     */
+    void emission_distr_build(const Texture *radiance);
+
+    /**
+     * \brief Convert the vertex data into a compact, non-interleaved layout
+     *
+     * Afterwards, the vertex buffer only contains tightly packed positions,
+     * which is all that ray intersection requires. Vertex normals are stored
+     * in a separate buffer using a 32 bit octahedral encoding, and texture
+     * coordinates are moved into a separate buffer in single or (when \c
+     * half_texcoords is set) half precision. The accessors \ref
+     * vertex_normal() and \ref vertex_texcoord() decode them transparently.
+     *
+     * Meshes with additional per-vertex attributes (e.g. colors) are left
+     * unchanged.
+     */
+    void compact_vertices(bool half_texcoords = false);
+
+    /// Does the mesh use the compact vertex layout? (see \ref compact_vertices())
+    bool has_compact_vertices() const { return m_compact_vertices; }
+
     // =============================================================
     //! @{ \name Shape interface implementation
     // =============================================================
@@ -222,6 +358,21 @@ public:
 
     virtual Float pdf_position(const PositionSample3f &ps, Mask active = true) const override;
 
+    /**
+     * \brief Sample a direction towards the mesh
+     *
+     * Picks a triangle proportionally to its emitted power (see \ref
+     * emission_distr_build()) or otherwise its area, and then samples the
+     * solid angle that it subtends as seen from the reference position.
+     * Triangles that appear very small are sampled by area instead, since
+     * spherical triangle sampling is numerically unstable for them.
+     */
+    virtual DirectionSample3f sample_direction(const Interaction3f &it, const Point2f &sample,
+                                               Mask active = true) const override;
+
+    virtual Float pdf_direction(const Interaction3f &it, const DirectionSample3f &ds,
+                                Mask active = true) const override;
+
     virtual void fill_surface_interaction(const Ray3f &ray,
                                           const Float *cache,
                                           SurfaceInteraction3f &si,
@@ -301,6 +452,9 @@ protected:
     inline Mesh() { m_mesh = true; }
     virtual ~Mesh();
 
+    /// Validate the vertex and face layouts and compute the attribute offsets
+    void init_structs();
+
     /**
      * \brief Build internal tables for sampling uniformly wrt. area.
      *
@@ -309,14 +463,21 @@ protected:
      */
     void area_distr_build();
 
-    // Ensures that the sampling table are ready.
-    ENOKI_INLINE void area_distr_ensure() const {
-        if (unlikely(m_area_distr.empty()))
-            const_cast<Mesh *>(this)->area_distr_build();
-    }
+    /**
+     * \brief Update the data derived from the vertex positions after they
+     * were modified (CPU variants)
+     *
+     * Recomputes the bounding box and vertex normals (if present), rebuilds
+     * the sampling tables that were already built, and notifies the attached
+     * emitter (if any), which may depend on the surface area.
+     */
+    void vertex_positions_changed();
 
     MTS_DECLARE_CLASS()
 protected:
+    /// Keeps externally provided vertex/face buffers alive (if applicable)
+    std::shared_ptr<void> m_external_owner;
+
     VertexHolder m_vertices;
     FaceHolder m_faces;
     ScalarSize m_vertex_size = 0;
@@ -329,6 +490,19 @@ protected:
     /// Byte offset of the color data within the vertex buffer
     ScalarIndex m_color_offset = 0;
 
+    /// Octahedrally encoded vertex normals (compact vertex layout only)
+    VertexHolder m_packed_normals;
+    /// Separately stored texture coordinates (compact vertex layout only)
+    VertexHolder m_packed_texcoords;
+    /// Is the vertex data stored in the compact layout?
+    bool m_compact_vertices = false;
+    /**
+     * Are the texture coordinates in \ref m_packed_texcoords stored in half
+     * precision? Before compaction, this records the precision requested by
+     * the user.
+     */
+    bool m_half_texcoords = false;
+
     std::string m_name;
     ScalarBoundingBox3f m_bbox;
     ScalarTransform4f m_to_world;
@@ -362,9 +536,14 @@ protected:
     /// Flag that can be set by the user to disable loading/computation of vertex normals
     bool m_disable_vertex_normals = false;
 
+    /// Should plugins convert the vertex data into the compact layout after loading?
+    bool m_compact_requested = false;
+
     /* Surface area distribution -- generated on demand when \ref
        prepare_area_distr() is first called. */
     DiscreteDistribution<Float> m_area_distr;
+    /// Distribution of the emitted power over the triangles (see \ref emission_distr_build())
+    DiscreteDistribution<Float> m_emission_distr;
     tbb::spin_mutex m_mutex;
 };
 
@@ -10,7 +10,7 @@ NAMESPACE_BEGIN(mitsuba)
 template <typename Float, typename Spectrum>
 class MTS_EXPORT_RENDER Scene : public Object {
 public:
-    MTS_IMPORT_TYPES(BSDF, Emitter, Film, Sampler, Shape, Sensor, Integrator, Medium, MediumPtr)
+    MTS_IMPORT_TYPES(BSDF, Emitter, Film, Sampler, Shape, Mesh, Sensor, Integrator, Medium, MediumPtr)
 
     /// Instantiate a scene from a \ref Properties object
     Scene(const Properties &props);
@@ -174,6 +174,9 @@ protected:
     void accel_release_cpu();
     void accel_release_gpu();
 
+    /// Update the acceleration data structure after the given shapes were moved or deformed
+    void accel_parameters_changed_cpu(const std::vector<size_t> &changed);
+
     /// Trace a ray
     MTS_INLINE SurfaceInteraction3f ray_intersect_cpu(const Ray3f &ray, Mask active) const;
     MTS_INLINE SurfaceInteraction3f ray_intersect_gpu(const Ray3f &ray, Mask active) const;
@@ -210,6 +213,7 @@ void DirectionSample<Float, Spectrum>::set_query(const Ray3f &ray, const Surface
     uv     = si.uv;
     time   = si.time;
     object = static_cast<ObjectPtr>(si.shape->emitter());
+    prim_index = si.prim_index;
     d      = ray.d;
     dist   = si.t;
 }
@@ -171,6 +171,12 @@ public:
     /// Return the distance to the focal plane
     ScalarFloat focus_distance() const { return m_focus_distance; }
 
+    void set_world_transform(const AnimatedTransform *transform) override {
+        if (transform->has_scale())
+            Throw("Scale factors in the camera-to-world transformation are not allowed!");
+        Base::set_world_transform(transform);
+    }
+
     void traverse(TraversalCallback *callback) override {
         callback->put_parameter("near_clip", m_near_clip);
         callback->put_parameter("far_clip", m_far_clip);
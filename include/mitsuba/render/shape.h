@@ -255,6 +255,19 @@ public:
     /// Is this shape a triangle mesh?
     bool is_mesh() const { return m_mesh; }
 
+    /**
+     * \brief Has the geometry of this shape been modified since the scene last
+     * updated its acceleration data structure?
+     *
+     * Set by implementations of \ref parameters_changed() that modify the
+     * geometry (even if its bounding box stays the same), and cleared by
+     * \ref Scene::parameters_changed().
+     */
+    bool dirty() const { return m_dirty; }
+
+    /// Mark the geometry of this shape as modified (or unmodified), see \ref dirty()
+    void set_dirty(bool dirty = true) { m_dirty = dirty; }
+
     /// Does the surface of this shape mark a medium transition?
     bool is_medium_transition() const { return m_interior_medium.get() != nullptr ||
                                                m_exterior_medium.get() != nullptr; }
@@ -328,6 +341,7 @@ protected:
 
 protected:
     bool m_mesh = false;
+    bool m_dirty = false;
     ref<BSDF> m_bsdf;
     ref<Emitter> m_emitter;
     ref<Sensor> m_sensor;
@@ -0,0 +1,151 @@
+"""
+Benchmark of the per-block overheads of the CPU render loop at high thread
+counts.
+
+Usage: python resources/benchmark_block_scheduling.py [variant] [max_threads]
+                                                      [--perf-counters]
+                                                      [--per-block-setup]
+
+A tiny scene is rendered with 8x8 blocks and a single sample per pixel, so
+that the time spent per block is dominated by the render loop itself (block
+scheduling, per-thread setup and updates of shared reference counts) rather
+than by the integrator. Each thread count from 1 to 'max_threads' (default:
+the number of cores) is timed, and the best time out of several repetitions
+is reported together with the throughput and the parallel efficiency.
+Operations that touch cache lines shared by all threads show up as an
+efficiency that drops steeply once the threads span several cores.
+
+With '--perf-counters', the hardware counters of the sampling profiler (see
+Profiler.enable_counters()) are recorded as well, and the last level cache
+misses and instructions per cycle of all threads are reported per block.
+Cache lines that bounce between cores are fetched from another core's cache
+each time they are written, which shows up as a growing number of misses per
+block at higher thread counts. To attribute these transfers to individual
+cache lines, run the benchmark under 'perf c2c record' and inspect the HITM
+(loads that hit a modified line in another core's cache) entries reported by
+'perf c2c report'.
+
+With '--per-block-setup', the integrator clones the sampler and allocates
+an image block for every block (the 'per_block_setup' integrator property),
+which reproduces the per-thread setup of the former render loop. Comparing
+the output with and without this flag measures the cost of that setup.
+Note that the former loop only repeated the setup once per TBB range, and
+the auto partitioner creates few ranges per thread, so the flag gives an
+upper bound of the difference.
+"""
+
+import sys
+import time
+
+import mitsuba
+
+args = [arg for arg in sys.argv[1:] if not arg.startswith('--')]
+perf_counters = '--perf-counters' in sys.argv[1:]
+per_block_setup = '--per-block-setup' in sys.argv[1:]
+
+variant = args[0] if len(args) > 0 else 'scalar_rgb'
+mitsuba.set_variant(variant)
+
+from mitsuba.core import Profiler, set_thread_count, util
+from mitsuba.core.xml import load_string
+
+max_threads = int(args[1]) if len(args) > 1 else util.core_count()
+
+SCENE = """<scene version="2.0.0">
+    <integrator type="direct">
+        <integer name="block_size" value="8"/>
+        <boolean name="per_block_setup" value="$per_block_setup"/>
+    </integrator>
+    <sensor type="perspective">
+        <film type="hdrfilm">
+            <integer name="width" value="1024"/>
+            <integer name="height" value="1024"/>
+            <rfilter type="box"/>
+        </film>
+        <sampler type="independent">
+            <integer name="sample_count" value="1"/>
+        </sampler>
+        <transform name="to_world">
+            <lookat origin="0, 0, 4" target="0, 0, 0" up="0, 1, 0"/>
+        </transform>
+    </sensor>
+    <shape type="sphere"/>
+    <emitter type="constant"/>
+</scene>"""
+
+
+def best_of(func, repeat=5):
+    result = float('inf')
+    for i in range(repeat):
+        start = time.perf_counter()
+        func()
+        result = min(result, time.perf_counter() - start)
+    return result
+
+
+def counter_totals():
+    """ Sum the hardware counters of the sampling profiler over all phases """
+    cycles, instructions, cache_misses = 0, 0, 0
+    for c in Profiler.counters().values():
+        cycles += c.cycles
+        instructions += c.instructions
+        cache_misses += c.cache_misses
+    return cycles, instructions, cache_misses
+
+
+def main():
+    global perf_counters
+
+    # Counters must be enabled before the worker threads are started
+    if perf_counters and not Profiler.enable_counters():
+        print('Hardware performance counters are unavailable, ignoring '
+              '--perf-counters.')
+        perf_counters = False
+    if perf_counters:
+        Profiler.set_sampling_rate(1000)
+        Profiler.static_initialization()
+
+    scene = load_string(SCENE, per_block_setup=str(per_block_setup).lower())
+    sensor = scene.sensors()[0]
+    integrator = scene.integrator()
+    blocks = (1024 // 8) ** 2
+
+    def render():
+        assert integrator.render(scene, sensor)
+
+    thread_counts = sorted(set([1, 2, 4, 8, 16, 32, 64, 128, 256, max_threads]))
+    thread_counts = [t for t in thread_counts if t <= max_threads]
+
+    print('%i blocks per render, variant "%s", per-thread setup %s'
+          % (blocks, variant, 'per block' if per_block_setup else 'once'))
+    header = '%8s %12s %16s %11s' % ('threads', 'time', 'blocks/s', 'efficiency')
+    if perf_counters:
+        header += ' %16s %8s' % ('LLC misses/blk', 'IPC')
+    print(header)
+
+    repeat = 5
+    baseline = None
+    for threads in thread_counts:
+        set_thread_count(threads)
+        render()  # Warm up the worker threads and their arenas
+        before = counter_totals() if perf_counters else None
+        t = best_of(render, repeat)
+        if baseline is None:
+            baseline = t
+        line = '%8i %9.2f ms %16.0f %10.1f%%' % (
+            threads, t * 1e3, blocks / t, 100 * baseline / (t * threads))
+        if perf_counters:
+            # Counters are accumulated over all repetitions
+            cycles, instructions, cache_misses = [
+                a - b for a, b in zip(counter_totals(), before)]
+            line += ' %16.1f %8.2f' % (cache_misses / (blocks * repeat),
+                                       instructions / max(cycles, 1))
+        print(line)
+
+    if perf_counters:
+        Profiler.static_shutdown()
+    set_thread_count()
+
+
+if __name__ == '__main__':
+    main()
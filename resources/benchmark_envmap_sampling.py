@@ -0,0 +1,80 @@
+"""
+Benchmark comparing the importance sampling strategies of the 'envmap' emitter
+(hierarchical warp vs. alias table).
+
+Usage: python resources/benchmark_envmap_sampling.py <envmap> [variant] [count]
+
+The default variant is 'packet_rgb'. For each strategy, 'count' directions are
+sampled at once (to amortize the Python call overhead), and the best time out
+of several repetitions is reported. Both strategies estimate the integral of
+the radiance over the sphere; the table lists this estimate and the variance
+of a single sample, which should be compared relative to each other.
+"""
+
+import sys
+import time
+
+import numpy as np
+import mitsuba
+
+if len(sys.argv) < 2:
+    print(__doc__)
+    sys.exit(1)
+
+filename = sys.argv[1]
+variant = sys.argv[2] if len(sys.argv) > 2 else 'packet_rgb'
+count = int(sys.argv[3]) if len(sys.argv) > 3 else 1000000
+mitsuba.set_variant(variant)
+
+from mitsuba.core import Float, Point2f
+from mitsuba.core.xml import load_string
+from mitsuba.render import SurfaceInteraction3f
+
+
+def best_of(func, repeat=5):
+    result = float('inf')
+    for i in range(repeat):
+        start = time.perf_counter()
+        func()
+        result = min(result, time.perf_counter() - start)
+    return result
+
+
+def main():
+    np.random.seed(0)
+    samples = np.random.uniform(size=(count, 2)).astype(np.float32)
+    sample = Point2f(Float(samples[:, 0]), Float(samples[:, 1]))
+
+    it = SurfaceInteraction3f.zero(count)
+    it.wavelengths = []
+
+    print('%i samples per call, variant "%s"' % (count, variant))
+    print('%-14s %12s %14s %14s %14s' % ('Strategy', 'build', 'Msamples/s',
+                                         'estimate', 'variance'))
+
+    for sampling in ['hierarchical', 'alias']:
+        xml = '''<emitter version="2.0.0" type="envmap">
+                     <string name="filename" value="%s"/>
+                     <string name="sampling" value="%s"/>
+                 </emitter>''' % (filename, sampling)
+
+        start = time.perf_counter()
+        emitter = load_string(xml)
+        t_build = time.perf_counter() - start
+
+        def run():
+            emitter.sample_direction(it, sample)
+
+        t_sample = best_of(run)
+
+        _, value = emitter.sample_direction(it, sample)
+        value = np.array(value).reshape(count, -1).mean(axis=1)
+        value = value[np.isfinite(value)]
+
+        print('%-14s %9.2f ms %14.2f %14.6g %14.6g' % (
+            sampling, t_build * 1e3, count / t_sample * 1e-6,
+            value.mean(), value.var()))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,83 @@
+"""
+Microbenchmark comparing separate BSDF::eval() and BSDF::pdf() calls against
+the fused BSDF::eval_pdf() method, as used by next event estimation.
+
+Usage: python resources/benchmark_eval_pdf.py [variant] [count]
+
+The default variant is 'packet_rgb'. Each BSDF is queried for 'count' random
+direction pairs at once (to amortize the Python call overhead), and the best
+time out of several repetitions is reported per query.
+"""
+
+import sys
+import time
+
+import numpy as np
+import enoki as ek
+import mitsuba
+
+variant = sys.argv[1] if len(sys.argv) > 1 else 'packet_rgb'
+count = int(sys.argv[2]) if len(sys.argv) > 2 else 1000000
+mitsuba.set_variant(variant)
+
+from mitsuba.core import Float, warp
+from mitsuba.core.xml import load_string
+from mitsuba.render import BSDFContext, SurfaceInteraction3f
+
+BSDFS = [
+    ('diffuse', '<bsdf type="diffuse"/>'),
+    ('plastic', '<bsdf type="plastic"/>'),
+    ('roughplastic', '<bsdf type="roughplastic"/>'),
+    ('roughconductor', '<bsdf type="roughconductor"><float name="alpha" value="0.2"/></bsdf>'),
+    ('roughconductor (tex)', '''<bsdf type="roughconductor">
+         <texture type="checkerboard" name="alpha">
+             <rgb name="color0" value="0.1"/><rgb name="color1" value="0.3"/>
+         </texture></bsdf>'''),
+    ('roughdielectric', '<bsdf type="roughdielectric"/>'),
+]
+
+
+def best_of(func, repeat=5):
+    result = float('inf')
+    for i in range(repeat):
+        start = time.perf_counter()
+        func()
+        result = min(result, time.perf_counter() - start)
+    return result
+
+
+def main():
+    np.random.seed(0)
+
+    def random_directions():
+        sample = np.random.uniform(size=(count, 2)).astype(np.float32)
+        return warp.square_to_uniform_sphere([Float(sample[:, 0]), Float(sample[:, 1])])
+
+    ctx = BSDFContext()
+    si = SurfaceInteraction3f.zero(count)
+    si.uv = [Float(np.random.uniform(size=count).astype(np.float32))] * 2
+    si.wi = random_directions()
+    si.wavelengths = []
+    wo = random_directions()
+
+    print('%i queries per call, variant "%s"' % (count, variant))
+    print('%-22s %14s %14s %9s' % ('BSDF', 'eval+pdf', 'eval_pdf', 'speedup'))
+
+    for name, xml in BSDFS:
+        bsdf = load_string(xml.replace('<bsdf ', '<bsdf version="2.0.0" ', 1))
+
+        def separate():
+            bsdf.eval(ctx, si, wo)
+            bsdf.pdf(ctx, si, wo)
+
+        def fused():
+            bsdf.eval_pdf(ctx, si, wo)
+
+        t_separate, t_fused = best_of(separate), best_of(fused)
+        print('%-22s %11.2f ns %11.2f ns %8.2fx' % (
+            name, t_separate * 1e9 / count, t_fused * 1e9 / count,
+            t_separate / t_fused))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,58 @@
+"""
+Benchmark of StructConverter on a typical film development conversion
+(float RGBA to 8 bit sRGB with dithering).
+
+Usage: python resources/benchmark_struct_converter.py [variant] [megapixels]
+
+The conversion is timed once with single precision input, which is handled
+by the wide SIMD backend, and once with double precision input, which falls
+back to the per-record routine (JIT-compiled where available). The best
+throughput out of several repetitions is reported in GB/s of input data.
+"""
+
+import sys
+import time
+
+import numpy as np
+import mitsuba
+
+variant = sys.argv[1] if len(sys.argv) > 1 else 'scalar_rgb'
+megapixels = int(sys.argv[2]) if len(sys.argv) > 2 else 4
+mitsuba.set_variant(variant)
+
+from mitsuba.core import Struct, StructConverter
+
+
+def best_of(func, repeat=5):
+    result = float('inf')
+    for i in range(repeat):
+        start = time.perf_counter()
+        func()
+        result = min(result, time.perf_counter() - start)
+    return result
+
+
+def main():
+    count = megapixels * (1 << 20)
+
+    for name, src_type, dtype in [('float32', Struct.Type.Float32, np.float32),
+                                  ('float64', Struct.Type.Float64, np.float64)]:
+        src_struct = Struct()
+        dst_struct = Struct()
+        for ch in 'RGB':
+            src_struct.append(ch, src_type)
+            dst_struct.append(ch, Struct.Type.UInt8,
+                              Struct.Flags.Normalized | Struct.Flags.Gamma)
+        src_struct.append('A', src_type, Struct.Flags.Alpha)
+        dst_struct.append('A', Struct.Type.UInt8,
+                          Struct.Flags.Normalized | Struct.Flags.Alpha)
+        s = StructConverter(src_struct, dst_struct, True)
+
+        data = np.random.uniform(size=count * 4).astype(dtype).tobytes()
+        t = best_of(lambda: s.convert(data))
+        print('%s input (vectorized=%i): %8.2f ms, %6.2f GB/s' %
+              (name, s.vectorized(), t * 1e3, len(data) / t * 1e-9))
+
+
+if __name__ == '__main__':
+    main()
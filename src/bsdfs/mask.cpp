@@ -158,6 +158,27 @@ public:
         return result;
     }
 
+    std::pair<Spectrum, Float> eval_pdf(const BSDFContext &ctx,
+                                        const SurfaceInteraction3f &si,
+                                        const Vector3f &wo,
+                                        Mask active) const override {
+        MTS_MASKED_FUNCTION(ProfilerPhase::BSDFEvaluate, active);
+
+        uint32_t null_index      = (uint32_t) component_count() - 1;
+        bool sample_transmission = ctx.is_enabled(BSDFFlags::Null, null_index);
+        bool sample_nested       = ctx.component == (uint32_t) -1 || ctx.component < null_index;
+
+        Float opacity = eval_opacity(si, active);
+        auto [value, pdf] = m_nested_bsdf->eval_pdf(ctx, si, wo, active);
+
+        if (!sample_nested)
+            pdf = 0.f;
+        else if (sample_transmission)
+            pdf *= opacity;
+
+        return { value * opacity, pdf };
+    }
+
     MTS_INLINE Float eval_opacity(const SurfaceInteraction3f &si, Mask active) const {
         return clamp(m_opacity->eval_1(si, active), 0.f, 1.f);
     }
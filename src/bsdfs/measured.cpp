@@ -380,6 +380,78 @@ public:
 #endif // MTS_SAMPLE_DIFFUSE
     }
 
+    std::pair<Spectrum, Float> eval_pdf(const BSDFContext &ctx,
+                                        const SurfaceInteraction3f &si,
+                                        const Vector3f &wo_,
+                                        Mask active) const override {
+        MTS_MASKED_FUNCTION(ProfilerPhase::BSDFEvaluate, active);
+
+        Vector3f wi = si.wi, wo = wo_;
+
+        active &= Frame3f::cos_theta(wi) > 0.f &&
+                Frame3f::cos_theta(wo) > 0.f;
+
+        if (!ctx.is_enabled(BSDFFlags::GlossyReflection) || none_or<false>(active))
+            return { 0.f, 0.f };
+
+        if (m_reduction >= 2) {
+            Float sy = wi.y(),
+                sx = (m_reduction == 4) ? wi.x() : sy;
+
+            wi.x() = mulsign_neg(wi.x(), sx);
+            wi.y() = mulsign_neg(wi.y(), sy);
+            wo.x() = mulsign_neg(wo.x(), sx);
+            wo.y() = mulsign_neg(wo.y(), sy);
+        }
+
+        Vector3f m = normalize(wo + wi);
+
+        // Cartesian -> spherical coordinates
+        Float theta_i = elevation(wi),
+            phi_i   = atan2(wi.y(), wi.x()),
+            theta_m = elevation(m),
+            phi_m   = atan2(m.y(), m.x());
+
+        // Spherical coordinates -> unit coordinate system
+        Vector2f u_wi(theta2u(theta_i), phi2u(phi_i)),
+                u_m (theta2u(theta_m), phi2u(
+                    m_isotropic ? (phi_m - phi_i) : phi_m));
+
+        u_m[1] = u_m[1] - floor(u_m[1]);
+
+        // The inverse mapping of the VNDF (and its density) is shared by eval() and pdf()
+        Float params[2] = { phi_i, theta_i };
+        auto [sample, vndf_pdf] = m_vndf.invert(u_m, params, active);
+
+        UnpolarizedSpectrum spec;
+        for (size_t i = 0; i < array_size_v<UnpolarizedSpectrum>; ++i) {
+            Float params_spec[3] = { phi_i, theta_i, si.wavelengths[i] };
+            spec[i] = m_spectra.eval(sample, params_spec, active);
+        }
+
+        if (m_jacobian)
+            spec *= m_ndf.eval(u_m, params, active) /
+                    (4 * m_sigma.eval(u_wi, params, active));
+
+#if MTS_SAMPLE_DIFFUSE == 1
+        ENOKI_MARK_USED(vndf_pdf);
+        Float pdf = warp::square_to_cosine_hemisphere_pdf(wo);
+#else // MTS_SAMPLE_DIFFUSE
+        Float pdf = 1.f;
+        #if MTS_SAMPLE_LUMINANCE == 1
+        pdf = m_luminance.eval(sample, params, active);
+        #endif
+
+        Float jacobian =
+            enoki::max(2.f * sqr(math::Pi<Float>) * u_m.x() * Frame3f::sin_theta(m), 1e-6f) * 4.f *
+            dot(wi, m);
+
+        pdf = vndf_pdf * pdf / jacobian;
+#endif // MTS_SAMPLE_DIFFUSE
+
+        return { unpolarized<Spectrum>(spec) & active, select(active, pdf, 0.f) };
+    }
+
     std::string to_string() const override {
         std::ostringstream oss;
         oss << "Measured[" << std::endl
@@ -397,6 +397,94 @@ public:
         return select(active, result, 0.f);
     }
 
+    std::pair<Spectrum, Float> eval_pdf(const BSDFContext &ctx,
+                                        const SurfaceInteraction3f &si,
+                                        const Vector3f &wo,
+                                        Mask active) const override {
+        MTS_MASKED_FUNCTION(ProfilerPhase::BSDFEvaluate, active);
+
+        Float cos_theta_i = Frame3f::cos_theta(si.wi),
+              cos_theta_o = Frame3f::cos_theta(wo);
+
+        // Calculate the half-direction vector
+        Vector3f H = normalize(wo + si.wi);
+
+        /* Filter cases where the micro/macro-surface don't agree on the side
+           (see pdf()). The BSDF value vanishes there as well. */
+        active &= cos_theta_i   > 0.f && cos_theta_o   > 0.f &&
+                  dot(si.wi, H) > 0.f && dot(wo,    H) > 0.f;
+
+        if (unlikely(!ctx.is_enabled(BSDFFlags::GlossyReflection) || none_or<false>(active)))
+            return { 0.f, 0.f };
+
+        /* Construct a microfacet distribution matching the
+           roughness values at the current surface position. */
+        MicrofacetDistribution distr(m_type,
+                                     m_alpha_u->eval_1(si, active),
+                                     m_alpha_v->eval_1(si, active),
+                                     m_sample_visible);
+
+        // Evaluate the microfacet normal distribution (shared by eval() and pdf())
+        Float D = distr.eval(H);
+
+        active &= neq(D, 0.f);
+
+        // Evaluate Smith's shadow-masking function
+        Float G1_i = distr.smith_g1(si.wi, H),
+              G    = G1_i * distr.smith_g1(wo, H);
+
+        // Evaluate the full microfacet model (except Fresnel)
+        UnpolarizedSpectrum result = D * G / (4.f * cos_theta_i);
+
+        // Evaluate the Fresnel factor
+        Complex<UnpolarizedSpectrum> eta_c(m_eta->eval(si, active),
+                                           m_k->eval(si, active));
+
+        Spectrum F;
+        if constexpr (is_polarized_v<Spectrum>) {
+            /* Due to lack of reciprocity in polarization-aware pBRDFs, they are
+               always evaluated w.r.t. the actual light propagation direction, no
+               matter the transport mode. In the following, 'wi_hat' is toward the
+               light source. */
+            Vector3f wi_hat = ctx.mode == TransportMode::Radiance ? wo : si.wi,
+                     wo_hat = ctx.mode == TransportMode::Radiance ? si.wi : wo;
+
+            // Mueller matrix for specular reflection.
+            F = mueller::specular_reflection(UnpolarizedSpectrum(Frame3f::cos_theta(wi_hat)), eta_c);
+
+            /* Apply frame reflection, according to "Stellar Polarimetry" by
+               David Clarke, Appendix A.2 (A26) */
+            F = mueller::reverse(F);
+
+            /* The Stokes reference frame vector of this matrix lies in the plane
+               of reflection. */
+            Vector3f s_axis_in  = normalize(cross(H, -wi_hat)),
+                     p_axis_in  = normalize(cross(-wi_hat, s_axis_in)),
+                     s_axis_out = normalize(cross(H, wo_hat)),
+                     p_axis_out = normalize(cross(wo_hat, s_axis_out));
+
+            /* Rotate in/out reference vector of F s.t. it aligns with the implicit
+               Stokes bases of -wi_hat & wo_hat. */
+            F = mueller::rotate_mueller_basis(F,
+                                              -wi_hat, p_axis_in, mueller::stokes_basis(-wi_hat),
+                                               wo_hat, p_axis_out, mueller::stokes_basis(wo_hat));
+        } else {
+            F = fresnel_conductor(UnpolarizedSpectrum(dot(si.wi, H)), eta_c);
+        }
+
+        /* If requested, include the specular reflectance component */
+        if (m_specular_reflectance)
+            result *= m_specular_reflectance->eval(si, active);
+
+        Float pdf;
+        if (likely(m_sample_visible))
+            pdf = D * G1_i / (4.f * cos_theta_i);
+        else
+            pdf = D * Frame3f::cos_theta(H) / (4.f * dot(wo, H));
+
+        return { (F * result) & active, select(active, pdf, 0.f) };
+    }
+
     void traverse(TraversalCallback *callback) override {
         if (m_alpha_u == m_alpha_v)
             callback->put_object("alpha", m_alpha_u.get());
@@ -450,6 +450,115 @@ public:
         return select(active, prob * abs(dwh_dwo), 0.f);
     }
 
+    std::pair<Spectrum, Float> eval_pdf(const BSDFContext &ctx,
+                                        const SurfaceInteraction3f &si,
+                                        const Vector3f &wo,
+                                        Mask active) const override {
+        MTS_MASKED_FUNCTION(ProfilerPhase::BSDFEvaluate, active);
+
+        Float cos_theta_i = Frame3f::cos_theta(si.wi),
+              cos_theta_o = Frame3f::cos_theta(wo);
+
+        // Ignore perfectly grazing configurations
+        active &= neq(cos_theta_i, 0.f);
+
+        // Determine the type of interaction
+        bool has_reflection   = ctx.is_enabled(BSDFFlags::GlossyReflection, 0),
+             has_transmission = ctx.is_enabled(BSDFFlags::GlossyTransmission, 1);
+
+        Mask reflect = cos_theta_i * cos_theta_o > 0.f;
+
+        // Determine the relative index of refraction
+        Float eta     = select(cos_theta_i > 0.f, Float(m_eta), Float(m_inv_eta)),
+              inv_eta = select(cos_theta_i > 0.f, Float(m_inv_eta), Float(m_eta));
+
+        // Compute the half-vector
+        Vector3f m = normalize(si.wi + wo * select(reflect, Float(1.f), eta));
+
+        // Ensure that the half-vector points into the same hemisphere as the macrosurface normal
+        m = mulsign(m, Frame3f::cos_theta(m));
+
+        /* Construct the microfacet distribution matching the
+           roughness values at the current surface position. */
+        MicrofacetDistribution distr(m_type,
+                                     m_alpha_u->eval_1(si, active),
+                                     m_alpha_v->eval_1(si, active),
+                                     m_sample_visible);
+
+        // Evaluate the microfacet normal distribution
+        Float D = distr.eval(m);
+
+        // Fresnel factor
+        Float F = std::get<0>(fresnel(dot(si.wi, m), Float(m_eta)));
+
+        // Smith's shadow-masking function
+        Float G1_i = distr.smith_g1(si.wi, m),
+              G    = G1_i * distr.smith_g1(wo, m);
+
+        UnpolarizedSpectrum result(0.f);
+
+        Mask eval_r = Mask(has_reflection) && reflect && active,
+             eval_t = Mask(has_transmission) && !reflect && active;
+
+        if (any_or<true>(eval_r)) {
+            UnpolarizedSpectrum value = F * D * G / (4.f * abs(cos_theta_i));
+
+            if (m_specular_reflectance)
+                value *= m_specular_reflectance->eval(si, eval_r);
+
+            result[eval_r] = value;
+        }
+
+        if (any_or<true>(eval_t)) {
+            /* Missing term in the original paper: account for the solid angle
+               compression when tracing radiance -- this is necessary for
+               bidirectional methods. */
+            Float scale = (ctx.mode == TransportMode::Radiance) ? sqr(inv_eta) : Float(1.f);
+
+            // Compute the total amount of transmission
+            UnpolarizedSpectrum value = abs(
+                (scale * (1.f - F) * D * G * eta * eta * dot(si.wi, m) * dot(wo, m)) /
+                (cos_theta_i * sqr(dot(si.wi, m) + eta * dot(wo, m))));
+
+            if (m_specular_transmittance)
+                value *= m_specular_transmittance->eval(si, eval_t);
+
+            result[eval_t] = value;
+        }
+
+        // ------------------- Sampling density (see pdf()) -------------------
+
+        Mask active_pdf = active &&
+                          ((Mask(has_reflection)   &&  reflect) ||
+                           (Mask(has_transmission) && !reflect)) &&
+                          dot(si.wi, m) * cos_theta_i > 0.f &&
+                          dot(wo,    m) * cos_theta_o > 0.f;
+
+        // Jacobian of the half-direction mapping
+        Float dwh_dwo = select(reflect, rcp(4.f * dot(wo, m)),
+                               (eta * eta * dot(wo, m)) /
+                                   sqr(dot(si.wi, m) + eta * dot(wo, m)));
+
+        // Evaluate the microfacet model sampling density function
+        Float prob;
+        if (likely(m_sample_visible)) {
+            // Reuses D and G1_i, since smith_g1() is symmetric w.r.t. flipping 'wi'
+            prob = D * G1_i * abs(dot(si.wi, m) / cos_theta_i);
+        } else {
+            /* Trick by Walter et al.: slightly scale the roughness values to
+               reduce importance sampling weights. */
+            MicrofacetDistribution sample_distr(distr);
+            sample_distr.scale_alpha(1.2f - .2f * sqrt(abs(cos_theta_i)));
+            prob = sample_distr.pdf(mulsign(si.wi, cos_theta_i), m);
+        }
+
+        if (likely(has_transmission && has_reflection))
+            prob *= select(reflect, F, 1.f - F);
+
+        return { unpolarized<Spectrum>(result),
+                 select(active_pdf, prob * abs(dwh_dwo), 0.f) };
+    }
+
     void traverse(TraversalCallback *callback) override {
         if (m_alpha_u == m_alpha_v)
             callback->put_object("alpha", m_alpha_u.get());
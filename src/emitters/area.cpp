@@ -3,6 +3,7 @@
 #include <mitsuba/core/spectrum.h>
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/render/medium.h>
+#include <mitsuba/render/mesh.h>
 #include <mitsuba/render/shape.h>
 #include <mitsuba/render/texture.h>
 
@@ -39,13 +40,19 @@ emitter shape and specify an :monosp:`area` instance as its child:
         </emitter>
     </shape>
 
+When a triangle mesh emits a spatially varying radiance (e.g. a bitmap
+texture), the texture is integrated over every triangle at load time, and
+direct illumination samples are distributed among the triangles
+proportionally to the power they emit. Bright parts of large emissive
+meshes (screens, signage, ..) thereby receive most of the samples.
+
  */
 
 template <typename Float, typename Spectrum>
 class AreaLight final : public Emitter<Float, Spectrum> {
 public:
     MTS_IMPORT_BASE(Emitter, m_flags, m_shape, m_medium)
-    MTS_IMPORT_TYPES(Scene, Shape, Texture)
+    MTS_IMPORT_TYPES(Scene, Shape, Mesh, Texture)
 
     AreaLight(const Properties &props) : Base(props) {
         if (props.has_property("to_world"))
@@ -66,6 +73,10 @@ public:
 
         Base::set_shape(shape);
         m_area_times_pi = m_shape->surface_area() * math::Pi<ScalarFloat>;
+
+        // Emissive meshes with a textured radiance pick triangles by power
+        if (m_radiance->is_spatially_varying() && shape->is_mesh())
+            static_cast<Mesh *>(shape)->emission_distr_build(m_radiance.get());
     }
 
     Spectrum eval(const SurfaceInteraction3f &si, Mask active) const override {
@@ -130,6 +141,15 @@ public:
         callback->put_object("radiance", m_radiance.get());
     }
 
+    void parameters_changed() override {
+        // The shape may have been deformed, or the radiance may have changed
+        if (!m_shape)
+            return;
+        m_area_times_pi = m_shape->surface_area() * math::Pi<ScalarFloat>;
+        if (m_radiance->is_spatially_varying() && m_shape->is_mesh())
+            static_cast<Mesh *>(m_shape)->emission_distr_build(m_radiance.get());
+    }
+
     std::string to_string() const override {
         std::ostringstream oss;
         oss << "AreaLight[" << std::endl
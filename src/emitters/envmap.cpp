@@ -2,11 +2,14 @@
 #include <mitsuba/core/bsphere.h>
 #include <mitsuba/core/fresolver.h>
 #include <mitsuba/core/plugin.h>
+#include <mitsuba/core/distr_1d.h>
 #include <mitsuba/core/distr_2d.h>
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/render/scene.h>
 #include <mitsuba/render/texture.h>
 #include <mitsuba/render/srgb.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -28,6 +31,12 @@ Environment emitter (:monosp:`envmap`)
  * - to_world
    - |transform|
    - Specifies an optional emitter-to-world transformation.  (Default: none, i.e. emitter space = world space)
+ * - sampling
+   - |string|
+   - Data structure used to importance sample the image: :monosp:`hierarchical` warps samples
+     through a MIP hierarchy that matches the bilinearly interpolated luminance, while
+     :monosp:`alias` uses an alias table over the pixels that samples in constant time
+     but only follows their average luminance. (Default: :monosp:`hierarchical`)
 
 This plugin provides a HDRI (high dynamic range imaging) environment map,
 which is a type of light source that is well-suited for representing "natural"
@@ -54,6 +63,13 @@ High quality free light probes are available on
 `Paul Debevec's <http://gl.ict.usc.edu/Data/HighResProbes>`_ and
 `Bernhard Vogl's <http://dativ.at/lightprobes/>`_ websites.
 
+The hierarchical warp descends one level of its MIP hierarchy per sample,
+i.e. it performs a chain of dependent memory accesses whose length grows with
+the logarithm of the resolution. The alias table instead needs two accesses
+per sample independent of the resolution. It is piecewise constant over the
+pixels rather than bilinear, which slightly increases variance in regions where
+the radiance changes rapidly, but is often faster for high-resolution maps.
+
  */
 
 template <typename Float, typename Spectrum>
@@ -80,45 +96,59 @@ public:
         m_filename = file_path.filename().string();
 
         std::unique_ptr<ScalarFloat[]> luminance(new ScalarFloat[bitmap->pixel_count()]);
-
-        ScalarFloat *ptr     = (ScalarFloat *) bitmap->data(),
-                    *lum_ptr = (ScalarFloat *) luminance.get();
-
-        for (size_t y = 0; y < bitmap->size().y(); ++y) {
-            ScalarFloat sin_theta =
-                std::sin(y / ScalarFloat(bitmap->size().y() - 1) * math::Pi<ScalarFloat>);
-
-            for (size_t x = 0; x < bitmap->size().x(); ++x) {
-                ScalarColor3f rgb = load_unaligned<ScalarVector3f>(ptr);
-                ScalarFloat lum   = mitsuba::luminance(rgb);
-
-                ScalarVector4f coeff;
-                if constexpr (is_monochromatic_v<Spectrum>) {
-                    coeff = ScalarVector4f(lum, lum, lum, 1.f);
-                } else if constexpr (is_rgb_v<Spectrum>) {
-                    coeff = concat(rgb, ScalarFloat(1.f));
-                } else {
-                    static_assert(is_spectral_v<Spectrum>);
-                    /* Evaluate the spectral upsampling model. This requires a
-                       reflectance value (colors in [0, 1]) which is accomplished here by
-                       scaling. We use a color where the highest component is 50%,
-                       which generally yields a fairly smooth spectrum. */
-                    ScalarFloat scale = hmax(rgb) * 2.f;
-                    ScalarColor3f rgb_norm = rgb / std::max((ScalarFloat) 1e-8, scale);
-                    coeff = concat((ScalarColor3f) srgb_model_fetch(rgb_norm), scale);
+        ScalarVector2u size = bitmap->size();
+
+        // Rows are independent, hence process them in parallel
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, size.y()),
+                          [&](const tbb::blocked_range<size_t> &range) {
+            for (size_t y = range.begin(); y != range.end(); ++y) {
+                ScalarFloat sin_theta =
+                    std::sin(y / ScalarFloat(size.y() - 1) * math::Pi<ScalarFloat>);
+
+                ScalarFloat *ptr     = (ScalarFloat *) bitmap->data() + y * size.x() * 4,
+                            *lum_ptr = luminance.get() + y * size.x();
+
+                for (size_t x = 0; x < size.x(); ++x) {
+                    ScalarColor3f rgb = load_unaligned<ScalarVector3f>(ptr);
+                    ScalarFloat lum   = mitsuba::luminance(rgb);
+
+                    ScalarVector4f coeff;
+                    if constexpr (is_monochromatic_v<Spectrum>) {
+                        coeff = ScalarVector4f(lum, lum, lum, 1.f);
+                    } else if constexpr (is_rgb_v<Spectrum>) {
+                        coeff = concat(rgb, ScalarFloat(1.f));
+                    } else {
+                        static_assert(is_spectral_v<Spectrum>);
+                        /* Evaluate the spectral upsampling model. This requires a
+                           reflectance value (colors in [0, 1]) which is accomplished here by
+                           scaling. We use a color where the highest component is 50%,
+                           which generally yields a fairly smooth spectrum. */
+                        ScalarFloat scale = hmax(rgb) * 2.f;
+                        ScalarColor3f rgb_norm = rgb / std::max((ScalarFloat) 1e-8, scale);
+                        coeff = concat((ScalarColor3f) srgb_model_fetch(rgb_norm), scale);
+                    }
+
+                    *lum_ptr++ = lum * sin_theta;
+                    store(ptr, coeff);
+                    ptr += 4;
                 }
-
-                *lum_ptr++ = lum * sin_theta;
-                store(ptr, coeff);
-                ptr += 4;
             }
-        }
+        });
 
-        m_resolution = bitmap->size();
+        m_resolution = size;
         m_data = DynamicBuffer<Float>::copy(bitmap->data(), hprod(m_resolution) * 4);
 
+        std::string sampling = props.string("sampling", "hierarchical");
+        if (sampling == "alias")
+            m_alias_sampling = true;
+        else if (sampling == "hierarchical")
+            m_alias_sampling = false;
+        else
+            Throw("Invalid \"sampling\" value \"%s\", must be \"hierarchical\" or "
+                  "\"alias\"!", sampling);
+
         m_scale = props.float_("scale", 1.f);
-        m_warp = Warp(luminance.get(), m_resolution);
+        build_sampling(luminance.get());
         m_d65 = Texture::D65(1.f);
         m_flags = EmitterFlags::Infinite | EmitterFlags::SpatiallyVarying;
     }
@@ -128,33 +158,36 @@ public:
 
         std::unique_ptr<ScalarFloat[]> luminance(new ScalarFloat[hprod(m_resolution)]);
 
-        ScalarFloat *ptr     = (ScalarFloat *) m_data.data(),
-                    *lum_ptr = (ScalarFloat *) luminance.get();
-
-
-        for (size_t y = 0; y < m_resolution.y(); ++y) {
-            ScalarFloat sin_theta =
-                std::sin(y / ScalarFloat(m_resolution.y() - 1) * math::Pi<ScalarFloat>);
-
-            for (size_t x = 0; x < m_resolution.x(); ++x) {
-                ScalarVector4f coeff = load<ScalarVector4f>(ptr);
-                ScalarFloat lum;
-
-                if constexpr (is_monochromatic_v<Spectrum>) {
-                    lum = coeff.x();
-                } else if constexpr (is_rgb_v<Spectrum>) {
-                    lum = mitsuba::luminance(ScalarColor3f(head<3>(coeff)));
-                } else {
-                    static_assert(is_spectral_v<Spectrum>);
-                    lum = srgb_model_mean(head<3>(coeff)) * coeff.w();
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, m_resolution.y()),
+                          [&](const tbb::blocked_range<size_t> &range) {
+            for (size_t y = range.begin(); y != range.end(); ++y) {
+                ScalarFloat sin_theta =
+                    std::sin(y / ScalarFloat(m_resolution.y() - 1) * math::Pi<ScalarFloat>);
+
+                const ScalarFloat *ptr = (const ScalarFloat *) m_data.data() +
+                                         y * m_resolution.x() * 4;
+                ScalarFloat *lum_ptr = luminance.get() + y * m_resolution.x();
+
+                for (size_t x = 0; x < m_resolution.x(); ++x) {
+                    ScalarVector4f coeff = load<ScalarVector4f>(ptr);
+                    ScalarFloat lum;
+
+                    if constexpr (is_monochromatic_v<Spectrum>) {
+                        lum = coeff.x();
+                    } else if constexpr (is_rgb_v<Spectrum>) {
+                        lum = mitsuba::luminance(ScalarColor3f(head<3>(coeff)));
+                    } else {
+                        static_assert(is_spectral_v<Spectrum>);
+                        lum = srgb_model_mean(head<3>(coeff)) * coeff.w();
+                    }
+
+                    *lum_ptr++ = lum * sin_theta;
+                    ptr += 4;
                 }
-
-                *lum_ptr++ = lum * sin_theta;
-                ptr += 4;
             }
-        }
+        });
 
-        m_warp = Warp(luminance.get(), m_resolution);
+        build_sampling(luminance.get());
     }
 
     void set_scene(const Scene *scene) override {
@@ -189,7 +222,7 @@ public:
     sample_direction(const Interaction3f &it, const Point2f &sample, Mask active) const override {
         MTS_MASKED_FUNCTION(ProfilerPhase::EndpointSampleDirection, active);
 
-        auto [uv, pdf] = m_warp.sample(sample);
+        auto [uv, pdf] = sample_uv(sample, active);
 
         Float theta = uv.y() * math::Pi<Float>,
               phi = uv.x() * (2.f * math::Pi<Float>);
@@ -236,7 +269,7 @@ public:
 
         Float inv_sin_theta =
             safe_rsqrt(max(sqr(d.x()) + sqr(d.z()), sqr(math::Epsilon<Float>)));
-        return m_warp.eval(uv) * inv_sin_theta * (1.f / (2.f * sqr(math::Pi<Float>)));
+        return pdf_uv(uv, active) * inv_sin_theta * (1.f / (2.f * sqr(math::Pi<Float>)));
     }
 
     ScalarBoundingBox3f bbox() const override {
@@ -256,12 +289,68 @@ public:
         oss << "EnvironmentMapEmitter[" << std::endl
             << "  filename = \"" << m_filename << "\"," << std::endl
             << "  resolution = \"" << m_resolution << "\"," << std::endl
+            << "  sampling = " << (m_alias_sampling ? "alias" : "hierarchical") << "," << std::endl
             << "  bsphere = " << m_bsphere << std::endl
             << "]";
         return oss.str();
     }
 
 protected:
+    /**
+     * \brief Build the data structure used for importance sampling from the
+     * luminance at the pixels (already multiplied by the sine of the
+     * elevation angle)
+     */
+    void build_sampling(const ScalarFloat *luminance) {
+        if (!m_alias_sampling) {
+            m_warp = Warp(luminance, m_resolution);
+            return;
+        }
+
+        /* The image is interpolated bilinearly between pixel centers, hence the
+           table covers the cells spanned by four neighboring pixels */
+        ScalarVector2u cells = m_resolution - 1u;
+        std::unique_ptr<ScalarFloat[]> pmf(new ScalarFloat[hprod(cells)]);
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, cells.y()),
+                          [&](const tbb::blocked_range<size_t> &range) {
+            for (size_t y = range.begin(); y != range.end(); ++y) {
+                const ScalarFloat *row_0 = luminance + y * m_resolution.x(),
+                                  *row_1 = row_0 + m_resolution.x();
+                ScalarFloat *pmf_ptr = pmf.get() + y * cells.x();
+                for (size_t x = 0; x < cells.x(); ++x)
+                    pmf_ptr[x] = .25f * (row_0[x] + row_0[x + 1] + row_1[x] + row_1[x + 1]);
+            }
+        });
+
+        m_alias = AliasDistribution<Float>(pmf.get(), hprod(cells));
+    }
+
+    /// Sample a position on the image, returns the position and its density
+    std::pair<Point2f, Float> sample_uv(const Point2f &sample, Mask active) const {
+        if (!m_alias_sampling)
+            return m_warp.sample(sample, nullptr, active);
+
+        ScalarVector2u cells = m_resolution - 1u;
+        auto [index, x, pmf] = m_alias.sample_reuse_pmf(sample.x(), active);
+
+        Point2f uv = (Point2f(Float(index % cells.x()), Float(index / cells.x())) +
+                      Point2f(x, sample.y())) / ScalarVector2f(cells);
+
+        return { uv, pmf * (ScalarFloat) hprod(cells) };
+    }
+
+    /// Evaluate the density of \ref sample_uv()
+    Float pdf_uv(const Point2f &uv, Mask active) const {
+        if (!m_alias_sampling)
+            return m_warp.eval(uv, nullptr, active);
+
+        ScalarVector2u cells = m_resolution - 1u;
+        Point2u pos = min(Point2u(uv * ScalarVector2f(cells)), cells - 1u);
+        return m_alias.eval_pmf_normalized(pos.x() + pos.y() * cells.x(), active) *
+               (ScalarFloat) hprod(cells);
+    }
+
     UnpolarizedSpectrum eval_spectrum(Point2f uv, const Wavelength &wavelengths, Mask active) const {
         uv *= Vector2f(m_resolution - 1u);
 
@@ -321,6 +410,8 @@ protected:
     DynamicBuffer<Float> m_data;
     ScalarVector2u m_resolution;
     Warp m_warp;
+    AliasDistribution<Float> m_alias;
+    bool m_alias_sampling;
     ref<Texture> m_d65;
     ScalarFloat m_scale;
 };
@@ -137,3 +137,57 @@ def test04_sample_direction(variant_packet_spectral, spectrum_key):
     # Evalutate the spectrum (divide by the pdf)
     spec = spectrum.eval(it) / ds.pdf
     assert ek.allclose(res, spec)
+
+
+@fresolver_append_path
+def create_textured_emitter():
+    from mitsuba.core.xml import load_string
+    # The checkerboard assigns a radiance of 1 to the first and 9 to the second triangle
+    return load_string("""<shape version='2.0.0' type='obj'>
+                              <string name='filename' value='data/two_triangles.obj'/>
+                              <boolean name='flip_tex_coords' value='false'/>
+                              <emitter type='area'>
+                                  <texture type='checkerboard' name='radiance'>
+                                      <rgb name='color0' value='1'/>
+                                      <rgb name='color1' value='9'/>
+                                  </texture>
+                              </emitter>
+                          </shape>""")
+
+
+def test05_sample_direction_power_weighted(variant_packet_rgb):
+    # Triangles are chosen proportionally to their power, and the solid angle
+    # of nearby triangles is sampled uniformly
+
+    import numpy as np
+    from mitsuba.render import SurfaceInteraction3f
+
+    shape = create_textured_emitter()
+    emitter = shape.emitter()
+
+    t = (np.arange(64) + 0.5) / 64
+    samples = np.array(np.meshgrid(t, t)).reshape(2, -1).T
+    n = len(samples)
+
+    triangles = np.array([[[0, 0, 0], [1, 0, 0], [0, 1, 0]],
+                          [[1, 0, 0], [2, 0, 0], [1, 1, 0]]], dtype=float)
+
+    def solid_angle(p, v):
+        a, b, c = [(x - p) / np.linalg.norm(x - p) for x in v]
+        return 2 * np.arctan2(abs(np.dot(a, np.cross(b, c))),
+                              1 + np.dot(a, b) + np.dot(b, c) + np.dot(c, a))
+
+    # Near: spherical triangle sampling, far: area sampling
+    for z in [1.0, 200.0]:
+        p = np.array([1, 0.5, z])
+        it = SurfaceInteraction3f.zero(n)
+        it.p = np.tile(p, (n, 1))
+        ds, res = emitter.sample_direction(it, samples)
+
+        # 10% of the samples are distributed by area
+        assert np.allclose(np.mean(ds.prim_index.numpy() == 1), 0.9 * 0.9 + 0.1 * 0.5, atol=0.01)
+        assert ek.allclose(emitter.pdf_direction(it, ds), ds.pdf, rtol=1e-3)
+
+        # Radiance is constant per triangle
+        ref = solid_angle(p, triangles[0]) + 9 * solid_angle(p, triangles[1])
+        assert np.allclose(np.mean(res.numpy()[:, 0]), ref, rtol=2e-2)
@@ -0,0 +1,55 @@
+import mitsuba
+import pytest
+import enoki as ek
+import numpy as np
+import os
+
+
+def create_envmap(tmpdir, sampling):
+    from mitsuba.core import Bitmap
+    from mitsuba.core.xml import load_string
+
+    # Smooth background with a small bright spot
+    np.random.seed(0)
+    data = np.random.uniform(0.1, 1.0, size=(16, 32, 3)).astype(np.float32)
+    data[5:7, 20:22, :] = 50.0
+
+    filename = os.path.join(str(tmpdir), 'envmap.exr')
+    Bitmap(data).write(filename)
+
+    return load_string("""<emitter version="2.0.0" type="envmap">
+                              <string name="filename" value="{}"/>
+                              <string name="sampling" value="{}"/>
+                          </emitter>""".format(filename, sampling))
+
+
+def test01_invalid_sampling(variant_scalar_rgb, tmpdir):
+    with pytest.raises(RuntimeError):
+        create_envmap(tmpdir, 'linear')
+
+
+@pytest.mark.parametrize("sampling", ['hierarchical', 'alias'])
+def test02_sample_direction(variant_packet_rgb, tmpdir, sampling):
+    # The density of sampled directions must match pdf_direction(), and both
+    # strategies must estimate the same integral of the radiance
+    from mitsuba.core import Float, Point2f
+    from mitsuba.render import SurfaceInteraction3f
+
+    emitter = create_envmap(tmpdir, sampling)
+
+    count = 100000
+    sample = np.random.uniform(size=(count, 2)).astype(np.float32)
+    sample = Point2f(Float(sample[:, 0]), Float(sample[:, 1]))
+
+    it = SurfaceInteraction3f.zero(count)
+    it.wavelengths = []
+
+    ds, value = emitter.sample_direction(it, sample)
+    assert ek.allclose(ds.pdf, emitter.pdf_direction(it, ds), rtol=1e-3)
+
+    # Integral of the (approximately) piecewise constant radiance
+    data_mean = np.array(value).reshape(count, -1).mean()
+    reference = create_envmap(tmpdir, 'hierarchical')
+    _, ref_value = reference.sample_direction(it, sample)
+    ref_mean = np.array(ref_value).reshape(count, -1).mean()
+    assert np.allclose(data_mean, ref_mean, rtol=2e-2)
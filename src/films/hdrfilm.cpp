@@ -1,6 +1,8 @@
 #include <mitsuba/core/bitmap.h>
+#include <mitsuba/core/denoise.h>
 #include <mitsuba/core/filesystem.h>
 #include <mitsuba/core/fstream.h>
+#include <mitsuba/core/numa.h>
 #include <mitsuba/core/spectrum.h>
 #include <mitsuba/core/string.h>
 #include <mitsuba/render/film.h>
@@ -40,6 +42,27 @@ High dynamic range film (:monosp:`hdrfilm`)
    - These parameters can optionally be provided to select a sub-rectangle
      of the output. In this case, only the requested regions
      will be rendered. (Default: Unused)
+ * - band_height
+   - |int|
+   - When writing OpenEXR files, the film is converted and written in bands of this many
+     scanlines, which bounds the memory needed during development to a single band rather than
+     the full frame. Set to zero to convert the whole frame at once. (Default: 64)
+ * - denoise
+   - |bool|
+   - If set to |true|, the image is filtered by an edge-avoiding À-Trous wavelet denoiser when it
+     is developed. (Default: |false|, i.e. disabled)
+ * - denoise_guides
+   - |string|
+   - Comma-separated list of arbitrary output variables (e.g. normals or depth rendered by the
+     :ref:`aov <integrator-aov>` integrator) that steer the denoiser, each optionally followed by
+     its tolerance, e.g. :monosp:`nn, dd.y:0.2`. (Default: none, tolerance: 0.1)
+ * - denoise_iterations
+   - |int|
+   - Number of iterations of the wavelet transform. The filter radius doubles with every
+     iteration. (Default: 5)
+ * - denoise_sigma
+   - |float|
+   - Tolerance for relative color differences between neighboring pixels. (Default: 1.0)
  * - high_quality_edges
    - |bool|
    - If set to |true|, regions slightly outside of the film plane will also be sampled. This may
@@ -77,6 +100,29 @@ When RGB(A) output is selected, the measured spectral power distributions are
 converted to linear RGB based on the CIE 1931 XYZ color matching curves and
 the ITU-R Rec. BT.709-3 primaries with a D65 white point.
 
+The film can optionally denoise the image before writing it, which allows rendering with
+substantially fewer samples per pixel. The denoiser (Dammertz et al. :cite:`Dammertz2010Edge`)
+averages neighboring pixels with weights that decrease with differences in color and in the
+feature images listed in :monosp:`denoise_guides`, so that geometric edges stay sharp. A guide
+matches the output variable of the same name, or all of its channels (e.g. :monosp:`nn` matches
+:monosp:`nn.X`, :monosp:`nn.Y` and :monosp:`nn.Z`). Its tolerance is specified relative to the
+standard deviation of the feature over the image. Denoising requires the full frame and therefore
+a full-resolution copy of the film storage during development. Only the color channels are
+filtered, and the guides are written to the output file unchanged. For instance, the following
+snippet denoises an image guided by the shading normals and depth:
+
+.. code-block:: xml
+
+    <integrator type="aov">
+        <string name="aovs" value="nn:sh_normal, dd.y:depth"/>
+        <integrator type="path"/>
+    </integrator>
+
+    <film type="hdrfilm">
+        <boolean name="denoise" value="true"/>
+        <string name="denoise_guides" value="nn, dd.y:0.2"/>
+    </film>
+
 The following XML snippet discribes a film that writes a full-HD RGBA OpenEXR file:
 
 .. code-block:: xml
@@ -104,6 +150,26 @@ public:
             props.string("component_format", "float16"));
 
         m_dest_file = props.string("filename", "");
+        m_band_height = (uint32_t) props.int_("band_height", 64);
+
+        m_denoise = props.bool_("denoise", false);
+        m_denoise_iterations = (uint32_t) props.int_("denoise_iterations", 5);
+        m_denoise_sigma = props.float_("denoise_sigma", 1.f);
+        for (const std::string &token : string::tokenize(props.string("denoise_guides", ""))) {
+            std::vector<std::string> item = string::tokenize(token, ":");
+            if (item.empty() || item.size() > 2)
+                Throw("Invalid denoiser guide \"%s\": require <name>[:<sigma>]", token);
+
+            float sigma = 0.1f;
+            if (item.size() == 2) {
+                try {
+                    sigma = std::stof(item[1]);
+                } catch (...) {
+                    Throw("Invalid tolerance of denoiser guide \"%s\"", token);
+                }
+            }
+            m_denoise_guide_names.emplace_back(item[0], sigma);
+        }
 
         if (file_format == "openexr" || file_format == "exr")
             m_file_format = Bitmap::FileFormat::OpenEXR;
@@ -197,7 +263,24 @@ public:
         m_storage = new ImageBlock(m_crop_size, channels.size());
         m_storage->set_offset(m_crop_offset);
         m_storage->clear();
+        if constexpr (!is_cuda_array_v<Float>)
+            numa::distribute(m_storage->data().data(),
+                             m_storage->data().size() * sizeof(ScalarFloat));
         m_channels = channels;
+
+        // Resolve the channels of the denoiser guides
+        m_denoise_guides.clear();
+        for (const auto &[name, sigma] : m_denoise_guide_names) {
+            std::vector<size_t> indices;
+            for (size_t i = 5; i < channels.size(); ++i) {
+                if (channels[i] == name || string::starts_with(channels[i], name + "."))
+                    indices.push_back(i);
+            }
+            if (indices.empty())
+                Throw("Film::prepare(): the denoiser guide \"%s\" does not match "
+                      "any output variable!", name);
+            m_denoise_guides.emplace_back(std::move(indices), sigma);
+        }
     }
 
     void put(const ImageBlock *block) override {
@@ -249,68 +332,15 @@ public:
             cuda_sync();
         }
 
-        ref<Bitmap> source = new Bitmap(m_channels.size() != 5 ? Bitmap::PixelFormat::MultiChannel
-                                                               : Bitmap::PixelFormat::XYZAW,
-                          struct_type_v<ScalarFloat>, m_storage->size(), m_storage->channel_count(),
-                          (uint8_t *) m_storage->data().managed().data());
-
         if (raw)
-            return source;
-
-        bool has_aovs = m_channels.size() != 5;
-
-        ref<Bitmap> target = new Bitmap(
-            has_aovs ? Bitmap::PixelFormat::MultiChannel : m_pixel_format,
-            m_component_format, m_storage->size(),
-            has_aovs ? (m_storage->channel_count() - 1) : 0);
-
-        if (has_aovs) {
-            for (size_t i = 0, j = 0; i < m_channels.size(); ++i, ++j) {
-                Struct::Field &source_field = source->struct_()->operator[](i),
-                              &dest_field   = target->struct_()->operator[](j);
-
-                switch (i) {
-                    case 0:
-                        dest_field.name = "R";
-                        dest_field.blend = {
-                            {  3.240479f, "X" },
-                            { -1.537150f, "Y" },
-                            { -0.498535f, "Z" }
-                        };
-                        break;
-
-                    case 1:
-                        dest_field.name = "G";
-                        dest_field.blend = {
-                            { -0.969256, "X" },
-                            {  1.875991, "Y" },
-                            {  0.041556, "Z" }
-                        };
-                        break;
-
-                    case 2:
-                        dest_field.name = "B";
-                        dest_field.blend = {
-                            {  0.055648, "X" },
-                            { -0.204043, "Y" },
-                            {  1.057311, "Z" }
-                        };
-                        break;
-
-                    case 4:
-                        source_field.flags |= +Struct::Flags::Weight;
-                        j--;
-                        break;
-
-                    default:
-                        dest_field.name = m_channels[i];
-                        break;
-                }
+            return storage_bitmap(0, (uint32_t) m_storage->height());
 
-                source_field.name = m_channels[i];
-            }
-        }
+        std::unique_ptr<ScalarFloat[]> denoised = denoised_storage();
+        ref<Bitmap> source = storage_bitmap(0, (uint32_t) m_storage->height(),
+                                            denoised.get());
 
+        ref<Bitmap> target = developed_bitmap(source->size());
+        setup_channels(source, target);
         source->convert(target);
 
         return target;
@@ -320,40 +350,29 @@ public:
         if (m_dest_file.empty())
             Throw("Destination file not specified, cannot develop.");
 
-        fs::path filename = m_dest_file;
-        std::string proper_extension;
-        if (m_file_format == Bitmap::FileFormat::OpenEXR)
-            proper_extension = ".exr";
-        else if (m_file_format == Bitmap::FileFormat::RGBE)
-            proper_extension = ".rgbe";
-        else
-            proper_extension = ".pfm";
-
-        std::string extension = string::to_lower(filename.extension().string());
-        if (extension != proper_extension)
-            filename.replace_extension(proper_extension);
-
+        fs::path filename = destination_filename(m_dest_file);
         Log(Info, "\U00002714  Developing \"%s\" ..", filename.string());
 
-        bitmap()->write(filename, m_file_format);
+        if (m_file_format == Bitmap::FileFormat::OpenEXR && m_band_height > 0)
+            develop_bands(filename);
+        else
+            bitmap()->write(filename, m_file_format);
     }
 
-    bool destination_exists(const fs::path &base_name) const override {
-        std::string proper_extension;
-        if (m_file_format == Bitmap::FileFormat::OpenEXR)
-            proper_extension = ".exr";
-        else if (m_file_format == Bitmap::FileFormat::RGBE)
-            proper_extension = ".rgbe";
-        else
-            proper_extension = ".pfm";
+    ref<WriteHandle> develop_async() override {
+        if (m_dest_file.empty())
+            Throw("Destination file not specified, cannot develop.");
 
-        fs::path filename = base_name;
+        fs::path filename = destination_filename(m_dest_file);
+        Log(Info, "\U00002714  Developing \"%s\" (asynchronously) ..", filename.string());
 
-        std::string extension = string::to_lower(filename.extension().string());
-        if (extension != proper_extension)
-            filename.replace_extension(proper_extension);
+        /* bitmap() returns a converted copy of the film storage, which the
+           write queue keeps alive until the file has been written */
+        return bitmap()->write_async(filename, m_file_format);
+    }
 
-        return fs::exists(filename);
+    bool destination_exists(const fs::path &base_name) const override {
+        return fs::exists(destination_filename(base_name));
     }
 
     std::string to_string() const override {
@@ -367,12 +386,215 @@ public:
             << "  file_format = " << m_file_format << "," << std::endl
             << "  pixel_format = " << m_pixel_format << "," << std::endl
             << "  component_format = " << m_component_format << "," << std::endl
-            << "  dest_file = \"" << m_dest_file << "\"" << std::endl
+            << "  band_height = " << m_band_height << "," << std::endl
+            << "  denoise = " << m_denoise << "," << std::endl;
+        if (m_denoise) {
+            oss << "  denoise_guides = [";
+            for (size_t i = 0; i < m_denoise_guide_names.size(); ++i)
+                oss << (i > 0 ? ", " : "") << m_denoise_guide_names[i].first << ":"
+                    << m_denoise_guide_names[i].second;
+            oss << "]," << std::endl
+                << "  denoise_iterations = " << m_denoise_iterations << "," << std::endl
+                << "  denoise_sigma = " << m_denoise_sigma << "," << std::endl;
+        }
+        oss            << "  dest_file = \"" << m_dest_file << "\"" << std::endl
             << "]";
         return oss.str();
     }
 
     MTS_DECLARE_CLASS()
+protected:
+    /// Append the extension matching the file format, unless already present
+    fs::path destination_filename(const fs::path &base_name) const {
+        std::string proper_extension;
+        if (m_file_format == Bitmap::FileFormat::OpenEXR)
+            proper_extension = ".exr";
+        else if (m_file_format == Bitmap::FileFormat::RGBE)
+            proper_extension = ".rgbe";
+        else
+            proper_extension = ".pfm";
+
+        fs::path filename = base_name;
+
+        std::string extension = string::to_lower(filename.extension().string());
+        if (extension != proper_extension)
+            filename.replace_extension(proper_extension);
+
+        return filename;
+    }
+
+    /**
+     * \brief Wrap \c rows scanlines of the film storage starting at row \c y
+     * into a bitmap
+     *
+     * When \c data is specified, it replaces the film storage (e.g. by the
+     * output of \ref denoised_storage()).
+     */
+    ref<Bitmap> storage_bitmap(uint32_t y, uint32_t rows, ScalarFloat *data = nullptr) {
+        size_t row_size = m_storage->width() * m_storage->channel_count();
+        if (!data)
+            data = (ScalarFloat *) m_storage->data().managed().data();
+
+        return new Bitmap(m_channels.size() != 5 ? Bitmap::PixelFormat::MultiChannel
+                                                 : Bitmap::PixelFormat::XYZAW,
+                          struct_type_v<ScalarFloat>,
+                          ScalarVector2u((uint32_t) m_storage->width(), rows),
+                          m_storage->channel_count(),
+                          (uint8_t *) (data + y * row_size));
+    }
+
+    /**
+     * \brief Return a denoised copy of the film storage, or \c nullptr when
+     * denoising is disabled
+     *
+     * The denoiser filters the normalized color (i.e. divided by the weight
+     * channel), which is afterwards multiplied by the weight again so that
+     * the copy can be developed like the original storage.
+     */
+    std::unique_ptr<ScalarFloat[]> denoised_storage() {
+        if (!m_denoise)
+            return nullptr;
+
+        if constexpr (is_cuda_array_v<Float>) {
+            cuda_eval();
+            cuda_sync();
+        }
+
+        uint32_t width  = (uint32_t) m_storage->width(),
+                 height = (uint32_t) m_storage->height();
+        size_t n = (size_t) width * height,
+               channel_count = m_storage->channel_count();
+        const ScalarFloat *data = (const ScalarFloat *) m_storage->data().managed().data();
+
+        auto weight = [&](size_t i) {
+            ScalarFloat w = data[i * channel_count + 4];
+            return w != 0.f ? 1.f / w : 0.f;
+        };
+
+        std::unique_ptr<float[]> color(new float[3 * n]);
+        for (size_t i = 0; i < n; ++i) {
+            ScalarFloat inv_w = weight(i);
+            for (size_t k = 0; k < 3; ++k)
+                color[k * n + i] = (float) (data[i * channel_count + k] * inv_w);
+        }
+
+        std::vector<std::unique_ptr<float[]>> guide_storage;
+        std::vector<DenoiserGuide> guides;
+        for (const auto &[indices, sigma] : m_denoise_guides) {
+            float *guide = new float[indices.size() * n];
+            guide_storage.emplace_back(guide);
+            for (size_t i = 0; i < n; ++i) {
+                ScalarFloat inv_w = weight(i);
+                for (size_t k = 0; k < indices.size(); ++k)
+                    guide[k * n + i] = (float) (data[i * channel_count + indices[k]] * inv_w);
+            }
+            guides.push_back({ guide, indices.size(), sigma });
+        }
+
+        denoise_atrous(color.get(), width, height, guides, m_denoise_iterations,
+                       m_denoise_sigma);
+
+        std::unique_ptr<ScalarFloat[]> result(new ScalarFloat[channel_count * n]);
+        memcpy(result.get(), data, channel_count * n * sizeof(ScalarFloat));
+        for (size_t i = 0; i < n; ++i) {
+            ScalarFloat w = data[i * channel_count + 4];
+            for (size_t k = 0; k < 3; ++k)
+                result[i * channel_count + k] = (ScalarFloat) color[k * n + i] * w;
+        }
+
+        return result;
+    }
+
+    /// Create a bitmap with the output pixel and component format of the film
+    ref<Bitmap> developed_bitmap(const ScalarVector2u &size, uint8_t *data = nullptr) const {
+        bool has_aovs = m_channels.size() != 5;
+
+        return new Bitmap(
+            has_aovs ? Bitmap::PixelFormat::MultiChannel : m_pixel_format,
+            m_component_format, size,
+            has_aovs ? (m_storage->channel_count() - 1) : 0, data);
+    }
+
+    /// Assign the channel names of arbitrary output variables to a storage/output bitmap pair
+    void setup_channels(Bitmap *source, Bitmap *target) const {
+        if (m_channels.size() == 5)
+            return;
+
+        for (size_t i = 0, j = 0; i < m_channels.size(); ++i, ++j) {
+            Struct::Field &source_field = source->struct_()->operator[](i),
+                          &dest_field   = target->struct_()->operator[](j);
+
+            switch (i) {
+                case 0:
+                    dest_field.name = "R";
+                    dest_field.blend = {
+                        {  3.240479f, "X" },
+                        { -1.537150f, "Y" },
+                        { -0.498535f, "Z" }
+                    };
+                    break;
+
+                case 1:
+                    dest_field.name = "G";
+                    dest_field.blend = {
+                        { -0.969256, "X" },
+                        {  1.875991, "Y" },
+                        {  0.041556, "Z" }
+                    };
+                    break;
+
+                case 2:
+                    dest_field.name = "B";
+                    dest_field.blend = {
+                        {  0.055648, "X" },
+                        { -0.204043, "Y" },
+                        {  1.057311, "Z" }
+                    };
+                    break;
+
+                case 4:
+                    source_field.flags |= +Struct::Flags::Weight;
+                    j--;
+                    break;
+
+                default:
+                    dest_field.name = m_channels[i];
+                    break;
+            }
+
+            source_field.name = m_channels[i];
+        }
+    }
+
+    /**
+     * \brief Develop the film into an OpenEXR file one band of scanlines at
+     * a time, so that only a band of the converted image is ever resident
+     */
+    void develop_bands(const fs::path &filename) {
+        if constexpr (is_cuda_array_v<Float>) {
+            cuda_eval();
+            cuda_sync();
+        }
+
+        uint32_t width  = (uint32_t) m_storage->width(),
+                 height = (uint32_t) m_storage->height(),
+                 band_height = std::max(std::min(m_band_height, height), 1u);
+
+        std::unique_ptr<ScalarFloat[]> denoised = denoised_storage();
+
+        ref<Bitmap> band = developed_bitmap(ScalarVector2u(width, band_height));
+        ref<Bitmap> dummy_source = storage_bitmap(0, band_height, denoised.get());
+        setup_channels(dummy_source, band);
+
+        band->write_openexr_bands(filename, height, [&](uint32_t y, uint32_t rows) {
+            ref<Bitmap> source = storage_bitmap(y, rows, denoised.get()),
+                        target = developed_bitmap(ScalarVector2u(width, rows),
+                                                  band->uint8_data());
+            setup_channels(source, target);
+            source->convert(target);
+        });
+    }
+
 protected:
     Bitmap::FileFormat m_file_format;
     Bitmap::PixelFormat m_pixel_format;
@@ -380,6 +602,13 @@ protected:
     fs::path m_dest_file;
     ref<ImageBlock> m_storage;
     std::vector<std::string> m_channels;
+    uint32_t m_band_height;
+    bool m_denoise;
+    uint32_t m_denoise_iterations;
+    float m_denoise_sigma;
+    std::vector<std::pair<std::string, float>> m_denoise_guide_names;
+    /// Storage channels of each denoiser guide, resolved in \ref prepare()
+    std::vector<std::pair<std::vector<size_t>, float>> m_denoise_guides;
 };
 
 MTS_IMPLEMENT_CLASS_VARIANT(HDRFilm, Film)
@@ -142,3 +142,128 @@ def test03_develop(variant_scalar_rgb, file_format, tmpdir):
             assert ek.allclose(img[:, :, :3], contents[:, :, :3], atol=1e-5)
         # Alpha channel was ignored, alpha and weights should default to 1.0.
         assert ek.allclose(img[:, :, 3:5], 1.0, atol=1e-6)
+
+
+def create_film(contents, params='', aovs=()):
+    """Create an HDR film with a box filter, and accumulate an array of shape
+    (height, width, channels) holding XYZAW values (followed by the AOVs)."""
+    from mitsuba.core.xml import load_string
+    from mitsuba.render import ImageBlock
+
+    height, width, channels = contents.shape
+    film = load_string("""<film version="2.0.0" type="hdrfilm">
+            <integer name="width" value="{}"/>
+            <integer name="height" value="{}"/>
+            <string name="component_format" value="float32"/>
+            <rfilter type="box"/>
+            {}
+        </film>""".format(width, height, params))
+
+    block = ImageBlock(film.size(), channels, film.reconstruction_filter())
+    block.clear()
+    for y in range(height):
+        for x in range(width):
+            block.put([x+0.5, y+0.5], contents[y, x, :])
+
+    film.prepare(['X', 'Y', 'Z', 'A', 'W'] + list(aovs))
+    film.put(block)
+    return film
+
+
+@pytest.mark.parametrize('band_height', [0, 1, 5, 64])
+def test04_develop_bands(variant_scalar_rgb, band_height, tmpdir):
+    """OpenEXR output developed in bands of scanlines must match the
+    contents of the film, including the final partial band."""
+    from mitsuba.core import Bitmap, Struct
+    import numpy as np
+
+    np.random.seed(54321)
+    contents = np.random.uniform(size=(37, 23, 5))
+    contents[:, :, 4] = 1.0
+    film = create_film(contents, """
+            <integer name="band_height" value="{}"/>
+            <string name="pixel_format" value="rgba"/>""".format(band_height))
+
+    filename = str(tmpdir.join('test_image.exr'))
+    film.set_destination_file(filename)
+    film.develop()
+
+    other = Bitmap(filename)
+    assert ek.all(other.size() == film.size())
+    img = np.array(other.convert(Bitmap.PixelFormat.XYZAW, Struct.Type.Float32,
+                                 srgb_gamma=False), copy=False)
+    assert ek.allclose(img, contents, atol=1e-5)
+
+
+def test05_develop_async(variant_scalar_rgb, tmpdir):
+    """The film can be cleared and reused while an asynchronous develop of
+    its previous contents is still pending."""
+    from mitsuba.core import Bitmap, Struct
+    import numpy as np
+
+    contents = np.full((8, 16, 5), 0.25)
+    contents[:, :, 3:] = 1.0
+    film = create_film(contents, '<string name="pixel_format" value="rgb"/>')
+
+    filename = str(tmpdir.join('test_image'))
+    film.set_destination_file(filename)
+    handle = film.develop_async()
+
+    # Overwrite the film contents before waiting on the pending write
+    film.prepare(['X', 'Y', 'Z', 'A', 'W'])
+    handle.wait()
+    assert handle.done()
+
+    other = Bitmap(filename + '.exr')
+    assert ek.all(other.size() == film.size())
+    img = np.array(other.convert(Bitmap.PixelFormat.XYZ, Struct.Type.Float32,
+                                 srgb_gamma=False), copy=False)
+    assert ek.allclose(img, 0.25, atol=1e-5)
+
+
+def test06_denoise(variant_scalar_rgb, tmpdir):
+    """The denoiser must remove noise from flat regions, while preserving an
+    edge that is visible in the guide channel."""
+    from mitsuba.core import Bitmap
+    import numpy as np
+
+    np.random.seed(4321)
+    height, width = 24, 32
+    reference = np.full((height, width), 0.2)
+    reference[:, width // 2:] = 0.8
+    depth = np.where(reference < 0.5, 1.0, 5.0)
+
+    contents = np.zeros((height, width, 6))
+    contents[:, :, :3] = (reference * np.random.uniform(0.5, 1.5, size=(height, width)))[:, :, None]
+    contents[:, :, 3] = 1.0
+    contents[:, :, 4] = 1.0
+    contents[:, :, 5] = depth
+
+    film = create_film(contents, """
+            <string name="pixel_format" value="xyz"/>
+            <boolean name="denoise" value="true"/>
+            <string name="denoise_guides" value="dd"/>""", aovs=['dd'])
+
+    filename = str(tmpdir.join('test_image.exr'))
+    film.set_destination_file(filename)
+    film.develop()
+
+    # AOV output is written as (linear) RGB and the arbitrary output variables
+    other = Bitmap(filename)
+    img = np.array(other, copy=False)
+    channels = [other.struct_()[i].name for i in range(img.shape[2])]
+    green = img[:, :, channels.index('G')]
+    guide = img[:, :, channels.index('dd')]
+
+    # Conversion factor of gray XYZ values to the green channel
+    scale = -0.969256 + 1.875991 + 0.041556
+    noisy_error = np.abs(contents[:, :, 1] - reference).mean()
+    error = np.abs(green / scale - reference).mean()
+    assert error < 0.25 * noisy_error
+
+    # The guide must not be modified
+    assert np.allclose(guide, depth)
+
+    # Missing guide channels are reported
+    with pytest.raises(RuntimeError):
+        film.prepare(['X', 'Y', 'Z', 'A', 'W', 'nn.X', 'nn.Y', 'nn.Z'])
@@ -141,16 +141,14 @@ public:
                     si, sampler->next_2d(active_e), true, active_e);
                 active_e &= neq(ds.pdf, 0.f);
 
-                // Query the BSDF for that emitter-sampled direction
+                /* Query the BSDF for that emitter-sampled direction, and determine
+                   the probability of having sampled that same direction using
+                   BSDF sampling. */
                 Vector3f wo = si.to_local(ds.d);
 
-                Spectrum bsdf_val = bsdf->eval(ctx, si, wo, active_e);
+                auto [bsdf_val, bsdf_pdf] = bsdf->eval_pdf(ctx, si, wo, active_e);
                 bsdf_val = si.to_world_mueller(bsdf_val, -wo, si.wi);
 
-                /* Determine probability of having sampled that same
-                   direction using BSDF sampling. */
-                Float bsdf_pdf = bsdf->pdf(ctx, si, wo, active_e);
-
                 Float mis = select(ds.delta, Float(1.f), mis_weight(
                     ds.pdf * m_frac_lum, bsdf_pdf * m_frac_bsdf) * m_weight_lum);
                 result[active_e] += mis * bsdf_val * emitter_val;
@@ -0,0 +1,796 @@
+#include <atomic>
+#include <enoki/stl.h>
+#include <mitsuba/core/arena.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/ray.h>
+#include <mitsuba/core/statistics.h>
+#include <mitsuba/core/util.h>
+#include <mitsuba/core/warp.h>
+#include <mitsuba/render/bsdf.h>
+#include <mitsuba/render/emitter.h>
+#include <mitsuba/render/integrator.h>
+#include <mitsuba/render/records.h>
+#include <mitsuba/render/sensor.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**!
+
+.. _integrator-guided:
+
+Guided path tracer (:monosp:`guided`)
+-------------------------------------------
+
+.. pluginparameters::
+
+ * - max_depth
+   - |int|
+   - Specifies the longest path depth in the generated output image (where -1 corresponds to
+     :math:`\infty`). A value of 1 will only render directly visible light sources. 2 will lead
+     to single-bounce (direct-only) illumination, and so on. (Default: -1)
+ * - rr_depth
+   - |int|
+   - Specifies the minimum path depth, after which the implementation will start to use the
+     *russian roulette* path termination criterion. (Default: 5)
+ * - hide_emitters
+   - |bool|
+   - Hide directly visible emitters. (Default: no, i.e. |false|)
+ * - training_budget
+   - |float|
+   - Fraction of the sample budget of the sensor that is spent on training passes. The
+     remaining samples are used to render the final image. (Default: 0.5)
+ * - bsdf_sampling_fraction
+   - |float|
+   - Probability of sampling the BSDF instead of the learned distribution of incident
+     radiance at surfaces with a non-delta BSDF. (Default: 0.5)
+ * - spatial_threshold
+   - |int|
+   - Number of training samples that causes a spatial cell to be split. Scaled by the
+     square root of the sample count of the current training pass. (Default: 12000)
+ * - directional_threshold
+   - |float|
+   - Fraction of the energy of a directional distribution above which a quadtree
+     node is subdivided. (Default: 0.01)
+ * - max_memory
+   - |int|
+   - Memory limit of the guiding data structure in MiB. Once reached, the tree is no
+     longer refined. (Default: 1024)
+
+This plugin implements a path tracer that learns the distribution of incident
+radiance while it renders, and uses it to importance sample directions in
+addition to the BSDF (:cite:`Muller2017Practical`). This is helpful in scenes
+where most of the light arrives via indirect paths that BSDF sampling rarely
+finds (e.g. a room lit through a gap in a door).
+
+The distribution is stored in a *spatial-directional tree* (SD-tree): a binary
+tree over the bounding box of the scene, whose leaves hold a quadtree over the
+sphere of directions. Rendering proceeds in training passes with 1, 2, 4, ...
+samples per pixel. Each pass splats the radiance of its paths into the tree and
+uses the distribution learned by the previous one for sampling. Between passes,
+spatial cells that received many samples are split, and quadtree nodes holding
+a large share of the energy are subdivided. The images of training passes are
+discarded; the remaining samples of the budget are rendered with the final
+distribution.
+
+Directions are chosen by one-sample multiple importance sampling between the
+BSDF and the learned distribution, hence the estimator remains unbiased when the
+distribution is poor. Surfaces with a delta component (e.g. smooth glass) are
+only sampled using their BSDF.
+
+.. note:: This integrator does not handle participating media and is only
+   available in scalar non-polarized variants.
+
+ */
+
+/// Atomically add a value to a float (used to splat into the guiding trees concurrently)
+inline void atomic_add(std::atomic<float> &target, float value) {
+    float current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, current + value,
+                                         std::memory_order_relaxed))
+        ;
+}
+
+/**
+ * \brief Quadtree that stores a piecewise constant distribution over the
+ * sphere of directions
+ *
+ * Directions are parameterized using the equal-area mapping \ref
+ * warp::uniform_sphere_to_square(), hence densities on the unit square and on
+ * the sphere differ by a constant factor of \f$4\pi\f$. Values are splatted
+ * into the leaves using atomic operations, which is safe while the structure
+ * of the tree is left unchanged.
+ */
+class DirectionalTree {
+public:
+    struct Node {
+        std::atomic<float> sum[4];
+        /// Indices of the child nodes (0: the quadrant is a leaf)
+        uint32_t child[4];
+
+        Node() {
+            for (int i = 0; i < 4; ++i) {
+                sum[i].store(0.f, std::memory_order_relaxed);
+                child[i] = 0;
+            }
+        }
+
+        Node(const Node &node) { *this = node; }
+
+        Node &operator=(const Node &node) {
+            for (int i = 0; i < 4; ++i) {
+                sum[i].store(node.sum[i].load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+                child[i] = node.child[i];
+            }
+            return *this;
+        }
+
+        float total() const {
+            float result = 0.f;
+            for (int i = 0; i < 4; ++i)
+                result += sum[i].load(std::memory_order_relaxed);
+            return result;
+        }
+    };
+
+    DirectionalTree() : m_nodes(1), m_total(0.f) { }
+
+    /// Splat a value into the leaf that contains the point \c p
+    void record(Point<float, 2> p, float value) {
+        uint32_t index = 0;
+        while (true) {
+            Node &node = m_nodes[index];
+            uint32_t q = quadrant(p);
+            if (node.child[q] == 0) {
+                atomic_add(node.sum[q], value);
+                break;
+            }
+            index = node.child[q];
+        }
+    }
+
+    /// Propagate the values splatted into the leaves to all interior nodes
+    void update_sums() { m_total = update_sums(0); }
+
+    /**
+     * \brief Warp a uniform sample on the unit square according to the
+     * distribution, and return the warped point and its density
+     *
+     * Falls back to uniform sampling if no energy was recorded.
+     */
+    std::pair<Point<float, 2>, float> sample(Point<float, 2> u) const {
+        if (!(m_total > 0.f))
+            return { u, 1.f };
+
+        u = min(u, Point<float, 2>(math::OneMinusEpsilon<float>));
+        Point<float, 2> origin(0.f);
+        float size = 1.f, pdf = 1.f;
+        uint32_t index = 0;
+
+        while (true) {
+            const Node &node = m_nodes[index];
+            float s[4];
+            for (int i = 0; i < 4; ++i)
+                s[i] = node.sum[i].load(std::memory_order_relaxed);
+            float total = s[0] + s[1] + s[2] + s[3];
+
+            // Choose the lower or upper half, then the left or right quadrant
+            uint32_t q = 0;
+            float p_lower = (s[0] + s[1]) / total;
+            if (u.y() < p_lower) {
+                u.y() /= p_lower;
+            } else {
+                u.y() = (u.y() - p_lower) / (1.f - p_lower);
+                q |= 2;
+            }
+
+            float p_left = s[q] / (s[q] + s[q | 1]);
+            if (u.x() < p_left) {
+                u.x() /= p_left;
+            } else {
+                u.x() = (u.x() - p_left) / (1.f - p_left);
+                q |= 1;
+            }
+
+            pdf *= 4.f * s[q] / total;
+            size *= .5f;
+            origin += Point<float, 2>(float(q & 1), float(q >> 1)) * size;
+
+            if (node.child[q] == 0)
+                break;
+            index = node.child[q];
+        }
+
+        return { origin + u * size, pdf };
+    }
+
+    /// Evaluate the density of \ref sample() at the point \c p
+    float pdf(Point<float, 2> p) const {
+        if (!(m_total > 0.f))
+            return 1.f;
+
+        float pdf = 1.f;
+        uint32_t index = 0;
+        while (true) {
+            const Node &node = m_nodes[index];
+            uint32_t q = quadrant(p);
+            float total = node.total();
+            if (!(total > 0.f))
+                return 0.f;
+            pdf *= 4.f * node.sum[q].load(std::memory_order_relaxed) / total;
+            if (node.child[q] == 0)
+                return pdf;
+            index = node.child[q];
+        }
+    }
+
+    /**
+     * \brief Rebuild the tree with a new structure that adapts to the energy
+     * recorded in \c source, and clear all values
+     *
+     * Quadrants holding more than a fraction \c threshold of the total energy
+     * are subdivided (up to a depth of \c max_depth), while subtrees with
+     * little energy are collapsed. At most \c max_nodes nodes are created.
+     */
+    void refine(const DirectionalTree &source, float threshold,
+                uint32_t max_depth, size_t max_nodes) {
+        m_nodes.clear();
+        m_nodes.emplace_back();
+        m_total = 0.f;
+        refine(source, 0, source.m_total, 0, 1, threshold * source.m_total,
+               max_depth, std::max(max_nodes, (size_t) 1));
+    }
+
+    /// Return the total energy (valid after \ref update_sums())
+    float total() const { return m_total; }
+
+    /// Return the number of nodes of the tree
+    size_t node_count() const { return m_nodes.size(); }
+
+private:
+    static constexpr uint32_t Invalid = (uint32_t) -1;
+
+    /// Return the quadrant containing \c p, and map \c p into that quadrant
+    static uint32_t quadrant(Point<float, 2> &p) {
+        uint32_t q = 0;
+        for (int i = 0; i < 2; ++i) {
+            if (p[i] < .5f) {
+                p[i] *= 2.f;
+            } else {
+                p[i] = std::min(p[i] * 2.f - 1.f, math::OneMinusEpsilon<float>);
+                q |= 1u << i;
+            }
+        }
+        return q;
+    }
+
+    float update_sums(uint32_t index) {
+        Node &node = m_nodes[index];
+        for (int i = 0; i < 4; ++i) {
+            if (node.child[i] != 0)
+                node.sum[i].store(update_sums(node.child[i]),
+                                  std::memory_order_relaxed);
+        }
+        return node.total();
+    }
+
+    /* Create the children of node \c index. \c source_index refers to the
+       corresponding node of the source tree, or is \c Invalid if the source
+       tree has a leaf here, whose energy \c source_energy is then assumed to
+       be uniformly distributed. */
+    void refine(const DirectionalTree &source, uint32_t source_index,
+                float source_energy, uint32_t index, uint32_t depth,
+                float threshold, uint32_t max_depth, size_t max_nodes) {
+        for (int i = 0; i < 4; ++i) {
+            float energy = source_energy * .25f;
+            uint32_t source_child = Invalid;
+            if (source_index != Invalid) {
+                const Node &node = source.m_nodes[source_index];
+                energy = node.sum[i].load(std::memory_order_relaxed);
+                if (node.child[i] != 0)
+                    source_child = node.child[i];
+            }
+
+            if (depth >= max_depth || !(energy > threshold) ||
+                m_nodes.size() >= max_nodes)
+                continue;
+
+            uint32_t child = (uint32_t) m_nodes.size();
+            m_nodes.emplace_back();
+            m_nodes[index].child[i] = child;
+            refine(source, source_child, energy, child, depth + 1, threshold,
+                   max_depth, max_nodes);
+        }
+    }
+
+private:
+    std::vector<Node> m_nodes;
+    float m_total;
+};
+
+/**
+ * \brief Binary tree over the bounding box of the scene, whose leaves store a
+ * pair of directional distributions
+ *
+ * The \c sampling distribution was learned in the previous training pass and
+ * is only read while rendering, while the current pass splats into the \c
+ * building distribution. Nodes are split at their center, cycling through the
+ * axes of a cube that encloses the scene.
+ */
+class SpatialTree {
+public:
+    struct Leaf {
+        DirectionalTree sampling, building;
+        std::atomic<uint64_t> sample_count;
+
+        Leaf() : sample_count(0) { }
+        Leaf(const Leaf &leaf)
+            : sampling(leaf.sampling), building(leaf.building),
+              sample_count(leaf.sample_count.load(std::memory_order_relaxed)) { }
+    };
+
+    struct Node {
+        /// Index of the first of two children (0: the node is a leaf)
+        uint32_t child = 0;
+        /// Axis along which the node is split
+        uint32_t axis = 0;
+        /// Index of the leaf data
+        uint32_t leaf = 0;
+    };
+
+    using ScalarPoint3f       = Point<float, 3>;
+    using ScalarBoundingBox3f = BoundingBox<ScalarPoint3f>;
+
+    SpatialTree() { reset(ScalarBoundingBox3f(ScalarPoint3f(0.f))); }
+
+    /// Discard all data and cover the given bounding box with a single leaf
+    void reset(const ScalarBoundingBox3f &bbox) {
+        m_nodes.assign(1, Node());
+        m_leaves.assign(1, Leaf());
+
+        // Enlarge the box into a cube, so that alternating splits produce cubes
+        m_origin = bbox.valid() ? bbox.min : ScalarPoint3f(0.f);
+        m_size = bbox.valid() ? hmax(bbox.extents()) : 0.f;
+        m_size = (m_size > 0.f ? m_size : 1.f) * (1.f + math::RayEpsilon<float>);
+    }
+
+    /// Return the leaf that contains the point \c p
+    Leaf &lookup(ScalarPoint3f p) {
+        p = clamp((p - m_origin) / m_size, 0.f, math::OneMinusEpsilon<float>);
+        uint32_t index = 0;
+        while (true) {
+            const Node &node = m_nodes[index];
+            if (node.child == 0)
+                return m_leaves[node.leaf];
+            float &x = p[node.axis];
+            if (x < .5f) {
+                x *= 2.f;
+                index = node.child;
+            } else {
+                x = std::min(x * 2.f - 1.f, math::OneMinusEpsilon<float>);
+                index = node.child + 1;
+            }
+        }
+    }
+
+    /**
+     * \brief Split all leaves that received more than \c threshold samples
+     *
+     * The children start out with a copy of the distributions and half the
+     * sample count of their parent, and are split further if necessary. No
+     * splits are performed once the memory usage reaches \c max_memory bytes.
+     */
+    void subdivide(uint64_t threshold, size_t max_memory) {
+        // Appending to 'm_nodes' while iterating over it also visits the new children
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            if (m_nodes[i].child != 0)
+                continue;
+
+            Leaf &leaf = m_leaves[m_nodes[i].leaf];
+            uint64_t count = leaf.sample_count.load(std::memory_order_relaxed);
+            if (count <= threshold || memory_usage() +
+                    leaf_memory(leaf) + 2 * sizeof(Node) > max_memory)
+                continue;
+
+            leaf.sample_count.store(count / 2, std::memory_order_relaxed);
+            m_leaves.push_back(m_leaves[m_nodes[i].leaf]);
+
+            uint32_t axis = (m_nodes[i].axis + 1) % 3;
+            Node lower, upper;
+            lower.axis = upper.axis = axis;
+            lower.leaf = m_nodes[i].leaf;
+            upper.leaf = (uint32_t) m_leaves.size() - 1;
+
+            m_nodes[i].child = (uint32_t) m_nodes.size();
+            m_nodes.push_back(lower);
+            m_nodes.push_back(upper);
+        }
+    }
+
+    /// Return the memory used by the tree (in bytes)
+    size_t memory_usage() const {
+        size_t result = m_nodes.size() * sizeof(Node);
+        for (const Leaf &leaf : m_leaves)
+            result += leaf_memory(leaf);
+        return result;
+    }
+
+    std::vector<Leaf> &leaves() { return m_leaves; }
+    size_t node_count() const { return m_nodes.size(); }
+
+private:
+    static size_t leaf_memory(const Leaf &leaf) {
+        return sizeof(Leaf) + (leaf.sampling.node_count() + leaf.building.node_count()) *
+                                  sizeof(DirectionalTree::Node);
+    }
+
+private:
+    std::vector<Node> m_nodes;
+    std::vector<Leaf> m_leaves;
+    ScalarPoint3f m_origin;
+    float m_size;
+};
+
+template <typename Float, typename Spectrum>
+class GuidedPathIntegrator : public MonteCarloIntegrator<Float, Spectrum> {
+public:
+    MTS_IMPORT_BASE(MonteCarloIntegrator, m_max_depth, m_rr_depth, m_samples_per_pass)
+    MTS_IMPORT_TYPES(Scene, Sensor, Sampler, ImageBlock, Medium, Emitter,
+                     EmitterPtr, BSDF, BSDFPtr)
+
+    /// The SD-tree is a scalar data structure, which is updated from a single path at a time
+    static constexpr bool Supported = !is_array_v<Float> && !is_polarized_v<Spectrum>;
+
+    /// Maximum depth of the directional quadtrees
+    static constexpr uint32_t MaxDirectionalDepth = 20;
+
+    GuidedPathIntegrator(const Properties &props) : Base(props) {
+        if constexpr (!Supported)
+            Throw("The guided path tracer is only available in scalar "
+                  "non-polarized variants!");
+
+        m_training_budget = props.float_("training_budget", .5f);
+        if (!(m_training_budget >= 0.f && m_training_budget < 1.f))
+            Throw("\"training_budget\" must be in the range [0, 1)!");
+
+        m_bsdf_sampling_fraction = props.float_("bsdf_sampling_fraction", .5f);
+        if (!(m_bsdf_sampling_fraction > 0.f && m_bsdf_sampling_fraction < 1.f))
+            Throw("\"bsdf_sampling_fraction\" must be in the range (0, 1)!");
+
+        m_spatial_threshold = props.size_("spatial_threshold", 12000);
+        m_directional_threshold = props.float_("directional_threshold", .01f);
+        m_max_memory = props.size_("max_memory", 1024) * 1024 * 1024;
+
+        // Every pass covers the image in one sweep, see render_block()
+        m_samples_per_pass = (uint32_t) -1;
+    }
+
+    bool render(Scene *scene, Sensor *sensor) override {
+        size_t total_spp = sensor->sampler()->sample_count(),
+               training_spp = (size_t) (total_spp * m_training_budget),
+               spp_done = 0;
+
+        m_tree.reset(scene->bbox());
+        m_iteration = 0;
+
+        // Training passes with an exponentially increasing sample count
+        for (size_t spp = 1; spp_done + spp <= training_spp; spp *= 2) {
+            Log(Info, "Guiding: training pass %i (%i sample%s per pixel)",
+                m_iteration + 1, spp, spp == 1 ? "" : "s");
+            m_training = true;
+            m_pass_spp = spp;
+            if (!Base::render(scene, sensor))
+                return false;
+            spp_done += spp;
+            refine();
+        }
+
+        m_training = false;
+        m_pass_spp = total_spp - spp_done;
+        Log(Info, "Guiding: final pass (%i sample%s per pixel)", m_pass_spp,
+            m_pass_spp == 1 ? "" : "s");
+        return Base::render(scene, sensor);
+    }
+
+    std::pair<Spectrum, Mask> sample(const Scene *scene,
+                                     Sampler *sampler,
+                                     const RayDifferential3f &ray_,
+                                     const Medium * /* medium */,
+                                     Float * /* aovs */,
+                                     Mask active) const override {
+        MTS_MASKED_FUNCTION(ProfilerPhase::SamplingIntegratorSample, active);
+
+        if constexpr (Supported) {
+            RayDifferential3f ray = ray_;
+
+            // Tracks radiance scaling due to index of refraction changes
+            Float eta(1.f);
+
+            // MIS weight for intersected emitters (set by prev. iteration)
+            Float emission_weight(1.f);
+
+            Spectrum throughput(1.f), result(0.f);
+
+            /* Vertices whose incident radiance is recorded during training.
+               They are stored in the thread's arena and released with the sample */
+            ScopedMemoryArena scratch;
+            size_t vertex_count = 0, vertex_capacity = 16;
+            Vertex *vertices = m_training ? scratch.arena().allocate<Vertex>(vertex_capacity)
+                                          : nullptr;
+            bool guiding = m_iteration > 0;
+
+            // ---------------------- First intersection ----------------------
+
+            statistics_count(StatisticsCounter::PathsTraced, active);
+
+            SurfaceInteraction3f si = scene->ray_intersect(ray, active);
+            Mask valid_ray = si.is_valid();
+            EmitterPtr emitter = si.emitter(scene);
+
+            int depth = 1;
+            for (;; ++depth) {
+
+                // ---------------- Intersection with emitters ----------------
+
+                if (emitter && active) {
+                    Spectrum contrib = emission_weight * throughput * emitter->eval(si);
+                    result += contrib;
+                    add_radiance(vertices, vertex_count, contrib);
+                }
+
+                active &= si.is_valid();
+
+                // Russian roulette (see the path tracer)
+                if (depth > m_rr_depth) {
+                    Float q = min(hmax(throughput) * sqr(eta), .95f);
+                    active &= sampler->next_1d(active) < q;
+                    throughput *= rcp(q);
+                }
+
+                if ((uint32_t) depth >= (uint32_t) m_max_depth || !active)
+                    break;
+
+                BSDFContext ctx;
+                BSDFPtr bsdf = si.bsdf(ray);
+                SpatialTree::Leaf *leaf = &m_tree.lookup(si.p);
+
+                // Delta components can't be combined with the learned distribution
+                bool guided = guiding && !has_flag(bsdf->flags(), BSDFFlags::Delta);
+
+                // --------------------- Emitter sampling ---------------------
+
+                if (likely(has_flag(bsdf->flags(), BSDFFlags::Smooth))) {
+                    auto [ds, emitter_val] = scene->sample_emitter_direction(
+                        si, sampler->next_2d(active), true, active);
+
+                    if (ds.pdf != 0.f) {
+                        /* Query the BSDF for that emitter-sampled direction, and
+                           determine the density of sampling that same direction
+                           using BSDF and guided sampling */
+                        Vector3f wo = si.to_local(ds.d);
+                        auto [bsdf_val, bsdf_pdf] = bsdf->eval_pdf(ctx, si, wo, active);
+                        if (guided)
+                            bsdf_pdf = mix_pdf(bsdf_pdf, guide_pdf(leaf, ds.d));
+
+                        Float mis = select(ds.delta, 1.f, mis_weight(ds.pdf, bsdf_pdf));
+                        Spectrum contrib = mis * throughput * bsdf_val * emitter_val;
+                        result += contrib;
+                        add_radiance(vertices, vertex_count, contrib);
+
+                        // Splat the incident radiance of the emitter sample as well
+                        if (m_training && !ds.delta)
+                            record(leaf, ds.d, hmean(mis * emitter_val));
+                    }
+                }
+
+                // ------------------ BSDF and guided sampling -----------------
+
+                BSDFSample3f bs;
+                Spectrum bsdf_val;
+                Vector3f wo_world;
+
+                if (!guided) {
+                    std::tie(bs, bsdf_val) = bsdf->sample(ctx, si, sampler->next_1d(active),
+                                                          sampler->next_2d(active), active);
+                    wo_world = si.to_world(bs.wo);
+                } else {
+                    /* One-sample MIS: choose between the BSDF and the learned
+                       distribution, and weight by the mixture density */
+                    Float u = sampler->next_1d(active);
+                    Point2f sample_2 = sampler->next_2d(active);
+                    Spectrum value;
+
+                    if (u < m_bsdf_sampling_fraction) {
+                        std::tie(bs, bsdf_val) = bsdf->sample(
+                            ctx, si, u / m_bsdf_sampling_fraction, sample_2, active);
+                        value = bsdf_val * bs.pdf;
+                        wo_world = si.to_world(bs.wo);
+                    } else {
+                        auto [p, pdf] = leaf->sampling.sample(sample_2);
+                        ENOKI_MARK_USED(pdf);
+                        wo_world = warp::square_to_uniform_sphere(Point2f(p));
+                        bs = BSDFSample3f(si.to_local(wo_world));
+                        std::tie(value, bs.pdf) = bsdf->eval_pdf(ctx, si, bs.wo, active);
+                    }
+
+                    Float pdf = mix_pdf(bs.pdf, guide_pdf(leaf, wo_world));
+                    bsdf_val = pdf > 0.f ? value / pdf : Spectrum(0.f);
+                    bs.pdf = pdf;
+                }
+
+                throughput = throughput * bsdf_val;
+                active &= any(neq(throughput, 0.f)) && bs.pdf > 0.f;
+                if (!active)
+                    break;
+
+                eta *= bs.eta;
+
+                if (m_training && !has_flag(bs.sampled_type, BSDFFlags::Delta)) {
+                    if (vertex_count == vertex_capacity) {
+                        vertex_capacity *= 2;
+                        Vertex *storage = scratch.arena().allocate<Vertex>(vertex_capacity);
+                        std::copy(vertices, vertices + vertex_count, storage);
+                        vertices = storage;
+                    }
+                    vertices[vertex_count++] = { leaf, wo_world, throughput,
+                                                 Spectrum(0.f), bs.pdf };
+                }
+
+                // Intersect the BSDF ray against the scene geometry
+                ray = si.spawn_ray(wo_world);
+                SurfaceInteraction3f si_bsdf = scene->ray_intersect(ray, active);
+
+                /* Determine probability of having sampled that same
+                   direction using emitter sampling. */
+                emitter = si_bsdf.emitter(scene, active);
+                DirectionSample3f ds(si_bsdf, si);
+                ds.object = emitter;
+
+                if (emitter) {
+                    Float emitter_pdf =
+                        !has_flag(bs.sampled_type, BSDFFlags::Delta)
+                            ? scene->pdf_emitter_direction(si, ds) : 0.f;
+                    emission_weight = mis_weight(bs.pdf, emitter_pdf);
+                }
+
+                si = std::move(si_bsdf);
+            }
+
+            for (size_t i = 0; i < vertex_count; ++i) {
+                const Vertex &v = vertices[i];
+                record(v.leaf, v.direction, hmean(v.radiance) / v.pdf);
+            }
+
+            statistics_record(StatisticsHistogram::PathLength, valid_ray ? depth : 0);
+
+            return { result, valid_ray };
+        } else {
+            ENOKI_MARK_USED(scene);
+            ENOKI_MARK_USED(sampler);
+            ENOKI_MARK_USED(ray_);
+            NotImplementedError("sample");
+        }
+    }
+
+    //! @}
+    // =============================================================
+
+    std::string to_string() const override {
+        return tfm::format("GuidedPathIntegrator[\n"
+            "  max_depth = %i,\n"
+            "  rr_depth = %i,\n"
+            "  training_budget = %f,\n"
+            "  bsdf_sampling_fraction = %f,\n"
+            "  spatial_threshold = %i,\n"
+            "  directional_threshold = %f,\n"
+            "  max_memory = %s\n"
+            "]", m_max_depth, m_rr_depth, m_training_budget,
+            m_bsdf_sampling_fraction, m_spatial_threshold,
+            m_directional_threshold, util::mem_string(m_max_memory));
+    }
+
+    MTS_DECLARE_CLASS()
+protected:
+    /// Path vertex whose incident radiance along the sampled direction is splatted
+    struct Vertex {
+        SpatialTree::Leaf *leaf;
+        Vector3f direction;
+        /// Path throughput, including the sampling weight of \c direction
+        Spectrum throughput;
+        /// Radiance arriving from \c direction
+        Spectrum radiance;
+        Float pdf;
+    };
+
+    void render_block(const Scene *scene, const Sensor *sensor, Sampler *sampler,
+                      ImageBlock *block, Float *aovs,
+                      size_t /* sample_count */) const override {
+        /* The base class seeds the sampler by the block index, which would
+           repeat the same samples in every pass */
+        ScalarPoint2i offset = block->offset();
+        sampler->seed(((uint64_t) m_iteration << 48) ^
+                      ((uint64_t) offset.y() << 24) ^ (uint64_t) offset.x());
+        Base::render_block(scene, sensor, sampler, block, aovs, m_pass_spp);
+    }
+
+    /// Build the distributions used by the next pass from the data of the last one
+    void refine() {
+        auto &leaves = m_tree.leaves();
+        for (auto &leaf : leaves)
+            leaf.building.update_sums();
+
+        // Sample count of the last pass, see Müller et al. (2017), Section 3.4
+        m_tree.subdivide((uint64_t) (m_spatial_threshold *
+                                     std::sqrt((double) m_pass_spp)),
+                         m_max_memory);
+
+        size_t max_nodes = m_max_memory / (2 * leaves.size() *
+                                           sizeof(DirectionalTree::Node));
+        for (auto &leaf : leaves) {
+            leaf.sampling = leaf.building;
+            leaf.building.refine(leaf.sampling, m_directional_threshold,
+                                 MaxDirectionalDepth, max_nodes);
+            leaf.sample_count.store(0, std::memory_order_relaxed);
+        }
+
+        m_iteration++;
+
+        size_t memory = m_tree.memory_usage();
+        Log(Info, "Guiding: SD-tree has %i spatial nodes, %i leaves (%s)",
+            m_tree.node_count(), leaves.size(), util::mem_string(memory));
+        if (memory >= m_max_memory)
+            Log(Warn, "Guiding: the SD-tree reached the memory limit of %s, "
+                "it will no longer be refined.", util::mem_string(m_max_memory));
+    }
+
+    /// Splat a radiance estimate (divided by the sampling density) into a leaf
+    void record(SpatialTree::Leaf *leaf, const Vector3f &d, Float value) const {
+        if (!(value > 0.f) || !std::isfinite(value))
+            return;
+        leaf->building.record(Point<float, 2>(warp::uniform_sphere_to_square(d)),
+                              (float) value);
+        leaf->sample_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Add a path contribution to the incident radiance of all recorded vertices
+    void add_radiance(Vertex *vertices, size_t count, const Spectrum &contrib) const {
+        for (size_t i = 0; i < count; ++i)
+            vertices[i].radiance += select(vertices[i].throughput > 0.f,
+                                           contrib / vertices[i].throughput, Spectrum(0.f));
+    }
+
+    /// Density of sampling the world-space direction \c d using the learned distribution
+    Float guide_pdf(const SpatialTree::Leaf *leaf, const Vector3f &d) const {
+        return leaf->sampling.pdf(Point<float, 2>(warp::uniform_sphere_to_square(d))) *
+               math::InvFourPi<Float>;
+    }
+
+    Float mix_pdf(Float bsdf_pdf, Float guide_pdf) const {
+        return m_bsdf_sampling_fraction * bsdf_pdf +
+               (1.f - m_bsdf_sampling_fraction) * guide_pdf;
+    }
+
+    Float mis_weight(Float pdf_a, Float pdf_b) const {
+        pdf_a *= pdf_a;
+        pdf_b *= pdf_b;
+        return select(pdf_a > 0.f, pdf_a / (pdf_a + pdf_b), 0.f);
+    }
+
+protected:
+    ScalarFloat m_training_budget;
+    ScalarFloat m_bsdf_sampling_fraction;
+    size_t m_spatial_threshold;
+    float m_directional_threshold;
+    size_t m_max_memory;
+
+    /* The tree is only restructured between passes; during a pass, it is
+       updated concurrently by the render threads using atomic operations */
+    mutable SpatialTree m_tree;
+    uint32_t m_iteration = 0;
+    bool m_training = false;
+    size_t m_pass_spp = 0;
+};
+
+MTS_IMPLEMENT_CLASS_VARIANT(GuidedPathIntegrator, MonteCarloIntegrator)
+MTS_EXPORT_PLUGIN(GuidedPathIntegrator, "Guided path tracer integrator");
+NAMESPACE_END(mitsuba)
@@ -2,6 +2,7 @@
 #include <enoki/stl.h>
 #include <mitsuba/core/ray.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/statistics.h>
 #include <mitsuba/render/bsdf.h>
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/render/integrator.h>
@@ -117,11 +118,14 @@ public:
 
         // ---------------------- First intersection ----------------------
 
+        statistics_count(StatisticsCounter::PathsTraced, active);
+
         SurfaceInteraction3f si = scene->ray_intersect(ray, active);
         Mask valid_ray = si.is_valid();
         EmitterPtr emitter = si.emitter(scene);
 
-        for (int depth = 1;; ++depth) {
+        int depth = 1;
+        for (;; ++depth) {
 
             // ---------------- Intersection with emitters ----------------
 
@@ -159,14 +163,12 @@ public:
                     si, sampler->next_2d(active_e), true, active_e);
                 active_e &= neq(ds.pdf, 0.f);
 
-                // Query the BSDF for that emitter-sampled direction
+                /* Query the BSDF for that emitter-sampled direction, and determine
+                   the density of sampling that same direction using BSDF sampling */
                 Vector3f wo = si.to_local(ds.d);
-                Spectrum bsdf_val = bsdf->eval(ctx, si, wo, active_e);
+                auto [bsdf_val, bsdf_pdf] = bsdf->eval_pdf(ctx, si, wo, active_e);
                 bsdf_val = si.to_world_mueller(bsdf_val, -wo, si.wi);
 
-                // Determine density of sampling that same direction using BSDF sampling
-                Float bsdf_pdf = bsdf->pdf(ctx, si, wo, active_e);
-
                 Float mis = select(ds.delta, 1.f, mis_weight(ds.pdf, bsdf_pdf));
                 result[active_e] += mis * throughput * bsdf_val * emitter_val;
             }
@@ -207,6 +209,10 @@ public:
             si = std::move(si_bsdf);
         }
 
+        // The lanes of a packet generally terminate at different depths
+        if constexpr (!is_array_v<Float>)
+            statistics_record(StatisticsHistogram::PathLength, valid_ray ? depth : 0);
+
         return { result, valid_ray };
     }
 
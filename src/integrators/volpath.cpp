@@ -2,6 +2,7 @@
 #include <enoki/stl.h>
 #include <mitsuba/core/ray.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/statistics.h>
 #include <mitsuba/render/bsdf.h>
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/render/integrator.h>
@@ -58,6 +59,7 @@ public:
         MediumInteraction3f mi = zero<MediumInteraction3f>();
         mi.t = math::Infinity<Float>;
         Mask specular_chain = active && !m_hide_emitters;
+        statistics_count(StatisticsCounter::PathsTraced, active);
         UInt32 depth = 0;
 
         UInt32 channel = 0;
@@ -124,6 +126,8 @@ public:
 
                 act_null_scatter |= null_scatter && active_medium;
                 act_medium_scatter |= !act_null_scatter && active_medium;
+                statistics_count(StatisticsCounter::MediumNullCollisions, act_null_scatter);
+                statistics_count(StatisticsCounter::MediumRealCollisions, act_medium_scatter);
 
                 if (any_or<true>(is_spectral && act_null_scatter))
                     masked(throughput, is_spectral && act_null_scatter) *=
@@ -200,14 +204,11 @@ public:
                 if (likely(any_or<true>(active_e))) {
                     auto [emitted, ds] = sample_emitter(si, false, scene, sampler, medium, channel, active_e);
 
-                    // Query the BSDF for that emitter-sampled direction
-                    Vector3f wo       = si.to_local(ds.d);
-                    Spectrum bsdf_val = bsdf->eval(ctx, si, wo, active_e);
+                    // Query the BSDF for that emitter-sampled direction, and determine
+                    // probability of having sampled that same direction using BSDF sampling.
+                    Vector3f wo = si.to_local(ds.d);
+                    auto [bsdf_val, bsdf_pdf] = bsdf->eval_pdf(ctx, si, wo, active_e);
                     bsdf_val = si.to_world_mueller(bsdf_val, -wo, si.wi);
-
-                    // Determine probability of having sampled that same
-                    // direction using BSDF sampling.
-                    Float bsdf_pdf = bsdf->pdf(ctx, si, wo, active_e);
                     result[active_e] += throughput * bsdf_val * mis_weight(ds.pdf, select(ds.delta, 0.f, bsdf_pdf)) * emitted;
                 }
 
@@ -253,6 +254,11 @@ public:
             }
             active &= (active_surface | active_medium);
         }
+
+        // The lanes of a packet generally terminate at different depths
+        if constexpr (!is_array_v<Float>)
+            statistics_record(StatisticsHistogram::PathLength, depth);
+
         return { result, valid_ray };
     }
 
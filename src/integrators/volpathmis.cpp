@@ -2,6 +2,7 @@
 #include <enoki/stl.h>
 #include <mitsuba/core/ray.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/statistics.h>
 #include <mitsuba/render/bsdf.h>
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/render/integrator.h>
@@ -111,6 +112,7 @@ public:
         mi.t = math::Infinity<Float>;
 
         Mask specular_chain = active && !m_hide_emitters;
+        statistics_count(StatisticsCounter::PathsTraced, active);
         UInt32 depth = 0;
         WeightMatrix p_over_f = full<WeightMatrix>(1.f);
         WeightMatrix p_over_f_nee = full<WeightMatrix>(1.f);
@@ -186,6 +188,8 @@ public:
                 Mask null_scatter = sampler->next_1d(active_medium) >= index_spectrum(mi.sigma_t, channel) / index_spectrum(mi.combined_extinction, channel);
                 act_null_scatter |= null_scatter && active_medium;
                 act_medium_scatter |= !act_null_scatter && active_medium;
+                statistics_count(StatisticsCounter::MediumNullCollisions, act_null_scatter);
+                statistics_count(StatisticsCounter::MediumRealCollisions, act_medium_scatter);
 
                 // Count this as a bounce
                 masked(depth, act_medium_scatter) += 1;
@@ -287,8 +291,7 @@ public:
                 if (likely(any_or<true>(active_e))) {
                     auto [p_over_f_nee_end, p_over_f_end, emitted, ds] = sample_emitter(si, false, scene, sampler, medium, p_over_f, channel, active_e);
                     Vector3f wo_local       = si.to_local(ds.d);
-                    Spectrum bsdf_val = bsdf->eval(ctx, si, wo_local, active_e);
-                    Float bsdf_pdf =  bsdf->pdf(ctx, si, wo_local, active_e);
+                    auto [bsdf_val, bsdf_pdf] = bsdf->eval_pdf(ctx, si, wo_local, active_e);
                     update_weights(p_over_f_nee_end, 1.0f, depolarize(bsdf_val), channel, active_e);
                     update_weights(p_over_f_end, select(ds.delta, 0.f, bsdf_pdf), depolarize(bsdf_val), channel, active_e);
                     masked(result, active_e) += mis_weight(p_over_f_nee_end, p_over_f_end) * emitted;
@@ -323,6 +326,10 @@ public:
             active &= (active_surface | active_medium);
         }
 
+        // The lanes of a packet generally terminate at different depths
+        if constexpr (!is_array_v<Float>)
+            statistics_record(StatisticsHistogram::PathLength, depth);
+
         return { result, valid_ray };
     }
 
@@ -0,0 +1,113 @@
+#include <mitsuba/core/arena.h>
+#include <mitsuba/core/tls.h>
+#include <algorithm>
+#include <atomic>
+
+NAMESPACE_BEGIN(mitsuba)
+
+static ThreadLocal<MemoryArena> *__thread_arena = nullptr;
+
+/* ThreadLocal::get() takes a spin lock, which is too costly for callers that
+   look up their arena in inner loops (e.g. once per sample). The result is
+   therefore cached, and the cache is invalidated by incrementing the
+   generation whenever the per-thread arenas are (re)created or released */
+static std::atomic<uint32_t> __thread_arena_generation { 0 };
+static thread_local MemoryArena *__thread_arena_cache = nullptr;
+static thread_local uint32_t __thread_arena_cache_generation = (uint32_t) -1;
+
+MemoryArena::MemoryArena(size_t chunk_size) : m_chunk_size(chunk_size) { }
+
+MemoryArena::~MemoryArena() {
+    for (Chunk &chunk : m_chunks)
+        delete[] chunk.data;
+}
+
+void *MemoryArena::allocate_slow(size_t size, size_t alignment) {
+    // Try the chunks following the current one, which are retained by rewind()
+    for (size_t i = m_head ? m_chunk + 1 : 0; i < m_chunks.size(); ++i) {
+        const Chunk &chunk = m_chunks[i];
+        uint8_t *ptr = (uint8_t *) (((uintptr_t) chunk.data + alignment - 1) &
+                                    ~(uintptr_t) (alignment - 1));
+        m_chunk = i;
+        m_head = chunk.data;
+        m_end = chunk.data + chunk.size;
+        if (ptr + size <= m_end) {
+            m_head = ptr + size;
+            return ptr;
+        }
+    }
+
+    size_t chunk_size = std::max(m_chunk_size, size + alignment);
+    Chunk chunk { new uint8_t[chunk_size], chunk_size };
+    m_chunks.push_back(chunk);
+    m_heap_allocation_count++;
+    statistics_add(StatisticsCounter::ScratchHeapAllocations);
+
+    uint8_t *ptr = (uint8_t *) (((uintptr_t) chunk.data + alignment - 1) &
+                                ~(uintptr_t) (alignment - 1));
+    m_chunk = m_chunks.size() - 1;
+    m_head = ptr + size;
+    m_end = chunk.data + chunk.size;
+    return ptr;
+}
+
+void MemoryArena::rewind(const Marker &marker) {
+    m_chunk = marker.chunk;
+    m_head = marker.head;
+    m_end = m_head ? m_chunks[m_chunk].data + m_chunks[m_chunk].size : nullptr;
+}
+
+void MemoryArena::reset() {
+    if (m_chunks.size() > 1) {
+        // Merge the chunks, so that the next block can be served by a single one
+        size_t size = capacity();
+        for (Chunk &chunk : m_chunks)
+            delete[] chunk.data;
+        m_chunks.clear();
+        m_chunks.push_back({ new uint8_t[size], size });
+        m_heap_allocation_count++;
+        statistics_add(StatisticsCounter::ScratchHeapAllocations);
+    }
+
+    m_chunk = 0;
+    m_head = m_chunks.empty() ? nullptr : m_chunks[0].data;
+    m_end = m_chunks.empty() ? nullptr : m_chunks[0].data + m_chunks[0].size;
+}
+
+size_t MemoryArena::used() const {
+    if (!m_head)
+        return 0;
+    size_t result = 0;
+    for (size_t i = 0; i < m_chunk; ++i)
+        result += m_chunks[i].size;
+    return result + (size_t) (m_head - m_chunks[m_chunk].data);
+}
+
+size_t MemoryArena::capacity() const {
+    size_t result = 0;
+    for (const Chunk &chunk : m_chunks)
+        result += chunk.size;
+    return result;
+}
+
+MemoryArena &MemoryArena::thread() {
+    uint32_t generation = __thread_arena_generation.load(std::memory_order_acquire);
+    if (unlikely(__thread_arena_cache_generation != generation)) {
+        __thread_arena_cache = &((MemoryArena &) *__thread_arena);
+        __thread_arena_cache_generation = generation;
+    }
+    return *__thread_arena_cache;
+}
+
+void MemoryArena::static_initialization() {
+    __thread_arena = new ThreadLocal<MemoryArena>();
+    __thread_arena_generation++;
+}
+
+void MemoryArena::static_shutdown() {
+    __thread_arena_generation++;
+    delete __thread_arena;
+    __thread_arena = nullptr;
+}
+
+NAMESPACE_END(mitsuba)
@@ -228,6 +228,9 @@ void Bitmap::vflip() {
     }
 }
 
+/// Number of entries per row processed by a task in the vertical resampling pass
+#define MTS_RESAMPLE_BLOCK_SIZE 1024
+
 template <typename Scalar, bool Filter,
           typename ReconstructionFilter = typename Bitmap::ReconstructionFilter>
 static void
@@ -296,16 +299,16 @@ resample(Bitmap *target, const Bitmap *source,
         r.set_boundary_condition(bc.second);
         r.set_clamp(clamp);
 
+        /* Process blocks of adjacent columns (and channels) at once, so that
+           the inner loop reads contiguous memory and runs on SIMD packets */
+        size_t row_size = (size_t) target->width() * channels;
+
         tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, source->width(), 100),
+            tbb::blocked_range<size_t>(0, row_size, MTS_RESAMPLE_BLOCK_SIZE),
             [&](const tbb::blocked_range<size_t> &range) {
-                for (auto x = range.begin(); x != range.end(); ++x) {
-                    const Scalar *s = (const Scalar *) source->uint8_data() +
-                                      x * channels;
-                    Scalar *t       = (Scalar *) target->uint8_data() +
-                                      x * channels;
-                    r.resample(s, source->width(), t, target->width(), (uint32_t) channels);
-                }
+                const Scalar *s = (const Scalar *) source->uint8_data() + range.begin();
+                Scalar *t       = (Scalar *) target->uint8_data() + range.begin();
+                r.resample_batch(s, row_size, t, row_size, range.size());
             }
         );
     }
@@ -806,26 +809,14 @@ void Bitmap::write(Stream *stream, FileFormat format, int quality) const {
     }
 }
 
-void Bitmap::write_async(const fs::path &path_, FileFormat format_, int quality_) const {
-    class WriteTask : public tbb::task {
-        ref<const Bitmap> bitmap;
-        fs::path path;
-        FileFormat format;
-        int quality;
-
-    public:
-        WriteTask(const Bitmap *bitmap, fs::path path, FileFormat format, int quality)
-            : bitmap(bitmap), path(path), format(format), quality(quality) { }
-
-        tbb::task* execute() override {
-            bitmap->write(path, format, quality);
-            return nullptr;
-        }
-    };
-
-    WriteTask *t = new (tbb::task::allocate_root())
-        WriteTask(this, path_, format_, quality_);
-    tbb::task::enqueue(*t);
+ref<WriteHandle> Bitmap::write_async(const fs::path &path, FileFormat format,
+                                     int quality) const {
+    ref<const Bitmap> bitmap(this);
+    return WriteQueue::instance()->enqueue(path.string(), [bitmap, path, format, quality]() {
+        ref<FileStream> fs = new FileStream(path, FileStream::ETruncReadWrite);
+        bitmap->write(fs, format, quality);
+        return fs->size();
+    });
 }
 
 bool Bitmap::operator==(const Bitmap &bitmap) const {
@@ -1279,6 +1270,30 @@ void Bitmap::read_openexr(Stream *stream) {
 }
 
 void Bitmap::write_openexr(Stream *stream, int quality) const {
+    write_openexr(stream, m_size.y(), { }, quality);
+}
+
+void Bitmap::write_openexr_bands(const fs::path &path, uint32_t height,
+                                 const std::function<void(uint32_t, uint32_t)> &fill,
+                                 int quality) {
+    ref<FileStream> fs = new FileStream(path, FileStream::ETruncReadWrite);
+    write_openexr_bands(fs, height, fill, quality);
+}
+
+void Bitmap::write_openexr_bands(Stream *stream, uint32_t height,
+                                 const std::function<void(uint32_t, uint32_t)> &fill,
+                                 int quality) {
+    if (!fill)
+        Throw("Bitmap::write_openexr_bands(): a fill callback is required!");
+    write_openexr(stream, height, fill, quality);
+}
+
+void Bitmap::write_openexr(Stream *stream, uint32_t height,
+                           const std::function<void(uint32_t, uint32_t)> &fill,
+                           int quality) const {
+    if (m_size.y() == 0 && height > 0)
+        Throw("Bitmap::write_openexr(): the staging bitmap has no scanlines!");
+
     if (Imf::globalThreadCount() == 0)
         Imf::setGlobalThreadCount(std::min(8, util::core_count()));
 
@@ -1292,7 +1307,7 @@ void Bitmap::write_openexr(Stream *stream, int quality) const {
 
     Imf::Header header(
         (int) m_size.x(),  // width
-        (int) m_size.y(),  // height,
+        (int) height,      // height,
         1.f,               // pixelAspectRatio
         Imath::V2f(0, 0),  // screenWindowCenter,
         1.f,               // screenWindowWidth
@@ -1367,8 +1382,7 @@ void Bitmap::write_openexr(Stream *stream, int quality) const {
            row_stride = pixel_stride * m_size.x();
 
     Imf::ChannelList &channels = header.channels();
-    Imf::FrameBuffer framebuffer;
-    const uint8_t *ptr = uint8_data();
+    std::vector<Imf::PixelType> comp_types;
     for (auto field : *m_struct) {
         Imf::PixelType comp_type;
         switch (field.type) {
@@ -1378,15 +1392,33 @@ void Bitmap::write_openexr(Stream *stream, int quality) const {
             default: Throw("Unexpected field type!");
         }
 
-        Imf::Slice slice(comp_type, (char *) (ptr + field.offset), pixel_stride, row_stride);
         channels.insert(field.name, Imf::Channel(comp_type));
-        framebuffer.insert(field.name, slice);
+        comp_types.push_back(comp_type);
     }
 
     EXROStream ostr(stream);
     Imf::OutputFile file(ostr, header);
-    file.setFrameBuffer(framebuffer);
-    file.writePixels((int) m_size.y());
+
+    /* Write the image in bands of (at most) m_size.y() scanlines. The slices
+       are offset so that scanline 'y' maps to the top row of the bitmap */
+    const char *ptr = (const char *) uint8_data();
+    for (uint32_t y = 0; y < height; y += m_size.y()) {
+        uint32_t rows = std::min(m_size.y(), height - y);
+        if (fill)
+            fill(y, rows);
+
+        Imf::FrameBuffer framebuffer;
+        const char *base = ptr - (ptrdiff_t) y * (ptrdiff_t) row_stride;
+        for (size_t i = 0; i < m_struct->field_count(); ++i) {
+            const Struct::Field &field = m_struct->operator[](i);
+            framebuffer.insert(field.name,
+                Imf::Slice(comp_types[i], (char *) (base + field.offset),
+                           pixel_stride, row_stride));
+        }
+
+        file.setFrameBuffer(framebuffer);
+        file.writePixels((int) rows);
+    }
 }
 
 // -----------------------------------------------------------------------------
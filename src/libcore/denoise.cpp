@@ -0,0 +1,181 @@
+#include <mitsuba/core/denoise.h>
+#include <mitsuba/core/logger.h>
+#include <mitsuba/core/timer.h>
+#include <mitsuba/core/util.h>
+#include <enoki/array.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <cstring>
+#include <memory>
+
+NAMESPACE_BEGIN(mitsuba)
+
+using FloatP = Packet<float>;
+
+/// Weights of the B3 spline kernel used by the À-Trous transform
+static const float atrous_kernel[5] = { 1.f / 16.f, 1.f / 4.f, 3.f / 8.f,
+                                        1.f / 4.f, 1.f / 16.f };
+
+/// Offset in the denominator of relative color differences (avoids division by zero)
+static const float atrous_color_epsilon = 1e-4f;
+
+namespace {
+struct AtrousGuide {
+    const float *data;
+    size_t channels;
+    /// Scale factor of squared feature differences, i.e. 1 / (2 sigma^2 variance)
+    float scale;
+};
+}
+
+template <typename Value> ENOKI_INLINE Value atrous_load(const float *ptr) {
+    if constexpr (std::is_same_v<Value, float>)
+        return *ptr;
+    else
+        return load_unaligned<Value>(ptr);
+}
+
+template <typename Value> ENOKI_INLINE void atrous_store(float *ptr, const Value &value) {
+    if constexpr (std::is_same_v<Value, float>)
+        *ptr = value;
+    else
+        store_unaligned(ptr, value);
+}
+
+/**
+ * Accumulate the contribution of the pixels at offset \c q - \c p to the
+ * pixels starting at index \c p, which are processed as a single packet (or
+ * scalar). The accumulators start at index \c a.
+ */
+template <typename Value>
+ENOKI_INLINE void atrous_tap(const float *in, size_t n, size_t p, size_t q,
+                             float kernel, float color_scale,
+                             const std::vector<AtrousGuide> &guides,
+                             float *acc, size_t stride, size_t a) {
+    Value cp[3], cq[3], norm(atrous_color_epsilon), dist(0.f);
+    for (int k = 0; k < 3; ++k) {
+        cp[k] = atrous_load<Value>(in + k * n + p);
+        cq[k] = atrous_load<Value>(in + k * n + q);
+        norm = fmadd(cp[k], cp[k], norm);
+        dist = fmadd(cp[k] - cq[k], cp[k] - cq[k], dist);
+    }
+    dist *= color_scale * rcp(norm);
+
+    for (const AtrousGuide &guide : guides) {
+        Value guide_dist(0.f);
+        for (size_t k = 0; k < guide.channels; ++k) {
+            Value diff = atrous_load<Value>(guide.data + k * n + p) -
+                         atrous_load<Value>(guide.data + k * n + q);
+            guide_dist = fmadd(diff, diff, guide_dist);
+        }
+        dist = fmadd(guide_dist, Value(guide.scale), dist);
+    }
+
+    Value weight = kernel * exp(-dist);
+
+    atrous_store(acc + a, atrous_load<Value>(acc + a) + weight);
+    for (int k = 0; k < 3; ++k) {
+        float *ptr = acc + (k + 1) * stride + a;
+        atrous_store(ptr, fmadd(weight, cq[k], atrous_load<Value>(ptr)));
+    }
+}
+
+void denoise_atrous(float *color, uint32_t width, uint32_t height,
+                    const std::vector<DenoiserGuide> &guides_,
+                    uint32_t iterations, float sigma_color) {
+    if (width == 0 || height == 0 || iterations == 0)
+        return;
+
+    Timer timer;
+    size_t n = (size_t) width * (size_t) height;
+
+    /* Normalize feature differences by the variance of each feature, so that
+       the tolerances don't depend on the scale of the scene */
+    std::vector<AtrousGuide> guides;
+    for (const DenoiserGuide &guide : guides_) {
+        double variance = 0.0;
+        for (size_t k = 0; k < guide.channels; ++k) {
+            const float *data = guide.data + k * n;
+            double sum = 0.0, sum_sqr = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                sum += data[i];
+                sum_sqr += (double) data[i] * data[i];
+            }
+            double mean = sum / n;
+            variance += std::max(sum_sqr / n - mean * mean, 0.0);
+        }
+        variance /= std::max(guide.channels, (size_t) 1);
+
+        // Constant features can't distinguish anything
+        if (variance > 0.0 && guide.sigma > 0.f)
+            guides.push_back({ guide.data, guide.channels,
+                               (float) (1.0 / (2.0 * guide.sigma * guide.sigma * variance)) });
+    }
+
+    std::unique_ptr<float[]> buffer(new float[3 * n]);
+    float *in = color, *out = buffer.get();
+
+    for (uint32_t it = 0; it < iterations; ++it) {
+        int step = 1 << it;
+        float sigma = sigma_color / (float) step,
+              color_scale = 1.f / (2.f * sigma * sigma);
+
+        tbb::parallel_for(
+            tbb::blocked_range<uint32_t>(0, height, 4),
+            [&](const tbb::blocked_range<uint32_t> &range) {
+                /* Accumulated weights and weighted colors of one row. The
+                   taps are the outer loop, so that the inner loop sweeps over
+                   contiguous pixels and can be vectorized */
+                size_t stride = width + FloatP::Size;
+                std::unique_ptr<float[]> acc(new float[4 * stride]);
+
+                for (uint32_t y = range.begin(); y != range.end(); ++y) {
+                    memset(acc.get(), 0, 4 * stride * sizeof(float));
+
+                    for (int i = 0; i < 5; ++i) {
+                        int yq = (int) y + (i - 2) * step;
+                        if (yq < 0 || yq >= (int) height)
+                            continue;
+
+                        for (int j = 0; j < 5; ++j) {
+                            int dx = (j - 2) * step;
+                            float kernel = atrous_kernel[i] * atrous_kernel[j];
+
+                            // Range of pixels whose neighbor lies within the image
+                            int x0 = std::max(0, -dx),
+                                x1 = std::min((int) width, (int) width - dx);
+                            int x = x0;
+
+                            size_t p = (size_t) y * width, q = (size_t) yq * width + dx;
+                            for (; x + (int) FloatP::Size <= x1; x += (int) FloatP::Size)
+                                atrous_tap<FloatP>(in, n, p + x, q + x, kernel, color_scale,
+                                                   guides, acc.get(), stride, x);
+                            for (; x < x1; ++x)
+                                atrous_tap<float>(in, n, p + x, q + x, kernel, color_scale,
+                                                  guides, acc.get(), stride, x);
+                        }
+                    }
+
+                    // The center tap always has a positive weight
+                    for (uint32_t x = 0; x < width; ++x) {
+                        float inv_weight = 1.f / acc[x];
+                        for (int k = 0; k < 3; ++k)
+                            out[k * n + (size_t) y * width + x] =
+                                acc[(k + 1) * stride + x] * inv_weight;
+                    }
+                }
+            }
+        );
+
+        std::swap(in, out);
+    }
+
+    if (in != color)
+        memcpy(color, in, 3 * n * sizeof(float));
+
+    Log(Debug, "Denoised a %ix%i image (%i iterations, %i guides) in %s.",
+        width, height, iterations, guides.size(),
+        util::time_string(timer.value()));
+}
+
+NAMESPACE_END(mitsuba)
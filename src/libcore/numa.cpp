@@ -0,0 +1,337 @@
+#include <mitsuba/core/numa.h>
+#include <mitsuba/core/logger.h>
+#include <mitsuba/core/string.h>
+#include <mitsuba/core/thread.h>
+#include <mitsuba/core/util.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_observer.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+#if defined(__LINUX__)
+#  include <pthread.h>
+#  include <sched.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#elif defined(__WINDOWS__)
+#  include <windows.h>
+#endif
+
+NAMESPACE_BEGIN(mitsuba)
+NAMESPACE_BEGIN(numa)
+
+#if defined(__LINUX__)
+/* Constants from <linux/mempolicy.h>. The system call is issued directly to
+   avoid a dependency on libnuma */
+static constexpr int MTS_MPOL_INTERLEAVE = 3;
+static constexpr unsigned MTS_MPOL_MF_MOVE = 1u << 1;
+#endif
+
+struct Topology {
+    /// Usable processors of each node
+    std::vector<std::vector<int>> cpus;
+    /// Operating system indices of the nodes
+    std::vector<int> ids;
+    /// All processors, alternating between the nodes
+    std::vector<int> order;
+};
+
+#if defined(__LINUX__)
+/// Parse a list of the form "0-3,8,10-11" used by the sysfs interface
+static std::vector<int> parse_list(const std::string &str) {
+    std::vector<int> result;
+    for (const std::string &item : string::tokenize(str, ",")) {
+        auto range = string::tokenize(item, "-");
+        if (range.empty())
+            continue;
+        int first = std::stoi(range[0]),
+            last  = range.size() > 1 ? std::stoi(range[1]) : first;
+        for (int i = first; i <= last; ++i)
+            result.push_back(i);
+    }
+    return result;
+}
+#endif
+
+static Topology detect_topology() {
+    Topology t;
+
+#if defined(__LINUX__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &mask) != 0) {
+        for (int i = 0; i < util::core_count() && i < CPU_SETSIZE; ++i)
+            CPU_SET(i, &mask);
+    }
+
+    try {
+        std::ifstream online("/sys/devices/system/node/online");
+        std::string line;
+        if (online && std::getline(online, line)) {
+            for (int id : parse_list(line)) {
+                std::ifstream is(tfm::format("/sys/devices/system/node/node%i/cpulist", id));
+                if (!is || !std::getline(is, line))
+                    continue;
+                std::vector<int> cpus;
+                for (int cpu : parse_list(line)) {
+                    if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &mask))
+                        cpus.push_back(cpu);
+                }
+                // Skip memory-only nodes and nodes excluded by the affinity mask
+                if (!cpus.empty()) {
+                    t.ids.push_back(id);
+                    t.cpus.push_back(std::move(cpus));
+                }
+            }
+        }
+    } catch (const std::exception &e) {
+        Log(Warn, "numa: could not parse the NUMA topology: %s", e.what());
+        t = Topology();
+    }
+
+    if (t.cpus.empty()) {
+        std::vector<int> cpus;
+        for (int i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &mask))
+                cpus.push_back(i);
+        }
+        t.ids.push_back(0);
+        t.cpus.push_back(std::move(cpus));
+    }
+#else
+    std::vector<int> cpus(util::core_count());
+    for (size_t i = 0; i < cpus.size(); ++i)
+        cpus[i] = (int) i;
+    t.ids.push_back(0);
+    t.cpus.push_back(std::move(cpus));
+#endif
+
+    size_t max_size = 0;
+    for (const auto &cpus : t.cpus)
+        max_size = std::max(max_size, cpus.size());
+    for (size_t i = 0; i < max_size; ++i) {
+        for (const auto &cpus : t.cpus) {
+            if (i < cpus.size())
+                t.order.push_back(cpus[i]);
+        }
+    }
+
+    return t;
+}
+
+static const Topology &topology() {
+    static Topology t = detect_topology();
+    return t;
+}
+
+static std::atomic<bool> __thread_pinning { false };
+static std::atomic<uint32_t> __pinned_threads { 0 };
+static std::atomic<AllocationPolicy> __allocation_policy { AllocationPolicy::FirstTouch };
+
+size_t node_count() { return topology().cpus.size(); }
+
+const std::vector<int> &node_cpus(size_t node) {
+    const Topology &t = topology();
+    if (node >= t.cpus.size())
+        Throw("numa::node_cpus(): invalid node index %i!", node);
+    return t.cpus[node];
+}
+
+void set_thread_pinning(bool value) { __thread_pinning = value; }
+bool thread_pinning() { return __thread_pinning; }
+
+void set_allocation_policy(AllocationPolicy policy) { __allocation_policy = policy; }
+AllocationPolicy allocation_policy() { return __allocation_policy; }
+
+static void set_affinity(const std::vector<int> &cpus) {
+#if defined(__LINUX__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus)
+        CPU_SET(cpu, &set);
+    int retval = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+    if (retval)
+        Log(Warn, "numa::pin_thread(): pthread_setaffinity_np(): failed: %s",
+            strerror(retval));
+#elif defined(__WINDOWS__)
+    DWORD_PTR mask = 0;
+    for (int cpu : cpus) {
+        if (cpu < (int) (8 * sizeof(DWORD_PTR)))
+            mask |= (DWORD_PTR) 1 << cpu;
+    }
+    if (!SetThreadAffinityMask(GetCurrentThread(), mask))
+        Log(Warn, "numa::pin_thread(): SetThreadAffinityMask(): failed: %s",
+            util::last_error());
+#else
+    /* CPU affinity not supported on OSX */
+    (void) cpus;
+#endif
+}
+
+void pin_thread(int node) {
+    const Topology &t = topology();
+    if (node >= (int) t.cpus.size())
+        Throw("numa::pin_thread(): invalid node index %i!", node);
+
+    if (node < 0) {
+        // Alternate between the nodes to balance the load of the memory controllers
+        int cpu = t.order[__pinned_threads++ % t.order.size()];
+        set_affinity({ cpu });
+    } else {
+        set_affinity(t.cpus[node]);
+    }
+}
+
+void distribute(const void *ptr, size_t size) {
+    if (__allocation_policy != AllocationPolicy::Interleave ||
+        size < (1u << 20) || node_count() < 2)
+        return;
+
+#if defined(__LINUX__)
+    uintptr_t page  = (uintptr_t) sysconf(_SC_PAGESIZE),
+              start = ((uintptr_t) ptr + page - 1) & ~(page - 1),
+              end   = ((uintptr_t) ptr + size) & ~(page - 1);
+    if (end <= start)
+        return;
+
+    const Topology &t = topology();
+    constexpr size_t bits = 8 * sizeof(unsigned long);
+    int max_id = *std::max_element(t.ids.begin(), t.ids.end());
+    std::vector<unsigned long> mask(max_id / bits + 1, 0ul);
+    for (int id : t.ids)
+        mask[id / bits] |= 1ul << (id % bits);
+
+    long retval = syscall(SYS_mbind, (void *) start, (unsigned long) (end - start),
+                          MTS_MPOL_INTERLEAVE, mask.data(),
+                          (unsigned long) (mask.size() * bits + 1), MTS_MPOL_MF_MOVE);
+    if (retval != 0) {
+        static std::atomic<bool> warned { false };
+        if (!warned.exchange(true))
+            Log(Warn, "numa::distribute(): mbind() failed: %s", strerror(errno));
+    }
+#else
+    (void) ptr;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+
+/// Confines the threads that join the task arena of a node to its processors
+class NodeObserver : public tbb::task_scheduler_observer {
+public:
+    NodeObserver(tbb::task_arena &arena, int node)
+        : tbb::task_scheduler_observer(arena), m_node(node) {
+        observe(true);
+    }
+
+    ~NodeObserver() { observe(false); }
+
+    void on_scheduler_entry(bool) { pin_thread(m_node); }
+
+private:
+    int m_node;
+};
+
+struct NodeArena {
+    size_t concurrency;
+    std::unique_ptr<tbb::task_arena> arena;
+    std::unique_ptr<NodeObserver> observer;
+};
+
+struct NodeArenas {
+    size_t thread_count;
+    std::vector<NodeArena> nodes;
+};
+
+static std::mutex __arena_mutex;
+static std::shared_ptr<NodeArenas> __arenas;
+
+/// Return the per-node task arenas, which are recreated when the thread count changes
+static std::shared_ptr<NodeArenas> node_arenas() {
+    std::lock_guard<std::mutex> guard(__arena_mutex);
+    size_t thread_count = std::max(__global_thread_count, (size_t) 1);
+    if (__arenas && __arenas->thread_count == thread_count)
+        return __arenas;
+
+    const Topology &t = topology();
+    size_t cpu_count = t.order.size();
+
+    std::shared_ptr<NodeArenas> arenas = std::make_shared<NodeArenas>();
+    arenas->thread_count = thread_count;
+    arenas->nodes.resize(t.cpus.size());
+    for (size_t i = 0; i < t.cpus.size(); ++i) {
+        NodeArena &node = arenas->nodes[i];
+        // Split the threads proportionally to the number of processors per node
+        node.concurrency = std::max(
+            (size_t) 1, (thread_count * t.cpus[i].size() + cpu_count / 2) / cpu_count);
+        node.arena.reset(new tbb::task_arena((int) node.concurrency, 0));
+        node.arena->initialize();
+        node.observer.reset(new NodeObserver(*node.arena, (int) i));
+    }
+
+    __arenas = arenas;
+    return arenas;
+}
+
+void parallel_for(size_t size, size_t grain_size,
+                  const std::function<void(size_t, size_t)> &func) {
+    auto body = [&](const tbb::blocked_range<size_t> &range) {
+        func(range.begin(), range.end());
+    };
+
+    if (!__thread_pinning || node_count() < 2) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, size, grain_size), body);
+        return;
+    }
+
+    std::shared_ptr<NodeArenas> arenas = node_arenas();
+    size_t n = arenas->nodes.size(), total = 0;
+    for (const NodeArena &node : arenas->nodes)
+        total += node.concurrency;
+
+    // Hand a contiguous part of the range to each node
+    std::vector<tbb::task_group> groups(n);
+    size_t begin = 0, cumulative = 0;
+    for (size_t i = 0; i < n; ++i) {
+        cumulative += arenas->nodes[i].concurrency;
+        size_t end = size * cumulative / total;
+        if (begin < end) {
+            arenas->nodes[i].arena->execute([&, i, begin, end] {
+                groups[i].run([&, begin, end] {
+                    tbb::parallel_for(
+                        tbb::blocked_range<size_t>(begin, end, grain_size), body);
+                });
+            });
+        }
+        begin = end;
+    }
+
+    // Wait for all nodes (even if one of them failed) before propagating errors
+    std::exception_ptr error;
+    for (size_t i = 0; i < n; ++i) {
+        try {
+            arenas->nodes[i].arena->execute([&, i] { groups[i].wait(); });
+        } catch (...) {
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void static_shutdown() {
+    std::lock_guard<std::mutex> guard(__arena_mutex);
+    __arenas.reset();
+}
+
+NAMESPACE_END(numa)
+NAMESPACE_END(mitsuba)
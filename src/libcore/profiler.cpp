@@ -1,5 +1,7 @@
 #include <mitsuba/core/profiler.h>
+#include <mitsuba/core/filesystem.h>
 #include <mitsuba/core/logger.h>
+#include <mitsuba/core/thread.h>
 #include <mitsuba/core/util.h>
 
 #if defined(MTS_ENABLE_PROFILER)
@@ -8,21 +10,133 @@
 #include <stdio.h>
 #include <tbb/tbb.h>
 #include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <fstream>
 #include <map>
+#include <mutex>
+
+#if defined(__linux__)
+#  include <linux/perf_event.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
 
 NAMESPACE_BEGIN(mitsuba)
 
 static thread_local uint64_t profiler_flags_storage = 0;
 uint64_t *profiler_flags() { return &profiler_flags_storage; }
 
+/// Number of hardware counters, see \ref ProfilerCounters
+static constexpr size_t profiler_counter_count = 4;
+
 struct ProfilerSample {
     uint64_t flags = (uint64_t) -1;
     uint64_t count = 0;
+    uint64_t counters[profiler_counter_count] = { };
 };
 
 static std::array<ProfilerSample, MTS_PROFILE_HASH_SIZE> profiler_samples;
 
+// -----------------------------------------------------------------------------
+
+static volatile bool profiler_counters_enabled = false;
+
+#if defined(__linux__)
+/* Hardware counters of a thread. They are opened when the thread registers
+   with the profiler (\ref Profiler::register_thread()), since system calls
+   other than read() must not be issued from within the signal handler. */
+struct CounterState {
+    /// Group leader, or -1 (not opened)
+    int fd;
+    uint64_t last[profiler_counter_count];
+};
+
+static thread_local CounterState counter_state = { -1, { } };
+
+static int counter_open(uint64_t config, int group_fd) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    // Count the calling thread on any CPU
+    return (int) syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+/// Open the counter group of the calling thread, returns the leader or -1
+static int counter_open_group() {
+    const uint64_t configs[profiler_counter_count] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    int fds[profiler_counter_count], leader = -1;
+    for (size_t i = 0; i < profiler_counter_count; ++i) {
+        fds[i] = counter_open(configs[i], leader);
+        if (fds[i] < 0) {
+            for (size_t j = 0; j < i; ++j)
+                close(fds[j]);
+            return -1;
+        }
+        if (i == 0)
+            leader = fds[0];
+    }
+    return leader;
+}
+
+/// Read the counters of a group (async-signal-safe)
+static bool counter_read(int fd, uint64_t *values) {
+    uint64_t buf[1 + profiler_counter_count];
+    if (read(fd, buf, sizeof(buf)) != (ssize_t) sizeof(buf) ||
+        buf[0] != profiler_counter_count)
+        return false;
+    memcpy(values, buf + 1, sizeof(uint64_t) * profiler_counter_count);
+    return true;
+}
+
+/// Start counting on the calling thread using the group \c fd
+static void counter_attach(int fd) {
+    CounterState &state = counter_state;
+    if (!counter_read(fd, state.last)) {
+        close(fd);
+        return;
+    }
+    // Only publish the descriptor once the baseline has been established
+    std::atomic_signal_fence(std::memory_order_release);
+    state.fd = fd;
+}
+
+/// Compute the counter increase since the previous sample of the calling thread
+static bool counter_delta(uint64_t *delta) {
+    CounterState &state = counter_state;
+    if (state.fd < 0)
+        return false;
+
+    uint64_t values[profiler_counter_count];
+    if (!counter_read(state.fd, values))
+        return false;
+
+    for (size_t i = 0; i < profiler_counter_count; ++i) {
+        delta[i] = values[i] - state.last[i];
+        state.last[i] = values[i];
+    }
+    return true;
+}
+#else
+static bool counter_delta(uint64_t *) { return false; }
+#endif
+
+// -----------------------------------------------------------------------------
+
 static void profiler_callback(int, siginfo_t *, void *) {
+    // Don't clobber the errno value of the interrupted code
+    int saved_errno = errno;
     uint64_t flags = *profiler_flags();
 
     uint64_t bucket_id =
@@ -42,12 +156,37 @@ static void profiler_callback(int, siginfo_t *, void *) {
     if (tries == profiler_samples.size()) {
         Log(Warn, "Profiler hash table filled up -- you may need to increase "
                   "MTS_PROFILE_HASH_SIZE.");
+        errno = saved_errno;
         return;
     }
 
     ProfilerSample &bucket = profiler_samples[bucket_id];
     bucket.flags = flags;
     bucket.count++;
+
+    /* Attribute the counter increase since the previous sample of this thread
+       to the phases that are currently active (just like the sample itself) */
+    uint64_t delta[profiler_counter_count];
+    if (profiler_counters_enabled && counter_delta(delta)) {
+        for (size_t i = 0; i < profiler_counter_count; ++i)
+            bucket.counters[i] += delta[i];
+    }
+
+    errno = saved_errno;
+}
+
+/// Sampling rate in Hz
+static uint32_t profiler_rate = 100;
+static bool profiler_running = false;
+
+static void profiler_set_timer(uint32_t rate) {
+    itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = rate == 0 ? 0 : std::max(1000000 / rate, 1u);
+    timer.it_value = timer.it_interval;
+
+    if (setitimer(ITIMER_PROF, &timer, nullptr))
+        Throw("profiler_start(): failure in setitimer(): %s", strerror(errno));
 }
 
 void Profiler::static_initialization() {
@@ -62,27 +201,254 @@ void Profiler::static_initialization() {
         if (sigaction(SIGPROF, &sa, nullptr))
             Throw("profiler_start(): failure in sigaction(): %s", strerror(errno));
 
-        itimerval timer;
-        timer.it_interval.tv_sec = 0;
-        timer.it_interval.tv_usec = 1000000 / 100; // 100 Hz sampling
-        timer.it_value = timer.it_interval;
+        profiler_set_timer(profiler_rate);
+        profiler_running = true;
+    }
+}
 
-        if (setitimer(ITIMER_PROF, &timer, nullptr))
-            Throw("profiler_start(): failure in setitimer(): %s", strerror(errno));
+void Profiler::set_sampling_rate(uint32_t rate) {
+    if (rate == 0)
+        Throw("Profiler::set_sampling_rate(): the rate must be positive!");
+    profiler_rate = rate;
+    if (profiler_running)
+        profiler_set_timer(rate);
+}
+
+bool Profiler::enable_counters() {
+#if defined(__linux__)
+    int fd = counter_open_group();
+    if (fd < 0) {
+        Log(Warn, "Profiler::enable_counters(): hardware performance counters "
+                  "are unavailable (%s). Check /proc/sys/kernel/perf_event_paranoid.",
+            strerror(errno));
+        return false;
     }
+    profiler_counters_enabled = true;
+    if (counter_state.fd < 0)
+        counter_attach(fd);
+    else
+        close(fd);
+    return true;
+#else
+    Log(Warn, "Profiler::enable_counters(): hardware performance counters are "
+              "only supported on Linux.");
+    return false;
+#endif
+}
+
+void Profiler::register_thread() {
+#if defined(__linux__)
+    if (!profiler_counters_enabled || counter_state.fd >= 0)
+        return;
+    int fd = counter_open_group();
+    if (fd >= 0)
+        counter_attach(fd);
+#endif
+}
+
+void Profiler::unregister_thread() {
+#if defined(__linux__)
+    int fd = counter_state.fd;
+    if (fd < 0)
+        return;
+    counter_state.fd = -1;
+    std::atomic_signal_fence(std::memory_order_release);
+    close(fd);
+#endif
+}
+
+std::map<std::string, ProfilerCounters> Profiler::counters() {
+    std::map<std::string, ProfilerCounters> result;
+
+    for (auto const &sample: profiler_samples) {
+        if (sample.count == 0)
+            continue;
+
+        // Attribute to the innermost (highest-numbered) phase
+        std::string name = "Idle";
+        for (int i = int(ProfilerPhase::ProfilerPhaseCount) - 1; i >= 0; --i) {
+            if (sample.flags & (1ull << i)) {
+                name = profiler_phase_id[i];
+                break;
+            }
+        }
+
+        ProfilerCounters &c = result[name];
+        c.samples       += sample.count;
+        c.cycles        += sample.counters[0];
+        c.instructions  += sample.counters[1];
+        c.cache_misses  += sample.counters[2];
+        c.branch_misses += sample.counters[3];
+    }
+
+    return result;
 }
 
 void Profiler::static_shutdown() {
-    if (util::detect_debugger())
+    stop_tracing();
+
+    if (!profiler_running)
         return;
 
-    itimerval timer;
-    timer.it_interval.tv_sec = 0;
-    timer.it_interval.tv_usec = 0;
-    timer.it_value = timer.it_interval;
+    profiler_set_timer(0);
+    profiler_running = false;
+}
 
-    if (setitimer(ITIMER_PROF, &timer, nullptr))
-        Throw("profiler_stop(): failure in setitimer(): %s", strerror(errno));
+// -----------------------------------------------------------------------------
+
+struct TraceEvent {
+    /// Time in nanoseconds since the call to \ref Profiler::start_tracing()
+    uint64_t time;
+    uint32_t phase;
+    uint32_t begin;
+};
+
+/// Ring buffer that is written by a single thread (and read by the exporter)
+struct TraceBuffer {
+    std::string name;
+    std::unique_ptr<TraceEvent[]> events{ new TraceEvent[MTS_PROFILE_TRACE_SIZE] };
+    /// Total number of events written during the current trace session
+    std::atomic<uint64_t> head{ 0 };
+    /// Trace session that the contents of the buffer belong to
+    std::atomic<uint64_t> session{ 0 };
+};
+
+std::atomic<uint64_t> profiler_trace_mask{ 0 };
+
+static std::mutex trace_mutex;
+/// Buffers of all threads that ever recorded an event (they outlive their thread)
+static std::vector<std::unique_ptr<TraceBuffer>> trace_buffers;
+static thread_local TraceBuffer *trace_buffer = nullptr;
+static std::atomic<uint64_t> trace_session{ 0 };
+static std::atomic<int64_t> trace_start{ 0 };
+
+static int64_t trace_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static TraceBuffer *trace_register_thread() {
+    std::unique_ptr<TraceBuffer> buffer(new TraceBuffer());
+    Thread *thread = Thread::thread();
+
+    std::lock_guard<std::mutex> guard(trace_mutex);
+    buffer->name = thread ? thread->name()
+                          : tfm::format("thread%i", trace_buffers.size());
+    trace_buffers.push_back(std::move(buffer));
+    return trace_buffers.back().get();
+}
+
+void profiler_trace_event(ProfilerPhase phase, bool begin) {
+    TraceBuffer *buffer = trace_buffer;
+    if (unlikely(!buffer))
+        buffer = trace_buffer = trace_register_thread();
+
+    // Lazily discard the events of a previous trace session
+    uint64_t session = trace_session.load(std::memory_order_acquire),
+             head = buffer->head.load(std::memory_order_relaxed);
+    if (unlikely(buffer->session.load(std::memory_order_relaxed) != session)) {
+        buffer->session.store(session, std::memory_order_relaxed);
+        head = 0;
+    }
+
+    TraceEvent &event = buffer->events[head % MTS_PROFILE_TRACE_SIZE];
+    event.time = (uint64_t) (trace_now() - trace_start.load(std::memory_order_relaxed));
+    event.phase = (uint32_t) phase;
+    event.begin = begin ? 1 : 0;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::start_tracing(uint64_t phase_mask) {
+    trace_start.store(trace_now(), std::memory_order_relaxed);
+    trace_session.fetch_add(1, std::memory_order_release);
+    profiler_trace_mask.store(phase_mask, std::memory_order_relaxed);
+}
+
+void Profiler::stop_tracing() {
+    profiler_trace_mask.store(0, std::memory_order_relaxed);
+}
+
+size_t Profiler::write_trace(const fs::path &filename) {
+    std::ofstream os(filename.native());
+    if (!os.good())
+        Throw("Profiler::write_trace(): unable to open \"%s\"!", filename);
+
+    auto escape = [](const std::string &str) {
+        std::string result;
+        for (char c : str) {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result;
+    };
+
+    uint64_t session = trace_session.load(std::memory_order_acquire);
+    size_t event_count = 0, thread_count = 0;
+    bool first = true;
+
+    auto write_event = [&](const char *name, char type, uint64_t time, size_t tid) {
+        os << (first ? "\n" : ",\n") << "  {\"name\": \"" << name
+           << "\", \"cat\": \"mitsuba\", \"ph\": \"" << type << "\", \"ts\": "
+           << tfm::format("%.3f", time / 1000.0) << ", \"pid\": 0, \"tid\": " << tid << "}";
+        first = false;
+        event_count++;
+    };
+
+    std::lock_guard<std::mutex> guard(trace_mutex);
+    os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+    for (size_t tid = 0; tid < trace_buffers.size(); ++tid) {
+        const TraceBuffer &buffer = *trace_buffers[tid];
+        uint64_t head = buffer.head.load(std::memory_order_acquire);
+        if (buffer.session.load(std::memory_order_relaxed) != session || head == 0)
+            continue;
+
+        os << (first ? "\n" : ",\n")
+           << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": "
+           << tid << ", \"args\": {\"name\": \"" << escape(buffer.name) << "\"}}";
+        first = false;
+        thread_count++;
+
+        uint64_t start = 0;
+        if (head > MTS_PROFILE_TRACE_SIZE) {
+            start = head - MTS_PROFILE_TRACE_SIZE;
+            Log(Warn, "Profiler::write_trace(): the ring buffer of thread \"%s\" "
+                      "overflowed, dropped the %i oldest events (trace fewer phases "
+                      "or increase MTS_PROFILE_TRACE_SIZE).", buffer.name, start);
+        }
+
+        /* Events of phases that began before the first retained event are
+           skipped, and phases that are still active are closed at the end */
+        std::vector<uint32_t> stack;
+        uint64_t last_time = 0;
+        for (uint64_t i = start; i < head; ++i) {
+            const TraceEvent &event = buffer.events[i % MTS_PROFILE_TRACE_SIZE];
+            last_time = event.time;
+            if (event.begin) {
+                stack.push_back(event.phase);
+            } else if (!stack.empty() && stack.back() == event.phase) {
+                stack.pop_back();
+            } else {
+                continue;
+            }
+            write_event(profiler_phase_id[event.phase], event.begin ? 'B' : 'E',
+                        event.time, tid);
+        }
+
+        while (!stack.empty()) {
+            write_event(profiler_phase_id[stack.back()], 'E', last_time, tid);
+            stack.pop_back();
+        }
+    }
+
+    os << "\n]}\n";
+    if (!os.good())
+        Throw("Profiler::write_trace(): error while writing \"%s\"!", filename);
+
+    Log(Info, "Wrote %i trace events of %i threads to \"%s\"", event_count,
+        thread_count, filename);
+    return event_count;
 }
 
 void Profiler::print_report() {
@@ -172,6 +538,23 @@ void Profiler::print_report() {
             std::string(prefix_length - kv.first.length() - 4, ' '),
             kv.second / float(event_count_total) * 100.f);
     }
+
+    if (!profiler_counters_enabled)
+        return;
+
+    auto counters = Profiler::counters();
+    Log(Info, "\U000023F1  Hardware counters (flat):");
+    Log(Info, "    Phase%s     IPC  LLC MPKI  Branch MPKI",
+        std::string(prefix_length - 9, ' '));
+    for (auto kv : leaf_results_sorted) {
+        auto it = counters.find(kv.first);
+        if (it == counters.end() || it->second.cycles == 0)
+            continue;
+        const ProfilerCounters &c = it->second;
+        Log(Info, "    %s%s%8.2f  %8.2f  %11.2f", kv.first,
+            std::string(prefix_length - kv.first.length() - 4, ' '),
+            c.ipc(), c.cache_mpki(), c.branch_mpki());
+    }
 }
 
 MTS_IMPLEMENT_CLASS(Profiler, Object)
@@ -0,0 +1,26 @@
+#include <mitsuba/core/arena.h>
+#include <mitsuba/core/math.h>
+#include <mitsuba/python/python.h>
+
+MTS_PY_EXPORT(MemoryArena) {
+    auto arena = py::class_<MemoryArena>(m, "MemoryArena", D(MemoryArena))
+        .def(py::init<size_t>(), "chunk_size"_a = 256 * 1024, D(MemoryArena, MemoryArena))
+        .def("allocate",
+            [](MemoryArena &arena, size_t size, size_t alignment) {
+                if (!math::is_power_of_two(alignment))
+                    Throw("MemoryArena.allocate(): the alignment must be a power of two!");
+                return (uintptr_t) arena.allocate(size, alignment);
+            }, "size"_a, "alignment"_a = 16, D(MemoryArena, allocate))
+        .def_method(MemoryArena, mark)
+        .def_method(MemoryArena, rewind, "marker"_a)
+        .def_method(MemoryArena, reset)
+        .def_method(MemoryArena, used)
+        .def_method(MemoryArena, capacity)
+        .def_method(MemoryArena, chunk_count)
+        .def_method(MemoryArena, allocation_count)
+        .def_method(MemoryArena, heap_allocation_count)
+        .def_static("thread", &MemoryArena::thread, py::return_value_policy::reference,
+                    D(MemoryArena, thread));
+
+    py::class_<MemoryArena::Marker>(arena, "Marker", D(MemoryArena, Marker));
+}
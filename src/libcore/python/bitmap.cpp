@@ -9,6 +9,25 @@ MTS_PY_EXPORT(Bitmap) {
     MTS_IMPORT_CORE_TYPES()
     using ReconstructionFilter = typename Bitmap::ReconstructionFilter;
 
+    MTS_PY_CLASS(WriteHandle, Object)
+        .def_method(WriteHandle, done)
+        .def("wait", &WriteHandle::wait, D(WriteHandle, wait),
+             py::call_guard<py::gil_scoped_release>())
+        .def_method(WriteHandle, description);
+
+    MTS_PY_CLASS(WriteQueue, Object)
+        .def(py::init<size_t, size_t>(), "thread_count"_a = 1, "capacity"_a = 8,
+             D(WriteQueue, WriteQueue))
+        .def("wait", &WriteQueue::wait, D(WriteQueue, wait),
+             py::call_guard<py::gil_scoped_release>())
+        .def_method(WriteQueue, pending)
+        .def_method(WriteQueue, capacity)
+        .def_method(WriteQueue, thread_count)
+        .def_method(WriteQueue, writes_completed)
+        .def_method(WriteQueue, bytes_written)
+        .def_method(WriteQueue, throughput)
+        .def_static_method(WriteQueue, instance);
+
     auto bitmap = MTS_PY_CLASS(Bitmap, Object);
 
     py::enum_<Bitmap::PixelFormat>(bitmap, "PixelFormat", D(Bitmap, PixelFormat))
@@ -165,7 +184,7 @@ MTS_PY_EXPORT(Bitmap) {
             py::overload_cast<const fs::path &, Bitmap::FileFormat, int>(
                 &Bitmap::write_async, py::const_),
             "path"_a, "format"_a = Bitmap::FileFormat::Auto, "quality"_a = -1,
-            D(Bitmap, write_async))
+            D(Bitmap, write_async), py::call_guard<py::gil_scoped_release>())
         .def("split", &Bitmap::split, D(Bitmap, split))
         .def_static("detect_file_format", &Bitmap::detect_file_format, D(Bitmap, detect_file_format))
         .def_property_readonly("__array_interface__", [](Bitmap &bitmap) -> py::object {
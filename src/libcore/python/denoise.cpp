@@ -0,0 +1,56 @@
+#include <mitsuba/core/denoise.h>
+#include <mitsuba/python/python.h>
+
+MTS_PY_EXPORT(denoise) {
+    using NumPyArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+
+    /// Convert a (height, width, channels) array into planar storage
+    auto to_planar = [](const NumPyArray &array, size_t height, size_t width,
+                        const char *name) {
+        if (array.ndim() != 3 || (size_t) array.shape(0) != height ||
+            (size_t) array.shape(1) != width)
+            Throw("denoise_atrous(): '%s' must be an array of shape (%i, %i, C)!",
+                  name, height, width);
+        size_t channels = (size_t) array.shape(2), n = height * width;
+        std::vector<float> result(channels * n);
+        const float *data = array.data();
+        for (size_t i = 0; i < n; ++i)
+            for (size_t k = 0; k < channels; ++k)
+                result[k * n + i] = data[i * channels + k];
+        return result;
+    };
+
+    m.def("denoise_atrous",
+        [to_planar](const NumPyArray &color,
+                    const std::vector<std::pair<NumPyArray, float>> &guides_,
+                    uint32_t iterations, float sigma_color) {
+            if (color.ndim() != 3 || color.shape(2) != 3)
+                Throw("denoise_atrous(): 'color' must be an array of shape (H, W, 3)!");
+            size_t height = (size_t) color.shape(0), width = (size_t) color.shape(1),
+                   n = height * width;
+
+            std::vector<float> color_p = to_planar(color, height, width, "color");
+            std::vector<std::vector<float>> guide_storage;
+            std::vector<DenoiserGuide> guides;
+            for (const auto &[array, sigma] : guides_) {
+                guide_storage.push_back(to_planar(array, height, width, "guides"));
+                guides.push_back({ guide_storage.back().data(),
+                                   (size_t) array.shape(2), sigma });
+            }
+
+            {
+                py::gil_scoped_release release;
+                denoise_atrous(color_p.data(), (uint32_t) width, (uint32_t) height,
+                               guides, iterations, sigma_color);
+            }
+
+            NumPyArray result({ height, width, (size_t) 3 });
+            float *out = result.mutable_data();
+            for (size_t i = 0; i < n; ++i)
+                for (size_t k = 0; k < 3; ++k)
+                    out[i * 3 + k] = color_p[k * n + i];
+            return result;
+        },
+        "color"_a, "guides"_a = std::vector<std::pair<NumPyArray, float>>(),
+        "iterations"_a = 5, "sigma_color"_a = 1.f, D(denoise_atrous));
+}
@@ -11,6 +11,7 @@ MTS_PY_DECLARE(filesystem);
 MTS_PY_DECLARE(quad);
 MTS_PY_DECLARE(Object);
 MTS_PY_DECLARE(Cast);
+MTS_PY_DECLARE(denoise);
 MTS_PY_DECLARE(Struct);
 MTS_PY_DECLARE(Appender);
 MTS_PY_DECLARE(ArgParser);
@@ -18,13 +19,17 @@ MTS_PY_DECLARE(Bitmap);
 MTS_PY_DECLARE(Formatter);
 MTS_PY_DECLARE(FileResolver);
 MTS_PY_DECLARE(Logger);
+MTS_PY_DECLARE(MemoryArena);
 MTS_PY_DECLARE(MemoryMappedFile);
+MTS_PY_DECLARE(numa);
 MTS_PY_DECLARE(Stream);
 MTS_PY_DECLARE(DummyStream);
 MTS_PY_DECLARE(FileStream);
 MTS_PY_DECLARE(MemoryStream);
 MTS_PY_DECLARE(ZStream);
 MTS_PY_DECLARE(ProgressReporter);
+MTS_PY_DECLARE(Profiler);
+MTS_PY_DECLARE(Statistics);
 MTS_PY_DECLARE(rfilter);
 MTS_PY_DECLARE(Thread);
 MTS_PY_DECLARE(util);
@@ -103,6 +108,7 @@ PYBIND11_MODULE(core_ext, m) {
     MTS_PY_IMPORT(quad);
     MTS_PY_IMPORT(Object);
     MTS_PY_IMPORT(Cast);
+    MTS_PY_IMPORT(denoise);
     MTS_PY_IMPORT(Struct);
     MTS_PY_IMPORT(Appender);
     MTS_PY_IMPORT(ArgParser);
@@ -112,12 +118,16 @@ PYBIND11_MODULE(core_ext, m) {
     MTS_PY_IMPORT(Formatter);
     MTS_PY_IMPORT(FileResolver);
     MTS_PY_IMPORT(Logger);
+    MTS_PY_IMPORT(MemoryArena);
     MTS_PY_IMPORT(MemoryMappedFile);
+    MTS_PY_IMPORT(numa);
     MTS_PY_IMPORT(DummyStream);
     MTS_PY_IMPORT(FileStream);
     MTS_PY_IMPORT(MemoryStream);
     MTS_PY_IMPORT(ZStream);
     MTS_PY_IMPORT(ProgressReporter);
+    MTS_PY_IMPORT(Profiler);
+    MTS_PY_IMPORT(Statistics);
     MTS_PY_IMPORT(Thread);
     MTS_PY_IMPORT(util);
 
@@ -127,6 +137,7 @@ PYBIND11_MODULE(core_ext, m) {
         [scheduler_holder](py::handle weakref) {
             delete scheduler_holder;
 
+            WriteQueue::static_shutdown();
             Bitmap::static_shutdown();
             Logger::static_shutdown();
             Thread::static_shutdown();
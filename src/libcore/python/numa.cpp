@@ -0,0 +1,19 @@
+#include <mitsuba/core/numa.h>
+#include <mitsuba/python/python.h>
+
+MTS_PY_EXPORT(numa) {
+    auto numa = m.def_submodule("numa", "NUMA-aware thread placement and memory allocation");
+
+    py::enum_<numa::AllocationPolicy>(numa, "AllocationPolicy", D(numa, AllocationPolicy))
+        .value("FirstTouch", numa::AllocationPolicy::FirstTouch,
+               D(numa, AllocationPolicy, FirstTouch))
+        .value("Interleave", numa::AllocationPolicy::Interleave,
+               D(numa, AllocationPolicy, Interleave));
+
+    numa.def_method(numa, node_count)
+        .def_method(numa, node_cpus, "node"_a)
+        .def_method(numa, set_thread_pinning, "value"_a)
+        .def_method(numa, thread_pinning)
+        .def_method(numa, set_allocation_policy, "policy"_a)
+        .def_method(numa, allocation_policy);
+}
@@ -71,6 +71,7 @@ MTS_PY_EXPORT(Object) {
     m.def("set_property", [](const void *ptr, void *type_, py::handle handle) {
         const std::type_info &type = *(const std::type_info *) type_;
 
+        SET_ATTR(Float);
         SET_ATTR(DynamicBuffer<Float>);
         SET_ATTR(DynamicBuffer<Int32>);
         SET_ATTR(DynamicBuffer<UInt32>);
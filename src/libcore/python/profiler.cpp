@@ -0,0 +1,65 @@
+#include <mitsuba/core/profiler.h>
+#include <mitsuba/python/python.h>
+
+MTS_PY_EXPORT(Profiler) {
+    py::enum_<ProfilerPhase>(m, "ProfilerPhase", D(ProfilerPhase))
+        .value("InitScene", ProfilerPhase::InitScene)
+        .value("LoadGeometry", ProfilerPhase::LoadGeometry)
+        .value("LoadTexture", ProfilerPhase::LoadTexture)
+        .value("InitKDTree", ProfilerPhase::InitKDTree)
+        .value("Render", ProfilerPhase::Render)
+        .value("RenderBlock", ProfilerPhase::RenderBlock)
+        .value("SamplingIntegratorSample", ProfilerPhase::SamplingIntegratorSample)
+        .value("SampleEmitterRay", ProfilerPhase::SampleEmitterRay)
+        .value("SampleEmitterDirection", ProfilerPhase::SampleEmitterDirection)
+        .value("RayTest", ProfilerPhase::RayTest)
+        .value("RayIntersect", ProfilerPhase::RayIntersect)
+        .value("CreateSurfaceInteraction", ProfilerPhase::CreateSurfaceInteraction)
+        .value("ImageBlockPut", ProfilerPhase::ImageBlockPut)
+        .value("BSDFEvaluate", ProfilerPhase::BSDFEvaluate)
+        .value("BSDFSample", ProfilerPhase::BSDFSample)
+        .value("PhaseFunctionEvaluate", ProfilerPhase::PhaseFunctionEvaluate)
+        .value("PhaseFunctionSample", ProfilerPhase::PhaseFunctionSample)
+        .value("MediumEvaluate", ProfilerPhase::MediumEvaluate)
+        .value("MediumSample", ProfilerPhase::MediumSample)
+        .value("EndpointEvaluate", ProfilerPhase::EndpointEvaluate)
+        .value("EndpointSampleRay", ProfilerPhase::EndpointSampleRay)
+        .value("EndpointSampleDirection", ProfilerPhase::EndpointSampleDirection)
+        .value("TextureSample", ProfilerPhase::TextureSample)
+        .value("TextureEvaluate", ProfilerPhase::TextureEvaluate);
+
+    py::class_<ProfilerCounters>(m, "ProfilerCounters", D(ProfilerCounters))
+        .def_readonly("samples", &ProfilerCounters::samples, D(ProfilerCounters, samples))
+        .def_readonly("cycles", &ProfilerCounters::cycles, D(ProfilerCounters, cycles))
+        .def_readonly("instructions", &ProfilerCounters::instructions,
+                      D(ProfilerCounters, instructions))
+        .def_readonly("cache_misses", &ProfilerCounters::cache_misses,
+                      D(ProfilerCounters, cache_misses))
+        .def_readonly("branch_misses", &ProfilerCounters::branch_misses,
+                      D(ProfilerCounters, branch_misses))
+        .def_method(ProfilerCounters, ipc)
+        .def_method(ProfilerCounters, cache_mpki)
+        .def_method(ProfilerCounters, branch_mpki)
+        .def("__repr__", [](const ProfilerCounters &c) {
+            return tfm::format("ProfilerCounters[samples=%i, ipc=%.2f, cache_mpki=%.2f, "
+                               "branch_mpki=%.2f]", c.samples, c.ipc(), c.cache_mpki(),
+                               c.branch_mpki());
+        });
+
+    py::class_<Profiler, std::unique_ptr<Profiler, py::nodelete>>(m, "Profiler", D(Profiler))
+        .def_static("static_initialization", &Profiler::static_initialization,
+                    D(Profiler, static_initialization))
+        .def_static("static_shutdown", &Profiler::static_shutdown,
+                    D(Profiler, static_shutdown))
+        .def_static("print_report", &Profiler::print_report, D(Profiler, print_report))
+        .def_static("set_sampling_rate", &Profiler::set_sampling_rate, "rate"_a,
+                    D(Profiler, set_sampling_rate))
+        .def_static("enable_counters", &Profiler::enable_counters,
+                    D(Profiler, enable_counters))
+        .def_static("counters", &Profiler::counters, D(Profiler, counters))
+        .def_static("start_tracing", &Profiler::start_tracing,
+                    "phase_mask"_a = (uint64_t) -1, D(Profiler, start_tracing))
+        .def_static("stop_tracing", &Profiler::stop_tracing, D(Profiler, stop_tracing))
+        .def_static("write_trace", &Profiler::write_trace, "filename"_a,
+                    D(Profiler, write_trace));
+}
@@ -0,0 +1,34 @@
+#include <mitsuba/core/statistics.h>
+#include <mitsuba/python/python.h>
+
+MTS_PY_EXPORT(Statistics) {
+    py::enum_<StatisticsCounter>(m, "StatisticsCounter", D(StatisticsCounter))
+        .value("RaysTraced", StatisticsCounter::RaysTraced)
+        .value("ShadowRaysTraced", StatisticsCounter::ShadowRaysTraced)
+        .value("KDTreeNodesVisited", StatisticsCounter::KDTreeNodesVisited)
+        .value("KDTreePrimitiveTests", StatisticsCounter::KDTreePrimitiveTests)
+        .value("PathsTraced", StatisticsCounter::PathsTraced)
+        .value("MediumNullCollisions", StatisticsCounter::MediumNullCollisions)
+        .value("MediumRealCollisions", StatisticsCounter::MediumRealCollisions)
+        .value("StructConverterCacheHits", StatisticsCounter::StructConverterCacheHits)
+        .value("StructConverterCacheMisses", StatisticsCounter::StructConverterCacheMisses)
+        .value("CompiledMeshCacheHits", StatisticsCounter::CompiledMeshCacheHits)
+        .value("CompiledMeshCacheMisses", StatisticsCounter::CompiledMeshCacheMisses);
+
+    py::enum_<StatisticsHistogram>(m, "StatisticsHistogram", D(StatisticsHistogram))
+        .value("PathLength", StatisticsHistogram::PathLength)
+        .value("KDTreeNodesPerRay", StatisticsHistogram::KDTreeNodesPerRay);
+
+    py::class_<Statistics, std::unique_ptr<Statistics, py::nodelete>>(m, "Statistics", D(Statistics))
+        .def_static("enabled", &Statistics::enabled, D(Statistics, enabled))
+        .def_static("reset", &Statistics::reset, D(Statistics, reset))
+        .def_static("counter", &Statistics::counter, "counter"_a, D(Statistics, counter))
+        .def_static("histogram", &Statistics::histogram, "histogram"_a,
+                    D(Statistics, histogram))
+        .def_static("histogram_mean", &Statistics::histogram_mean, "histogram"_a,
+                    D(Statistics, histogram_mean))
+        .def_static("elapsed", &Statistics::elapsed, D(Statistics, elapsed))
+        .def_static("print_report", &Statistics::print_report, D(Statistics, print_report))
+        .def_static("write_json", &Statistics::write_json, "filename"_a,
+                    D(Statistics, write_json));
+}
@@ -151,6 +151,8 @@ MTS_PY_EXPORT(Struct) {
         .def(py::init<const Struct *, const Struct *, bool>(), "source"_a, "target"_a, "dither"_a = false)
         .def_method(StructConverter, source)
         .def_method(StructConverter, target)
+        .def_method(StructConverter, vectorized)
+        .def_static_method(StructConverter, cache_statistics)
         .def("convert", [](const StructConverter &c, py::bytes input_) -> py::bytes {
             std::string input(input_);
             size_t count = input.length() / c.source()->size();
@@ -116,6 +116,30 @@ MTS_PY_EXPORT(warp) {
           vectorize(warp::square_to_uniform_cone_pdf<true, Float>),
           "v"_a, "cos_cutoff"_a, D(warp, square_to_uniform_cone_pdf));
 
+    m.def("spherical_triangle_solid_angle",
+          vectorize(warp::spherical_triangle_solid_angle<Float>),
+          "a"_a, "b"_a, "c"_a, D(warp, spherical_triangle_solid_angle));
+
+    m.def("square_to_spherical_triangle",
+          vectorize(warp::square_to_spherical_triangle<Float>),
+          "sample"_a, "a"_a, "b"_a, "c"_a, D(warp, square_to_spherical_triangle));
+
+    m.def("square_to_spherical_triangle_pdf",
+          vectorize(warp::square_to_spherical_triangle_pdf<Float>),
+          "a"_a, "b"_a, "c"_a, D(warp, square_to_spherical_triangle_pdf));
+
+    m.def("spherical_rectangle_solid_angle",
+          vectorize(warp::spherical_rectangle_solid_angle<Float>),
+          "p0"_a, "p1"_a, "z"_a, D(warp, spherical_rectangle_solid_angle));
+
+    m.def("square_to_spherical_rectangle",
+          vectorize(warp::square_to_spherical_rectangle<Float>),
+          "sample"_a, "p0"_a, "p1"_a, "z"_a, D(warp, square_to_spherical_rectangle));
+
+    m.def("square_to_spherical_rectangle_pdf",
+          vectorize(warp::square_to_spherical_rectangle_pdf<Float>),
+          "p0"_a, "p1"_a, "z"_a, D(warp, square_to_spherical_rectangle_pdf));
+
     m.def("square_to_beckmann",
           vectorize(warp::square_to_beckmann<Float>),
           "sample"_a, "alpha"_a, D(warp, square_to_beckmann));
@@ -10,7 +10,7 @@ MTS_PY_EXPORT(xml) {
 
     m.def(
         "load_file",
-        [](const std::string &name, bool update_scene, py::kwargs kwargs) {
+        [](const std::string &name, bool update_scene, bool load_report, py::kwargs kwargs) {
             xml::ParameterList param;
             if (kwargs) {
                 for (auto [k, v] : kwargs)
@@ -22,9 +22,10 @@ MTS_PY_EXPORT(xml) {
             py::gil_scoped_release release;
             return cast_object(
                 xml::load_file(
-                    name, mitsuba::detail::get_variant<Float, Spectrum>(), param, update_scene));
+                    name, mitsuba::detail::get_variant<Float, Spectrum>(), param,
+                    update_scene, load_report));
         },
-        "path"_a, "update_scene"_a = false, D(xml, load_file));
+        "path"_a, "update_scene"_a = false, "load_report"_a = false, D(xml, load_file));
 
     m.def(
         "load_string",
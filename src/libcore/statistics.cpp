@@ -0,0 +1,183 @@
+#include <mitsuba/core/statistics.h>
+#include <mitsuba/core/filesystem.h>
+#include <mitsuba/core/logger.h>
+#include <mitsuba/core/util.h>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+NAMESPACE_BEGIN(mitsuba)
+
+static std::chrono::steady_clock::time_point statistics_start =
+    std::chrono::steady_clock::now();
+
+#if defined(MTS_ENABLE_STATISTICS)
+
+static std::mutex statistics_mutex;
+/// Statistics of all threads that ever recorded an event (they outlive their thread)
+static std::vector<std::unique_ptr<StatisticsData>> statistics_threads;
+
+static StatisticsData *statistics_register_thread() {
+    std::unique_ptr<StatisticsData> data(new StatisticsData());
+    memset(data.get(), 0, sizeof(StatisticsData));
+
+    std::lock_guard<std::mutex> guard(statistics_mutex);
+    statistics_threads.push_back(std::move(data));
+    return statistics_threads.back().get();
+}
+
+static thread_local StatisticsData *statistics_data_storage = nullptr;
+
+StatisticsData *statistics_data() {
+    StatisticsData *data = statistics_data_storage;
+    if (unlikely(!data))
+        data = statistics_data_storage = statistics_register_thread();
+    return data;
+}
+
+bool Statistics::enabled() { return true; }
+
+void Statistics::reset() {
+    std::lock_guard<std::mutex> guard(statistics_mutex);
+    for (auto &data : statistics_threads)
+        memset(data.get(), 0, sizeof(StatisticsData));
+    statistics_start = std::chrono::steady_clock::now();
+}
+
+uint64_t Statistics::counter(StatisticsCounter counter) {
+    std::lock_guard<std::mutex> guard(statistics_mutex);
+    uint64_t result = 0;
+    for (auto &data : statistics_threads)
+        result += data->counters[int(counter)];
+    return result;
+}
+
+std::vector<uint64_t> Statistics::histogram(StatisticsHistogram histogram) {
+    std::lock_guard<std::mutex> guard(statistics_mutex);
+    std::vector<uint64_t> result(MTS_STATISTICS_HISTOGRAM_BINS, 0);
+    for (auto &data : statistics_threads) {
+        for (size_t i = 0; i < MTS_STATISTICS_HISTOGRAM_BINS; ++i)
+            result[i] += data->histograms[int(histogram)].bins[i];
+    }
+    return result;
+}
+
+double Statistics::histogram_mean(StatisticsHistogram histogram) {
+    std::lock_guard<std::mutex> guard(statistics_mutex);
+    uint64_t count = 0, sum = 0;
+    for (auto &data : statistics_threads) {
+        count += data->histograms[int(histogram)].count;
+        sum += data->histograms[int(histogram)].sum;
+    }
+    return count == 0 ? 0.0 : sum / (double) count;
+}
+
+#else
+
+bool Statistics::enabled() { return false; }
+void Statistics::reset() { statistics_start = std::chrono::steady_clock::now(); }
+uint64_t Statistics::counter(StatisticsCounter) { return 0; }
+
+std::vector<uint64_t> Statistics::histogram(StatisticsHistogram) {
+    return std::vector<uint64_t>(MTS_STATISTICS_HISTOGRAM_BINS, 0);
+}
+
+double Statistics::histogram_mean(StatisticsHistogram) { return 0.0; }
+
+#endif
+
+double Statistics::elapsed() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         statistics_start).count();
+}
+
+/// Return the smallest value whose bin contains the given fraction of all entries
+static uint64_t histogram_percentile(const std::vector<uint64_t> &bins,
+                                     uint32_t bin_width, double fraction) {
+    uint64_t total = 0, accum = 0;
+    for (uint64_t value : bins)
+        total += value;
+    for (size_t i = 0; i < bins.size(); ++i) {
+        accum += bins[i];
+        if (accum > 0 && accum >= fraction * total)
+            return (uint64_t) i * bin_width;
+    }
+    return 0;
+}
+
+void Statistics::print_report() {
+    if (!enabled())
+        return;
+
+    double elapsed = Statistics::elapsed();
+    Log(Info, "\U0001F4CA Statistics (%s):", util::time_string(elapsed * 1000.0));
+
+    for (int i = 0; i < int(StatisticsCounter::StatisticsCounterCount); ++i) {
+        uint64_t value = counter(StatisticsCounter(i));
+        if (value == 0)
+            continue;
+        std::string name = statistics_counter_id[i];
+        Log(Info, "    %s%s%12i  (%.2f M/s)", name, std::string(32 - name.length(), ' '),
+            value, value / (elapsed * 1e6));
+    }
+
+    for (int i = 0; i < int(StatisticsHistogram::StatisticsHistogramCount); ++i) {
+        auto bins = histogram(StatisticsHistogram(i));
+        uint32_t width = statistics_histogram_bin_width[i];
+        uint64_t count = 0;
+        for (uint64_t value : bins)
+            count += value;
+        if (count == 0)
+            continue;
+
+        std::string name = statistics_histogram_id[i];
+        Log(Info, "    %s%smean %.2f, median %i, 99th percentile %i", name,
+            std::string(32 - name.length(), ' '),
+            histogram_mean(StatisticsHistogram(i)),
+            histogram_percentile(bins, width, .5),
+            histogram_percentile(bins, width, .99));
+    }
+
+    uint64_t rays = counter(StatisticsCounter::RaysTraced),
+             paths = counter(StatisticsCounter::PathsTraced);
+    if (rays > 0 && paths > 0)
+        Log(Info, "    Rays per path%s%.2f", std::string(32 - 13, ' '),
+            rays / (double) paths);
+}
+
+void Statistics::write_json(const fs::path &filename) {
+    std::ofstream os(filename.native());
+    if (!os.good())
+        Throw("Statistics::write_json(): unable to open \"%s\"!", filename);
+
+    os << "{" << std::endl
+       << "  \"enabled\": " << (enabled() ? "true" : "false") << "," << std::endl
+       << "  \"elapsed\": " << tfm::format("%.6f", elapsed()) << "," << std::endl
+       << "  \"counters\": {";
+
+    for (int i = 0; i < int(StatisticsCounter::StatisticsCounterCount); ++i)
+        os << (i == 0 ? "" : ",") << std::endl << "    \"" << statistics_counter_id[i]
+           << "\": " << counter(StatisticsCounter(i));
+
+    os << std::endl << "  }," << std::endl << "  \"histograms\": {";
+
+    for (int i = 0; i < int(StatisticsHistogram::StatisticsHistogramCount); ++i) {
+        auto bins = histogram(StatisticsHistogram(i));
+        os << (i == 0 ? "" : ",") << std::endl << "    \"" << statistics_histogram_id[i]
+           << "\": {" << std::endl
+           << "      \"bin_width\": " << statistics_histogram_bin_width[i] << "," << std::endl
+           << "      \"mean\": " << tfm::format("%.6f", histogram_mean(StatisticsHistogram(i)))
+           << "," << std::endl << "      \"bins\": [";
+        for (size_t j = 0; j < bins.size(); ++j)
+            os << (j == 0 ? "" : ", ") << bins[j];
+        os << "]" << std::endl << "    }";
+    }
+
+    os << std::endl << "  }" << std::endl << "}" << std::endl;
+
+    if (!os.good())
+        Throw("Statistics::write_json(): error while writing \"%s\"!", filename);
+}
+
+NAMESPACE_END(mitsuba)
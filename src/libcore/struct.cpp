@@ -1,6 +1,7 @@
 #include <mitsuba/core/struct.h>
 #include <mitsuba/core/logger.h>
 #include <mitsuba/core/math.h>
+#include <mitsuba/core/statistics.h>
 #include <mitsuba/core/stream.h>
 #include <mitsuba/core/hash.h>
 #include <mitsuba/core/jit.h>
@@ -8,6 +9,7 @@
 #include <enoki/half.h>
 #include <enoki/color.h>
 #include <unordered_map>
+#include <atomic>
 #include <ostream>
 #include <map>
 
@@ -1214,28 +1216,48 @@ size_t hash(const Struct &s) {
                         hash(s.m_byte_order));
 }
 
-static std::unordered_map<
-           std::pair<ref<const Struct>, ref<const Struct>>, void *,
-    hasher<std::pair<ref<const Struct>, ref<const Struct>>>,
-    comparator<std::pair<ref<const Struct>, ref<const Struct>>>> __cache;
+#if MTS_STRUCTCONVERTER_USE_JIT == 1
+/// Process-wide cache of compiled conversion kernels: (source, target), dither -> kernel
+using StructConverterKey =
+    std::pair<std::pair<ref<const Struct>, ref<const Struct>>, bool>;
+
+static std::unordered_map<StructConverterKey, void *,
+                          hasher<StructConverterKey>,
+                          comparator<StructConverterKey>> __cache;
+#endif
+
+static std::atomic<size_t> __cache_hits { 0 }, __cache_misses { 0 };
 
 StructConverter::StructConverter(const Struct *source, const Struct *target, bool dither)
- : m_source(source), m_target(target) {
+ : m_source(source), m_target(target), m_dither(dither) {
+    prepare_packet();
+
 #if MTS_STRUCTCONVERTER_USE_JIT == 1
     using namespace asmjit;
 
+    // No kernel is needed when the wide SIMD backend handles the conversion
+    m_func = nullptr;
+    if (m_vectorized)
+        return;
+
     // Use the Jit instance to cache structure converters
     auto jit = Jit::get_instance();
     std::lock_guard<std::mutex> guard(jit->mutex);
 
-    auto key = std::make_pair(ref<const Struct>(source), ref<const Struct>(target));
+    StructConverterKey key(
+        std::make_pair(ref<const Struct>(source), ref<const Struct>(target)),
+        dither);
     auto it = __cache.find(key);
 
     if (it != __cache.end()) {
         // Cache hit
         m_func = ptr_as_func<FuncType>(it->second);
+        __cache_hits++;
+        statistics_add(StatisticsCounter::StructConverterCacheHits);
         return;
     }
+    __cache_misses++;
+    statistics_add(StatisticsCounter::StructConverterCacheMisses);
 
     CodeHolder code;
     code.init(jit->runtime.getCodeInfo());
@@ -1458,12 +1480,253 @@ StructConverter::StructConverter(const Struct *source, const Struct *target, boo
        Log(Info, "Assembly:\n%s", logger.getString());
     #endif
 
+    /* Store private copies of the descriptors so that later modifications
+       of 'source' and 'target' by the caller cannot invalidate the cache */
+    key.first = std::make_pair(ref<const Struct>(new Struct(*source)),
+                               ref<const Struct>(new Struct(*target)));
     __cache[key] = (void *) m_func;
-#else
-    m_dither = dither;
 #endif
 }
 
+std::pair<size_t, size_t> StructConverter::cache_statistics() {
+    return { __cache_hits.load(), __cache_misses.load() };
+}
+
+NAMESPACE_BEGIN(detail)
+
+/// Field types supported by the wide SIMD conversion backend
+static bool packet_supported(Struct::Type type) {
+    return type == Struct::Type::UInt8 || type == Struct::Type::UInt16 ||
+           type == Struct::Type::Float16 || type == Struct::Type::Float32;
+}
+
+/// Load and linearize a field of up to <tt>array_size_v<FloatP></tt> records
+template <typename FloatP>
+FloatP packet_load(const uint8_t *src, size_t stride, const Struct::Field &f, size_t n) {
+    alignas(alignof(FloatP)) float buf[array_size_v<FloatP>] = { };
+    src += f.offset;
+
+    switch (f.type) {
+        case Struct::Type::UInt8:
+            for (size_t i = 0; i < n; ++i)
+                buf[i] = (float) src[i * stride];
+            break;
+
+        case Struct::Type::UInt16:
+            for (size_t i = 0; i < n; ++i) {
+                uint16_t value;
+                memcpy(&value, src + i * stride, sizeof(uint16_t));
+                buf[i] = (float) value;
+            }
+            break;
+
+        case Struct::Type::Float16:
+            for (size_t i = 0; i < n; ++i) {
+                uint16_t value;
+                memcpy(&value, src + i * stride, sizeof(uint16_t));
+                buf[i] = enoki::half::float16_to_float32(value);
+            }
+            break;
+
+        case Struct::Type::Float32:
+            for (size_t i = 0; i < n; ++i)
+                memcpy(buf + i, src + i * stride, sizeof(float));
+            break;
+
+        default: Throw("StructConverter: unsupported field type!");
+    }
+
+    FloatP value = load<FloatP>(buf);
+
+    if (f.is_integer() && has_flag(f.flags, Struct::Flags::Normalized))
+        value *= float(1.0 / f.range().second);
+
+    if (has_flag(f.flags, Struct::Flags::Gamma))
+        value = srgb_to_linear(value);
+
+    return value;
+}
+
+/// Quantize and store a field of up to <tt>array_size_v<FloatP></tt> records
+template <typename FloatP>
+void packet_save(uint8_t *dst, size_t stride, const Struct::Field &f,
+                 FloatP value, const FloatP *dither, size_t n) {
+    alignas(alignof(FloatP)) float buf[array_size_v<FloatP>];
+    dst += f.offset;
+
+    if (has_flag(f.flags, Struct::Flags::Gamma))
+        value = linear_to_srgb(value);
+
+    if (f.is_integer()) {
+        auto range = f.range();
+        if (has_flag(f.flags, Struct::Flags::Normalized)) {
+            value *= float(range.second);
+            if (dither)
+                value += *dither;
+        }
+        value = min(max(round(value), float(range.first)), float(range.second));
+    }
+
+    store<FloatP>(buf, value);
+
+    switch (f.type) {
+        case Struct::Type::UInt8:
+            for (size_t i = 0; i < n; ++i)
+                dst[i * stride] = (uint8_t) buf[i];
+            break;
+
+        case Struct::Type::UInt16:
+            for (size_t i = 0; i < n; ++i) {
+                uint16_t result = (uint16_t) buf[i];
+                memcpy(dst + i * stride, &result, sizeof(uint16_t));
+            }
+            break;
+
+        case Struct::Type::Float16:
+            for (size_t i = 0; i < n; ++i) {
+                uint16_t result = enoki::half::float32_to_float16(buf[i]);
+                memcpy(dst + i * stride, &result, sizeof(uint16_t));
+            }
+            break;
+
+        case Struct::Type::Float32:
+            for (size_t i = 0; i < n; ++i)
+                memcpy(dst + i * stride, buf + i, sizeof(float));
+            break;
+
+        default: Throw("StructConverter: unsupported field type!");
+    }
+}
+
+NAMESPACE_END(detail)
+
+void StructConverter::prepare_packet() {
+    using namespace mitsuba::detail;
+
+    m_vectorized = false;
+    m_packet_fields.clear();
+    m_packet_has_weight = false;
+
+    if (m_source->byte_order() != Struct::host_byte_order() ||
+        m_target->byte_order() != Struct::host_byte_order())
+        return;
+
+    bool has_alpha = false;
+    for (const Struct::Field &f : *m_source) {
+        if (!packet_supported(f.type) || has_flag(f.flags, Struct::Flags::Assert))
+            return;
+        if (has_flag(f.flags, Struct::Flags::Weight)) {
+            if (m_packet_has_weight)
+                return;
+            m_packet_weight = f;
+            m_packet_has_weight = true;
+        }
+        has_alpha |= has_flag(f.flags, Struct::Flags::Alpha);
+    }
+
+    for (const Struct::Field &f : *m_target) {
+        if (!packet_supported(f.type) || !f.blend.empty())
+            return;
+        if (has_flag(f.flags, Struct::Flags::Weight))
+            m_packet_has_weight = false;
+    }
+
+    uint32_t flag_mask = Struct::Flags::Normalized | Struct::Flags::Gamma,
+             special_channels_mask = Struct::Flags::Weight | Struct::Flags::Alpha;
+
+    for (const Struct::Field &f : *m_target) {
+        PacketField pf;
+        pf.target = f;
+        pf.has_source = m_source->has_field(f.name);
+
+        if (pf.has_source)
+            pf.source = m_source->field(f.name);
+        else if (!has_flag(f.flags, Struct::Flags::Default))
+            return;
+
+        /* Alpha (un)premultiplication is left to the per-record backend */
+        uint32_t source_flags = pf.has_source ? pf.source.flags : 0u;
+        if (has_alpha && (f.flags & special_channels_mask) == 0 &&
+            has_flag(source_flags, Struct::Flags::PremultipliedAlpha) !=
+            has_flag(f.flags, Struct::Flags::PremultipliedAlpha))
+            return;
+
+        /* The per-record backend copies unnormalized integers without
+           linearizing them, so narrowing conversions truncate instead of
+           saturating. Leave those to it so that both backends agree. */
+        if (pf.has_source && !m_packet_has_weight && pf.source.type != f.type &&
+            pf.source.is_integer() && f.is_integer() &&
+            !has_flag(f.flags, Struct::Flags::Normalized) &&
+            (pf.source.flags & flag_mask) == (f.flags & flag_mask))
+            return;
+
+        pf.passthrough = pf.has_source && !m_packet_has_weight &&
+                         pf.source.type == f.type &&
+                         (pf.source.flags & flag_mask) == (f.flags & flag_mask);
+
+        m_packet_fields.push_back(pf);
+    }
+
+    m_vectorized = true;
+}
+
+bool StructConverter::convert_2d_packet(size_t width, size_t height,
+                                        const void *src_, void *dest_) const {
+    using namespace mitsuba::detail;
+    using FloatP  = Packet<float>;
+    using UInt32P = uint32_array_t<FloatP>;
+    constexpr size_t Size = array_size_v<FloatP>;
+
+    size_t source_size = m_source->size();
+    size_t target_size = m_target->size();
+
+    const uint8_t *src = (const uint8_t *) src_;
+    uint8_t *dest = (uint8_t *) dest_;
+
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; x += Size) {
+            size_t n = std::min(Size, width - x);
+
+            FloatP inv_weight(1.f);
+            if (m_packet_has_weight)
+                inv_weight = 1.f / packet_load<FloatP>(src, source_size, m_packet_weight, n);
+
+            FloatP dither(0.f);
+            if (m_dither) {
+                UInt32P index = (UInt32P((uint32_t) (y & 255)) << 8) |
+                                ((UInt32P((uint32_t) x) + arange<UInt32P>()) & 255u);
+                dither = gather<FloatP>(dither_matrix256, index);
+            }
+
+            for (const PacketField &pf : m_packet_fields) {
+                const Struct::Field &f = pf.target;
+
+                if (pf.passthrough) {
+                    for (size_t i = 0; i < n; ++i)
+                        memcpy(dest + i * target_size + f.offset,
+                               src + i * source_size + pf.source.offset, f.size);
+                    continue;
+                }
+
+                FloatP value = pf.has_source
+                    ? packet_load<FloatP>(src, source_size, pf.source, n)
+                    : FloatP((float) f.default_);
+
+                if (m_packet_has_weight)
+                    value *= inv_weight;
+
+                packet_save<FloatP>(dest, target_size, f, value,
+                                    m_dither ? &dither : nullptr, n);
+            }
+
+            src  += n * source_size;
+            dest += n * target_size;
+        }
+    }
+
+    return true;
+}
+
 #if MTS_STRUCTCONVERTER_USE_JIT == 0
 
 bool StructConverter::load(const uint8_t *src, const Struct::Field &f, Value &value) const {
@@ -1722,6 +1985,9 @@ void StructConverter::save(uint8_t *dst, const Struct::Field &f, Value value, si
 bool StructConverter::convert_2d(size_t width, size_t height, const void *src_, void *dest_) const {
     using namespace mitsuba::detail;
 
+    if (m_vectorized)
+        return convert_2d_packet(width, height, src_, dest_);
+
     size_t source_size = m_source->size();
     size_t target_size = m_target->size();
     Struct::Field weight_field, alpha_field;
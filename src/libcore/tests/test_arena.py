@@ -0,0 +1,78 @@
+import mitsuba
+import pytest
+
+
+def test01_alignment(variant_scalar_rgb):
+    from mitsuba.core import MemoryArena
+
+    arena = MemoryArena(1024)
+    for alignment in [1, 4, 16, 64, 256]:
+        assert arena.allocate(3, alignment) % alignment == 0
+    assert arena.allocation_count() == 5
+
+    with pytest.raises(RuntimeError):
+        arena.allocate(16, 3)
+
+
+def test02_large_allocation(variant_scalar_rgb):
+    from mitsuba.core import MemoryArena
+
+    arena = MemoryArena(1024)
+    arena.allocate(100)
+    arena.allocate(4096)
+    assert arena.chunk_count() == 2
+    assert arena.capacity() >= 1024 + 4096
+    assert arena.used() >= 1024 + 4096
+
+
+def test03_rewind(variant_scalar_rgb):
+    from mitsuba.core import MemoryArena
+
+    arena = MemoryArena(1024)
+    arena.allocate(100)
+    marker = arena.mark()
+    used = arena.used()
+    p0 = arena.allocate(200)
+    arena.allocate(2000)
+    arena.rewind(marker)
+    assert arena.used() == used
+    assert arena.allocate(200) == p0
+
+    # The chunk that was allocated after the marker is reused
+    heap = arena.heap_allocation_count()
+    arena.allocate(2000)
+    assert arena.heap_allocation_count() == heap
+
+
+def test04_steady_state(variant_scalar_rgb):
+    from mitsuba.core import MemoryArena
+
+    arena = MemoryArena(1024)
+
+    def block():
+        for i in range(100):
+            arena.allocate(64)
+        arena.reset()
+        assert arena.used() == 0
+
+    # The chunks are merged by the first reset ..
+    block()
+    assert arena.chunk_count() == 1
+    assert arena.capacity() >= 6400
+
+    # .. after which further blocks don't touch the heap anymore
+    heap = arena.heap_allocation_count()
+    for i in range(10):
+        block()
+    assert arena.heap_allocation_count() == heap
+
+
+def test05_thread_arena(variant_scalar_rgb):
+    from mitsuba.core import MemoryArena
+
+    arena = MemoryArena.thread()
+    count = arena.allocation_count()
+    marker = arena.mark()
+    arena.allocate(16)
+    arena.rewind(marker)
+    assert MemoryArena.thread().allocation_count() == count + 1
@@ -244,3 +244,97 @@ def test_accumulate():
     # but (row, column) in arrays.
     b1.accumulate(b2, [5, 3], [3, 1], [1, 5])
     assert np.all(np.array(b1, copy=False) == ref)
+
+
+@pytest.mark.parametrize('channels', [1, 3, 4])
+def test_resample_box_downsample(channels):
+    # A box filter halving the resolution averages 2x2 blocks of pixels
+    rfilter = mitsuba.core.xml.load_string("<rfilter version='2.0.0' type='box'/>")
+    b = Bitmap(Bitmap.PixelFormat.MultiChannel, Struct.Type.Float32, [62, 38], channels)
+    data = np.random.RandomState(1).uniform(size=(38, 62, channels)).astype(np.float32)
+    np.array(b, copy=False)[:] = data
+
+    ref = data.reshape(19, 2, 31, 2, channels).mean(axis=(1, 3))
+    result = np.array(b.resample([31, 19], rfilter), copy=False)
+    assert np.allclose(result, ref, atol=1e-6)
+
+
+@pytest.mark.parametrize('bc', [FilterBoundaryCondition.Clamp,
+                                FilterBoundaryCondition.Zero,
+                                FilterBoundaryCondition.One])
+def test_resample_channels_interleaved(bc):
+    # Resampling an RGB image must match resampling each channel separately
+    b = Bitmap(Bitmap.PixelFormat.RGB, Struct.Type.Float32, [45, 33])
+    data = np.random.RandomState(2).uniform(size=(33, 45, 3)).astype(np.float32)
+    np.array(b, copy=False)[:] = data
+
+    for res in [[17, 80], [90, 21], [45, 33]]:
+        result = np.array(b.resample(res, bc=(bc, bc)), copy=False)
+        for ch in range(3):
+            c = Bitmap(Bitmap.PixelFormat.Y, Struct.Type.Float32, [45, 33])
+            np.array(c, copy=False)[:, :, 0] = data[:, :, ch]
+            ref = np.array(c.resample(res, bc=(bc, bc)), copy=False)
+            assert np.allclose(result[:, :, ch], ref[:, :, 0], atol=1e-5)
+
+
+def test_resample_weight_table_cache():
+    # Filters whose parameters differ only slightly must not share weight tables
+    b = Bitmap(Bitmap.PixelFormat.Y, Struct.Type.Float32, [40, 30])
+    np.array(b, copy=False)[:] = np.random.RandomState(3).uniform(size=(30, 40, 1))
+
+    results = []
+    for stddev in [0.5, 0.502, 0.5]:
+        rfilter = mitsuba.core.xml.load_string(
+            "<rfilter version='2.0.0' type='gaussian'>"
+            "<float name='stddev' value='%f'/></rfilter>" % stddev)
+        results.append(np.array(b.resample([17, 13], rfilter)))
+
+    assert not np.allclose(results[0], results[1], rtol=0, atol=1e-7)
+    assert np.all(results[0] == results[2])
+
+
+def test_write_async(tmpdir):
+    from mitsuba.core import WriteQueue
+    queue = WriteQueue.instance()
+    completed = queue.writes_completed()
+
+    handles = []
+    for i in range(20):
+        b = Bitmap(Bitmap.PixelFormat.RGB, Struct.Type.Float32, [16, 8])
+        np.array(b, copy=False)[:] = i
+        handles.append(b.write_async(os.path.join(str(tmpdir), 'out_%i.exr' % i)))
+        # The queue is bounded
+        assert queue.pending() <= queue.capacity() + queue.thread_count()
+
+    for h in handles:
+        h.wait()
+        assert h.done()
+    assert queue.writes_completed() - completed == 20
+    assert queue.bytes_written() > 0
+
+    for i in range(20):
+        b = Bitmap(os.path.join(str(tmpdir), 'out_%i.exr' % i))
+        assert np.all(np.array(b, copy=False) == i)
+
+    # Errors are reported through the handle
+    h = b.write_async(os.path.join(str(tmpdir), 'missing_dir', 'out.exr'))
+    with pytest.raises(Exception):
+        h.wait()
+    queue.wait()
+    assert queue.pending() == 0
+
+
+@pytest.mark.slow
+def test_resample_throughput():
+    # Reports the throughput of a typical texture MIP-map level computation
+    import time
+    b = Bitmap(Bitmap.PixelFormat.RGBA, Struct.Type.Float32, [2048, 1024])
+    np.array(b, copy=False)[:] = np.random.uniform(size=(1024, 2048, 4))
+
+    for res in [[1024, 512], [4096, 2048]]:
+        b.resample(res)  # warm up (and populate the weight table cache)
+        t0 = time.time()
+        b.resample(res)
+        elapsed = time.time() - t0
+        print('Bitmap.resample(%s): %.1f MPix/s' %
+              (res, res[0] * res[1] / elapsed * 1e-6))
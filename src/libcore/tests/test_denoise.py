@@ -0,0 +1,37 @@
+import mitsuba
+import pytest
+import numpy as np
+
+
+def test01_constant(variant_scalar_rgb):
+    from mitsuba.core import denoise_atrous
+
+    # A constant image is a fixed point of the filter (including the borders)
+    color = np.full((17, 23, 3), 0.5, dtype=np.float32)
+    result = denoise_atrous(color)
+    assert result.shape == color.shape
+    assert np.allclose(result, 0.5, atol=1e-6)
+
+    with pytest.raises(RuntimeError):
+        denoise_atrous(np.zeros((17, 23, 4), dtype=np.float32))
+    with pytest.raises(RuntimeError):
+        denoise_atrous(color, [(np.zeros((16, 23, 1), dtype=np.float32), 0.1)])
+
+
+def test02_guided(variant_scalar_rgb):
+    from mitsuba.core import denoise_atrous
+
+    # Noise is removed, but not across the edge in the guide
+    np.random.seed(0)
+    reference = np.full((40, 40, 3), 0.1, dtype=np.float32)
+    reference[:, 20:, :] = 1.0
+    guide = (reference[:, :, :1] > 0.5).astype(np.float32)
+    noisy = reference * np.random.uniform(0.5, 1.5, size=(40, 40, 1)).astype(np.float32)
+
+    result = denoise_atrous(noisy, [(guide, 0.1)], iterations=5)
+    noisy_error = np.abs(noisy - reference).mean()
+    assert np.abs(result - reference).mean() < 0.25 * noisy_error
+
+    # Both sides of the edge keep their mean
+    assert np.allclose(result[:, :20].mean(), 0.1, rtol=5e-2)
+    assert np.allclose(result[:, 20:].mean(), 1.0, rtol=5e-2)
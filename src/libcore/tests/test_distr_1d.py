@@ -302,3 +302,63 @@ def test18_irrcont_simple_function(variant_packet_rgb):
                 0.48734, 0.654313, 0.786607, 0.899653, 1.])
          * d.normalization())
     )
+
+
+def test19_alias_empty_invalid(variant_packet_rgb):
+    # Test that the alias distribution rejects the same inputs as DiscreteDistribution
+    from mitsuba.core import AliasDistribution
+
+    d = AliasDistribution()
+    assert d.empty()
+
+    with pytest.raises(RuntimeError) as excinfo:
+        d.update()
+    assert 'empty distribution' in str(excinfo.value)
+
+    with pytest.raises(RuntimeError) as excinfo:
+        AliasDistribution([0, 0, 0])
+    assert "no probability mass found" in str(excinfo.value)
+
+    with pytest.raises(RuntimeError) as excinfo:
+        AliasDistribution([1, -1, 1])
+    assert "entries must be non-negative" in str(excinfo.value)
+
+
+def test20_alias_basic(variant_packet_rgb):
+    from mitsuba.core import AliasDistribution, Float
+
+    x = AliasDistribution([1, 3, 2])
+    assert len(x) == 3
+    assert x.sum() == 6
+    assert ek.allclose(x.normalization(), 1.0 / 6.0)
+    assert x.eval_pmf([1, 2, 0]) == [3, 2, 1]
+    assert ek.allclose(x.eval_pmf_normalized([1, 2, 0]), Float([3, 2, 1]) / 6.0)
+
+    # Zero-valued entries are never sampled
+    y = AliasDistribution([0, 0, 1, 0, 1, 0, 0, 0])
+    index = y.sample(ek.linspace(Float, 0, 1, 100))
+    assert ek.all(ek.eq(index, 2) | ek.eq(index, 4))
+
+
+def test21_alias_bruteforce(variant_packet_rgb):
+    # Stratified samples must hit every entry in proportion to its probability
+    from mitsuba.core import AliasDistribution, Float, PCG32, UInt64
+    import numpy as np
+
+    rng = PCG32(initseq=UInt64.arange(50))
+    n = 10000
+
+    for size in range(2, 20):
+        density = Float(rng.next_uint32_bounded(10)[0:size])
+        if ek.hsum(density) == 0:
+            continue
+        distr = AliasDistribution(density)
+
+        x = (ek.arange(Float, n) + 0.5) / n
+        index, x_reuse, pmf = distr.sample_reuse_pmf(x)
+        counts = np.bincount(np.array(index), minlength=size)
+        expected = np.array(density) / ek.hsum(density) * n
+
+        assert np.all(np.abs(counts - expected) <= 2 * size)
+        assert ek.allclose(pmf, distr.eval_pmf_normalized(index))
+        assert ek.all((x_reuse >= 0) & (x_reuse <= 1))
@@ -0,0 +1,67 @@
+import mitsuba
+import pytest
+import numpy as np
+
+
+def test01_topology(variant_scalar_rgb):
+    from mitsuba.core import numa, util
+
+    assert numa.node_count() >= 1
+    cpus = [cpu for node in range(numa.node_count()) for cpu in numa.node_cpus(node)]
+    assert len(cpus) == len(set(cpus))
+    assert len(cpus) == util.core_count()
+
+    with pytest.raises(RuntimeError):
+        numa.node_cpus(numa.node_count())
+
+
+def test02_allocation_policy(variant_scalar_rgb):
+    from mitsuba.core import numa
+
+    assert numa.allocation_policy() == numa.AllocationPolicy.FirstTouch
+    numa.set_allocation_policy(numa.AllocationPolicy.Interleave)
+    assert numa.allocation_policy() == numa.AllocationPolicy.Interleave
+    numa.set_allocation_policy(numa.AllocationPolicy.FirstTouch)
+
+
+def test03_render_pinned(variant_scalar_rgb):
+    from mitsuba.core import numa
+    from mitsuba.core.xml import load_string
+
+    scene_xml = """<scene version="2.0.0">
+        <sensor type="perspective">
+            <film type="hdrfilm">
+                <integer name="width" value="64"/>
+                <integer name="height" value="48"/>
+                <rfilter type="box"/>
+            </film>
+            <sampler type="independent">
+                <integer name="sample_count" value="4"/>
+            </sampler>
+            <transform name="to_world">
+                <lookat origin="0, 0, 4" target="0, 0, 0" up="0, 1, 0"/>
+            </transform>
+        </sensor>
+        <integrator type="path"/>
+        <shape type="sphere"/>
+        <emitter type="constant"/>
+    </scene>"""
+
+    def render():
+        scene = load_string(scene_xml)
+        sensor = scene.sensors()[0]
+        assert scene.integrator().render(scene, sensor)
+        return np.array(sensor.film().bitmap(raw=True), copy=False).copy()
+
+    reference = render()
+
+    # Blocks are seeded deterministically, thread placement must not matter
+    numa.set_thread_pinning(True)
+    numa.set_allocation_policy(numa.AllocationPolicy.Interleave)
+    try:
+        image = render()
+    finally:
+        numa.set_thread_pinning(False)
+        numa.set_allocation_policy(numa.AllocationPolicy.FirstTouch)
+
+    assert np.allclose(image, reference)
@@ -0,0 +1,66 @@
+import json
+import pytest
+
+import mitsuba
+
+
+def test01_chrome_trace(variant_scalar_rgb, tmpdir):
+    from mitsuba.core import Profiler, ProfilerPhase
+    from mitsuba.core.xml import load_string
+
+    Profiler.start_tracing(1 << int(ProfilerPhase.InitScene))
+    for i in range(3):
+        load_string('<scene version="2.0.0"/>')
+    Profiler.stop_tracing()
+
+    # Not recorded: tracing has stopped
+    load_string('<scene version="2.0.0"/>')
+
+    path = str(tmpdir.join('trace.json'))
+    count = Profiler.write_trace(path)
+    if count == 0:
+        pytest.skip('Profiler is disabled in this build')
+
+    with open(path) as f:
+        trace = json.load(f)
+
+    events = [e for e in trace['traceEvents'] if e['ph'] in ['B', 'E']]
+    assert len(events) == count == 6
+    assert all(e['name'] == 'Scene initialization' for e in events)
+    assert [e['ph'] for e in events] == ['B', 'E'] * 3
+    assert all(events[i]['ts'] <= events[i + 1]['ts'] for i in range(5))
+
+    threads = [e for e in trace['traceEvents'] if e['ph'] == 'M']
+    assert len(threads) == 1 and threads[0]['tid'] == events[0]['tid']
+
+    # Restarting discards the previous events
+    Profiler.start_tracing(1 << int(ProfilerPhase.InitScene))
+    Profiler.stop_tracing()
+    assert Profiler.write_trace(path) == 0
+
+
+def test02_hardware_counters(variant_scalar_rgb):
+    from mitsuba.core import Profiler
+
+    if not Profiler.enable_counters():
+        pytest.skip('Hardware performance counters are unavailable')
+
+    Profiler.set_sampling_rate(1000)
+    Profiler.static_initialization()
+    value = 0
+    for i in range(2000000):
+        value += i * i
+
+    # Keep the profiler running (later tests may rely on it), but restore the
+    # default sampling rate
+    Profiler.set_sampling_rate(100)
+
+    counters = Profiler.counters()
+    if 'Idle' not in counters:
+        pytest.skip('No samples were recorded (running under a debugger?)')
+
+    c = counters['Idle']
+    assert c.samples > 0
+    assert c.instructions > 0 and c.cycles > 0
+    assert c.ipc() > 0
+    assert c.cache_misses <= c.instructions
@@ -2,6 +2,7 @@ import struct
 import numpy as np
 import pytest
 import itertools
+import platform
 import sys
 
 import mitsuba
@@ -447,3 +448,127 @@ def test19_alpha_4():
     dst_data = (src_data_float[0], src_data_float[1], src_data[2])
     check_conversion(s, '@BBB', '@BBB',
                      src_data, dst_data)
+
+
+@pytest.mark.parametrize('count', [1, 7, 17, 1001])
+def test20_vectorized_srgb(count):
+    """Tests the wide SIMD backend on many records (including a partial packet)"""
+    src_struct = Struct() \
+        .append('r', Struct.Type.UInt8, Struct.Flags.Normalized | Struct.Flags.Gamma) \
+        .append('g', Struct.Type.UInt16, Struct.Flags.Normalized) \
+        .append('b', Struct.Type.Float16) \
+        .append('weight', Struct.Type.Float32, Struct.Flags.Weight)
+    dst_struct = Struct() \
+        .append('r', Struct.Type.Float32) \
+        .append('g', Struct.Type.Float32) \
+        .append('b', Struct.Type.Float32) \
+        .append('a', Struct.Type.Float32, Struct.Flags.Default, 1.0)
+    s = StructConverter(src_struct, dst_struct)
+    assert s.vectorized()
+
+    rng = np.random.RandomState(0)
+    src = np.zeros(count, dtype=[('r', np.uint8), ('g', np.uint16),
+                                 ('b', np.float16), ('weight', np.float32)])
+    src['r'] = rng.randint(0, 256, count)
+    src['g'] = rng.randint(0, 65536, count)
+    src['b'] = rng.uniform(0, 4, count)
+    src['weight'] = rng.uniform(0.5, 2, count)
+
+    dst = np.frombuffer(s.convert(src.tobytes()), dtype=np.float32).reshape(count, 4)
+    ref_r = [from_srgb(v / 255.0) for v in src['r']]
+    ref_g = src['g'] / 65535.0
+    ref_b = src['b'].astype(np.float32)
+    # Like all other channels, the defaulted alpha channel is divided by the weight
+    ref = np.stack([ref_r, ref_g, ref_b, np.ones(count)], axis=1) \
+        / src['weight'][:, None]
+    assert np.allclose(dst, ref, rtol=1e-4, atol=1e-6)
+
+
+def test21_vectorized_quantize():
+    """Tests quantization to 8 bit sRGB and half precision on many records"""
+    src_struct = Struct() \
+        .append('r', Struct.Type.Float32) \
+        .append('g', Struct.Type.Float32)
+    dst_struct = Struct() \
+        .append('r', Struct.Type.UInt8, Struct.Flags.Normalized | Struct.Flags.Gamma) \
+        .append('g', Struct.Type.Float16)
+    s = StructConverter(src_struct, dst_struct)
+    assert s.vectorized()
+
+    count = 999
+    src = np.zeros((count, 2), dtype=np.float32)
+    src[:, 0] = np.linspace(-0.5, 1.5, count)
+    src[:, 1] = np.linspace(-10, 10, count)
+    dst = np.frombuffer(s.convert(src.tobytes()),
+                        dtype=[('r', np.uint8), ('g', np.float16)])
+
+    ref_r = [np.clip(np.round(to_srgb(np.clip(v, 0, 1)) * 255), 0, 255)
+             for v in src[:, 0]]
+    assert np.all(np.abs(dst['r'].astype(np.int32) - ref_r) <= 1)
+    assert np.all(dst['g'] == src[:, 1].astype(np.float16))
+
+
+def test22_vectorized_fallback():
+    """Conversions that are not supported by the SIMD backend still work"""
+    s1 = Struct().append('val', Struct.Type.Float64)
+    s2 = Struct().append('val', Struct.Type.Float32)
+    assert not StructConverter(s1, s2).vectorized()
+
+    s1 = Struct(byte_order=Struct.ByteOrder.BigEndian
+                if sys.byteorder == "little" else
+                Struct.ByteOrder.LittleEndian) \
+        .append('val', Struct.Type.UInt16)
+    assert not StructConverter(s1, s1).vectorized()
+
+
+def test23_kernel_cache():
+    """Identical conversions share a compiled kernel unless dithering differs"""
+    s1 = Struct().append('kernel_cache_test', Struct.Type.Float64)
+    s2 = Struct().append('kernel_cache_test', Struct.Type.UInt32)
+    hits, misses = StructConverter.cache_statistics()
+
+    check_conversion(StructConverter(s1, s2), '@d', '@I', (3,))
+    check_conversion(StructConverter(s1, s2), '@d', '@I', (4,))
+    check_conversion(StructConverter(s1, s2, True), '@d', '@I', (5,))
+
+    # Modifying a descriptor after use must not affect cached kernels
+    s1.append('extra', Struct.Type.Float64)
+    check_conversion(StructConverter(s1, s2), '@dd', '@I', (6, 7), (6,))
+
+    hits2, misses2 = StructConverter.cache_statistics()
+    # Float64 fields are not handled by the SIMD backend, which never compiles kernels
+    assert not StructConverter(s1, s2).vectorized()
+    if platform.machine() in ['x86_64', 'AMD64']:
+        # JIT backend: the second conversion reuses the kernel of the first one
+        assert (hits2 - hits, misses2 - misses) == (1, 3)
+    else:
+        # Per-record backend: no kernels are compiled or cached
+        assert (hits2 - hits, misses2 - misses) == (0, 0)
+
+
+def test24_vectorized_integer_narrowing():
+    """The SIMD and per-record backends agree on integer conversions"""
+    swapped = Struct.ByteOrder.BigEndian if sys.byteorder == "little" \
+        else Struct.ByteOrder.LittleEndian
+    values = np.array([0, 1, 127, 128, 255, 256, 1000, 32768, 65535],
+                      dtype=np.uint16)
+
+    for normalized in [False, True]:
+        flags = Struct.Flags.Normalized if normalized else 0
+        # A byte-swapped source is always handled by the per-record backend
+        s1 = Struct().append('val', Struct.Type.UInt16, flags)
+        s2 = Struct(byte_order=swapped).append('val', Struct.Type.UInt16, flags)
+        s3 = Struct().append('val', Struct.Type.UInt8, flags)
+        c1, c2 = StructConverter(s1, s3), StructConverter(s2, s3)
+        assert not c2.vectorized()
+        assert c1.vectorized() == normalized
+
+        r1 = np.frombuffer(c1.convert(values.tobytes()), dtype=np.uint8)
+        r2 = np.frombuffer(c2.convert(values.byteswap().tobytes()), dtype=np.uint8)
+        assert np.all(r1 == r2)
+
+        if normalized:
+            assert np.all(r1 == np.round(values / 257.0).astype(np.uint8))
+        else:
+            # Narrowing without normalization keeps the low-order bits
+            assert np.all(r1 == values.astype(np.uint8))
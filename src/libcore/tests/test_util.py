@@ -27,3 +27,17 @@ def test01_mem_string(variant_scalar_rgb):
         assert mem_string(2 * 1024 ** 4, precise=True) == '2 TiB'
         assert mem_string(2 * 1024 ** 5, precise=True) == '2 PiB'
         assert mem_string(2 * 1024 ** 6, precise=True) == '2 EiB'
+
+
+@pytest.mark.skipif(not sys.platform.startswith('linux'), reason='Linux only')
+def test02_resident_memory(variant_scalar_rgb):
+    from mitsuba.core.util import resident_memory
+    import numpy as np
+
+    before = resident_memory()
+    assert before > 0
+
+    # Touch 64 MiB of memory
+    data = np.ones(64 * 1024 * 1024, dtype=np.uint8)
+    assert resident_memory() - before >= 32 * 1024 * 1024
+    del data
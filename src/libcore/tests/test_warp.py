@@ -166,6 +166,55 @@ def test_square_to_uniform_cone(variant_scalar_rgb):
     check_vectorization("square_to_uniform_cone", wrapper)
 
 
+def test_square_to_spherical_triangle(variant_scalar_rgb):
+    from mitsuba.core import warp
+
+    # The octant triangle covers 1/8 of the sphere
+    a, b, c = [1, 0, 0], [0, 1, 0], [0, 0, 1]
+    assert ek.allclose(warp.spherical_triangle_solid_angle(a, b, c), ek.pi / 2)
+    assert ek.allclose(warp.square_to_spherical_triangle_pdf(a, b, c), 2 / ek.pi)
+
+    # By symmetry, the mean direction over the octant is [1/2, 1/2, 1/2]
+    t = np.linspace(0.025, 0.975, 20)
+    samples = [[x, y] for x in t for y in t]
+    d = np.array([warp.square_to_spherical_triangle(s, a, b, c) for s in samples])
+    assert np.allclose(np.linalg.norm(d, axis=1), 1, atol=1e-5)
+    assert np.all(d > -1e-6)
+    assert np.allclose(np.mean(d, axis=0), 0.5, atol=1e-2)
+
+    # Samples of a general triangle lie inside of it
+    v = np.array([[1, 0.2, 0.1], [-0.3, 1, 0.4], [0.2, -0.1, 1]])
+    v /= np.linalg.norm(v, axis=1)[:, None]
+    for s in samples:
+        d = np.array(warp.square_to_spherical_triangle(s, *v))
+        for i in range(3):
+            n = np.cross(v[i], v[(i + 1) % 3])
+            assert np.dot(n, d) > -1e-5
+
+
+def test_square_to_spherical_rectangle(variant_scalar_rgb):
+    from mitsuba.core import warp
+
+    # A square of side length 2 at distance 1 covers 1/6 of the sphere
+    assert ek.allclose(warp.spherical_rectangle_solid_angle([-1, -1], [1, 1], 1), 2 * ek.pi / 3)
+    assert ek.allclose(warp.spherical_rectangle_solid_angle([-1, -1], [1, 1], -1), 2 * ek.pi / 3)
+    assert ek.allclose(warp.square_to_spherical_rectangle_pdf([-1, -1], [1, 1], 1), 3 / (2 * ek.pi))
+    assert ek.allclose(warp.square_to_spherical_rectangle([.5, .5], [-1, -1], [1, 1], 1), [0, 0, 1], atol=1e-6)
+
+    p0, p1, z = [-0.3, -1.2], [0.8, 0.5], 0.7
+    solid_angle = warp.spherical_rectangle_solid_angle(p0, p1, z)
+    for u in [0.1, 0.3, 0.5, 0.7, 0.9]:
+        for v in [0.1, 0.5, 0.9]:
+            p = warp.square_to_spherical_rectangle([u, v], p0, p1, z)
+            assert p0[0] <= p[0] <= p1[0] and p0[1] <= p[1] <= p1[1]
+            assert ek.allclose(p[2], z)
+
+            # The first sample dimension splits off a sub-rectangle with the
+            # corresponding fraction of the solid angle
+            assert ek.allclose(warp.spherical_rectangle_solid_angle(p0, [p[0], p1[1]], z),
+                               u * solid_angle, atol=1e-5)
+
+
 def test_square_to_beckmann(variant_scalar_rgb):
     from mitsuba.core import warp
 
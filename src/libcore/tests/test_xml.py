@@ -297,3 +297,60 @@ def test20_upgrade_tree(variant_scalar_rgb):
                                <float name="intIOR" value="1.33"/>
                            </bsdf>
                        </scene>""")
+
+
+def test21_load_report(variant_scalar_rgb, tmpdir):
+    from mitsuba.core import xml, Thread, Appender, LogLevel
+    import re
+
+    # Several unnamed children of the same parent are instantiated in
+    # parallel and stored once they are all available
+    filename = str(tmpdir.join('scene.xml'))
+    with open(filename, 'w') as f:
+        f.write("""<scene version="2.0.0">
+            <shape type="sphere" id="sphere_1"/>
+            <shape type="sphere">
+                <bsdf type="diffuse" id="diffuse"/>
+            </shape>
+            <shape type="sphere">
+                <ref id="diffuse"/>
+            </shape>
+            <emitter type="constant"/>
+        </scene>""")
+
+    # Capture the report, which is logged at the 'Info' level
+    messages = []
+
+    class MyAppender(Appender):
+        def append(self, level, text):
+            messages.append(text)
+
+    logger = Thread.thread().logger()
+    log_level = logger.log_level()
+    appender = MyAppender()
+    logger.add_appender(appender)
+    logger.set_log_level(LogLevel.Info)
+    try:
+        scene = xml.load_file(filename, load_report=True)
+    finally:
+        logger.remove_appender(appender)
+        logger.set_log_level(log_level)
+
+    assert len(scene.shapes()) == 3
+    assert len(scene.emitters()) == 1
+
+    report = [m for m in messages if 'Scene load report' in m]
+    assert len(report) == 1
+    report = report[0]
+    assert re.search(r'Scene load report: 6 objects, parsing took \S+, '
+                     r'instantiation took \S+', report)
+
+    # One entry (count and time) per plugin
+    for plugin, count in [('scene "scene"', 1), ('shape "sphere"', 3),
+                          ('bsdf "diffuse"', 1), ('emitter "constant"', 1)]:
+        assert re.search(r'%s\s+%i\s+\d' % (plugin, count), report), plugin
+
+    # Named objects are listed by their ID, unnamed ones by their location
+    assert '"sphere_1"' in report
+    assert '"diffuse"' in report
+    assert re.search(r'emitter "constant" near .*line 9', report)
@@ -1,8 +1,10 @@
 #include <mitsuba/core/thread.h>
+#include <mitsuba/core/arena.h>
 #include <mitsuba/core/logger.h>
 #include <mitsuba/core/tls.h>
 #include <mitsuba/core/util.h>
 #include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/numa.h>
 #include <mitsuba/core/profiler.h>
 #include <tbb/task_scheduler_observer.h>
 #include <condition_variable>
@@ -368,6 +370,7 @@ void Thread::dispatch() {
     d->native_handle = d->thread.native_handle();
 
     ThreadLocalBase::register_thread();
+    Profiler::register_thread();
 
     uint32_t id = thread_ctr++;
     #if defined(__LINUX__) || defined(__OSX__)
@@ -412,6 +415,7 @@ void Thread::exit() {
     Log(Debug, "Thread \"%s\" has finished", d->name);
     d->running = false;
     Assert(*self == this);
+    Profiler::unregister_thread();
     ThreadLocalBase::unregister_thread();
     dec_ref();
 }
@@ -459,6 +463,7 @@ bool Thread::register_external_thread(const std::string &prefix) {
     thr->d->running = true;
     thr->d->tbb_thread = true;
     *self = thr;
+    Profiler::register_thread();
 
     const std::string &thread_name = thr->name();
     #if defined(__LINUX__)
@@ -477,6 +482,7 @@ bool Thread::unregister_external_thread() {
     if (!thr || !thr->d->tbb_thread)
         return false;
     thr->d->running = false;
+    Profiler::unregister_thread();
     ThreadLocalBase::unregister_thread();
     return true;
 }
@@ -489,6 +495,8 @@ public:
 
     void on_scheduler_entry(bool) {
         if (register_external_thread("tbb")) {
+            if (numa::thread_pinning())
+                numa::pin_thread();
             std::unique_lock<std::mutex> lock(m_mutex);
             m_started_counter++;
         }
@@ -522,6 +530,7 @@ void Thread::static_initialization() {
     #endif
     ThreadLocalBase::static_initialization();
     ThreadLocalBase::register_thread();
+    MemoryArena::static_initialization();
 
     __global_thread_count = util::core_count();
 
@@ -537,12 +546,14 @@ void Thread::static_initialization() {
 }
 
 void Thread::static_shutdown() {
+    numa::static_shutdown();
     observer->wait();
     observer.reset();
     thread()->d->running = false;
     ThreadLocalBase::unregister_thread();
     delete self;
     self = nullptr;
+    MemoryArena::static_shutdown();
     ThreadLocalBase::static_shutdown();
 
     #if defined(__LINUX__) || defined(__OSX__)
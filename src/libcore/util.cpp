@@ -12,13 +12,16 @@
 #  include <unistd.h>
 #  include <limits.h>
 #  include <sys/ioctl.h>
+#  include <cstdio>
 #elif defined(__OSX__)
 #  include <sys/sysctl.h>
 #  include <mach-o/dyld.h>
+#  include <mach/mach.h>
 #  include <unistd.h>
 #  include <sys/ioctl.h>
 #elif defined(__WINDOWS__)
 #  include <windows.h>
+#  include <psapi.h>
 #endif
 
 NAMESPACE_BEGIN(mitsuba)
@@ -201,6 +204,34 @@ std::string mem_string(size_t size, bool precise) {
     return tfm::format(precise ? "%.5g %s" : "%.3g %s", value, orders[i]);
 }
 
+size_t resident_memory() {
+#if defined(__LINUX__)
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f)
+        return 0;
+    unsigned long pages_total = 0, pages_resident = 0;
+    int count = fscanf(f, "%lu %lu", &pages_total, &pages_resident);
+    fclose(f);
+    if (count != 2)
+        return 0;
+    return (size_t) pages_resident * (size_t) sysconf(_SC_PAGESIZE);
+#elif defined(__OSX__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  (task_info_t) &info, &count) != KERN_SUCCESS)
+        return 0;
+    return (size_t) info.resident_size;
+#elif defined(__WINDOWS__)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return (size_t) counters.WorkingSetSize;
+#else
+    return 0;
+#endif
+}
+
 #if defined(__WINDOWS__) || defined(__LINUX__)
     void MTS_EXPORT __dummySymbol() { }
 #endif
@@ -0,0 +1,197 @@
+#include <mitsuba/core/writequeue.h>
+#include <mitsuba/core/logger.h>
+#include <mitsuba/core/string.h>
+#include <mitsuba/core/util.h>
+#include <chrono>
+#include <sstream>
+
+NAMESPACE_BEGIN(mitsuba)
+
+// -----------------------------------------------------------------------------
+
+WriteHandle::WriteHandle(const std::string &description, std::shared_future<void> future)
+    : m_description(description), m_future(std::move(future)) { }
+
+WriteHandle::~WriteHandle() { }
+
+bool WriteHandle::done() const {
+    return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void WriteHandle::wait() const {
+    m_future.get();
+}
+
+std::string WriteHandle::to_string() const {
+    return tfm::format("WriteHandle[description=\"%s\", done=%i]",
+                       m_description, (int) done());
+}
+
+// -----------------------------------------------------------------------------
+
+class WriteQueue::WorkerThread : public Thread {
+public:
+    WorkerThread(WriteQueue *queue, size_t index)
+        : Thread(tfm::format("io%i", index)), m_queue(queue) { }
+
+    void run() override { m_queue->run(); }
+
+private:
+    WriteQueue *m_queue;
+};
+
+static std::mutex __instance_mutex;
+static ref<WriteQueue> __instance;
+
+WriteQueue::WriteQueue(size_t thread_count, size_t capacity)
+    : m_capacity(std::max(capacity, (size_t) 1)) {
+    thread_count = std::max(thread_count, (size_t) 1);
+    for (size_t i = 0; i < thread_count; ++i) {
+        ref<Thread> thread = new WorkerThread(this, i);
+        thread->start();
+        m_threads.push_back(thread);
+    }
+}
+
+WriteQueue::~WriteQueue() {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_task_cv.notify_all();
+    for (auto &thread : m_threads)
+        thread->join();
+}
+
+ref<WriteHandle> WriteQueue::enqueue(const std::string &description, Task task) {
+    Entry entry;
+    entry.description = description;
+    entry.task = std::move(task);
+    ref<WriteHandle> handle =
+        new WriteHandle(description, entry.promise.get_future().share());
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_queue.size() >= m_capacity)
+            Log(Debug, "Write queue is full, waiting for pending writes ..");
+        m_space_cv.wait(lock, [&] { return m_queue.size() < m_capacity || m_shutdown; });
+        if (m_shutdown)
+            Throw("WriteQueue::enqueue(): the queue is shutting down!");
+        m_queue.push_back(std::move(entry));
+    }
+    m_task_cv.notify_one();
+
+    return handle;
+}
+
+void WriteQueue::run() {
+    while (true) {
+        Entry entry;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_task_cv.wait(lock, [&] { return !m_queue.empty() || m_shutdown; });
+            if (m_queue.empty())
+                return; /* Shutdown, and all pending writes have finished */
+            entry = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_running++;
+        }
+        m_space_cv.notify_one();
+
+        auto start = std::chrono::steady_clock::now();
+        size_t bytes = 0;
+        bool success = false;
+        try {
+            bytes = entry.task();
+            success = true;
+            entry.promise.set_value();
+        } catch (const std::exception &e) {
+            Log(Warn, "Asynchronous write \"%s\" failed: %s", entry.description, e.what());
+            entry.promise.set_exception(std::current_exception());
+        } catch (...) {
+            Log(Warn, "Asynchronous write \"%s\" failed: unknown exception", entry.description);
+            entry.promise.set_exception(std::current_exception());
+        }
+        double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_running--;
+            m_busy_time += elapsed;
+            if (success) {
+                m_writes_completed++;
+                m_bytes_written += bytes;
+            }
+        }
+        m_idle_cv.notify_all();
+    }
+}
+
+void WriteQueue::wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle_cv.wait(lock, [&] { return m_queue.empty() && m_running == 0; });
+}
+
+size_t WriteQueue::pending() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_queue.size() + m_running;
+}
+
+size_t WriteQueue::writes_completed() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_writes_completed;
+}
+
+size_t WriteQueue::bytes_written() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_bytes_written;
+}
+
+double WriteQueue::throughput() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_busy_time == 0.0)
+        return 0.0;
+    return m_bytes_written / (1024.0 * 1024.0) / m_busy_time;
+}
+
+std::string WriteQueue::to_string() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    std::ostringstream oss;
+    oss << "WriteQueue[" << std::endl
+        << "  thread_count = " << m_threads.size() << "," << std::endl
+        << "  capacity = " << m_capacity << "," << std::endl
+        << "  pending = " << m_queue.size() + m_running << "," << std::endl
+        << "  writes_completed = " << m_writes_completed << "," << std::endl
+        << "  bytes_written = " << util::mem_string(m_bytes_written) << std::endl
+        << "]";
+    return oss.str();
+}
+
+WriteQueue *WriteQueue::instance() {
+    std::lock_guard<std::mutex> guard(__instance_mutex);
+    if (!__instance)
+        __instance = new WriteQueue(2, 8);
+    return __instance;
+}
+
+void WriteQueue::static_shutdown() {
+    ref<WriteQueue> instance;
+    {
+        std::lock_guard<std::mutex> guard(__instance_mutex);
+        instance = std::move(__instance);
+    }
+    if (!instance)
+        return;
+
+    instance->wait();
+    if (instance->writes_completed() > 0)
+        Log(Debug, "Asynchronous writes: %i files, %s, %.1f MiB/s",
+            instance->writes_completed(),
+            util::mem_string(instance->bytes_written()),
+            instance->throughput());
+}
+
+MTS_IMPLEMENT_CLASS(WriteHandle, Object)
+MTS_IMPLEMENT_CLASS(WriteQueue, Object)
+NAMESPACE_END(mitsuba)
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <cctype>
 #include <fstream>
+#include <map>
 #include <set>
 #include <unordered_map>
 
@@ -7,15 +9,19 @@
 #include <mitsuba/core/config.h>
 #include <mitsuba/core/filesystem.h>
 #include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/fstream.h>
 #include <mitsuba/core/logger.h>
 #include <mitsuba/core/math.h>
+#include <mitsuba/core/mmap.h>
 #include <mitsuba/core/object.h>
 #include <mitsuba/core/plugin.h>
 #include <mitsuba/core/profiler.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/spectrum.h>
 #include <mitsuba/core/string.h>
+#include <mitsuba/core/timer.h>
 #include <mitsuba/core/transform.h>
+#include <mitsuba/core/util.h>
 #include <mitsuba/core/vector.h>
 #include <mitsuba/core/xml.h>
 #include <pugixml.hpp>
@@ -226,6 +232,15 @@ struct XMLObject {
     size_t location = 0;
     ref<Object> object;
     tbb::spin_mutex mutex;
+
+    /// Estimated instantiation cost of this object and its children (size of referenced files)
+    size_t cost = 0;
+
+    /// Time (in ms) spent in the plugin constructor, and including the construction of children
+    float load_time = 0.f, total_time = 0.f;
+
+    /// Change of the resident memory of the process during the plugin constructor
+    int64_t memory = 0;
 };
 
 enum class ColorMode {
@@ -260,6 +275,11 @@ struct XMLParseContext {
     Transform4f transform;
     size_t id_counter = 0;
     bool parallelize;
+    bool load_report = false;
+    /* Record the textures generated by <rgb> and <spectrum> tags as separate
+       objects instead of creating them right away, so that the whole scene
+       is described by serializable properties (used by parse_file()) */
+    bool deferred = false;
     ColorMode color_mode;
 
     XMLParseContext(const std::string &variant) : variant(variant) {
@@ -432,6 +452,33 @@ void upgrade_tree(XMLSource &src, pugi::xml_node &node, const Version &version)
     src.modified = true;
 }
 
+/// Create the texture for an <rgb> or <spectrum> tag, or record it for later instantiation
+static void add_texture(XMLSource &src, XMLParseContext &ctx, pugi::xml_node &node,
+                        Properties &props, const Properties &tex_props) {
+    std::string name = node.attribute("name").value();
+
+    if (ctx.deferred) {
+        std::string id = tfm::format("_unnamed_%i", ctx.id_counter++);
+        auto &inst = ctx.instances[id];
+        inst.props = tex_props;
+        inst.props.set_id(id);
+        inst.class_ = Class::for_name("Texture", ctx.variant);
+        inst.offset = src.offset;
+        inst.src_id = src.id;
+        inst.location = node.offset_debug();
+        props.set_named_reference(name, id);
+        return;
+    }
+
+    ref<Object> obj = PluginManager::instance()->create_object(
+        tex_props, Class::for_name("Texture", ctx.variant));
+    auto expanded = obj->expand();
+    Assert(expanded.size() <= 1);
+    if (!expanded.empty())
+        obj = expanded[0];
+    props.set_object(name, obj);
+}
+
 static std::pair<std::string, std::string> parse_xml(XMLSource &src, XMLParseContext &ctx,
                                                      pugi::xml_node &node, Tag parent_tag,
                                                      Properties &props, ParameterList &param,
@@ -566,12 +613,31 @@ static std::pair<std::string, std::string> parse_xml(XMLSource &src, XMLParseCon
                             props_nested.set_named_reference(arg_name, nested_id);
                     }
 
+                    /* Estimate the cost of instantiating this subtree from the
+                       size of the files that it references. It is used to start
+                       expensive siblings first when instantiating in parallel. */
+                    size_t cost = 0;
+                    for (auto &kv : props_nested.named_references()) {
+                        auto it3 = ctx.instances.find(kv.second);
+                        if (it3 != ctx.instances.end())
+                            cost += it3->second.cost;
+                    }
+                    for (pugi::xml_node &ch : node.children("string")) {
+                        if (strcmp(ch.attribute("name").value(), "filename") != 0)
+                            continue;
+                        fs::path filename = Thread::thread()->file_resolver()->resolve(
+                            ch.attribute("value").value());
+                        if (fs::exists(filename))
+                            cost += fs::file_size(filename);
+                    }
+
                     auto &inst = ctx.instances[id];
                     inst.props = props_nested;
                     inst.class_ = it2->second;
                     inst.offset = src.offset;
                     inst.src_id = src.id;
                     inst.location = node.offset_debug();
+                    inst.cost = cost;
                     return std::make_pair(name, id);
                 }
                 break;
@@ -778,9 +844,7 @@ static std::pair<std::string, std::string> parse_xml(XMLSource &src, XMLParseCon
                         if (!within_emitter && is_ior)
                             props2.set_bool("unbounded", true);
 
-                        ref<Object> obj = PluginManager::instance()->create_object(
-                            props2, Class::for_name("Texture", ctx.variant));
-                        props.set_object(node.attribute("name").value(), obj);
+                        add_texture(src, ctx, node, props, props2);
                     } else {
                         props.set_color("color", col);
                     }
@@ -814,13 +878,7 @@ static std::pair<std::string, std::string> parse_xml(XMLSource &src, XMLParseCon
                             props2.set_float("value", value);
                         }
 
-                        ref<Object> obj = PluginManager::instance()->create_object(
-                            props2, Class::for_name("Texture", ctx.variant));
-                        auto expanded = obj->expand();
-                        Assert(expanded.size() <= 1);
-                        if (!expanded.empty())
-                            obj = expanded[0];
-                        props.set_object(node.attribute("name").value(), obj);
+                        add_texture(src, ctx, node, props, props2);
                     } else {
                         /* Parse wavelength:value pairs, either inlined or from an external file.
                            Wavelengths are expected to be specified in increasing order. */
@@ -874,24 +932,6 @@ static std::pair<std::string, std::string> parse_xml(XMLSource &src, XMLParseCon
                                 is_regular = false;
                         }
 
-                        Properties props2;
-
-                        if (is_regular) {
-                            props2.set_plugin_name("regular");
-                            props2.set_long("size", wavelengths.size());
-                            props2.set_float("lambda_min", wavelengths.front());
-                            props2.set_float("lambda_max", wavelengths.back());
-                            props2.set_pointer("values", values.data());
-                        } else {
-                            props2.set_plugin_name("irregular");
-                            props2.set_long("size", wavelengths.size());
-                            props2.set_pointer("wavelengths", wavelengths.data());
-                            props2.set_pointer("values", values.data());
-                        }
-
-                        ref<Object> obj = PluginManager::instance()->create_object(
-                            props2, Class::for_name("Texture", ctx.variant));
-
                         // In non-spectral mode, pre-integrate against the CIE matching curves
                         if (ctx.color_mode != ColorMode::Spectral) {
 
@@ -914,11 +954,42 @@ static std::pair<std::string, std::string> parse_xml(XMLSource &src, XMLParseCon
                                     props3.set_bool("unbounded", true);
                             }
 
-                            obj = PluginManager::instance()->create_object(
-                                props3, Class::for_name("Texture", ctx.variant));
-                        }
+                            add_texture(src, ctx, node, props, props3);
+                        } else {
+                            /* Deferred textures can't refer to the (temporary)
+                               arrays, hence their contents are stored as strings */
+                            auto to_string = [](const std::vector<Float> &v) {
+                                std::string result;
+                                for (size_t n = 0; n < v.size(); ++n)
+                                    result += tfm::format(n == 0 ? "%.9g" : ", %.9g", v[n]);
+                                return result;
+                            };
+
+                            Properties props2;
+                            if (is_regular) {
+                                props2.set_plugin_name("regular");
+                                props2.set_float("lambda_min", wavelengths.front());
+                                props2.set_float("lambda_max", wavelengths.back());
+                                if (ctx.deferred) {
+                                    props2.set_string("values", to_string(values));
+                                } else {
+                                    props2.set_long("size", wavelengths.size());
+                                    props2.set_pointer("values", values.data());
+                                }
+                            } else {
+                                props2.set_plugin_name("irregular");
+                                if (ctx.deferred) {
+                                    props2.set_string("wavelengths", to_string(wavelengths));
+                                    props2.set_string("values", to_string(values));
+                                } else {
+                                    props2.set_long("size", wavelengths.size());
+                                    props2.set_pointer("wavelengths", wavelengths.data());
+                                    props2.set_pointer("values", values.data());
+                                }
+                            }
 
-                        props.set_object(node.attribute("name").value(), obj);
+                            add_texture(src, ctx, node, props, props2);
+                        }
                     }
                 }
                 break;
@@ -1044,14 +1115,33 @@ static ref<Object> instantiate_node(XMLParseContext &ctx, const std::string &id)
         return instantiate_node(ctx, alias);
     }
 
+    Timer timer;
     Properties &props = inst.props;
     const auto &named_references = props.named_references();
 
+    /* Instantiate the children with the largest estimated cost first, so that
+       e.g. big meshes don't end up on the critical path of the parallel loop */
+    std::vector<uint32_t> order(named_references.size());
+    for (uint32_t i = 0; i < (uint32_t) order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        auto it_a = ctx.instances.find(named_references[a].second),
+             it_b = ctx.instances.find(named_references[b].second);
+        size_t cost_a = it_a != ctx.instances.end() ? it_a->second.cost : 0,
+               cost_b = it_b != ctx.instances.end() ? it_b->second.cost : 0;
+        return cost_a > cost_b;
+    });
+
+    /* The children are stored into 'props' afterwards: inserting properties
+       from several threads at once is not safe */
+    std::vector<std::vector<ref<Object>>> children(named_references.size());
+
     ThreadEnvironment env;
 
     auto functor = [&](const tbb::blocked_range<uint32_t> &range) {
         ScopedSetThreadEnvironment set_env(env);
-        for (uint32_t i = range.begin(); i != range.end(); ++i) {
+        for (uint32_t k = range.begin(); k != range.end(); ++k) {
+            uint32_t i = order[k];
             auto &kv = named_references[i];
             try {
                 ref<Object> obj;
@@ -1066,16 +1156,9 @@ static ref<Object> instantiate_node(XMLParseContext &ctx, const std::string &id)
                     instantiate_recursively();
 
                 // Give the object a chance to recursively expand into sub-objects
-                std::vector<ref<Object>> children = obj->expand();
-                if (children.empty()) {
-                    props.set_object(kv.first, obj, false);
-                } else if (children.size() == 1) {
-                    props.set_object(kv.first, children[0], false);
-                } else {
-                    int ctr = 0;
-                    for (auto c : children)
-                        props.set_object(kv.first + "_" + std::to_string(ctr++), c, false);
-                }
+                children[i] = obj->expand();
+                if (children[i].empty())
+                    children[i].push_back(obj);
             } catch (const std::exception &e) {
                 if (strstr(e.what(), "Error while loading") == nullptr)
                     Throw("Error while loading \"%s\" (near %s): %s",
@@ -1093,6 +1176,20 @@ static ref<Object> instantiate_node(XMLParseContext &ctx, const std::string &id)
     else
         functor(range);
 
+    for (size_t i = 0; i < named_references.size(); ++i) {
+        const std::string &name = named_references[i].first;
+        if (children[i].size() == 1) {
+            props.set_object(name, children[i][0], false);
+        } else {
+            int ctr = 0;
+            for (auto c : children[i])
+                props.set_object(name + "_" + std::to_string(ctr++), c, false);
+        }
+    }
+
+    Timer timer_self;
+    size_t memory_before = ctx.load_report ? util::resident_memory() : 0;
+
     try {
         inst.object = PluginManager::instance()->create_object(props, inst.class_);
     } catch (const std::exception &e) {
@@ -1102,6 +1199,11 @@ static ref<Object> instantiate_node(XMLParseContext &ctx, const std::string &id)
               e.what());
     }
 
+    inst.load_time = (float) timer_self.value();
+    inst.total_time = (float) timer.value();
+    if (ctx.load_report)
+        inst.memory = (int64_t) util::resident_memory() - (int64_t) memory_before;
+
     auto unqueried = props.unqueried();
     if (!unqueried.empty()) {
         for (auto &v : unqueried) {
@@ -1125,43 +1227,81 @@ static ref<Object> instantiate_node(XMLParseContext &ctx, const std::string &id)
     return inst.object;
 }
 
-NAMESPACE_END(detail)
-
-ref<Object> load_string(const std::string &string, const std::string &variant,
-                        ParameterList param) {
-    ScopedPhase sp(ProfilerPhase::InitScene);
-    pugi::xml_document doc;
-    pugi::xml_parse_result result = doc.load_buffer(string.c_str(), string.length(),
-                                                    pugi::parse_default |
-                                                    pugi::parse_comments);
-    detail::XMLSource src{
-        "<string>", doc,
-        [&](ptrdiff_t pos) { return detail::string_offset(string, pos); }
+/// Print the plugins and objects that dominate the load time of a scene
+static void print_load_report(const XMLParseContext &ctx, float parse_time) {
+    struct PluginStats {
+        size_t count = 0;
+        float load_time = 0.f;
+        int64_t memory = 0;
     };
 
-    if (!result) // There was a parser error
-        Throw("Error while loading \"%s\" (at %s): %s", src.id,
-              src.offset(result.offset), result.description());
+    std::vector<const XMLObject *> objects;
+    std::map<std::string, PluginStats> plugins;
+    float total_time = 0.f;
+
+    for (auto &kv : ctx.instances) {
+        const XMLObject &inst = kv.second;
+        if (!inst.object || !inst.alias.empty())
+            continue;
+        objects.push_back(&inst);
+
+        std::string plugin = string::to_lower(inst.class_->name()) + " \"" +
+                             inst.props.plugin_name() + "\"";
+        PluginStats &stats = plugins[plugin];
+        stats.count++;
+        stats.load_time += inst.load_time;
+        stats.memory += inst.memory;
+        total_time = std::max(total_time, inst.total_time);
+    }
 
-    pugi::xml_node root = doc.document_element();
-    detail::XMLParseContext ctx(variant);
-    Properties prop;
-    size_t arg_counter; // Unused
-    auto scene_id = detail::parse_xml(src, ctx, root, Tag::Invalid, prop,
-                                      param, arg_counter, 0).second;
-    return detail::instantiate_node(ctx, scene_id);
-}
+    auto mem = [](int64_t value) {
+        return value > 0 ? util::mem_string((size_t) value) : std::string("-");
+    };
 
-ref<Object> load_file(const fs::path &filename_, const std::string &variant,
-                      ParameterList param, bool write_update) {
-    ScopedPhase sp(ProfilerPhase::InitScene);
-    fs::path filename = filename_;
-    if (!fs::exists(filename))
-        Throw("\"%s\": file does not exist!", filename);
+    std::vector<std::pair<std::string, PluginStats>> plugins_sorted(plugins.begin(), plugins.end());
+    std::sort(plugins_sorted.begin(), plugins_sorted.end(),
+              [](const auto &a, const auto &b) { return a.second.load_time > b.second.load_time; });
+    std::sort(objects.begin(), objects.end(),
+              [](const XMLObject *a, const XMLObject *b) { return a->load_time > b->load_time; });
+
+    std::ostringstream oss;
+    oss << tfm::format("Scene load report: %i objects, parsing took %s, "
+                       "instantiation took %s", objects.size(),
+                       util::time_string(parse_time), util::time_string(total_time))
+        << std::endl << std::endl
+        << tfm::format("  %-32s %8s %10s %10s", "Plugin", "Count", "Time", "Memory")
+        << std::endl;
+    for (auto &kv : plugins_sorted)
+        oss << tfm::format("  %-32s %8i %10s %10s", kv.first, kv.second.count,
+                           util::time_string(kv.second.load_time), mem(kv.second.memory))
+            << std::endl;
+
+    size_t count = std::min(objects.size(), (size_t) MTS_XML_LOAD_REPORT_ENTRIES);
+    oss << std::endl
+        << tfm::format("  %-10s %10s %10s  %s", "Time", "Subtree", "Memory", "Object")
+        << std::endl;
+    for (size_t i = 0; i < count; ++i) {
+        const XMLObject &inst = *objects[i];
+        std::string id = inst.props.id();
+        if (string::starts_with(id, "_unnamed_"))
+            id = tfm::format("%s \"%s\" near %s", string::to_lower(inst.class_->name()),
+                             inst.props.plugin_name(), inst.offset(inst.location));
+        else
+            id = tfm::format("\"%s\"", id);
+        oss << tfm::format("  %-10s %10s %10s  %s", util::time_string(inst.load_time),
+                           util::time_string(inst.total_time), mem(inst.memory), id)
+            << std::endl;
+    }
+    oss << std::endl
+        << "  (Time: plugin constructor, Subtree: including children, Memory: change "
+           "of the resident set size, which also includes concurrently loaded objects)";
 
-    Log(Info, "Loading XML file \"%s\" ..", filename);
-    Log(Info, "Using variant \"%s\"", variant);
+    Log(Info, "%s", oss.str());
+}
 
+/// Parse a scene XML file into \c ctx and return the identifier of the root object
+static std::string parse_document(XMLParseContext &ctx, fs::path filename,
+                                  ParameterList &param, bool write_update) {
     pugi::xml_document doc;
     pugi::xml_parse_result result = doc.load_file(filename.native().c_str(),
                                                   pugi::parse_default |
@@ -1178,7 +1318,6 @@ ref<Object> load_file(const fs::path &filename_, const std::string &variant,
 
     pugi::xml_node root = doc.document_element();
 
-    detail::XMLParseContext ctx(variant);
     Properties prop;
     size_t arg_counter = 0; // Unused
     auto scene_id = detail::parse_xml(src, ctx, root, Tag::Invalid, prop,
@@ -1208,8 +1347,474 @@ ref<Object> load_file(const fs::path &filename_, const std::string &variant,
         filename = backup;
     }
 
+    return scene_id;
+}
+
+/// Register a set of object descriptions with \c ctx (the inverse of \ref parse_document())
+static void add_descriptions(XMLParseContext &ctx, const std::vector<ObjectDescription> &objects,
+                             const std::string &src_id) {
+    for (const auto &desc : objects) {
+        if (ctx.instances.find(desc.id) != ctx.instances.end())
+            Throw("Error while loading \"%s\": duplicate id \"%s\"", src_id, desc.id);
+
+        auto &inst = ctx.instances[desc.id];
+        inst.src_id = src_id;
+        inst.offset = [id = desc.id](ptrdiff_t) { return tfm::format("object \"%s\"", id); };
+
+        if (!desc.alias.empty()) {
+            inst.alias = desc.alias;
+            continue;
+        }
+
+        auto it = tag_class->find(class_key(desc.tag, ctx.variant));
+        if (it == tag_class->end())
+            Throw("Error while loading \"%s\": could not retrieve class object for "
+                  "tag \"%s\" and variant \"%s\"", src_id, desc.tag, ctx.variant);
+
+        inst.props = desc.props;
+        inst.class_ = it->second;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/// Magic number ('MTSC') and format version of compiled scene files
+static constexpr uint32_t compiled_magic = 0x4353544D;
+static constexpr uint32_t compiled_version = 1;
+
+/// Size of the fixed header, which is followed by the variant name and the object descriptions
+static constexpr size_t compiled_header_size = 16;
+
+static void write_matrix(Stream *stream, const Matrix4f &m) {
+    for (size_t i = 0; i < 4; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            stream->write(m(i, j));
+}
+
+static Matrix4f read_matrix(Stream *stream) {
+    Matrix4f m;
+    for (size_t i = 0; i < 4; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            stream->read(m(i, j));
+    return m;
+}
+
+static void write_properties(Stream *stream, const Properties &props) {
+    std::vector<std::string> names = props.property_names();
+    stream->write(props.plugin_name());
+    stream->write(props.id());
+    stream->write((uint32_t) names.size());
+
+    for (const std::string &name : names) {
+        Properties::Type type = props.type(name);
+        stream->write(name);
+        stream->write((uint32_t) type);
+
+        switch (type) {
+            case Properties::Type::Bool:
+                stream->write((uint8_t) props.bool_(name));
+                break;
+
+            case Properties::Type::Long:
+                stream->write(props.long_(name));
+                break;
+
+            case Properties::Type::Float:
+                stream->write(props.float_(name));
+                break;
+
+            case Properties::Type::Point3f:
+                stream->write_array(props.point3f(name).data(), 3);
+                break;
+
+            case Properties::Type::Vector3f:
+                stream->write_array(props.vector3f(name).data(), 3);
+                break;
+
+            case Properties::Type::Color:
+                stream->write_array(props.color(name).data(), 3);
+                break;
+
+            case Properties::Type::Transform:
+                write_matrix(stream, props.transform(name).matrix);
+                break;
+
+            case Properties::Type::AnimatedTransform: {
+                    ref<AnimatedTransform> trafo = props.animated_transform(name);
+                    stream->write((uint32_t) trafo->size());
+                    if (trafo->size() == 0)
+                        write_matrix(stream, trafo->eval(0.f).matrix);
+                    for (size_t i = 0; i < trafo->size(); ++i) {
+                        const auto &frame = (*trafo)[i];
+                        stream->write(frame.time);
+                        for (size_t j = 0; j < 3; ++j)
+                            for (size_t k = 0; k < 3; ++k)
+                                stream->write(frame.scale(j, k));
+                        stream->write_array(frame.quat.data(), 4);
+                        stream->write_array(frame.trans.data(), 3);
+                    }
+                }
+                break;
+
+            case Properties::Type::String:
+                stream->write(props.string(name));
+                break;
+
+            case Properties::Type::NamedReference:
+                stream->write((const std::string &) props.named_reference(name));
+                break;
+
+            default:
+                Throw("Property \"%s\" of plugin \"%s\" can't be stored in a "
+                      "compiled scene file (unsupported type)!", name,
+                      props.plugin_name());
+        }
+    }
+}
+
+static Properties read_properties(Stream *stream) {
+    std::string plugin_name, id, name;
+    uint32_t count, type;
+    stream->read(plugin_name);
+    stream->read(id);
+    stream->read(count);
+
+    Properties props(plugin_name);
+    props.set_id(id);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        stream->read(name);
+        stream->read(type);
+
+        switch ((Properties::Type) type) {
+            case Properties::Type::Bool: {
+                    uint8_t value;
+                    stream->read(value);
+                    props.set_bool(name, value != 0);
+                }
+                break;
+
+            case Properties::Type::Long: {
+                    int64_t value;
+                    stream->read(value);
+                    props.set_long(name, value);
+                }
+                break;
+
+            case Properties::Type::Float: {
+                    Float value;
+                    stream->read(value);
+                    props.set_float(name, value);
+                }
+                break;
+
+            case Properties::Type::Point3f: {
+                    Point3f value;
+                    stream->read_array(value.data(), 3);
+                    props.set_point3f(name, value);
+                }
+                break;
+
+            case Properties::Type::Vector3f: {
+                    Vector3f value;
+                    stream->read_array(value.data(), 3);
+                    props.set_vector3f(name, value);
+                }
+                break;
+
+            case Properties::Type::Color: {
+                    Color3f value;
+                    stream->read_array(value.data(), 3);
+                    props.set_color(name, value);
+                }
+                break;
+
+            case Properties::Type::Transform:
+                props.set_transform(name, Transform4f(read_matrix(stream)));
+                break;
+
+            case Properties::Type::AnimatedTransform: {
+                    uint32_t size;
+                    stream->read(size);
+                    ref<AnimatedTransform> trafo;
+                    if (size == 0)
+                        trafo = new AnimatedTransform(Transform4f(read_matrix(stream)));
+                    else
+                        trafo = new AnimatedTransform();
+                    for (uint32_t j = 0; j < size; ++j) {
+                        Float time;
+                        Matrix3f scale;
+                        Quaternion4f quat;
+                        Vector3f trans;
+                        stream->read(time);
+                        for (size_t k = 0; k < 3; ++k)
+                            for (size_t l = 0; l < 3; ++l)
+                                stream->read(scale(k, l));
+                        stream->read_array(quat.data(), 4);
+                        stream->read_array(trans.data(), 3);
+                        trafo->append(AnimatedTransform::Keyframe(time, scale, quat, trans));
+                    }
+                    props.set_animated_transform(name, trafo);
+                }
+                break;
+
+            case Properties::Type::String: {
+                    std::string value;
+                    stream->read(value);
+                    props.set_string(name, value);
+                }
+                break;
+
+            case Properties::Type::NamedReference: {
+                    std::string value;
+                    stream->read(value);
+                    props.set_named_reference(name, NamedReference(value));
+                }
+                break;
+
+            default:
+                Throw("Invalid property type (%i) in compiled scene file!", type);
+        }
+    }
+
+    return props;
+}
+
+/// Load a compiled scene file (see \ref write_compiled())
+static ref<Object> load_compiled(const fs::path &filename, const std::string &variant,
+                                 bool load_report) {
+    Log(Info, "Loading compiled scene \"%s\" ..", filename);
+    Timer timer;
+
+    ref<FileStream> stream = new FileStream(filename);
+    uint32_t magic, version;
+    uint64_t table_offset;
+    stream->read(magic);
+    stream->read(version);
+    stream->read(table_offset);
+
+    if (magic != compiled_magic)
+        Throw("\"%s\": not a compiled scene file!", filename);
+    if (version != compiled_version)
+        Throw("\"%s\": unsupported compiled scene file version (%i, expected %i). "
+              "Please recompile the scene.", filename, version, compiled_version);
+
+    std::string file_variant, root_id;
+    stream->read(file_variant);
+    if (file_variant != variant)
+        Throw("\"%s\": the scene was compiled for variant \"%s\" and can't be "
+              "loaded using variant \"%s\"!", filename, file_variant, variant);
+    Log(Info, "Using variant \"%s\"", variant);
+
+    stream->read(root_id);
+    uint32_t count;
+    stream->read(count);
+
+    std::vector<ObjectDescription> objects(count);
+    for (auto &desc : objects) {
+        stream->read(desc.id);
+        stream->read(desc.tag);
+        stream->read(desc.alias);
+        desc.props = read_properties(stream);
+    }
+
+    /* Plugins look up their data blocks relative to the directory of the
+       compiled file. Add it to a copy of the file resolver, which is only
+       installed while loading (the previous one is restored on exit) */
+    Thread *thread = Thread::thread();
+    ThreadEnvironment env;
+    ScopedSetThreadEnvironment set_env(env);
+
+    ref<FileResolver> fs = new FileResolver(*thread->file_resolver());
+    fs::path dir = fs::absolute(filename).parent_path();
+    if (!fs->contains(dir))
+        fs->append(dir);
+    thread->set_file_resolver(fs);
+
+    XMLParseContext ctx(variant);
+    ctx.load_report = load_report;
+    add_descriptions(ctx, objects, filename.string());
+
+    float parse_time = (float) timer.value();
+    ref<Object> result = instantiate_node(ctx, root_id);
+    if (load_report)
+        print_load_report(ctx, parse_time);
+    return result;
+}
+
+NAMESPACE_END(detail)
+
+ref<Object> load_string(const std::string &string, const std::string &variant,
+                        ParameterList param) {
+    ScopedPhase sp(ProfilerPhase::InitScene);
+    pugi::xml_document doc;
+    pugi::xml_parse_result result = doc.load_buffer(string.c_str(), string.length(),
+                                                    pugi::parse_default |
+                                                    pugi::parse_comments);
+    detail::XMLSource src{
+        "<string>", doc,
+        [&](ptrdiff_t pos) { return detail::string_offset(string, pos); }
+    };
+
+    if (!result) // There was a parser error
+        Throw("Error while loading \"%s\" (at %s): %s", src.id,
+              src.offset(result.offset), result.description());
+
+    pugi::xml_node root = doc.document_element();
+    detail::XMLParseContext ctx(variant);
+    Properties prop;
+    size_t arg_counter; // Unused
+    auto scene_id = detail::parse_xml(src, ctx, root, Tag::Invalid, prop,
+                                      param, arg_counter, 0).second;
     return detail::instantiate_node(ctx, scene_id);
 }
 
+ref<Object> load_file(const fs::path &filename, const std::string &variant,
+                      ParameterList param, bool write_update, bool load_report) {
+    ScopedPhase sp(ProfilerPhase::InitScene);
+    if (!fs::exists(filename))
+        Throw("\"%s\": file does not exist!", filename);
+
+    if (filename.extension() == ".mtsc") {
+        if (!param.empty())
+            Log(Warn, "\"%s\": parameters are ignored when loading a compiled "
+                      "scene file!", filename);
+        return detail::load_compiled(filename, variant, load_report);
+    }
+
+    Log(Info, "Loading XML file \"%s\" ..", filename);
+    Log(Info, "Using variant \"%s\"", variant);
+
+    Timer timer;
+    detail::XMLParseContext ctx(variant);
+    ctx.load_report = load_report;
+    auto scene_id = detail::parse_document(ctx, filename, param, write_update);
+
+    float parse_time = (float) timer.value();
+    ref<Object> result = detail::instantiate_node(ctx, scene_id);
+    if (load_report)
+        detail::print_load_report(ctx, parse_time);
+    return result;
+}
+
+std::string parse_file(const fs::path &filename, const std::string &variant,
+                       std::vector<ObjectDescription> &objects, ParameterList param) {
+    if (!fs::exists(filename))
+        Throw("\"%s\": file does not exist!", filename);
+
+    detail::XMLParseContext ctx(variant);
+    ctx.deferred = true;
+    auto scene_id = detail::parse_document(ctx, filename, param, false);
+
+    objects.clear();
+    objects.reserve(ctx.instances.size());
+    for (auto &kv : ctx.instances) {
+        const detail::XMLObject &inst = kv.second;
+        ObjectDescription desc;
+        desc.id = kv.first;
+        desc.alias = inst.alias;
+        if (inst.alias.empty()) {
+            desc.tag = inst.class_->alias();
+            desc.props = inst.props;
+        }
+        objects.push_back(std::move(desc));
+    }
+
+    // Produce a deterministic ordering
+    std::sort(objects.begin(), objects.end(),
+              [](const ObjectDescription &a, const ObjectDescription &b) {
+                  return a.id < b.id;
+              });
+
+    return scene_id;
+}
+
+ref<Object> instantiate(const std::vector<ObjectDescription> &objects,
+                        const std::string &root_id, const std::string &variant) {
+    ScopedPhase sp(ProfilerPhase::InitScene);
+    detail::XMLParseContext ctx(variant);
+    detail::add_descriptions(ctx, objects, "<object descriptions>");
+    return detail::instantiate_node(ctx, root_id);
+}
+
+void write_compiled(const fs::path &filename, const std::string &variant,
+                    const std::string &root_id, const std::vector<ObjectDescription> &objects,
+                    const std::vector<CompiledBlob> &blobs) {
+    ref<FileStream> stream = new FileStream(filename, FileStream::ETruncReadWrite);
+
+    stream->write(detail::compiled_magic);
+    stream->write(detail::compiled_version);
+    stream->write((uint64_t) 0); // Offset of the blob table, written below
+    Assert(stream->tell() == detail::compiled_header_size);
+
+    stream->write(variant);
+    stream->write(root_id);
+    stream->write((uint32_t) objects.size());
+    for (const auto &desc : objects) {
+        stream->write(desc.id);
+        stream->write(desc.tag);
+        stream->write(desc.alias);
+        detail::write_properties(stream, desc.props);
+    }
+
+    auto align = [](uint64_t offset) {
+        return (offset + MTS_XML_COMPILED_ALIGNMENT - 1) /
+               MTS_XML_COMPILED_ALIGNMENT * MTS_XML_COMPILED_ALIGNMENT;
+    };
+
+    /* Blob table: number of blobs, followed by an (offset, size) pair per blob */
+    uint64_t table_offset = stream->tell(),
+             offset = align(table_offset + sizeof(uint64_t) * (1 + 2 * blobs.size()));
+    stream->write((uint64_t) blobs.size());
+    for (const auto &blob : blobs) {
+        stream->write(offset);
+        stream->write((uint64_t) blob.second);
+        offset = align(offset + blob.second);
+    }
+
+    const uint8_t zeros[MTS_XML_COMPILED_ALIGNMENT] = { };
+    for (const auto &blob : blobs) {
+        size_t pos = stream->tell();
+        stream->write(zeros, align(pos) - pos);
+        stream->write(blob.first, blob.second);
+    }
+
+    stream->seek(sizeof(uint32_t) * 2);
+    stream->write(table_offset);
+    stream->close();
+
+    Log(Info, "Wrote compiled scene \"%s\" (%i objects, %i data blocks, %s)",
+        filename, objects.size(), blobs.size(), util::mem_string(offset));
+}
+
+CompiledBlob compiled_blob(const MemoryMappedFile *file, size_t index) {
+    const uint8_t *data = (const uint8_t *) file->data();
+    size_t size = file->size();
+
+    auto fail = [&]() {
+        Throw("\"%s\": invalid or truncated compiled scene file!", file->filename());
+    };
+
+    if (size < detail::compiled_header_size ||
+        *(const uint32_t *) data != detail::compiled_magic)
+        fail();
+
+    uint64_t table_offset = *(const uint64_t *) (data + sizeof(uint32_t) * 2);
+    if (table_offset + sizeof(uint64_t) > size)
+        fail();
+
+    const uint64_t *table = (const uint64_t *) (data + table_offset);
+    uint64_t count = table[0];
+    if (index >= count || table_offset + sizeof(uint64_t) * (1 + 2 * count) > size)
+        Throw("\"%s\": data block %i does not exist!", file->filename(), index);
+
+    uint64_t blob_offset = table[1 + 2 * index],
+             blob_size   = table[2 + 2 * index];
+    if (blob_offset + blob_size > size)
+        fail();
+
+    return { data + blob_offset, (size_t) blob_size };
+}
+
 NAMESPACE_END(xml)
 NAMESPACE_END(mitsuba)
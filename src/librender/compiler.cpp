@@ -0,0 +1,129 @@
+#include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/logger.h>
+#include <mitsuba/core/plugin.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/struct.h>
+#include <mitsuba/core/thread.h>
+#include <mitsuba/core/timer.h>
+#include <mitsuba/core/util.h>
+#include <mitsuba/render/compiler.h>
+#include <mitsuba/render/mesh.h>
+#include <tbb/tbb.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+MTS_VARIANT void SceneCompiler<Float, Spectrum>::compile(const fs::path &path,
+                                                         const fs::path &output,
+                                                         xml::ParameterList parameters) {
+    std::string variant = detail::get_variant<Float, Spectrum>();
+    Log(Info, "Compiling \"%s\" into \"%s\" ..", path, output);
+    Timer timer;
+
+    std::vector<xml::ObjectDescription> objects;
+    std::string root_id = xml::parse_file(path, variant, objects, parameters);
+
+    /// Properties that are consumed by the mesh loaders and baked into the buffers
+    const char *loader_properties[] = { "filename", "to_world", "shape_index",
+                                        "flip_tex_coords" };
+
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        const xml::ObjectDescription &desc = objects[i];
+        const std::string &plugin = desc.props.plugin_name();
+        if (desc.tag == "shape" &&
+            (plugin == "ply" || plugin == "obj" || plugin == "serialized"))
+            candidates.push_back(i);
+    }
+
+    /* Load the meshes in parallel. They are created without their BSDFs,
+       emitters, etc., which remain separate objects of the compiled scene */
+    std::vector<ref<Mesh>> meshes(candidates.size());
+    ThreadEnvironment env;
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, candidates.size(), 1),
+        [&](const tbb::blocked_range<size_t> &range) {
+            ScopedSetThreadEnvironment set_env(env);
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                Properties props(objects[candidates[i]].props);
+                for (const auto &kv : props.named_references())
+                    props.remove_property(kv.first);
+                // Keep the vertex data interleaved, it is compacted when loading the compiled scene
+                props.remove_property("compact_vertices");
+                props.remove_property("half_texcoords");
+
+                ref<Shape> shape = PluginManager::instance()->create_object<Shape>(props);
+                meshes[i] = dynamic_cast<Mesh *>(shape.get());
+            }
+        }
+    );
+
+    std::vector<xml::CompiledBlob> blobs;
+    size_t embedded = 0;
+
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        Mesh *mesh = meshes[i];
+        Properties &props = objects[candidates[i]].props;
+        if (!mesh)
+            continue;
+
+        const Struct *vertex_struct = mesh->vertex_struct(),
+                     *face_struct   = mesh->face_struct();
+
+        std::string fields;
+        bool supported = face_struct->size() == 3 * sizeof(typename Mesh::ScalarIndex);
+        for (const auto &field : *vertex_struct) {
+            supported &= field.type == struct_type_v<typename Mesh::InputFloat>;
+            fields += (fields.empty() ? "" : ",") + field.name;
+        }
+
+        if (!supported) {
+            Log(Warn, "Mesh \"%s\" uses an unsupported vertex/face layout and is "
+                      "not embedded into the compiled scene.", props.id());
+            continue;
+        }
+
+        std::string name = fs::path(props.string("filename")).filename().string();
+        for (const char *key : loader_properties)
+            props.remove_property(key);
+
+        ScalarBoundingBox3f bbox = mesh->bbox();
+        props.set_plugin_name("compiled");
+        props.set_string("filename", output.filename().string());
+        props.set_string("name", name);
+        props.set_string("vertex_fields", fields);
+        props.set_long("vertex_count", (int64_t) mesh->vertex_count());
+        props.set_long("face_count", (int64_t) mesh->face_count());
+        props.set_long("vertex_blob", (int64_t) blobs.size());
+        props.set_long("face_blob", (int64_t) blobs.size() + 1);
+        props.set_point3f("bbox_min", Properties::Point3f(bbox.min));
+        props.set_point3f("bbox_max", Properties::Point3f(bbox.max));
+
+        // Include the padding record at the end of both buffers
+        blobs.emplace_back(mesh->vertices(),
+                           (mesh->vertex_count() + 1) * vertex_struct->size());
+        blobs.emplace_back(mesh->faces(),
+                           (mesh->face_count() + 1) * face_struct->size());
+        embedded++;
+    }
+
+    /* Resolve the remaining external files (e.g. textures), so that the
+       compiled scene does not depend on the search path */
+    auto fs = Thread::thread()->file_resolver();
+    for (auto &desc : objects) {
+        Properties &props = desc.props;
+        if (props.plugin_name() == "compiled" || !props.has_property("filename") ||
+            props.type("filename") != Properties::Type::String)
+            continue;
+        fs::path filename = fs->resolve(props.string("filename"));
+        if (fs::exists(filename))
+            props.set_string("filename", fs::absolute(filename).string(), false);
+    }
+
+    xml::write_compiled(output, variant, root_id, objects, blobs);
+
+    Log(Info, "Compiled scene with %i objects (%i embedded meshes) in %s",
+        objects.size(), embedded, util::time_string(timer.value()));
+}
+
+MTS_INSTANTIATE_CLASS(SceneCompiler)
+NAMESPACE_END(mitsuba)
@@ -0,0 +1,338 @@
+#include <mitsuba/render/distributed.h>
+#include <mitsuba/core/logger.h>
+#include <mitsuba/core/util.h>
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+#if defined(MTS_ENABLE_ZMQ)
+#  include <mitsuba/core/zmq11.h>
+#else
+/// Placeholder that allows the (never allocated) socket pointers to be destroyed
+namespace zmq { class socket { }; }
+#endif
+
+NAMESPACE_BEGIN(mitsuba)
+
+// -----------------------------------------------------------------------------
+
+TileQueue::TileQueue(Spiral *spiral, float lease_timeout)
+    : m_lease_timeout(lease_timeout) {
+    while (true) {
+        auto [offset, size, block_id] = spiral->next_block();
+        if (hprod(size) == 0)
+            break;
+        uint32_t id = (uint32_t) m_tiles.size();
+        m_tiles.push_back({ { id, (uint64_t) block_id, offset, size },
+                            State::Pending, 0.f });
+        m_pending.push_back(id);
+    }
+}
+
+TileQueue::~TileQueue() { }
+
+std::pair<TileQueue::Status, TileQueue::Tile> TileQueue::lease() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    float now = m_timer.value();
+
+    uint32_t id;
+    if (!m_pending.empty()) {
+        id = m_pending.front();
+        m_pending.pop_front();
+    } else {
+        /* All tiles have been handed out: lease the tile whose lease expired
+           first again (its worker may have died) */
+        Entry *expired = nullptr;
+        for (Entry &entry : m_tiles) {
+            if (entry.state == State::Leased && entry.deadline < now &&
+                (!expired || entry.deadline < expired->deadline))
+                expired = &entry;
+        }
+        if (!expired)
+            return { done() ? Status::Done : Status::Wait, Tile() };
+        id = expired->tile.id;
+        Log(Warn, "The lease of tile %i expired, handing it out again.", id);
+    }
+
+    Entry &entry = m_tiles[id];
+    entry.state = State::Leased;
+    entry.deadline = now + 1000.f * m_lease_timeout;
+    return { Status::Leased, entry.tile };
+}
+
+bool TileQueue::complete(uint32_t id) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (id >= m_tiles.size())
+        Throw("TileQueue::complete(): invalid tile index %i!", id);
+
+    Entry &entry = m_tiles[id];
+    if (entry.state == State::Complete)
+        return false;
+    if (entry.state == State::Pending)
+        m_pending.erase(std::find(m_pending.begin(), m_pending.end(), id));
+    entry.state = State::Complete;
+    ++m_completed;
+    return true;
+}
+
+void TileQueue::release(uint32_t id) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (id >= m_tiles.size())
+        Throw("TileQueue::release(): invalid tile index %i!", id);
+
+    Entry &entry = m_tiles[id];
+    if (entry.state != State::Leased)
+        return;
+    entry.state = State::Pending;
+    m_pending.push_front(id);
+}
+
+const TileQueue::Tile &TileQueue::tile(uint32_t id) const {
+    if (id >= m_tiles.size())
+        Throw("TileQueue::tile(): invalid tile index %i!", id);
+    return m_tiles[id].tile;
+}
+
+std::string TileQueue::to_string() const {
+    return tfm::format("TileQueue[tiles=%i, completed=%i, lease_timeout=%.1f]",
+                       m_tiles.size(), completed_count(), m_lease_timeout);
+}
+
+// -----------------------------------------------------------------------------
+
+struct RenderServer::Job {
+    RenderMessage header;
+    ref<TileQueue> queue;
+    std::function<size_t(const TileQueue::Tile &)> payload_size;
+    ResultCallback callback;
+};
+
+class RenderServer::ServerThread : public Thread {
+public:
+    ServerThread(RenderServer *server) : Thread("server"), m_server(server) { }
+    void run() override { m_server->run(); }
+
+private:
+    RenderServer *m_server;
+};
+
+static std::mutex __server_mutex;
+static ref<RenderServer> __server_instance;
+
+RenderServer::RenderServer(const std::string &address, float lease_timeout)
+    : m_address(address), m_lease_timeout(lease_timeout) {
+#if defined(MTS_ENABLE_ZMQ)
+    static zmq::context context;
+    m_socket.reset(new zmq::socket(context, zmq::socket::router));
+    m_socket->setsockopt(ZMQ_LINGER, 0);
+    try {
+        m_socket->bind(address);
+    } catch (const zmq::exception &e) {
+        Throw("RenderServer: could not bind to \"%s\": %s", address, e.what());
+    }
+
+    Log(Info, "Listening for render workers on \"%s\" ..", address);
+    m_thread = new ServerThread(this);
+    m_thread->start();
+#else
+    Throw("RenderServer: Mitsuba was compiled without support for distributed "
+          "rendering (MTS_ENABLE_ZMQ)!");
+#endif
+}
+
+RenderServer::~RenderServer() {
+    m_shutdown = true;
+    if (m_thread)
+        m_thread->join();
+}
+
+void RenderServer::start_job(TileQueue *queue, const RenderMessage &job,
+                             std::function<size_t(const TileQueue::Tile &)> payload_size,
+                             ResultCallback callback) {
+    std::lock_guard<std::mutex> guard(m_job_mutex);
+    m_job.reset(new Job{ job, queue, std::move(payload_size), std::move(callback) });
+    m_job->header.job = ++m_job_id;
+}
+
+void RenderServer::finish_job() {
+    std::lock_guard<std::mutex> guard(m_job_mutex);
+    m_job.reset();
+}
+
+void RenderServer::run() {
+#if defined(MTS_ENABLE_ZMQ)
+    zmq::pollitem item { (void *) *m_socket, 0, zmq::pollin, 0 };
+    Timer shutdown_timer;
+    bool draining = false;
+
+    /* Identities of the workers that have not been told to shut down yet */
+    std::unordered_set<std::string> workers;
+
+    while (true) {
+        /* Once shut down, keep replying until every worker has been told to
+           exit. Workers that are still rendering a tile will only ask again
+           once it is done, hence wait for up to the lease timeout before
+           considering them lost. */
+        if (m_shutdown && !draining) {
+            draining = true;
+            shutdown_timer.reset();
+        }
+        if (draining) {
+            if (workers.empty())
+                break;
+            if (shutdown_timer.value() > 1000.f * m_lease_timeout) {
+                Log(Warn, "RenderServer: %i worker%s did not acknowledge the "
+                    "shutdown.", workers.size(), workers.size() == 1 ? "" : "s");
+                break;
+            }
+        }
+
+        zmq::poll(&item, 1, 100);
+        if (!(item.revents & zmq::pollin))
+            continue;
+
+        zmq::message identity, header, payload;
+        m_socket->recv(identity);
+        bool has_header  = m_socket->more() && m_socket->recv(header),
+             has_payload = m_socket->more() && m_socket->recv(payload);
+        m_socket->discard_remainder();
+
+        if (!has_header || header.size() != sizeof(RenderMessage)) {
+            Log(Warn, "RenderServer: discarding a malformed message.");
+            continue;
+        }
+
+        RenderMessage message, reply;
+        memcpy(&message, header.data(), sizeof(RenderMessage));
+        std::string worker((const char *) identity.data(), identity.size());
+
+        if (m_shutdown) {
+            reply.type = RenderMessage::Shutdown;
+            workers.erase(worker);
+        } else {
+            workers.insert(worker);
+
+            std::lock_guard<std::mutex> guard(m_job_mutex);
+
+            if (message.type == RenderMessage::Result && m_job &&
+                message.job == m_job->header.job) {
+                TileQueue *queue = m_job->queue.get();
+                if (message.tile < queue->tile_count()) {
+                    const TileQueue::Tile &tile = queue->tile(message.tile);
+                    if (!has_payload || payload.size() != m_job->payload_size(tile))
+                        Log(Warn, "RenderServer: discarding the result of tile %i "
+                            "with an unexpected size.", message.tile);
+                    else if (queue->complete(message.tile)) {
+                        m_job->callback(tile, payload.data());
+                        ++m_result_count;
+                    }
+                }
+            }
+
+            reply.type = RenderMessage::Wait;
+            if (m_job) {
+                auto [status, tile] = m_job->queue->lease();
+                if (status == TileQueue::Status::Leased) {
+                    reply = m_job->header;
+                    reply.type = RenderMessage::Lease;
+                    reply.tile = tile.id;
+                    reply.seed = tile.seed;
+                    for (int i = 0; i < 2; ++i) {
+                        reply.offset[i] = tile.offset[i];
+                        reply.size[i] = tile.size[i];
+                    }
+                }
+            }
+        }
+
+        m_socket->sendmore(identity);
+        m_socket->send(reply);
+    }
+#endif
+}
+
+bool RenderServer::enabled() {
+#if defined(MTS_ENABLE_ZMQ)
+    return true;
+#else
+    return false;
+#endif
+}
+
+RenderServer *RenderServer::instance() {
+    std::lock_guard<std::mutex> guard(__server_mutex);
+    return __server_instance.get();
+}
+
+void RenderServer::set_instance(RenderServer *server) {
+    std::lock_guard<std::mutex> guard(__server_mutex);
+    __server_instance = server;
+}
+
+std::string RenderServer::to_string() const {
+    return tfm::format("RenderServer[address=\"%s\", lease_timeout=%.1f, results=%i]",
+                       m_address, m_lease_timeout, result_count());
+}
+
+// -----------------------------------------------------------------------------
+
+RenderClient::RenderClient(const std::string &address, float timeout)
+    : m_address(address), m_timeout(timeout) {
+#if defined(MTS_ENABLE_ZMQ)
+    static zmq::context context;
+    m_socket.reset(new zmq::socket(context, zmq::socket::dealer));
+    m_socket->setsockopt(ZMQ_LINGER, 0);
+    try {
+        m_socket->connect(address);
+    } catch (const zmq::exception &e) {
+        Throw("RenderClient: could not connect to \"%s\": %s", address, e.what());
+    }
+#else
+    Throw("RenderClient: Mitsuba was compiled without support for distributed "
+          "rendering (MTS_ENABLE_ZMQ)!");
+#endif
+}
+
+RenderClient::~RenderClient() { }
+
+RenderMessage RenderClient::send(const RenderMessage &message, const void *data,
+                                 size_t size) {
+#if defined(MTS_ENABLE_ZMQ)
+    if (data) {
+        m_socket->sendmore(message);
+        m_socket->send(data, size);
+    } else {
+        m_socket->send(message);
+    }
+
+    zmq::pollitem item { (void *) *m_socket, 0, zmq::pollin, 0 };
+    zmq::poll(&item, 1, (long) (1000.f * m_timeout));
+    if (!(item.revents & zmq::pollin))
+        Throw("RenderClient: the server at \"%s\" did not reply within %s, "
+              "lost the connection?", m_address,
+              util::time_string(1000.f * m_timeout));
+
+    zmq::message reply;
+    m_socket->recv(reply);
+    m_socket->discard_remainder();
+    if (reply.size() != sizeof(RenderMessage))
+        Throw("RenderClient: received a malformed message!");
+
+    RenderMessage result;
+    memcpy(&result, reply.data(), sizeof(RenderMessage));
+    return result;
+#else
+    (void) message; (void) data; (void) size;
+    Throw("RenderClient: Mitsuba was compiled without support for distributed "
+          "rendering (MTS_ENABLE_ZMQ)!");
+#endif
+}
+
+std::string RenderClient::to_string() const {
+    return tfm::format("RenderClient[address=\"%s\", timeout=%.1f]", m_address, m_timeout);
+}
+
+MTS_IMPLEMENT_CLASS(TileQueue, Object)
+MTS_IMPLEMENT_CLASS(RenderServer, Object)
+MTS_IMPLEMENT_CLASS(RenderClient, Object)
+NAMESPACE_END(mitsuba)
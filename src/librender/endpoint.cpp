@@ -23,6 +23,10 @@ MTS_VARIANT Endpoint<Float, Spectrum>::~Endpoint() { }
 MTS_VARIANT void Endpoint<Float, Spectrum>::set_scene(const Scene *) {
 }
 
+MTS_VARIANT void Endpoint<Float, Spectrum>::set_world_transform(const AnimatedTransform *transform) {
+    m_world_transform = transform;
+}
+
 MTS_VARIANT void Endpoint<Float, Spectrum>::set_shape(Shape * shape) {
     m_shape = shape;
 }
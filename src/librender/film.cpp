@@ -1,6 +1,7 @@
 #include <mitsuba/render/film.h>
 #include <mitsuba/core/plugin.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/writequeue.h>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -63,6 +64,11 @@ MTS_VARIANT void Film<Float, Spectrum>::set_crop_window(const ScalarPoint2i &cro
     m_crop_offset = crop_offset;
 }
 
+MTS_VARIANT ref<WriteHandle> Film<Float, Spectrum>::develop_async() {
+    develop();
+    return nullptr;
+}
+
 MTS_VARIANT std::string Film<Float, Spectrum>::to_string() const {
     std::ostringstream oss;
     oss << "Film[" << std::endl
@@ -2,19 +2,22 @@
 #include <mutex>
 
 #include <enoki/morton.h>
+#include <mitsuba/core/arena.h>
+#include <mitsuba/core/numa.h>
 #include <mitsuba/core/profiler.h>
 #include <mitsuba/core/progress.h>
 #include <mitsuba/core/spectrum.h>
 #include <mitsuba/core/timer.h>
 #include <mitsuba/core/util.h>
 #include <mitsuba/core/warp.h>
+#include <mitsuba/render/distributed.h>
 #include <mitsuba/render/film.h>
 #include <mitsuba/render/integrator.h>
+#include <mitsuba/render/scene.h>
 #include <mitsuba/render/sampler.h>
 #include <mitsuba/render/sensor.h>
 #include <mitsuba/render/spiral.h>
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
+#include <chrono>
 #include <mutex>
 
 NAMESPACE_BEGIN(mitsuba)
@@ -36,6 +39,9 @@ MTS_VARIANT SamplingIntegrator<Float, Spectrum>::SamplingIntegrator(const Proper
 
     /// Disable direct visibility of emitters if needed
     m_hide_emitters = props.bool_("hide_emitters", false);
+
+    /// Set up the per-thread render state for every block (for benchmarking)
+    m_per_block_setup = props.bool_("per_block_setup", false);
 }
 
 MTS_VARIANT SamplingIntegrator<Float, Spectrum>::~SamplingIntegrator() { }
@@ -52,7 +58,7 @@ MTS_VARIANT bool SamplingIntegrator<Float, Spectrum>::render(Scene *scene, Senso
     ScopedPhase sp(ProfilerPhase::Render);
     m_stop = false;
 
-    ref<Film> film = sensor->film();
+    Film *film = sensor->film();
     ScalarVector2i film_size = film->crop_size();
 
     size_t total_spp        = sensor->sampler()->sample_count();
@@ -95,40 +101,155 @@ MTS_VARIANT bool SamplingIntegrator<Float, Spectrum>::render(Scene *scene, Senso
                blocks_done = 0;
 
         m_render_timer.reset();
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, total_blocks, 1),
-            [&](const tbb::blocked_range<size_t> &range) {
-                ScopedSetThreadEnvironment set_env(env);
-                ref<Sampler> sampler = sensor->sampler()->clone();
-                ref<ImageBlock> block = new ImageBlock(m_block_size, channels.size(),
-                                                       film->reconstruction_filter(),
-                                                       !has_aovs);
-                scoped_flush_denormals flush_denormals(true);
-                std::unique_ptr<Float[]> aovs(new Float[channels.size()]);
-
-                // For each block
-                for (auto i = range.begin(); i != range.end() && !should_stop(); ++i) {
-                    auto [offset, size, block_id] = spiral.next_block();
-                    Assert(hprod(size) != 0);
-                    block->set_size(size);
-                    block->set_offset(offset);
-
-                    // Ensure that the sample generation is fully deterministic
-                    sampler->seed(block_id);
-
-                    render_block(scene, sensor, sampler, block,
-                                 aovs.get(), samples_per_pass);
-
-                    film->put(block);
-
-                    /* Critical section: update progress bar */ {
-                        std::lock_guard<std::mutex> lock(mutex);
-                        blocks_done++;
-                        progress->update(blocks_done / (ScalarFloat) total_blocks);
+        if (ref<RenderServer> server = RenderServer::instance(); server) {
+            /* Distributed rendering: the local threads and remote workers
+               lease blocks from a shared queue */
+            ref<TileQueue> queue = new TileQueue(&spiral, server->lease_timeout());
+            size_t remote_blocks = 0;
+            ref<ImageBlock> remote_block = new ImageBlock(m_block_size, channels.size(),
+                                                          film->reconstruction_filter(),
+                                                          !has_aovs);
+            auto payload_size = [&](const TileQueue::Tile &tile) {
+                return channels.size() * sizeof(ScalarFloat) *
+                       hprod(tile.size + 2 * remote_block->border_size());
+            };
+
+            // Workers look up the sensor by its index
+            RenderMessage job;
+            job.sensor = (uint32_t) -1;
+            for (size_t i = 0; i < scene->sensors().size(); ++i) {
+                if (scene->sensors()[i].get() == sensor)
+                    job.sensor = (uint32_t) i;
+            }
+            if (job.sensor == (uint32_t) -1)
+                Throw("Distributed rendering requires a sensor that is part of the scene!");
+            job.spp = (uint32_t) samples_per_pass;
+            job.channel_count = (uint32_t) channels.size();
+            job.film_size[0] = film_size.x();
+            job.film_size[1] = film_size.y();
+
+            // Invoked by the server thread, which never runs it concurrently
+            server->start_job(queue, job, payload_size,
+                [&](const TileQueue::Tile &tile, const void *data) {
+                    remote_block->set_size(tile.size);
+                    remote_block->set_offset(tile.offset);
+                    memcpy(remote_block->data().data(), data, payload_size(tile));
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    film->put(remote_block);
+                    blocks_done++;
+                    remote_blocks++;
+                    progress->update(blocks_done / (ScalarFloat) total_blocks);
+                });
+
+            numa::parallel_for(
+                n_threads, 1,
+                [&](size_t, size_t) {
+                    ScopedSetThreadEnvironment set_env(env);
+                    ref<Sampler> sampler = sensor->sampler()->clone();
+                    ref<ImageBlock> block = new ImageBlock(m_block_size, channels.size(),
+                                                           film->reconstruction_filter(),
+                                                           !has_aovs);
+                    scoped_flush_denormals flush_denormals(true);
+                    MemoryArena &arena = MemoryArena::thread();
+                    /* Merge the chunks of the arena. The calling thread also runs
+                       a task, so its own allocations must be left intact. */
+                    if (arena.used() == 0)
+                        arena.reset();
+
+                    while (!should_stop()) {
+                        auto [status, tile] = queue->lease();
+                        if (status == TileQueue::Status::Done)
+                            break;
+                        if (status == TileQueue::Status::Wait) {
+                            // The remaining blocks are rendered by workers
+                            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                            continue;
+                        }
+
+                        block->set_size(tile.size);
+                        block->set_offset(tile.offset);
+                        sampler->seed(tile.seed);
+
+                        // Scratch memory of integrators is released after every block
+                        ScopedMemoryArena scratch(arena);
+                        Float *aovs = arena.allocate<Float>(channels.size());
+
+                        render_block(scene, sensor, sampler, block,
+                                     aovs, samples_per_pass);
+
+                        if (should_stop()) {
+                            queue->release(tile.id);
+                            break;
+                        }
+
+                        // Discard blocks that a worker has already returned
+                        if (queue->complete(tile.id)) {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            film->put(block);
+                            blocks_done++;
+                            progress->update(blocks_done / (ScalarFloat) total_blocks);
+                        }
                     }
                 }
-            }
-        );
+            );
+
+            server->finish_job();
+            Log(Info, "%i/%i blocks were rendered by workers.", remote_blocks,
+                total_blocks);
+        } else {
+            /* Each thread fetches blocks until the spiral is exhausted, so that
+               the per-thread state below (whose construction updates the
+               shared reference counts of the sensor's sampler, the
+               reconstruction filter, the logger, etc.) is only set up once */
+            numa::parallel_for(
+                n_threads, 1,
+                [&](size_t, size_t) {
+                    ScopedSetThreadEnvironment set_env(env);
+                    ref<Sampler> sampler;
+                    ref<ImageBlock> block;
+                    scoped_flush_denormals flush_denormals(true);
+                    MemoryArena &arena = MemoryArena::thread();
+                    /* Merge the chunks of the arena. The calling thread also runs
+                       a task, so its own allocations must be left intact. */
+                    if (arena.used() == 0)
+                        arena.reset();
+
+                    // For each block
+                    while (!should_stop()) {
+                        auto [offset, size, block_id] = spiral.next_block();
+                        if (hprod(size) == 0)
+                            break;
+                        if (!block || m_per_block_setup) {
+                            sampler = sensor->sampler()->clone();
+                            block = new ImageBlock(m_block_size, channels.size(),
+                                                   film->reconstruction_filter(),
+                                                   !has_aovs);
+                        }
+                        block->set_size(size);
+                        block->set_offset(offset);
+
+                        // Ensure that the sample generation is fully deterministic
+                        sampler->seed(block_id);
+
+                        // Scratch memory of integrators is released after every block
+                        ScopedMemoryArena scratch(arena);
+                        Float *aovs = arena.allocate<Float>(channels.size());
+
+                        render_block(scene, sensor, sampler, block,
+                                     aovs, samples_per_pass);
+
+                        film->put(block);
+
+                        /* Critical section: update progress bar */ {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            blocks_done++;
+                            progress->update(blocks_done / (ScalarFloat) total_blocks);
+                        }
+                    }
+                }
+            );
+        }
     } else {
         ref<Sampler> sampler = sensor->sampler();
 
@@ -163,12 +284,110 @@ MTS_VARIANT bool SamplingIntegrator<Float, Spectrum>::render(Scene *scene, Senso
     return !m_stop;
 }
 
+MTS_VARIANT bool SamplingIntegrator<Float, Spectrum>::render_worker(Scene *scene,
+                                                                    const std::string &address) {
+    m_stop = false;
+
+    if constexpr (!is_cuda_array_v<Float>) {
+        std::vector<std::string> channels = aov_names();
+        bool has_aovs = !channels.empty();
+        for (size_t i = 0; i < 5; ++i)
+            channels.insert(channels.begin() + i, std::string(1, "XYZAW"[i]));
+
+        size_t n_threads = __global_thread_count;
+        Log(Info, "Connecting %i worker thread%s to \"%s\" ..", n_threads,
+            n_threads == 1 ? "" : "s", address);
+
+        ThreadEnvironment env;
+        std::atomic<size_t> blocks_done(0);
+
+        m_render_timer.reset();
+        numa::parallel_for(
+            n_threads, 1,
+            [&](size_t, size_t) {
+                ScopedSetThreadEnvironment set_env(env);
+                scoped_flush_denormals flush_denormals(true);
+                MemoryArena &arena = MemoryArena::thread();
+                /* Merge the chunks of the arena. The calling thread also runs
+                   a task, so its own allocations must be left intact. */
+                if (arena.used() == 0)
+                    arena.reset();
+
+                // Each thread has its own connection and leases blocks independently
+                ref<RenderClient> client = new RenderClient(address);
+                ref<Sampler> sampler;
+                ref<ImageBlock> block;
+                uint32_t sensor_index = (uint32_t) -1;
+
+                RenderMessage reply = client->send(RenderMessage());
+                while (!should_stop() && reply.type != RenderMessage::Shutdown) {
+                    if (reply.type != RenderMessage::Lease) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                        reply = client->send(RenderMessage());
+                        continue;
+                    }
+
+                    if (reply.sensor >= scene->sensors().size())
+                        Throw("The scene of the render server does not match the "
+                              "scene of this worker (sensor %i not found)!", reply.sensor);
+                    Sensor *sensor = scene->sensors()[reply.sensor].get();
+                    Film *film = sensor->film();
+
+                    ScalarVector2i size(reply.size[0], reply.size[1]);
+                    if (reply.channel_count != channels.size() ||
+                        film->crop_size() != ScalarVector2i(reply.film_size[0],
+                                                            reply.film_size[1]) ||
+                        any(size > (int) m_block_size))
+                        Throw("The scene of the render server does not match the "
+                              "scene of this worker (film, block size or AOVs differ)!");
+
+                    if (reply.sensor != sensor_index) {
+                        sampler = sensor->sampler()->clone();
+                        block = new ImageBlock(m_block_size, channels.size(),
+                                               film->reconstruction_filter(), !has_aovs);
+                        sensor_index = reply.sensor;
+                    }
+
+                    block->set_size(size);
+                    block->set_offset(ScalarPoint2i(reply.offset[0], reply.offset[1]));
+                    sampler->seed(reply.seed);
+
+                    {
+                        ScopedMemoryArena scratch(arena);
+                        Float *aovs = arena.allocate<Float>(channels.size());
+                        render_block(scene, sensor, sampler, block, aovs, reply.spp);
+                    }
+                    if (should_stop())
+                        break;
+
+                    RenderMessage result = reply;
+                    result.type = RenderMessage::Result;
+                    reply = client->send(result, block->data().data(),
+                                         channels.size() * sizeof(ScalarFloat) *
+                                         hprod(size + 2 * block->border_size()));
+                    blocks_done++;
+                }
+            }
+        );
+
+        Log(Info, "Worker finished, rendered %i blocks. (took %s)",
+            (size_t) blocks_done, util::time_string(m_render_timer.value(), true));
+    } else {
+        ENOKI_MARK_USED(scene);
+        ENOKI_MARK_USED(address);
+        Throw("Distributed rendering is not supported by GPU variants.");
+    }
+
+    return !m_stop;
+}
+
 MTS_VARIANT void SamplingIntegrator<Float, Spectrum>::render_block(const Scene *scene,
                                                                    const Sensor *sensor,
                                                                    Sampler *sampler,
                                                                    ImageBlock *block,
                                                                    Float *aovs,
                                                                    size_t sample_count_) const {
+    ScopedPhase sp(ProfilerPhase::RenderBlock);
     block->clear();
     uint32_t pixel_count  = (uint32_t)(m_block_size * m_block_size),
              sample_count = (uint32_t)(sample_count_ == (size_t) -1
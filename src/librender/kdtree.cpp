@@ -61,6 +61,18 @@ MTS_VARIANT void ShapeKDTree<Float, Spectrum>::build() {
     );
 }
 
+MTS_VARIANT void ShapeKDTree<Float, Spectrum>::rebuild() {
+    m_nodes.reset();
+    m_indices.reset();
+    m_node_count = m_index_count = 0;
+
+    m_bbox.reset();
+    for (Shape *shape : m_shapes)
+        m_bbox.expand(shape->bbox());
+
+    build();
+}
+
 MTS_VARIANT void ShapeKDTree<Float, Spectrum>::add_shape(Shape *shape) {
     Assert(!ready());
     m_primitive_map.push_back(m_primitive_map.back() +
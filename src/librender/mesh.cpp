@@ -1,5 +1,6 @@
 #include <mitsuba/core/fstream.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/spectrum.h>
 #include <mitsuba/core/timer.h>
 #include <mitsuba/core/transform.h>
 #include <mitsuba/core/util.h>
@@ -7,7 +8,12 @@
 #include <mitsuba/render/interaction.h>
 #include <mitsuba/render/mesh.h>
 #include <mitsuba/render/records.h>
+#include <mitsuba/render/texture.h>
 #include "blender_types.h"
+#include <enoki/half.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <atomic>
 #include <mutex>
 
 #if defined(MTS_ENABLE_EMBREE)
@@ -20,14 +26,48 @@
 #endif
 
 
+/// Grain size for TBB parallelization
+#define MTS_MESH_GRAIN_SIZE 4096u
+
 NAMESPACE_BEGIN(mitsuba)
 
+namespace {
+/// Encode a unit vector using 32 bits (see \ref detail::octahedral_decode())
+template <typename Normal3f>
+uint32_t octahedral_encode(const Normal3f &n) {
+    using Float = value_t<Normal3f>;
+    using Vector2f = Vector<Float, 2>;
+
+    Float inv_norm = rcp(abs(n.x()) + abs(n.y()) + abs(n.z()));
+    Vector2f p(n.x() * inv_norm, n.y() * inv_norm);
+
+    // Fold the lower hemisphere over the diagonals
+    if (n.z() < 0.f)
+        p = (1.f - abs(Vector2f(p.y(), p.x()))) *
+            Vector2f(p.x() >= 0.f ? 1.f : -1.f, p.y() >= 0.f ? 1.f : -1.f);
+
+    auto quantize = [](Float value) {
+        return (uint32_t) (uint16_t) (int16_t) std::round(
+            clamp(value, -1.f, 1.f) * 32767.f);
+    };
+
+    return quantize(p.x()) | (quantize(p.y()) << 16);
+}
+} // namespace
+
 MTS_VARIANT Mesh<Float, Spectrum>::Mesh(const Properties &props) : Base(props) {
     /* When set to ``true``, Mitsuba will use per-face instead of per-vertex
        normals when rendering the object, which will give it a faceted
        appearance. Default: ``false`` */
     if (props.bool_("face_normals", false))
         m_disable_vertex_normals = true;
+    /* When set to ``true``, the vertex data is converted into a compact,
+       non-interleaved layout after loading (see \ref compact_vertices()).
+       Default: ``false`` */
+    m_compact_requested = props.bool_("compact_vertices", false);
+    /* Store texture coordinates in half precision when using the compact
+       vertex layout. Default: ``false`` */
+    m_half_texcoords = props.bool_("half_texcoords", false);
     m_to_world = props.transform("to_world", ScalarTransform4f());
     m_mesh = true;
 }
@@ -37,6 +77,34 @@ MTS_VARIANT Mesh<Float, Spectrum>::Mesh(const std::string &name, Struct *vertex_
                                         ScalarSize face_count)
     : m_name(name), m_vertex_count(vertex_count), m_face_count(face_count),
       m_vertex_struct(vertex_struct), m_face_struct(face_struct) {
+    init_structs();
+
+    m_vertices = VertexHolder(new uint8_t[(vertex_count + 1) * m_vertex_size]);
+    m_faces    = FaceHolder(new uint8_t[(face_count + 1) * m_face_size]);
+
+    m_mesh = true;
+}
+
+MTS_VARIANT Mesh<Float, Spectrum>::Mesh(const std::string &name, Struct *vertex_struct,
+                                        ScalarSize vertex_count, void *vertices,
+                                        Struct *face_struct, ScalarSize face_count,
+                                        void *faces, const std::shared_ptr<void> &owner)
+    : m_external_owner(owner), m_name(name), m_vertex_count(vertex_count),
+      m_face_count(face_count), m_vertex_struct(vertex_struct),
+      m_face_struct(face_struct) {
+    if (!vertices || !faces)
+        Throw("Mesh::Mesh(): vertex and face buffers must be non-null!");
+
+    init_structs();
+
+    m_vertices = VertexHolder((uint8_t *) vertices, BufferDeleter{ false });
+    m_faces    = FaceHolder((uint8_t *) faces, BufferDeleter{ false });
+
+    recompute_bbox();
+    m_mesh = true;
+}
+
+MTS_VARIANT void Mesh<Float, Spectrum>::init_structs() {
     /* Helper lambda function to determine compatibility (offset/type) of a 'Struct' field */
     auto check_field = [](const Struct *s, size_t idx,
                           const std::string &suffix_exp,
@@ -52,6 +120,9 @@ MTS_VARIANT Mesh<Float, Spectrum>::Mesh(const std::string &name, Struct *vertex_
             Throw("Mesh::Mesh(): Incompatible data structure %s", s->to_string());
     };
 
+    const Struct *vertex_struct = m_vertex_struct.get(),
+                 *face_struct   = m_face_struct.get();
+
     check_field(vertex_struct, 0, "x",  struct_type_v<InputFloat>);
     check_field(vertex_struct, 1, "y",  struct_type_v<InputFloat>);
     check_field(vertex_struct, 2, "z",  struct_type_v<InputFloat>);
@@ -82,11 +153,6 @@ MTS_VARIANT Mesh<Float, Spectrum>::Mesh(const std::string &name, Struct *vertex_
 
     m_vertex_size = (ScalarSize) m_vertex_struct->size();
     m_face_size   = (ScalarSize) m_face_struct->size();
-
-    m_vertices = VertexHolder(new uint8_t[(vertex_count + 1) * m_vertex_size]);
-    m_faces    = VertexHolder(new uint8_t[(face_count + 1) * m_face_size]);
-
-    m_mesh = true;
 }
 
 /**
@@ -367,15 +433,48 @@ MTS_VARIANT void Mesh<Float, Spectrum>::write_ply(Stream *stream) const {
     Log(Info, "Writing mesh to \"%s\" ..", stream_name);
 
     Timer timer;
+
+    /* The compact layout stores the attributes in separate buffers. Expand
+       them into a temporary interleaved buffer before writing */
+    ref<Struct> vertex_struct = m_vertex_struct;
+    VertexHolder vertices_expanded;
+    const uint8_t *vertices = m_vertices.get();
+    if (m_compact_vertices) {
+        vertex_struct = new Struct();
+        for (auto name : { "x", "y", "z" })
+            vertex_struct->append(name, struct_type_v<InputFloat>);
+        if (has_vertex_normals())
+            for (auto name : { "nx", "ny", "nz" })
+                vertex_struct->append(name, struct_type_v<InputFloat>);
+        if (has_vertex_texcoords())
+            for (auto name : { "u", "v" })
+                vertex_struct->append(name, struct_type_v<InputFloat>);
+
+        size_t size = vertex_struct->size();
+        vertices_expanded = VertexHolder(new uint8_t[m_vertex_count * size]);
+        for (ScalarSize i = 0; i < m_vertex_count; ++i) {
+            uint8_t *ptr = vertices_expanded.get() + i * size;
+            store_unaligned(ptr, vertex_position(i));
+            ptr += sizeof(InputPoint3f);
+            if (has_vertex_normals()) {
+                store_unaligned(ptr, vertex_normal(i));
+                ptr += sizeof(InputNormal3f);
+            }
+            if (has_vertex_texcoords())
+                store_unaligned(ptr, vertex_texcoord(i));
+        }
+        vertices = vertices_expanded.get();
+    }
+
     stream->write_line("ply");
     if (Struct::host_byte_order() == Struct::ByteOrder::BigEndian)
         stream->write_line("format binary_big_endian 1.0");
     else
         stream->write_line("format binary_little_endian 1.0");
 
-    if (m_vertex_struct->field_count() > 0) {
+    if (vertex_struct->field_count() > 0) {
         stream->write_line(tfm::format("element vertex %i", m_vertex_count));
-        for (auto const &f : *m_vertex_struct)
+        for (auto const &f : *vertex_struct)
             stream->write_line(
                 tfm::format("property %s %s", type_name(f.type), f.name));
     }
@@ -388,10 +487,10 @@ MTS_VARIANT void Mesh<Float, Spectrum>::write_ply(Stream *stream) const {
 
     stream->write_line("end_header");
 
-    if (m_vertex_struct->field_count() > 0) {
+    if (vertex_struct->field_count() > 0) {
         stream->write(
-            m_vertices.get(),
-            m_vertex_struct->size() * m_vertex_count
+            vertices,
+            vertex_struct->size() * m_vertex_count
         );
     }
 
@@ -419,7 +518,7 @@ MTS_VARIANT void Mesh<Float, Spectrum>::write_ply(Stream *stream) const {
     Log(Info, "\"%s\": wrote %i faces, %i vertices (%s in %s)",
         m_name, m_face_count, m_vertex_count,
         util::mem_string(m_face_count * m_face_struct->size() +
-                         m_vertex_count * m_vertex_struct->size()),
+                         m_vertex_count * vertex_struct->size()),
         util::time_string(timer.value())
     );
 }
@@ -429,55 +528,96 @@ MTS_VARIANT void Mesh<Float, Spectrum>::recompute_vertex_normals() {
         Throw("Storing new normals in a Mesh that didn't have normals at "
               "construction time is not implemented yet.");
 
-    std::vector<InputNormal3f> normals(m_vertex_count, zero<InputNormal3f>());
-    size_t invalid_counter = 0;
+    if ((uint64_t) m_face_count * 3 > (uint64_t) std::numeric_limits<uint32_t>::max())
+        Throw("recompute_vertex_normals(): too many faces!");
+
     Timer timer;
+    ScalarSize corner_count = m_face_count * 3;
+
+    /* The computation proceeds in three parallel phases that avoid atomic
+       scatter operations: the weighted face normal contribution of every
+       triangle corner is computed first. The corners are then sorted by
+       vertex index, which finally allows accumulating the contributions of
+       each vertex independently. */
+    std::unique_ptr<InputNormal3f[]> corner_normals(new InputNormal3f[corner_count]);
+    std::unique_ptr<uint64_t[]> corners(new uint64_t[corner_count]);
 
     /* Weighting scheme based on "Computing Vertex Normals from Polygonal Facets"
        by Grit Thuermer and Charles A. Wuethrich, JGT 1998, Vol 3 */
-    for (ScalarSize i = 0; i < m_face_count; ++i) {
-        const ScalarIndex *idx = (const ScalarIndex *) face(i);
-        Assert(idx[0] < m_vertex_count && idx[1] < m_vertex_count && idx[2] < m_vertex_count);
-        InputPoint3f v[3]{ vertex_position(idx[0]),
-                           vertex_position(idx[1]),
-                           vertex_position(idx[2]) };
-
-        InputVector3f side_0 = v[1] - v[0],
-                      side_1 = v[2] - v[0];
-        InputNormal3f n = cross(side_0, side_1);
-        InputFloat length_sqr = squared_norm(n);
-        if (likely(length_sqr > 0)) {
-            n *= rsqrt(length_sqr);
-
-            // Use Enoki to compute the face angles at the same time
-            auto side1 = transpose(Array<Packet<InputFloat, 3>, 3>{ side_0, v[2] - v[1], v[0] - v[2] });
-            auto side2 = transpose(Array<Packet<InputFloat, 3>, 3>{ side_1, v[0] - v[1], v[1] - v[2] });
-            InputVector3f face_angles = unit_angle(normalize(side1), normalize(side2));
-
-            for (size_t j = 0; j < 3; ++j)
-                normals[idx[j]] += n * face_angles[j];
-        }
-    }
+    tbb::parallel_for(
+        tbb::blocked_range<ScalarSize>(0u, m_face_count, MTS_MESH_GRAIN_SIZE),
+        [&](const tbb::blocked_range<ScalarSize> &range) {
+            for (ScalarSize i = range.begin(); i != range.end(); ++i) {
+                const ScalarIndex *idx = (const ScalarIndex *) face(i);
+                Assert(idx[0] < m_vertex_count && idx[1] < m_vertex_count && idx[2] < m_vertex_count);
+                InputPoint3f v[3]{ vertex_position(idx[0]),
+                                   vertex_position(idx[1]),
+                                   vertex_position(idx[2]) };
+
+                InputVector3f side_0 = v[1] - v[0],
+                              side_1 = v[2] - v[0];
+                InputNormal3f n = cross(side_0, side_1);
+                InputFloat length_sqr = squared_norm(n);
+                InputVector3f face_angles = zero<InputVector3f>();
+                if (likely(length_sqr > 0)) {
+                    n *= rsqrt(length_sqr);
+
+                    // Use Enoki to compute the face angles at the same time
+                    auto side1 = transpose(Array<Packet<InputFloat, 3>, 3>{ side_0, v[2] - v[1], v[0] - v[2] });
+                    auto side2 = transpose(Array<Packet<InputFloat, 3>, 3>{ side_1, v[0] - v[1], v[1] - v[2] });
+                    face_angles = unit_angle(normalize(side1), normalize(side2));
+                }
 
-    for (ScalarSize i = 0; i < m_vertex_count; i++) {
-        InputNormal3f n = normals[i];
-        InputFloat length = norm(n);
-        if (likely(length != 0.f)) {
-            n /= length;
-        } else {
-            n = InputNormal3f(1, 0, 0); // Choose some bogus value
-            invalid_counter++;
+                for (size_t j = 0; j < 3; ++j) {
+                    ScalarIndex corner = i * 3 + (ScalarIndex) j;
+                    corner_normals[corner] = n * face_angles[j];
+                    corners[corner] = ((uint64_t) idx[j] << 32) | corner;
+                }
+            }
         }
+    );
 
-        store(vertex(i) + m_normal_offset, n);
-    }
+    tbb::parallel_sort(corners.get(), corners.get() + corner_count);
+
+    std::atomic<size_t> invalid_counter(0);
+    tbb::parallel_for(
+        tbb::blocked_range<ScalarSize>(0u, m_vertex_count, MTS_MESH_GRAIN_SIZE),
+        [&](const tbb::blocked_range<ScalarSize> &range) {
+            const uint64_t *it = std::lower_bound(corners.get(), corners.get() + corner_count,
+                                                  (uint64_t) range.begin() << 32),
+                           *end = corners.get() + corner_count;
+            size_t invalid_local = 0;
+
+            for (ScalarSize i = range.begin(); i != range.end(); ++i) {
+                InputNormal3f n = zero<InputNormal3f>();
+                for (; it != end && (ScalarIndex) (*it >> 32) == i; ++it)
+                    n += corner_normals[(ScalarIndex) *it];
+
+                InputFloat length = norm(n);
+                if (likely(length != 0.f)) {
+                    n /= length;
+                } else {
+                    n = InputNormal3f(1, 0, 0); // Choose some bogus value
+                    invalid_local++;
+                }
+
+                if (m_packed_normals)
+                    ((uint32_t *) m_packed_normals.get())[i] = octahedral_encode(n);
+                else
+                    store_unaligned(vertex(i) + m_normal_offset, n);
+            }
+
+            if (invalid_local > 0)
+                invalid_counter += invalid_local;
+        }
+    );
 
     if (invalid_counter == 0)
         Log(Debug, "\"%s\": computed vertex normals (took %s)", m_name,
             util::time_string(timer.value()));
     else
         Log(Warn, "\"%s\": computed vertex normals (took %s, %i invalid vertices!)",
-            m_name, util::time_string(timer.value()), invalid_counter);
+            m_name, util::time_string(timer.value()), (size_t) invalid_counter);
 }
 
 MTS_VARIANT void Mesh<Float, Spectrum>::recompute_bbox() {
@@ -486,19 +626,240 @@ MTS_VARIANT void Mesh<Float, Spectrum>::recompute_bbox() {
         m_bbox.expand(vertex_position(i));
 }
 
+MTS_VARIANT void Mesh<Float, Spectrum>::compact_vertices(bool half_texcoords) {
+    if (m_compact_vertices)
+        return;
+
+    size_t expected_fields = 3;
+    if (m_normal_offset != 0)
+        expected_fields += 3;
+    if (m_texcoord_offset != 0)
+        expected_fields += 2;
+
+    if (m_vertex_struct->field_count() != expected_fields) {
+        Log(Warn, "\"%s\": the mesh has additional per-vertex attributes, "
+            "keeping the interleaved vertex layout.", m_name);
+        return;
+    }
+
+    Timer timer;
+    ScalarSize position_size = (ScalarSize) sizeof(InputPoint3f);
+    VertexHolder positions(new uint8_t[(m_vertex_count + 1) * position_size]),
+                 normals, texcoords;
+
+    if (has_vertex_normals())
+        normals = VertexHolder(new uint8_t[(m_vertex_count + 1) * sizeof(uint32_t)]);
+
+    size_t texcoord_size = half_texcoords ? sizeof(uint32_t) : sizeof(InputVector2f);
+    if (has_vertex_texcoords())
+        texcoords = VertexHolder(new uint8_t[(m_vertex_count + 1) * texcoord_size]);
+
+    for (ScalarSize i = 0; i < m_vertex_count; ++i) {
+        store_unaligned(positions.get() + i * position_size, vertex_position(i));
+
+        if (normals)
+            ((uint32_t *) normals.get())[i] = octahedral_encode(vertex_normal(i));
+
+        if (texcoords) {
+            InputVector2f uv = vertex_texcoord(i);
+            if (half_texcoords)
+                ((uint32_t *) texcoords.get())[i] =
+                    (uint32_t) enoki::half::float32_to_float16(uv.x()) |
+                    ((uint32_t) enoki::half::float32_to_float16(uv.y()) << 16);
+            else
+                store_unaligned(texcoords.get() + i * texcoord_size, uv);
+        }
+    }
+
+    // Zero-initialize the padding records
+    memset(positions.get() + m_vertex_count * position_size, 0, position_size);
+    if (normals)
+        memset(normals.get() + m_vertex_count * sizeof(uint32_t), 0, sizeof(uint32_t));
+    if (texcoords)
+        memset(texcoords.get() + m_vertex_count * texcoord_size, 0, texcoord_size);
+
+    size_t old_size = (size_t) m_vertex_size * m_vertex_count,
+           new_size = ((size_t) position_size + (normals ? sizeof(uint32_t) : 0) +
+                       (texcoords ? texcoord_size : 0)) * m_vertex_count;
+
+    m_vertex_struct = new Struct();
+    for (auto name : { "x", "y", "z" })
+        m_vertex_struct->append(name, struct_type_v<InputFloat>);
+
+    m_vertices         = std::move(positions);
+    m_packed_normals   = std::move(normals);
+    m_packed_texcoords = std::move(texcoords);
+    m_vertex_size      = position_size;
+    m_normal_offset    = 0;
+    m_texcoord_offset  = 0;
+    m_half_texcoords   = half_texcoords;
+    m_compact_vertices = true;
+
+    /* The externally provided storage may only be released once no buffer
+       refers to it anymore. The faces remain borrowed unless owned */
+    if (m_faces.get_deleter().owned)
+        m_external_owner.reset();
+
+    Log(Debug, "\"%s\": converted to compact vertex layout (%s -> %s, took %s)",
+        m_name, util::mem_string(old_size), util::mem_string(new_size),
+        util::time_string(timer.value()));
+}
+
 MTS_VARIANT void Mesh<Float, Spectrum>::area_distr_build() {
     if (m_face_count == 0)
         Throw("Cannot create sampling table for an empty mesh: %s", to_string());
 
     std::lock_guard<tbb::spin_mutex> lock(m_mutex);
-    std::unique_ptr<ScalarFloat[]> table(new ScalarFloat[m_face_count]);
-    for (ScalarIndex i = 0; i < m_face_count; i++)
-        table[i] = face_area(i);
 
-    m_area_distr = DiscreteDistribution<Float>(
-        table.get(),
-        m_face_count
+    // Another thread may have built the table while we were waiting
+    if (!m_area_distr.empty())
+        return;
+
+    using FloatStorage = DynamicBuffer<Float>;
+    FloatStorage table = enoki::empty<FloatStorage>(m_face_count);
+    table.managed();
+    ScalarFloat *table_ptr = table.data();
+
+    tbb::parallel_for(
+        tbb::blocked_range<ScalarIndex>(0u, m_face_count, MTS_MESH_GRAIN_SIZE),
+        [&](const tbb::blocked_range<ScalarIndex> &range) {
+            for (ScalarIndex i = range.begin(); i != range.end(); ++i)
+                table_ptr[i] = face_area(i);
+        }
     );
+
+    m_area_distr = DiscreteDistribution<Float>(std::move(table));
+}
+
+MTS_VARIANT void Mesh<Float, Spectrum>::vertex_positions_changed() {
+    recompute_bbox();
+
+    if (has_vertex_normals())
+        recompute_vertex_normals();
+
+    if (!m_area_distr.empty()) {
+        m_area_distr = DiscreteDistribution<Float>();
+        area_distr_build();
+    }
+
+    // Area lights cache the surface area and rebuild the power-weighted table
+    if (m_emitter)
+        m_emitter->parameters_changed();
+}
+
+MTS_VARIANT void Mesh<Float, Spectrum>::emission_distr_build(const Texture *radiance) {
+    if constexpr (is_cuda_array_v<Float>) {
+        ENOKI_MARK_USED(radiance);
+        Log(Debug, "\"%s\": triangles of emissive meshes are sampled by area in GPU "
+            "variants.", m_name);
+    } else {
+        area_distr_ensure();
+        Timer timer;
+
+        /* Number of quadrature points per triangle, which are the images of a
+           regular 4x4 grid under square_to_uniform_triangle() */
+        constexpr uint32_t QuadratureSize = 16;
+
+        /* Fraction of the samples that are still distributed by area, so that
+           triangles whose radiance is underestimated by the quadrature (e.g.
+           due to thin features of the texture) are sampled all the same */
+        constexpr ScalarFloat AreaFraction = .1f;
+
+        // Radiance at the quadrature points 'index' of the triangles following 'begin'
+        auto eval = [&](ScalarIndex begin, UInt32 index, Mask active) {
+            UInt32 face = begin + index / QuadratureSize,
+                   j    = index % QuadratureSize;
+
+            Point2f b = warp::square_to_uniform_triangle(
+                Point2f((Float(j % 4u) + .5f) * .25f, (Float(j / 4u) + .5f) * .25f));
+
+            Array<UInt32, 3> fi = face_indices(face, active);
+            Point3f p0 = vertex_position(fi[0], active),
+                    p1 = vertex_position(fi[1], active),
+                    p2 = vertex_position(fi[2], active);
+
+            SurfaceInteraction3f si = zero<SurfaceInteraction3f>();
+            si.p = p0 + (p1 - p0) * b.x() + (p2 - p0) * b.y();
+            si.n = normalize(cross(p1 - p0, p2 - p0));
+            si.sh_frame = Frame3f(si.n);
+            si.wi = Vector3f(0.f, 0.f, 1.f);
+            si.shape = this;
+            si.prim_index = face;
+
+            if (has_vertex_texcoords()) {
+                Point2f uv0 = vertex_texcoord(fi[0], active),
+                        uv1 = vertex_texcoord(fi[1], active),
+                        uv2 = vertex_texcoord(fi[2], active);
+                si.uv = uv0 * (1.f - b.x() - b.y())
+                      + uv1 * b.x() + uv2 * b.y();
+            } else {
+                si.uv = b;
+            }
+
+            if constexpr (is_spectral_v<Spectrum>) {
+                auto [wavelengths, weight] = sample_rgb_spectrum(
+                    math::sample_shifted<Wavelength>((Float(j) + .5f) / QuadratureSize));
+                si.wavelengths = wavelengths;
+                return hmean(radiance->eval(si, active) * weight);
+            } else {
+                return hmean(radiance->eval(si, active));
+            }
+        };
+
+        using FloatStorage = DynamicBuffer<Float>;
+        FloatStorage table = enoki::empty<FloatStorage>(m_face_count);
+        ScalarFloat *table_ptr = table.data();
+        const ScalarFloat *area_ptr = m_area_distr.pmf().data();
+
+        tbb::parallel_for(
+            tbb::blocked_range<ScalarIndex>(0u, m_face_count,
+                                            MTS_MESH_GRAIN_SIZE / QuadratureSize),
+            [&](const tbb::blocked_range<ScalarIndex> &range) {
+                uint32_t count = (range.end() - range.begin()) * QuadratureSize;
+                std::vector<ScalarFloat> values(count);
+
+                if constexpr (!is_array_v<Float>) {
+                    for (uint32_t i = 0; i < count; ++i)
+                        values[i] = eval(range.begin(), i, true);
+                } else {
+                    for (auto [index, active] : enoki::range<UInt32>(count))
+                        scatter(values.data(), eval(range.begin(), index, active),
+                                index, active);
+                }
+
+                for (ScalarIndex i = range.begin(); i != range.end(); ++i) {
+                    const ScalarFloat *v = values.data() + (i - range.begin()) * QuadratureSize;
+                    ScalarFloat sum = 0.f;
+                    for (uint32_t j = 0; j < QuadratureSize; ++j)
+                        sum += v[j];
+                    table_ptr[i] = area_ptr[i] * std::max(sum, 0.f) / QuadratureSize;
+                }
+            },
+            // Split down to the grain size, which bounds the size of 'values'
+            tbb::simple_partitioner()
+        );
+
+        double power = 0.0;
+        for (ScalarSize i = 0; i < m_face_count; ++i)
+            power += table_ptr[i];
+
+        if (!(power > 0.0)) {
+            Log(Warn, "\"%s\": the emitted radiance is zero, sampling triangles by "
+                "area.", m_name);
+            m_emission_distr = DiscreteDistribution<Float>();
+            return;
+        }
+
+        ScalarFloat power_scale = (1.f - AreaFraction) / (ScalarFloat) power,
+                    area_scale  = AreaFraction / m_area_distr.sum();
+        for (ScalarSize i = 0; i < m_face_count; ++i)
+            table_ptr[i] = table_ptr[i] * power_scale + area_ptr[i] * area_scale;
+
+        m_emission_distr = DiscreteDistribution<Float>(std::move(table));
+
+        Log(Debug, "\"%s\": built power-weighted triangle sampling table (took %s)",
+            m_name, util::time_string(timer.value()));
+    }
 }
 
 MTS_VARIANT typename Mesh<Float, Spectrum>::ScalarSize
@@ -537,6 +898,7 @@ Mesh<Float, Spectrum>::sample_position(Float time, const Point2f &sample_, Mask
     ps.time  = time;
     ps.pdf   = m_area_distr.normalization();
     ps.delta = false;
+    ps.prim_index = face_idx;
 
     if (has_vertex_texcoords()) {
         Point2f uv0 = vertex_texcoord(fi[0], active),
@@ -568,6 +930,119 @@ MTS_VARIANT Float Mesh<Float, Spectrum>::pdf_position(const PositionSample3f &,
     return m_area_distr.normalization();
 }
 
+MTS_VARIANT typename Mesh<Float, Spectrum>::DirectionSample3f
+Mesh<Float, Spectrum>::sample_direction(const Interaction3f &it, const Point2f &sample_,
+                                        Mask active) const {
+    MTS_MASK_ARGUMENT(active);
+
+    area_distr_ensure();
+    const DiscreteDistribution<Float> &distr =
+        m_emission_distr.empty() ? m_area_distr : m_emission_distr;
+
+    using Index = replace_scalar_t<Float, ScalarIndex>;
+    Index face_idx;
+    Point2f sample = sample_;
+    std::tie(face_idx, sample.y()) = distr.sample_reuse(sample.y(), active);
+
+    Array<Index, 3> fi = face_indices(face_idx, active);
+
+    Point3f p0 = vertex_position(fi[0], active),
+            p1 = vertex_position(fi[1], active),
+            p2 = vertex_position(fi[2], active);
+
+    Vector3f e0 = p1 - p0, e1 = p2 - p0, ng = cross(e0, e1);
+
+    Vector3f a = normalize(p0 - it.p),
+             b = normalize(p1 - it.p),
+             c = normalize(p2 - it.p);
+    Float solid_angle = warp::spherical_triangle_solid_angle(a, b, c);
+    Mask spherical = warp::use_spherical_sampling(solid_angle);
+
+    // Barycentric coordinates of the sampled position
+    Point2f bary = warp::square_to_uniform_triangle(sample);
+
+    if (any_or<true>(spherical)) {
+        // Intersect the sampled direction with the plane of the triangle
+        Vector3f d = warp::square_to_spherical_triangle(sample, a, b, c);
+        Vector3f v = it.p + d * (dot(p0 - it.p, ng) / dot(d, ng)) - p0;
+
+        Float d00 = dot(e0, e0), d01 = dot(e0, e1), d11 = dot(e1, e1),
+              d20 = dot(v, e0),  d21 = dot(v, e1),
+              inv_det = rcp(d00 * d11 - d01 * d01);
+
+        // Guard against round-off errors that place the position outside
+        Point2f bary_sph = max(Point2f(d11 * d20 - d01 * d21,
+                                       d00 * d21 - d01 * d20) * inv_det, 0.f);
+        Float bary_sum = bary_sph.x() + bary_sph.y();
+        masked(bary_sph, bary_sum > 1.f) = bary_sph / bary_sum;
+        masked(bary, spherical) = bary_sph;
+    }
+
+    DirectionSample3f ds;
+    ds.p     = p0 + e0 * bary.x() + e1 * bary.y();
+    ds.time  = it.time;
+    ds.delta = false;
+    ds.object = (const Object *) this;
+    ds.prim_index = face_idx;
+
+    if (has_vertex_texcoords()) {
+        Point2f uv0 = vertex_texcoord(fi[0], active),
+                uv1 = vertex_texcoord(fi[1], active),
+                uv2 = vertex_texcoord(fi[2], active);
+        ds.uv = uv0 * (1.f - bary.x() - bary.y())
+              + uv1 * bary.x() + uv2 * bary.y();
+    } else {
+        ds.uv = bary;
+    }
+
+    if (has_vertex_normals()) {
+        Normal3f n0 = vertex_normal(fi[0], active),
+                 n1 = vertex_normal(fi[1], active),
+                 n2 = vertex_normal(fi[2], active);
+        ds.n = normalize(n0 * (1.f - bary.x() - bary.y())
+                       + n1 * bary.x() + n2 * bary.y());
+    } else {
+        ds.n = normalize(ng);
+    }
+
+    ds.d = ds.p - it.p;
+    Float dist_squared = squared_norm(ds.d);
+    ds.dist = sqrt(dist_squared);
+    ds.d /= ds.dist;
+
+    // Area sampling: convert 1 / (face area) into a density per solid angle
+    Float dp = abs_dot(ds.d, ng);
+    ds.pdf = distr.eval_pmf_normalized(face_idx, active) *
+             select(spherical, rcp(solid_angle),
+                    select(neq(dp, 0.f), 2.f * dist_squared / dp, 0.f));
+
+    return ds;
+}
+
+MTS_VARIANT Float Mesh<Float, Spectrum>::pdf_direction(const Interaction3f &it,
+                                                       const DirectionSample3f &ds,
+                                                       Mask active) const {
+    MTS_MASK_ARGUMENT(active);
+
+    area_distr_ensure();
+    const DiscreteDistribution<Float> &distr =
+        m_emission_distr.empty() ? m_area_distr : m_emission_distr;
+
+    Array<UInt32, 3> fi = face_indices(ds.prim_index, active);
+
+    Point3f p0 = vertex_position(fi[0], active),
+            p1 = vertex_position(fi[1], active),
+            p2 = vertex_position(fi[2], active);
+
+    Float solid_angle = warp::spherical_triangle_solid_angle(
+        normalize(p0 - it.p), normalize(p1 - it.p), normalize(p2 - it.p));
+
+    Float dp = abs_dot(ds.d, cross(p1 - p0, p2 - p0));
+    return distr.eval_pmf_normalized(ds.prim_index, active) *
+           select(warp::use_spherical_sampling(solid_angle), rcp(solid_angle),
+                  select(neq(dp, 0.f), 2.f * ds.dist * ds.dist / dp, 0.f));
+}
+
 MTS_VARIANT void Mesh<Float, Spectrum>::fill_surface_interaction(const Ray3f & /*ray*/,
                                                                  const Float *cache,
                                                                  SurfaceInteraction3f &si,
@@ -797,11 +1272,14 @@ MTS_VARIANT std::string Mesh<Float, Spectrum>::to_string() const {
         << "  name = \"" << m_name << "\"," << std::endl
         << "  bbox = " << string::indent(m_bbox) << "," << std::endl
         << "  vertex_struct = " << string::indent(m_vertex_struct) << "," << std::endl
+        << (m_compact_vertices ? "  compact_vertices = 1,\n" : "")
         << "  vertex_count = " << m_vertex_count << "," << std::endl
-        << "  vertices = [" << util::mem_string(m_vertex_size * m_vertex_count) << " of vertex data]," << std::endl
+        << "  vertices = [" << util::mem_string(m_vertex_size * m_vertex_count) << " of "
+        << (m_external_owner ? "external " : "") << "vertex data]," << std::endl
         << "  face_struct = " << string::indent(m_face_struct) << "," << std::endl
         << "  face_count = " << m_face_count << "," << std::endl
-        << "  faces = [" << util::mem_string(m_face_size * m_face_count) << " of face data]," << std::endl
+        << "  faces = [" << util::mem_string(m_face_size * m_face_count) << " of "
+        << (m_external_owner ? "external " : "") << "face data]," << std::endl
         << "  disable_vertex_normals = " << m_disable_vertex_normals << "," << std::endl
         << "  surface_area = " << m_area_distr.sum() << std::endl
         << "]";
@@ -898,7 +1376,11 @@ MTS_VARIANT void Mesh<Float, Spectrum>::parameters_changed() {
 
         if (m_area_distr.empty())
             area_distr_build();
+    } else {
+        vertex_positions_changed();
     }
+
+    set_dirty();
 }
 
 template <typename Value, size_t Dim, typename Func,
@@ -1016,6 +1498,8 @@ MTS_VARIANT void Mesh<Float, Spectrum>::traverse(TraversalCallback *callback) {
 
 #else // MTS_ENABLE_OPTIX off
 MTS_VARIANT void Mesh<Float, Spectrum>::parameters_changed() {
+    vertex_positions_changed();
+    set_dirty();
 }
 MTS_VARIANT void Mesh<Float, Spectrum>::traverse(TraversalCallback * /*callback*/) {
 }
@@ -49,6 +49,14 @@ public:
         PYBIND11_OVERLOAD_PURE(Float, BSDF, pdf, ctx, si, wo, active);
     }
 
+    std::pair<Spectrum, Float> eval_pdf(const BSDFContext &ctx,
+                                        const SurfaceInteraction3f &si,
+                                        const Vector3f &wo,
+                                        Mask active) const override {
+        using Return = std::pair<Spectrum, Float>;
+        PYBIND11_OVERLOAD(Return, BSDF, eval_pdf, ctx, si, wo, active);
+    }
+
     std::string to_string() const override {
         PYBIND11_OVERLOAD_PURE(std::string, BSDF, to_string,);
     }
@@ -69,6 +77,8 @@ MTS_PY_EXPORT(BSDF) {
             "ctx"_a, "si"_a, "wo"_a, "active"_a = true, D(BSDF, eval))
         .def("pdf", vectorize(&BSDF::pdf),
             "ctx"_a, "si"_a, "wo"_a, "active"_a = true, D(BSDF, pdf))
+        .def("eval_pdf", vectorize(&BSDF::eval_pdf),
+            "ctx"_a, "si"_a, "wo"_a, "active"_a = true, D(BSDF, eval_pdf))
         .def("eval_null_transmission", vectorize(&BSDF::eval_null_transmission),
             "si"_a, "active"_a = true, D(BSDF, eval_null_transmission))
         .def("flags", py::overload_cast<Mask>(&BSDF::flags, py::const_),
@@ -110,6 +120,13 @@ MTS_PY_EXPORT(BSDF) {
                                 Mask active) { return ptr->pdf(ctx, si, wo, active); }),
             "ptr"_a, "ctx"_a, "si"_a, "wo"_a, "active"_a = true,
             D(BSDF, pdf));
+        bsdf.def_static(
+            "eval_pdf_vec",
+            vectorize([](const BSDFPtr &ptr, const BSDFContext &ctx,
+                                const SurfaceInteraction3f &si, const Vector3f &wo,
+                                Mask active) { return ptr->eval_pdf(ctx, si, wo, active); }),
+            "ptr"_a, "ctx"_a, "si"_a, "wo"_a, "active"_a = true,
+            D(BSDF, eval_pdf));
         bsdf.def_static(
             "flags_vec",
             vectorize([](const BSDFPtr &ptr, Mask active) {
@@ -0,0 +1,38 @@
+#include <mitsuba/render/distributed.h>
+#include <mitsuba/python/python.h>
+
+MTS_PY_EXPORT(distributed) {
+    auto queue = MTS_PY_CLASS(TileQueue, Object)
+        .def(py::init<Spiral *, float>(), "spiral"_a, "lease_timeout"_a = 60.f,
+             D(TileQueue, TileQueue))
+        .def("lease", &TileQueue::lease, py::call_guard<py::gil_scoped_release>(),
+             D(TileQueue, lease))
+        .def_method(TileQueue, complete, "id"_a)
+        .def_method(TileQueue, release, "id"_a)
+        .def_method(TileQueue, tile, "id"_a)
+        .def_method(TileQueue, tile_count)
+        .def_method(TileQueue, completed_count)
+        .def_method(TileQueue, done)
+        .def_method(TileQueue, lease_timeout);
+
+    py::class_<TileQueue::Tile>(queue, "Tile", D(TileQueue, Tile))
+        .def_readonly("id", &TileQueue::Tile::id, D(TileQueue, Tile, id))
+        .def_readonly("seed", &TileQueue::Tile::seed, D(TileQueue, Tile, seed))
+        .def_readonly("offset", &TileQueue::Tile::offset, D(TileQueue, Tile, offset))
+        .def_readonly("size", &TileQueue::Tile::size, D(TileQueue, Tile, size));
+
+    py::enum_<TileQueue::Status>(queue, "Status", D(TileQueue, Status))
+        .value("Leased", TileQueue::Status::Leased, D(TileQueue, Status, Leased))
+        .value("Wait", TileQueue::Status::Wait, D(TileQueue, Status, Wait))
+        .value("Done", TileQueue::Status::Done, D(TileQueue, Status, Done));
+
+    MTS_PY_CLASS(RenderServer, Object)
+        .def(py::init<const std::string &, float>(), "address"_a,
+             "lease_timeout"_a = 60.f, D(RenderServer, RenderServer))
+        .def_method(RenderServer, lease_timeout)
+        .def_method(RenderServer, result_count)
+        .def_static("enabled", &RenderServer::enabled, D(RenderServer, enabled))
+        .def_static("instance", &RenderServer::instance, D(RenderServer, instance))
+        .def_static("set_instance", &RenderServer::set_instance, "server"_a,
+                    D(RenderServer, set_instance));
+}
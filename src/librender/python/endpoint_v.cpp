@@ -21,6 +21,7 @@ MTS_PY_EXPORT(Endpoint) {
         .def("eval", vectorize(&Endpoint::eval),
             "si"_a, "active"_a = true, D(Endpoint, eval))
         .def_method(Endpoint, world_transform)
+        .def_method(Endpoint, set_world_transform, "transform"_a)
         .def_method(Endpoint, needs_sample_2)
         .def_method(Endpoint, needs_sample_3)
         .def("shape",  py::overload_cast<>(&Endpoint::shape, py::const_),  D(Endpoint, shape))
@@ -1,5 +1,6 @@
 #include <mitsuba/core/bitmap.h>
 #include <mitsuba/core/filesystem.h>
+#include <mitsuba/core/writequeue.h>
 #include <mitsuba/render/film.h>
 #include <mitsuba/render/imageblock.h>
 #include <mitsuba/core/rfilter.h>
@@ -18,6 +19,7 @@ MTS_PY_EXPORT(Film) {
                                             const ScalarPoint2i &, Bitmap *>(
                 &Film::develop, py::const_),
             "offset"_a, "size"_a, "target_offset"_a, "target"_a)
+        .def_method(Film, develop_async)
         .def_method(Film, destination_exists, "basename"_a)
         .def_method(Film, bitmap, "raw"_a = false)
         .def_method(Film, has_high_quality_edges)
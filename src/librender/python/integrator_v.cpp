@@ -160,7 +160,10 @@ MTS_PY_EXPORT(Integrator) {
                     ref<SamplingIntegrator>>(m, "SamplingIntegrator", D(SamplingIntegrator))
             .def(py::init<const Properties&>())
             .def_method(SamplingIntegrator, aov_names)
-            .def_method(SamplingIntegrator, should_stop);
+            .def_method(SamplingIntegrator, should_stop)
+            .def("render_worker", &SamplingIntegrator::render_worker,
+                 py::call_guard<py::gil_scoped_release>(), "scene"_a, "address"_a,
+                 D(SamplingIntegrator, render_worker));
 
     bind_integrator_sample<Float, Spectrum>(integrator);
 
@@ -1,6 +1,7 @@
 #include <mitsuba/python/python.h>
 
 MTS_PY_DECLARE(BSDFContext);
+MTS_PY_DECLARE(distributed);
 MTS_PY_DECLARE(EmitterExtras);
 MTS_PY_DECLARE(MicrofacetType);
 MTS_PY_DECLARE(PhaseFunctionExtras);
@@ -11,6 +12,7 @@ PYBIND11_MODULE(render_ext, m) {
     m.attr("__name__") = "mitsuba.render";
 
     MTS_PY_IMPORT(BSDFContext);
+    MTS_PY_IMPORT(distributed);
     MTS_PY_IMPORT(EmitterExtras);
     MTS_PY_IMPORT(MicrofacetType);
     MTS_PY_IMPORT(PhaseFunctionExtras);
@@ -27,6 +27,7 @@ MTS_PY_EXPORT(PositionSample) {
         .def_readwrite("pdf",    &PositionSample3f::pdf,    D(PositionSample, pdf))
         .def_readwrite("delta",  &PositionSample3f::delta,  D(PositionSample, delta))
         .def_readwrite("object", &PositionSample3f::object, D(PositionSample, object))
+        .def_readwrite("prim_index", &PositionSample3f::prim_index, D(PositionSample, prim_index))
         .def_repr(PositionSample3f);
 
     bind_set_object<PositionSample3f>(pos);
@@ -42,8 +43,9 @@ MTS_PY_EXPORT(DirectionSample) {
         .def(py::init<const DirectionSample3f &>(), "Copy constructor", "other"_a)
         .def(py::init<const Point3f &, const Normal3f &, const Point2f &,
                         const Float &, const Float &, const Mask &,
-                        const ObjectPtr &, const Vector3f &, const Float &>(),
+                        const ObjectPtr &, const Vector3f &, const Float &, const UInt32 &>(),
             "p"_a, "n"_a, "uv"_a, "time"_a, "pdf"_a, "delta"_a, "object"_a, "d"_a, "dist"_a,
+            "prim_index"_a = UInt32(0),
             "Element-by-element constructor")
         .def(py::init<const SurfaceInteraction3f &, const Interaction3f &>(),
             "si"_a, "ref"_a, D(PositionSample, PositionSample))
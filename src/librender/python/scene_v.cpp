@@ -1,4 +1,5 @@
 #include <mitsuba/core/properties.h>
+#include <mitsuba/render/compiler.h>
 #include <mitsuba/render/integrator.h>
 #include <mitsuba/render/mesh.h>
 #include <mitsuba/render/scene.h>
@@ -72,5 +73,21 @@ MTS_PY_EXPORT(Scene) {
             },
             D(Scene, integrator))
         .def("__repr__", &Scene::to_string);
+
+    m.def(
+        "compile_scene",
+        [](const std::string &path, const std::string &output, py::kwargs kwargs) {
+            xml::ParameterList param;
+            if (kwargs) {
+                for (auto [k, v] : kwargs)
+                    param.emplace_back(
+                        (std::string) py::str(k),
+                        (std::string) py::str(v)
+                    );
+            }
+            py::gil_scoped_release release;
+            SceneCompiler<Float, Spectrum>::compile(path, output, param);
+        },
+        "path"_a, "output"_a, D(SceneCompiler, compile));
 }
 #endif
\ No newline at end of file
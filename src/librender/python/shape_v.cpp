@@ -39,6 +39,8 @@ MTS_PY_EXPORT(Shape) {
         .def_method(Shape, surface_area)
         .def_method(Shape, id)
         .def_method(Shape, is_mesh)
+        .def_method(Shape, dirty)
+        .def("set_dirty", &Shape::set_dirty, "dirty"_a = true, D(Shape, set_dirty))
         .def_method(Shape, is_medium_transition)
         .def_method(Shape, interior_medium)
         .def_method(Shape, exterior_medium)
@@ -55,6 +57,63 @@ MTS_PY_EXPORT(Shape) {
         .def(py::init<const std::string &, Struct *, ScalarSize, Struct *, ScalarSize>(),
             D(Mesh, Mesh))
         .def(py::init<const std::string &, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t, short, const ScalarMatrix4f &>(), "Constructor to call from Blender")
+        .def(py::init([](const std::string &name,
+                         Struct *vertex_struct, ScalarSize vertex_count, py::array vertices,
+                         Struct *face_struct, ScalarSize face_count, py::array faces) {
+            auto check_buffer = [](const char *label, const py::array &array,
+                                   Struct *s, ScalarSize count) {
+                if (!(array.flags() & py::array::c_style))
+                    throw py::type_error(tfm::format(
+                        "Mesh(): the %s array must be C-contiguous!", label));
+                if (!array.writeable())
+                    throw py::type_error(tfm::format(
+                        "Mesh(): the %s array must be writeable!", label));
+                /* Either the dtype matches the struct, or the array holds
+                   plain values of the type shared by all fields */
+                py::object struct_dtype = py::cast(s).attr("dtype")();
+                py::dtype dtype = array.dtype();
+                size_t itemsize = (size_t) array.itemsize();
+                bool compatible;
+                if (dtype.attr("fields").is_none()) {
+                    compatible = s->size() % itemsize == 0;
+                    for (auto kv : py::dict(struct_dtype.attr("fields"))) {
+                        py::tuple field = kv.second.cast<py::tuple>();
+                        compatible &= field[0].attr("__eq__")(dtype).cast<bool>() &&
+                                      field[1].cast<size_t>() % itemsize == 0;
+                    }
+                } else {
+                    compatible = struct_dtype.attr("__eq__")(dtype).cast<bool>();
+                }
+                if (!compatible)
+                    throw py::type_error(tfm::format(
+                        "Mesh(): the dtype %s of the %s array is incompatible "
+                        "with the layout %s", (std::string) py::str(dtype), label,
+                        s->to_string()));
+                size_t expected = ((size_t) count + 1) * s->size();
+                if ((size_t) array.nbytes() < expected)
+                    throw py::type_error(tfm::format(
+                        "Mesh(): the %s array must provide storage for %i "
+                        "records (including one padding record), got %i bytes "
+                        "instead of %i!", label, count + 1, array.nbytes(),
+                        expected));
+            };
+
+            check_buffer("vertex", vertices, vertex_struct, vertex_count);
+            check_buffer("face", faces, face_struct, face_count);
+
+            /* Keep both arrays alive for the lifetime of the mesh. The
+               release may happen on any thread, hence the GIL acquisition */
+            std::shared_ptr<void> owner(
+                new py::tuple(py::make_tuple(vertices, faces)),
+                [](void *ptr) {
+                    py::gil_scoped_acquire gil;
+                    delete (py::tuple *) ptr;
+                });
+
+            return new Mesh(name, vertex_struct, vertex_count, vertices.mutable_data(),
+                            face_struct, face_count, faces.mutable_data(), owner);
+        }), "name"_a, "vertex_struct"_a, "vertex_count"_a, "vertices"_a,
+            "face_struct"_a, "face_count"_a, "faces"_a, D(Mesh, Mesh, 3))
         .def_method(Mesh, vertex_struct)
         .def_method(Mesh, face_struct)
         .def_method(Mesh, vertex_count)
@@ -62,8 +121,11 @@ MTS_PY_EXPORT(Shape) {
         .def_method(Mesh, has_vertex_normals)
         .def_method(Mesh, has_vertex_texcoords)
         .def_method(Mesh, has_vertex_colors)
+        .def_method(Mesh, is_external)
         .def_method(Mesh, recompute_vertex_normals)
         .def_method(Mesh, recompute_bbox)
+        .def_method(Mesh, compact_vertices, "half_texcoords"_a = false)
+        .def_method(Mesh, has_compact_vertices)
         .def("write_ply", &Mesh::write_ply, "stream"_a, "Export mesh as a binary PLY file")
         .def("vertices", [](py::object &o) {
             Mesh &m = py::cast<Mesh&>(o);
@@ -1,11 +1,15 @@
+#include <mitsuba/core/numa.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/plugin.h>
+#include <mitsuba/core/statistics.h>
 #include <mitsuba/render/bsdf.h>
 #include <mitsuba/render/medium.h>
 #include <mitsuba/render/scene.h>
 #include <mitsuba/render/kdtree.h>
+#include <mitsuba/render/mesh.h>
 #include <mitsuba/render/integrator.h>
 #include <enoki/stl.h>
+#include <tbb/parallel_for.h>
 
 #if defined(MTS_ENABLE_EMBREE)
 #  include "scene_embree.inl"
@@ -88,14 +92,48 @@ MTS_VARIANT Scene<Float, Spectrum>::Scene(const Properties &props) {
             create_object<Integrator>(Properties("path"));
     }
 
-    if constexpr (is_cuda_array_v<Float>)
+    if constexpr (is_cuda_array_v<Float>) {
         accel_init_gpu(props);
-    else
+    } else {
+        // Place the (read-only) mesh buffers according to the NUMA allocation policy
+        for (Shape *shape : m_shapes) {
+            if (!shape->is_mesh())
+                continue;
+            Mesh *mesh = static_cast<Mesh *>(shape);
+            if (mesh->is_external())
+                continue;
+            numa::distribute(mesh->vertices(),
+                             mesh->vertex_count() * mesh->vertex_struct()->size());
+            numa::distribute(mesh->faces(),
+                             mesh->face_count() * mesh->face_struct()->size());
+        }
         accel_init_cpu(props);
+    }
+
+    // The acceleration data structure reflects the current state of all shapes
+    for (Shape *shape : m_shapes)
+        shape->set_dirty(false);
 
     // Create emitters' shapes (environment luminaires)
     for (Emitter *emitter: m_emitters)
         emitter->set_scene(this);
+
+    /* Build the area sampling tables of emissive meshes now rather than
+       lazily upon the first emitter sample, which would stall all render
+       threads while one of them builds the table */
+    std::vector<const Mesh *> emissive_meshes;
+    for (Shape *shape : m_shapes) {
+        if (shape->is_mesh() && shape->is_emitter())
+            emissive_meshes.push_back(static_cast<const Mesh *>(shape));
+    }
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, emissive_meshes.size(), 1),
+        [&](const tbb::blocked_range<size_t> &range) {
+            for (size_t i = range.begin(); i != range.end(); ++i)
+                emissive_meshes[i]->area_distr_ensure();
+        }
+    );
 }
 
 MTS_VARIANT Scene<Float, Spectrum>::~Scene() {
@@ -108,6 +146,7 @@ MTS_VARIANT Scene<Float, Spectrum>::~Scene() {
 MTS_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
 Scene<Float, Spectrum>::ray_intersect(const Ray3f &ray, Mask active) const {
     MTS_MASKED_FUNCTION(ProfilerPhase::RayIntersect, active);
+    statistics_count(StatisticsCounter::RaysTraced, active);
 
     if constexpr (is_cuda_array_v<Float>)
         return ray_intersect_gpu(ray, active);
@@ -131,6 +170,7 @@ Scene<Float, Spectrum>::ray_intersect_naive(const Ray3f &ray, Mask active) const
 MTS_VARIANT typename Scene<Float, Spectrum>::Mask
 Scene<Float, Spectrum>::ray_test(const Ray3f &ray, Mask active) const {
     MTS_MASKED_FUNCTION(ProfilerPhase::RayTest, active);
+    statistics_count(StatisticsCounter::ShadowRaysTraced, active);
 
     if constexpr (is_cuda_array_v<Float>)
         return ray_test_gpu(ray, active);
@@ -215,6 +255,28 @@ MTS_VARIANT void Scene<Float, Spectrum>::traverse(TraversalCallback *callback) {
 }
 
 MTS_VARIANT void Scene<Float, Spectrum>::parameters_changed() {
+    /* Only shapes whose geometry changed (e.g. moved or deformed between the
+       frames of an animation) require an update of the ray tracing
+       acceleration data structure. Meshes in GPU mode notify OptiX directly. */
+    std::vector<size_t> changed;
+    ScalarBoundingBox3f bbox;
+    for (size_t i = 0; i < m_shapes.size(); ++i) {
+        Shape *shape = m_shapes[i];
+        if (shape->dirty()) {
+            shape->set_dirty(false);
+            changed.push_back(i);
+        }
+        bbox.expand(shape->bbox());
+    }
+
+    if (!changed.empty()) {
+        Log(Debug, "Scene::parameters_changed(): %i/%i shapes were modified.",
+            changed.size(), m_shapes.size());
+        m_bbox = bbox;
+        if constexpr (!is_cuda_array_v<Float>)
+            accel_parameters_changed_cpu(changed);
+    }
+
     if (m_environment)
         m_environment->set_scene(this);
 }
@@ -39,6 +39,23 @@ MTS_VARIANT void Scene<Float, Spectrum>::accel_release_cpu() {
     rtcReleaseScene((RTCScene) m_accel);
 }
 
+MTS_VARIANT void
+Scene<Float, Spectrum>::accel_parameters_changed_cpu(const std::vector<size_t> &changed) {
+    Timer timer;
+    RTCScene embree_scene = (RTCScene) m_accel;
+
+    // Geometry IDs match the shape indices (see accel_init_cpu())
+    for (size_t i : changed) {
+        RTCGeometry geom = rtcGetGeometry(embree_scene, (unsigned int) i);
+        if (m_shapes[i]->is_mesh())
+            rtcUpdateGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0);
+        rtcCommitGeometry(geom);
+    }
+    rtcCommitScene(embree_scene);
+    Log(Debug, "Embree updated %i shapes. (took %s)", changed.size(),
+        util::time_string(timer.value()));
+}
+
 MTS_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
 Scene<Float, Spectrum>::ray_intersect_cpu(const Ray3f &ray, Mask active) const {
     if constexpr (!is_cuda_array_v<Float>) {
@@ -14,6 +14,12 @@ MTS_VARIANT void Scene<Float, Spectrum>::accel_release_cpu() {
     m_accel = nullptr;
 }
 
+MTS_VARIANT void
+Scene<Float, Spectrum>::accel_parameters_changed_cpu(const std::vector<size_t> & /* changed */) {
+    // The kd-tree cannot be refit, rebuild it using the original build parameters
+    ((ShapeKDTree *) m_accel)->rebuild();
+}
+
 MTS_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
 Scene<Float, Spectrum>::ray_intersect_cpu(const Ray3f &ray, Mask active) const {
     const ShapeKDTree *kdtree = (const ShapeKDTree *) m_accel;
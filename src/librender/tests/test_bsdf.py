@@ -28,3 +28,69 @@ def test02_bs_construct(variant_scalar_rgb):
     assert ek.allclose(bs.pdf, 0.0)
     assert ek.allclose(bs.eta, 1.0)
     assert bs.sampled_type == 0
+
+
+def check_eval_pdf(bsdf_xml):
+    from mitsuba.core import Frame3f, warp
+    from mitsuba.core.xml import load_string
+    from mitsuba.render import BSDFContext, SurfaceInteraction3f
+
+    bsdf = load_string(bsdf_xml.replace('<bsdf ', '<bsdf version="2.0.0" ', 1))
+    ctx = BSDFContext()
+    si = SurfaceInteraction3f()
+    si.t = 0.1
+    si.p = [0, 0, 0]
+    si.uv = [0.5, 0.5]
+    si.n = [0, 0, 1]
+    si.sh_frame = Frame3f(si.n)
+    si.wavelengths = []
+
+    res = 8
+    for wi in [ek.normalize([1.0, 1.0, 1.0]), ek.normalize([-0.2, 0.5, -1.0])]:
+        si.wi = wi
+        for i in range(res):
+            for j in range(res):
+                wo = warp.square_to_uniform_sphere([(i + .5) / res, (j + .5) / res])
+                value, pdf = bsdf.eval_pdf(ctx, si, wo)
+                assert ek.allclose(value, bsdf.eval(ctx, si, wo), rtol=1e-4, atol=1e-6)
+                assert ek.allclose(pdf, bsdf.pdf(ctx, si, wo), rtol=1e-4, atol=1e-6)
+
+
+@pytest.mark.parametrize('bsdf_xml', [
+    '<bsdf type="diffuse"/>',
+    '<bsdf type="plastic"/>',
+    '<bsdf type="roughplastic"/>',
+    '<bsdf type="roughplastic"><boolean name="sample_visible" value="false"/></bsdf>',
+    '<bsdf type="roughconductor"><float name="alpha_u" value="0.2"/>'
+    '<float name="alpha_v" value="0.05"/></bsdf>',
+    '<bsdf type="roughconductor"><string name="distribution" value="ggx"/>'
+    '<boolean name="sample_visible" value="false"/></bsdf>',
+    '<bsdf type="roughdielectric"/>',
+    '<bsdf type="roughdielectric"><boolean name="sample_visible" value="false"/></bsdf>',
+    '<bsdf type="conductor"/>',
+    '<bsdf type="twosided"><bsdf type="roughconductor"/></bsdf>',
+    '<bsdf type="blendbsdf"><float name="weight" value="0.3"/>'
+    '<bsdf type="diffuse"/><bsdf type="roughconductor"/></bsdf>',
+    '<bsdf type="mask"><float name="opacity" value="0.4"/><bsdf type="roughplastic"/></bsdf>',
+])
+def test03_eval_pdf(variant_scalar_rgb, bsdf_xml):
+    check_eval_pdf(bsdf_xml)
+
+
+@pytest.mark.parametrize('bsdf_xml', [
+    '<bsdf type="roughconductor"><string name="material" value="Au"/></bsdf>',
+    '<bsdf type="roughconductor"><string name="material" value="Cu"/>'
+    '<float name="alpha_u" value="0.2"/><float name="alpha_v" value="0.05"/>'
+    '<boolean name="sample_visible" value="false"/></bsdf>',
+])
+def test04_eval_pdf_measured_eta(variant_scalar_rgb, bsdf_xml):
+    check_eval_pdf(bsdf_xml)
+
+
+@pytest.mark.parametrize('bsdf_xml', [
+    '<bsdf type="roughconductor"/>',
+    '<bsdf type="roughconductor"><string name="material" value="Au"/>'
+    '<float name="alpha_u" value="0.2"/><float name="alpha_v" value="0.05"/></bsdf>',
+])
+def test05_eval_pdf_polarized(variant_scalar_mono_polarized, bsdf_xml):
+    check_eval_pdf(bsdf_xml)
@@ -0,0 +1,72 @@
+import pytest
+
+import mitsuba
+import enoki as ek
+from mitsuba.python.test.util import fresolver_append_path
+
+
+@fresolver_append_path
+def test01_compile_and_load(variant_scalar_rgb, tmpdir):
+    from mitsuba.core import Thread
+    from mitsuba.core.xml import load_file
+    from mitsuba.render import compile_scene
+
+    scene_path = str(tmpdir.join('scene.xml'))
+    compiled_path = str(tmpdir.join('scene.mtsc'))
+
+    with open(scene_path, 'w') as f:
+        f.write("""<scene version="2.0.0">
+            <shape type="ply">
+                <string name="filename" value="resources/data/tests/ply/rectangle_normals_uv.ply"/>
+                <transform name="to_world">
+                    <translate x="$offset"/>
+                </transform>
+                <bsdf type="diffuse">
+                    <rgb name="reflectance" value="0.2, 0.4, 0.6"/>
+                </bsdf>
+            </shape>
+            <shape type="sphere"/>
+        </scene>""")
+
+    compile_scene(scene_path, compiled_path, offset=1)
+    ref = load_file(scene_path, offset=1)
+
+    # The search path of the calling thread must not be extended permanently
+    fresolver = Thread.thread().file_resolver()
+    paths = list(fresolver)
+    scene = load_file(compiled_path)
+    assert list(Thread.thread().file_resolver()) == paths
+
+    assert len(scene.shapes()) == len(ref.shapes())
+    assert ek.allclose(scene.bbox().min, ref.bbox().min)
+    assert ek.allclose(scene.bbox().max, ref.bbox().max)
+
+    mesh_ref = [s for s in ref.shapes() if s.is_mesh()][0]
+    mesh = [s for s in scene.shapes() if s.is_mesh()][0]
+    assert mesh.is_external()
+    assert mesh.vertex_count() == mesh_ref.vertex_count()
+    assert mesh.face_count() == mesh_ref.face_count()
+    v, v_ref = mesh.vertices(), mesh_ref.vertices()
+    f, f_ref = mesh.faces(), mesh_ref.faces()
+    for i in range(mesh.vertex_count()):
+        assert ek.allclose(v[i].tolist(), v_ref[i].tolist())
+    for i in range(mesh.face_count()):
+        assert f[i].tolist() == f_ref[i].tolist()
+
+    ray = mitsuba.core.Ray3f([1.1, 1, -1], [0, -1, 0], 0, [])
+    si, si_ref = scene.ray_intersect(ray), ref.ray_intersect(ray)
+    assert si.is_valid() == si_ref.is_valid()
+    assert ek.allclose(si.t, si_ref.t)
+    assert ek.allclose(si.uv, si_ref.uv)
+    assert str(si.bsdf()) == str(si_ref.bsdf())
+
+
+def test02_invalid_file(variant_scalar_rgb, tmpdir):
+    from mitsuba.core.xml import load_file
+
+    path = str(tmpdir.join('invalid.mtsc'))
+    with open(path, 'w') as f:
+        f.write('<scene version="2.0.0"/>' + ' ' * 64)
+
+    with pytest.raises(RuntimeError, match='not a compiled scene file'):
+        load_file(path)
@@ -0,0 +1,132 @@
+import mitsuba
+import pytest
+import enoki as ek
+import numpy as np
+import subprocess
+import sys
+import time
+
+
+def make_queue(lease_timeout=60.0):
+    from mitsuba.render import Spiral, TileQueue
+
+    # 3x2 blocks, rendered in two passes
+    spiral = Spiral([80, 64], [0, 0], 32, 2)
+    return TileQueue(spiral, lease_timeout)
+
+
+def test01_lease_complete(variant_scalar_rgb):
+    from mitsuba.render import TileQueue
+
+    queue = make_queue()
+    assert queue.tile_count() == 12
+
+    tiles = []
+    for i in range(queue.tile_count()):
+        status, tile = queue.lease()
+        assert status == TileQueue.Status.Leased
+        tiles.append(tile)
+
+    # Every block of every pass is handed out exactly once
+    assert sorted(t.id for t in tiles) == list(range(12))
+    assert len(set(t.seed for t in tiles)) == 12
+    assert sum(t.size[0] * t.size[1] for t in tiles) == 2 * 80 * 64
+
+    # Outstanding leases have not expired yet
+    assert queue.lease()[0] == TileQueue.Status.Wait
+
+    for t in tiles:
+        assert queue.complete(t.id)
+        # Duplicate results must be discarded
+        assert not queue.complete(t.id)
+
+    assert queue.done()
+    assert queue.completed_count() == 12
+    assert queue.lease()[0] == TileQueue.Status.Done
+
+
+def test02_expired_leases(variant_scalar_rgb):
+    from mitsuba.render import TileQueue
+
+    queue = make_queue(lease_timeout=0.05)
+    leased = [queue.lease()[1] for i in range(queue.tile_count())]
+
+    # A released tile is handed out again right away
+    queue.release(leased[3].id)
+    status, tile = queue.lease()
+    assert status == TileQueue.Status.Leased and tile.id == leased[3].id
+
+    for t in leased[1:]:
+        queue.complete(t.id)
+    assert queue.lease()[0] == TileQueue.Status.Wait
+
+    # The first tile was leased by a worker that died
+    time.sleep(0.1)
+    status, tile = queue.lease()
+    assert status == TileQueue.Status.Leased and tile.id == leased[0].id
+    assert queue.complete(tile.id)
+    assert queue.done()
+
+
+SCENE = """<scene version="2.0.0">
+    <integrator type="path"/>
+    <sensor type="perspective">
+        <transform name="to_world">
+            <lookat origin="0, 0, 4" target="0, 0, 0" up="0, 1, 0"/>
+        </transform>
+        <film type="hdrfilm">
+            <integer name="width" value="96"/>
+            <integer name="height" value="72"/>
+            <rfilter type="gaussian"/>
+        </film>
+        <sampler type="independent">
+            <integer name="sample_count" value="4"/>
+        </sampler>
+    </sensor>
+    <shape type="sphere"/>
+    <emitter type="constant"/>
+</scene>"""
+
+WORKER = """
+import mitsuba, sys
+mitsuba.set_variant('scalar_rgb')
+from mitsuba.core.xml import load_file
+scene = load_file(sys.argv[1])
+scene.integrator().render_worker(scene, sys.argv[2])
+"""
+
+
+def test03_distributed_render(variant_scalar_rgb, tmpdir):
+    from mitsuba.core.xml import load_file
+    from mitsuba.render import RenderServer
+
+    if not RenderServer.enabled():
+        pytest.skip("Mitsuba was compiled without distributed rendering support")
+
+    filename = str(tmpdir.join('scene.xml'))
+    with open(filename, 'w') as f:
+        f.write(SCENE)
+
+    scene = load_file(filename)
+    sensor = scene.sensors()[0]
+    scene.integrator().render(scene, sensor)
+    reference = np.array(sensor.film().bitmap(raw=True), copy=False).copy()
+
+    server = RenderServer('tcp://127.0.0.1:25557', 10.0)
+    RenderServer.set_instance(server)
+    workers = [subprocess.Popen([sys.executable, '-c', WORKER, filename,
+                                 'tcp://127.0.0.1:25557']) for i in range(2)]
+    try:
+        # Give the workers some time to connect and load the scene
+        time.sleep(2)
+        assert scene.integrator().render(scene, sensor)
+        image = np.array(sensor.film().bitmap(raw=True), copy=False)
+    finally:
+        RenderServer.set_instance(None)
+        del server
+        for worker in workers:
+            worker.wait(timeout=30)
+
+    # Blocks are seeded identically, no matter where they are rendered
+    assert np.allclose(image, reference, atol=1e-5)
+    assert all(worker.returncode == 0 for worker in workers)
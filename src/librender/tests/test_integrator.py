@@ -148,6 +148,32 @@ def test06_render_timeout(variants_cpu_rgb, int_name):
     assert ek.allclose(timeout, effective, atol=0.5)
 
 
+def test07_guided_create(variant_scalar_rgb):
+    make_integrator('guided', xml="""
+        <float name="training_budget" value="0.25"/>
+        <float name="bsdf_sampling_fraction" value="0.3"/>
+        <integer name="max_memory" value="16"/>
+    """)
+
+    # The BSDF must be sampled with a nonzero probability
+    with pytest.raises(RuntimeError):
+        make_integrator('guided', xml="""
+            <float name="bsdf_sampling_fraction" value="0"/>
+        """)
+
+    # At least one sample must remain for the final pass
+    with pytest.raises(RuntimeError):
+        make_integrator('guided', xml="""
+            <float name="training_budget" value="1"/>
+        """)
+
+
+@pytest.mark.parametrize("scene_name", ['box', 'museum_plane'])
+def test08_guided_render(variant_scalar_rgb, scene_name):
+    # Guiding must not bias the result compared to the path tracer
+    check_scene('guided', scene_name)
+
+
 def make_reference_renders():
     mitsuba.set_variant('scalar_rgb')
     from mitsuba.core import Bitmap, Struct
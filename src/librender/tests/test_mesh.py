@@ -228,3 +228,175 @@ def test06_load_various_features(variant_scalar_rgb, mesh_format, features, face
                 assert ek.allclose(v[3:6], [0.0, 1.0, 0.0])
 
     return fresolver_append_path(test)()
+
+
+def test07_create_mesh_from_buffers(variant_scalar_rgb):
+    """Checks that a mesh can wrap NumPy buffers without copying them."""
+    from mitsuba.core import Struct
+    from mitsuba.render import Mesh
+    import numpy as np
+
+    vertex_struct = Struct() \
+        .append("x", Struct.Type.Float32) \
+        .append("y", Struct.Type.Float32) \
+        .append("z", Struct.Type.Float32)
+
+    index_struct = Struct() \
+        .append("i0", Struct.Type.UInt32) \
+        .append("i1", Struct.Type.UInt32) \
+        .append("i2", Struct.Type.UInt32)
+
+    # One additional padding record is required by the mesh
+    vertices = np.zeros((4, 3), dtype=np.float32)
+    vertices[:3] = [[0, 0, 0], [0, 0, 1], [0, 1, 0]]
+    faces = np.zeros((2, 3), dtype=np.uint32)
+    faces[0] = [0, 1, 2]
+
+    m = Mesh("MyMesh", vertex_struct, 3, vertices, index_struct, 1, faces)
+    assert m.is_external()
+    assert m.vertex_count() == 3 and m.face_count() == 1
+    assert ek.allclose(m.bbox().max, [0, 1, 1])
+    assert ek.allclose(m.surface_area(), 0.5)
+
+    # Writes through NumPy are visible to the mesh and vice versa
+    vertices[2] = [0, 2, 0]
+    assert ek.allclose(m.vertices()['y'][2], 2)
+    m.vertices()['z'][1] = 3
+    assert vertices[1, 2] == 3
+
+    # Arrays with the dtype of the struct are accepted as well
+    vertices_2 = np.zeros(4, dtype=vertex_struct.dtype())
+    m = Mesh("MyMesh", vertex_struct, 3, vertices_2, index_struct, 1, faces)
+    assert m.is_external()
+
+    # Buffers whose dtype does not match the struct are rejected
+    with pytest.raises(TypeError):
+        Mesh("MyMesh", vertex_struct, 3, vertices.view(np.int32),
+             index_struct, 1, faces)
+    with pytest.raises(TypeError):
+        Mesh("MyMesh", vertex_struct, 3, vertices, index_struct, 1,
+             faces.astype(np.float32))
+    vertex_struct_2 = Struct()
+    for name in ['x', 'y', 'z', 'nx', 'ny', 'nz']:
+        vertex_struct_2.append(name, Struct.Type.Float32)
+    with pytest.raises(TypeError):
+        Mesh("MyMesh", vertex_struct_2, 3, np.zeros((4, 6), dtype=np.float64),
+             index_struct, 1, faces)
+
+    # Buffers without padding are rejected
+    with pytest.raises(TypeError):
+        Mesh("MyMesh", vertex_struct, 4, vertices, index_struct, 1, faces)
+    with pytest.raises(TypeError):
+        Mesh("MyMesh", vertex_struct, 3, np.asfortranarray(vertices),
+             index_struct, 1, faces)
+
+
+@pytest.mark.parametrize('half_texcoords', [True, False])
+def test08_compact_vertices(variant_scalar_rgb, half_texcoords):
+    """Compares attributes of a mesh stored in the compact vertex layout
+    against the interleaved reference"""
+    from mitsuba.core.xml import load_string
+
+    def load(compact):
+        return load_string("""
+            <shape type="ply" version="2.0.0">
+                <string name="filename" value="resources/data/tests/ply/rectangle_normals_uv.ply"/>
+                <boolean name="compact_vertices" value="{0}"/>
+                <boolean name="half_texcoords" value="{1}"/>
+            </shape>
+        """.format(str(compact).lower(), str(half_texcoords).lower()))
+
+    def test():
+        ref, shape = load(False), load(True)
+        assert not ref.has_compact_vertices()
+        assert shape.has_compact_vertices()
+        assert shape.has_vertex_normals() and shape.has_vertex_texcoords()
+        assert shape.vertex_struct().size() == 12
+        assert shape.vertex_count() == ref.vertex_count()
+        assert ek.allclose(shape.bbox().min, ref.bbox().min)
+        assert ek.allclose(shape.bbox().max, ref.bbox().max)
+        assert ek.allclose(shape.surface_area(), ref.surface_area())
+
+        v_ref = ref.vertices()
+        v = shape.vertices()
+        for i in range(ref.vertex_count()):
+            assert ek.allclose(v[i].tolist(), v_ref[i].tolist()[:3])
+
+        si_ref = ref.sample_position(0, [0.3, 0.6])
+        si = shape.sample_position(0, [0.3, 0.6])
+        assert ek.allclose(si.p, si_ref.p)
+        assert ek.allclose(si.n, si_ref.n, atol=1e-4)
+        assert ek.allclose(si.uv, si_ref.uv, atol=1e-3 if half_texcoords else 1e-6)
+
+    fresolver_append_path(test)()
+
+
+def test09_compact_external_mesh(variant_scalar_rgb):
+    """Compacting a mesh that wraps NumPy buffers must keep the (still
+    borrowed) face buffer alive after all other references are dropped"""
+    from mitsuba.core import Struct, Ray3f
+    from mitsuba.render import Mesh
+    import numpy as np
+    import gc
+
+    def create():
+        vertex_struct = Struct() \
+            .append("x", Struct.Type.Float32) \
+            .append("y", Struct.Type.Float32) \
+            .append("z", Struct.Type.Float32)
+
+        index_struct = Struct() \
+            .append("i0", Struct.Type.UInt32) \
+            .append("i1", Struct.Type.UInt32) \
+            .append("i2", Struct.Type.UInt32)
+
+        vertices = np.zeros((5, 3), dtype=np.float32)
+        vertices[:4] = [[0, 0, 0], [1, 0, 0], [0, 1, 0], [1, 1, 0]]
+        faces = np.zeros((3, 3), dtype=np.uint32)
+        faces[:2] = [[0, 1, 2], [1, 3, 2]]
+        return Mesh("MyMesh", vertex_struct, 4, vertices, index_struct, 2, faces)
+
+    m = create()
+    m.compact_vertices()
+    assert m.has_compact_vertices()
+    gc.collect()
+
+    # Recycle the memory of any prematurely released buffers
+    garbage = [np.full((3, 3), 0xFFFFFFFF, dtype=np.uint32) for i in range(100)]
+
+    assert m.faces().tolist() == [(0, 1, 2), (1, 3, 2)]
+    for x, y, index in [(0.2, 0.3, 0), (0.8, 0.7, 1)]:
+        hit, u, v, t = m.ray_intersect_triangle(index, Ray3f([x, y, 1], [0, 0, -1], 0, []))
+        assert hit and ek.allclose(t, 1)
+    del garbage
+
+
+@fresolver_append_path
+def test10_deform_emissive_mesh(variant_scalar_rgb):
+    """Modifying the vertices of an emissive mesh must update the sampling
+    tables and the emitter."""
+    from mitsuba.core.xml import load_string
+
+    shape = load_string("""
+        <shape type="ply" version="2.0.0">
+            <string name="filename" value="data/triangle.ply"/>
+            <emitter type="area"/>
+        </shape>
+    """)
+    assert ek.allclose(shape.surface_area(), 0.5)
+    ps = shape.sample_position(0, [0.5, 0.5])
+    assert ek.allclose(ps.pdf, 2)
+    _, weight = shape.emitter().sample_ray(0, 0.5, [0.5, 0.5], [0.5, 0.5])
+
+    v = shape.vertices()
+    for c in ['x', 'y', 'z']:
+        v[c] *= 2
+    shape.parameters_changed()
+    assert shape.dirty()
+
+    assert ek.allclose(shape.surface_area(), 2)
+    assert ek.allclose(shape.bbox().max, [0, 2, 2])
+    ps = shape.sample_position(0, [0.5, 0.5])
+    assert ek.allclose(ps.pdf, 0.5)
+    _, weight_2 = shape.emitter().sample_ray(0, 0.5, [0.5, 0.5], [0.5, 0.5])
+    assert ek.allclose(weight_2, 4 * weight)
@@ -28,7 +28,8 @@ def test01_position_sample_construction_single(variant_scalar_rgb):
   time = 0,
   pdf = 0.002,
   delta = 0,
-  object = nullptr
+  object = nullptr,
+  prim_index = 0
 ]"""
 
     # SurfaceInteraction constructor
@@ -73,7 +74,8 @@ def test02_position_sample_construction_dynamic(variant_packet_rgb):
   time = [0, 0.5, 0.7, 1, 1.5],
   pdf = [0, 0, 0, 0, 0],
   delta = [0, 0, 0, 0, 0],
-  object = [nullptr, nullptr, nullptr, nullptr, nullptr]
+  object = [nullptr, nullptr, nullptr, nullptr, nullptr],
+  prim_index = [0, 0, 0, 0, 0]
 ]"""
 
     # SurfaceInteraction constructor
@@ -138,6 +140,7 @@ def test04_direction_sample_construction_single(variant_scalar_rgb):
   pdf = 0.002,
   delta = 0,
   object = nullptr,
+  prim_index = 0,
   d = [0, 42, -1],
   dist = 0.13
 ]"""
@@ -1,6 +1,7 @@
 import pytest
 
 import mitsuba
+import enoki as ek
 from mitsuba.python.test.util import fresolver_append_path
 
 
@@ -48,3 +49,124 @@ def test01_emitter_checks(variant_scalar_rgb):
                 + shape_xml.format('<emitter type="area" id="my_inner_emitter"/>')
                 + shape_xml.format('<ref id="my_emitter"/>'), 4)
 
+
+def test02_parameters_changed_updates_accel(variant_scalar_rgb):
+    from mitsuba.core import Ray3f
+    from mitsuba.core.xml import load_string
+    from mitsuba.python.util import traverse
+
+    scene = load_string("""<scene version="2.0.0">
+        <shape type="sphere" id="sphere">
+            <point name="center" x="0" y="0" z="0"/>
+            <float name="radius" value="1"/>
+        </shape>
+    </scene>""")
+
+    ray = Ray3f([5, 0, -10], [0, 0, 1], 0.0, [])
+    assert not scene.ray_test(ray)
+
+    # Moving the sphere must be reflected by the acceleration data structure
+    params = traverse(scene)
+    params['sphere.center'] = [5, 0, 0]
+    params.update()
+
+    assert scene.ray_test(ray)
+    si = scene.ray_intersect(ray)
+    assert ek.allclose(si.t, 9.0)
+    assert ek.allclose(scene.bbox().min, [4, -1, -1])
+
+
+def test03_render_sequence(variant_scalar_rgb, tmpdir):
+    from mitsuba.core import Bitmap, Struct, ScalarTransform4f, AnimatedTransform
+    from mitsuba.core.xml import load_string
+    from mitsuba.python.util import render_sequence
+    import numpy as np
+
+    scene = load_string("""<scene version="2.0.0">
+        <integrator type="direct"/>
+        <sensor type="perspective">
+            <transform name="to_world">
+                <lookat origin="0, 0, -5" target="0, 0, 0" up="0, 1, 0"/>
+            </transform>
+            <film type="hdrfilm">
+                <integer name="width" value="8"/>
+                <integer name="height" value="8"/>
+            </film>
+            <sampler type="independent">
+                <integer name="sample_count" value="4"/>
+            </sampler>
+        </sensor>
+        <emitter type="constant" id="light">
+            <spectrum name="radiance" value="1"/>
+        </emitter>
+    </scene>""")
+
+    def update(params, frame):
+        params['light.radiance.value'] = frame + 1.0
+        scene.sensors()[0].set_world_transform(AnimatedTransform(
+            ScalarTransform4f.look_at(origin=[0, 0, -5 - frame],
+                                      target=[0, 0, 0], up=[0, 1, 0])))
+
+    filenames = render_sequence(scene, 3, update, str(tmpdir.join('frame_%02i.exr')))
+    assert len(filenames) == 3
+
+    for frame, filename in enumerate(filenames):
+        img = np.array(Bitmap(filename).convert(Bitmap.PixelFormat.RGB,
+                                                Struct.Type.Float32, False))
+        assert ek.allclose(img, frame + 1.0, rtol=1e-3)
+
+
+def test04_deformed_mesh_updates_accel(variant_scalar_rgb):
+    from mitsuba.core import Properties, Ray3f, Struct
+    from mitsuba.render import Mesh, Scene
+
+    vertex_struct = Struct() \
+        .append("x", Struct.Type.Float32) \
+        .append("y", Struct.Type.Float32) \
+        .append("z", Struct.Type.Float32)
+
+    index_struct = Struct() \
+        .append("i0", Struct.Type.UInt32) \
+        .append("i1", Struct.Type.UInt32) \
+        .append("i2", Struct.Type.UInt32)
+
+    # Strip of triangles along the X axis, so that the kd-tree has to split it.
+    # Two unused vertices fix the bounding box of the mesh.
+    n = 16
+    m = Mesh("strip", vertex_struct, 3 * n + 2, index_struct, n)
+    v, f = m.vertices(), m.faces()
+    for i in range(n):
+        v[3 * i + 0] = (2 * i, 0, 0)
+        v[3 * i + 1] = (2 * i + 1, 0, 0)
+        v[3 * i + 2] = (2 * i, 1, 0)
+        f[i] = (3 * i, 3 * i + 1, 3 * i + 2)
+    v[3 * n] = (0, 0, -1)
+    v[3 * n + 1] = (2 * n, 1, 1)
+    m.recompute_bbox()
+
+    props = Properties("scene")
+    props["_unnamed_0"] = m
+    scene = Scene(props)
+    assert not m.dirty()
+
+    ray = Ray3f([0.25, 0.25, -10], [0, 0, 1], 0.0, [])
+    assert ek.allclose(scene.ray_intersect(ray).t, 10.0)
+
+    # Move the last triangle in front of the first one. The bounding box of
+    # the mesh stays the same, but the kd-tree must be rebuilt nonetheless.
+    k = 3 * (n - 1)
+    v[k + 0] = (0, 0, -0.5)
+    v[k + 1] = (1, 0, -0.5)
+    v[k + 2] = (0, 1, -0.5)
+    m.parameters_changed()
+    assert m.dirty()
+    bbox = m.bbox()
+
+    scene.parameters_changed()
+    assert not m.dirty()
+    assert ek.allclose(scene.bbox().min, bbox.min)
+    assert ek.allclose(scene.bbox().max, bbox.max)
+
+    si = scene.ray_intersect(ray)
+    assert ek.allclose(si.t, 9.5)
+    assert si.prim_index == n - 1
@@ -0,0 +1,62 @@
+import json
+import pytest
+
+import mitsuba
+
+
+def render_scene():
+    from mitsuba.core.xml import load_string
+
+    scene = load_string("""
+        <scene version="2.0.0">
+            <integrator type="path">
+                <integer name="max_depth" value="4"/>
+            </integrator>
+            <sensor type="perspective">
+                <transform name="to_world">
+                    <lookat origin="0, 0, 5" target="0, 0, 0" up="0, 1, 0"/>
+                </transform>
+                <film type="hdrfilm">
+                    <integer name="width" value="16"/>
+                    <integer name="height" value="16"/>
+                </film>
+                <sampler type="independent">
+                    <integer name="sample_count" value="4"/>
+                </sampler>
+            </sensor>
+            <emitter type="constant"/>
+            <shape type="sphere"/>
+        </scene>
+    """)
+    assert scene.integrator().render(scene, scene.sensors()[0])
+
+
+def test01_render_counters(variant_scalar_rgb, tmpdir):
+    from mitsuba.core import Statistics, StatisticsCounter, StatisticsHistogram
+
+    if not Statistics.enabled():
+        pytest.skip('Render statistics are disabled in this build')
+
+    Statistics.reset()
+    render_scene()
+
+    paths = Statistics.counter(StatisticsCounter.PathsTraced)
+    assert paths == 16 * 16 * 4
+    assert Statistics.counter(StatisticsCounter.RaysTraced) >= paths
+    assert Statistics.counter(StatisticsCounter.ShadowRaysTraced) > 0
+
+    bins = Statistics.histogram(StatisticsHistogram.PathLength)
+    assert sum(bins) == paths
+    assert all(b == 0 for b in bins[5:])
+    assert 0 < Statistics.histogram_mean(StatisticsHistogram.PathLength) <= 4
+
+    path = str(tmpdir.join('stats.json'))
+    Statistics.write_json(path)
+    with open(path) as f:
+        stats = json.load(f)
+    assert stats['enabled']
+    assert stats['counters']['Paths traced'] == paths
+    assert stats['histograms']['Path length']['bins'] == bins
+
+    Statistics.reset()
+    assert Statistics.counter(StatisticsCounter.PathsTraced) == 0
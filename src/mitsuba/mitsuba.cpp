@@ -5,11 +5,17 @@
 #include <mitsuba/core/fstream.h>
 #include <mitsuba/core/jit.h>
 #include <mitsuba/core/logger.h>
+#include <mitsuba/core/numa.h>
 #include <mitsuba/core/profiler.h>
+#include <mitsuba/core/statistics.h>
+#include <mitsuba/core/string.h>
 #include <mitsuba/core/thread.h>
 #include <mitsuba/core/util.h>
 #include <mitsuba/core/vector.h>
+#include <mitsuba/core/writequeue.h>
 #include <mitsuba/core/xml.h>
+#include <mitsuba/render/compiler.h>
+#include <mitsuba/render/distributed.h>
 #include <mitsuba/render/integrator.h>
 #include <mitsuba/render/records.h>
 #include <mitsuba/render/scene.h>
@@ -26,7 +32,7 @@ static void help(int thread_count) {
     std::cout << util::info_copyright() << std::endl;
     std::cout << util::info_features() << std::endl;
     std::cout << R"(
-Usage: mitsuba [options] <One or more scene XML files>
+Usage: mitsuba [options] <One or more scene XML (or compiled scene) files>
 
 Options:
 
@@ -47,6 +53,19 @@ Options:
     -t <count>, --threads <count>
         Render with the specified number of threads.
 
+    --pin-threads
+        Pin the worker threads to processor cores. On machines with
+        several NUMA nodes (sockets), the image blocks are furthermore
+        rendered by one group of threads per node, whose threads only
+        run on the processors of that node.
+
+    --numa <policy>
+        Placement of the memory pages of large scene data (mesh
+        buffers, kd-tree, film storage) on NUMA machines. Available
+        policies: "first-touch" (default, pages stay on the node of
+        the thread that first wrote them) and "interleave" (pages
+        are spread across all nodes).
+
     -D <key>=<value>, --define <key>=<value>
         Define a constant that can referenced as "$key"
         within the scene description.
@@ -55,48 +74,196 @@ Options:
         Index of the sensor to render with (following the declaration
         order in the scene file). Default value: 0.
 
+        A comma-separated list of indices and ranges (e.g. "0,2,4-7")
+        or "all" renders several sensors in batch mode: the scene and
+        its acceleration data structure are loaded only once, and each
+        image is written in the background while the next sensor is
+        being rendered. The output files are suffixed with the sensor
+        index (e.g. "scene_2.exr").
+
     -u, --update
         When specified, Mitsuba will update the scene's
         XML description to the latest version.
 
+    --load-report
+        Print the time and memory spent on loading each type of
+        plugin, and the objects that took longest to load.
+
+    --profile-rate <rate>
+        Sampling rate (in Hz) of the builtin profiler. Default: 100.
+
+    --perf-counters
+        Attribute hardware performance counters (cycles, instructions,
+        last level cache and branch misses) to the phases sampled by
+        the builtin profiler, and report the IPC and miss rates per
+        phase (Linux only).
+
+    --stats
+        Write the render statistics (ray, path and cache counters, and
+        histograms of path lengths etc.) of each scene to a JSON file
+        next to the output image ("scene.json"). Requires a build with
+        the MTS_ENABLE_STATISTICS CMake option, which also prints a
+        summary after each rendering.
+
+    --trace <filename>
+        Record per-thread timelines of scene loading, rendering and
+        of the individual image blocks, and write them to "filename"
+        in the Chrome trace event format (viewable using
+        chrome://tracing or https://ui.perfetto.dev).
+
+    -c, --compile
+        Instead of rendering, convert each scene into a compiled scene
+        file ("scene.mtsc", or the file specified using -o). It stores
+        the resolved scene description along with the decoded mesh
+        data, and loads much faster than the original scene. Compiled
+        files are specific to the selected mode and can be rendered
+        like XML files.
+
     -o <filename>, --output <filename>
         Write the output image to the file "filename".
+
+    --listen <address>
+        Distribute the rendering of the image blocks to worker
+        processes, which connect to the given ZeroMQ address
+        (e.g. "tcp://*:5555"). The local threads keep rendering
+        as well. Requires a build with the MTS_ENABLE_ZMQ CMake
+        option.
+
+    --connect <address>
+        Instead of rendering, act as a worker of the process
+        listening at the given address (e.g. "tcp://host:5555").
+        The worker must be started with the same scene file(s),
+        mode and definitions (-D). It renders the blocks it is
+        given until the master process exits. Distributed
+        rendering supports a single scene file per invocation.
+
+    --lease-timeout <seconds>
+        Time after which the blocks leased by a worker that did
+        not respond (e.g. because it crashed or its connection
+        dropped) are handed out again. Default: 60.
 )";
 }
 
+template <typename Float, typename Spectrum>
+void compile(const fs::path &path, const fs::path &output, const xml::ParameterList &params) {
+    SceneCompiler<Float, Spectrum>::compile(path, output, params);
+}
+
+template <typename Float, typename Spectrum>
+bool render_worker(Object *scene_, const std::string &address) {
+    auto *scene = dynamic_cast<Scene<Float, Spectrum> *>(scene_);
+    if (!scene)
+        Throw("Root element of the input file must be a <scene> tag!");
+
+    auto *integrator =
+        dynamic_cast<SamplingIntegrator<Float, Spectrum> *>(scene->integrator());
+    if (!integrator)
+        Throw("--connect: distributed rendering requires a sampling-based integrator!");
+
+    return integrator->render_worker(scene, address);
+}
+
 std::function<void(void)> develop_callback;
 std::mutex develop_callback_mutex;
 
+/**
+ * Parse the argument of -s/--sensor: a comma-separated list of indices and
+ * inclusive ranges (e.g. "0,2,4-7"), or "all". An empty result denotes "all".
+ */
+std::vector<size_t> parse_sensor_list(const std::string &value) {
+    std::vector<size_t> result;
+    if (string::to_lower(value) == "all")
+        return result;
+
+    for (const std::string &token : string::tokenize(value, ",")) {
+        try {
+            auto sep = token.find('-');
+            if (sep == std::string::npos) {
+                result.push_back((size_t) std::stoul(token));
+            } else {
+                size_t first = (size_t) std::stoul(token.substr(0, sep)),
+                       last  = (size_t) std::stoul(token.substr(sep + 1));
+                if (first > last)
+                    Throw("invalid range \"%s\"", token);
+                for (size_t i = first; i <= last; ++i)
+                    result.push_back(i);
+            }
+        } catch (const std::logic_error &) {
+            Throw("-s/--sensor: could not parse \"%s\"!", value);
+        }
+    }
+
+    if (result.empty())
+        Throw("-s/--sensor: expected at least one sensor index!");
+    return result;
+}
+
 template <typename Float, typename Spectrum>
-bool render(Object *scene_, size_t sensor_i, filesystem::path filename) {
+bool render(Object *scene_, std::vector<size_t> sensors, filesystem::path filename) {
     auto *scene = dynamic_cast<Scene<Float, Spectrum> *>(scene_);
     if (!scene)
         Throw("Root element of the input file must be a <scene> tag!");
-    if (sensor_i >= scene->sensors().size())
-        Throw("Specified sensor index is out of bounds!");
-    auto sensor = scene->sensors()[sensor_i];
-    auto film = sensor->film();
 
-    filename.replace_extension("exr");
-    film->set_destination_file(filename);
+    if (sensors.empty()) {
+        for (size_t i = 0; i < scene->sensors().size(); ++i)
+            sensors.push_back(i);
+    }
+    for (size_t sensor_i : sensors) {
+        if (sensor_i >= scene->sensors().size())
+            Throw("Specified sensor index %i is out of bounds!", sensor_i);
+    }
 
     auto integrator = scene->integrator();
     if (!integrator)
         Throw("No integrator specified for scene: %s", scene->to_string());
 
-    /* critical section */ {
-        std::lock_guard<std::mutex> guard(develop_callback_mutex);
-        develop_callback = [&]() { film->develop(); };
+    /* In batch mode, images are developed on the write queue so that encoding
+       and I/O of one view overlap with the rendering of the next one */
+    bool batch = sensors.size() > 1;
+    std::vector<ref<WriteHandle>> handles;
+    fs::path basename = filename;
+    basename.replace_extension("");
+
+    bool success = true;
+    for (size_t sensor_i : sensors) {
+        auto sensor = scene->sensors()[sensor_i];
+        auto film = sensor->film();
+
+        if (batch) {
+            Log(Info, "Rendering sensor %i (%i/%i) ..", sensor_i,
+                handles.size() + 1, sensors.size());
+            filename = fs::path(basename.string() + tfm::format("_%i", sensor_i));
+        }
+        filename.replace_extension("exr");
+        film->set_destination_file(filename);
+
+        /* critical section */ {
+            std::lock_guard<std::mutex> guard(develop_callback_mutex);
+            develop_callback = [&]() { film->develop(); };
+        }
+        bool sensor_success = integrator->render(scene, sensor.get());
+        /* critical section */ {
+            std::lock_guard<std::mutex> guard(develop_callback_mutex);
+            develop_callback = nullptr;
+        }
+
+        if (!sensor_success) {
+            Log(Warn, "\U0000274C Rendering failed, result not saved.");
+            success = false;
+            break;
+        }
+
+        if (batch)
+            handles.push_back(film->develop_async());
+        else
+            film->develop();
     }
-    bool success = integrator->render(scene, sensor.get());
-    /* critical section */ {
-        std::lock_guard<std::mutex> guard(develop_callback_mutex);
-        develop_callback = nullptr;
+
+    for (auto &handle : handles) {
+        if (handle)
+            handle->wait();
     }
-    if (success)
-        film->develop();
-    else
-        Log(Warn, "\U0000274C Rendering failed, result not saved.");
+
     return success;
 }
 
@@ -125,11 +292,22 @@ int main(int argc, char *argv[]) {
     ArgParser parser;
     using StringVec    = std::vector<std::string>;
     auto arg_threads   = parser.add(StringVec{ "-t", "--threads" }, true);
+    auto arg_pin       = parser.add(StringVec{ "--pin-threads" }, false);
+    auto arg_numa      = parser.add(StringVec{ "--numa" }, true);
     auto arg_verbose   = parser.add(StringVec{ "-v", "--verbose" }, false);
     auto arg_define    = parser.add(StringVec{ "-D", "--define" }, true);
     auto arg_sensor_i  = parser.add(StringVec{ "-s", "--sensor" }, true);
     auto arg_output    = parser.add(StringVec{ "-o", "--output" }, true);
     auto arg_update    = parser.add(StringVec{ "-u", "--update" }, false);
+    auto arg_report    = parser.add(StringVec{ "--load-report" }, false);
+    auto arg_compile   = parser.add(StringVec{ "-c", "--compile" }, false);
+    auto arg_rate      = parser.add(StringVec{ "--profile-rate" }, true);
+    auto arg_trace     = parser.add(StringVec{ "--trace" }, true);
+    auto arg_counters  = parser.add(StringVec{ "--perf-counters" }, false);
+    auto arg_stats     = parser.add(StringVec{ "--stats" }, false);
+    auto arg_listen    = parser.add(StringVec{ "--listen" }, true);
+    auto arg_connect   = parser.add(StringVec{ "--connect" }, true);
+    auto arg_lease     = parser.add(StringVec{ "--lease-timeout" }, true);
     auto arg_help      = parser.add(StringVec{ "-h", "--help" });
     auto arg_mode      = parser.add(StringVec{ "-m", "--mode" }, true);
     auto arg_extra     = parser.add("", true);
@@ -172,15 +350,64 @@ int main(int argc, char *argv[]) {
         if (string::starts_with(mode, "gpu"))
             cie_alloc();
 
-        size_t sensor_i  = (*arg_sensor_i ? arg_sensor_i->as_int() : 0);
+        std::vector<size_t> sensors = { 0 };
+        if (*arg_sensor_i)
+            sensors = parse_sensor_list(arg_sensor_i->as_string());
 
         // Initialize Intel Thread Building Blocks with the requested number of threads
         if (*arg_threads)
             __global_thread_count = arg_threads->as_int();
         if (__global_thread_count < 1)
             Throw("Thread count must be >= 1!");
+
+        // Must be set before TBB launches its worker threads
+        if (*arg_pin)
+            numa::set_thread_pinning(true);
+        if (*arg_numa) {
+            std::string policy = arg_numa->as_string();
+            if (policy == "first-touch")
+                numa::set_allocation_policy(numa::AllocationPolicy::FirstTouch);
+            else if (policy == "interleave")
+                numa::set_allocation_policy(numa::AllocationPolicy::Interleave);
+            else
+                Throw("--numa: unknown policy \"%s\", expected \"first-touch\" "
+                      "or \"interleave\"!", policy);
+        }
+        if (*arg_pin || *arg_numa)
+            Log(Info, "Detected %i NUMA node%s.", numa::node_count(),
+                numa::node_count() == 1 ? "" : "s");
+
         tbb::task_scheduler_init init((int) __global_thread_count);
 
+        if (*arg_rate) {
+            int rate = arg_rate->as_int();
+            if (rate < 1)
+                Throw("--profile-rate: the sampling rate must be >= 1!");
+            Profiler::set_sampling_rate((uint32_t) rate);
+        }
+
+        if (*arg_counters)
+            Profiler::enable_counters();
+
+        if (*arg_stats && !Statistics::enabled())
+            Log(Warn, "--stats: Mitsuba was compiled without render statistics "
+                      "(MTS_ENABLE_STATISTICS), the counters will be zero.");
+
+        // Trace the coarse phases, up to and including the rendering of image blocks
+        if (*arg_trace)
+            Profiler::start_tracing((1ull << (int(ProfilerPhase::RenderBlock) + 1)) - 1);
+
+        if (*arg_listen && *arg_connect)
+            Throw("--listen and --connect are mutually exclusive!");
+        if ((*arg_listen || *arg_connect) && arg_extra->next())
+            Throw("Distributed rendering supports a single scene file per invocation!");
+
+        /* Start the server before loading any scene, so that early workers
+           are asked to wait rather than timing out */
+        if (*arg_listen)
+            RenderServer::set_instance(new RenderServer(
+                arg_listen->as_string(), *arg_lease ? (float) arg_lease->as_float() : 60.f));
+
         // Append the mitsuba directory to the FileResolver search path list
         ref<Thread> thread = Thread::thread();
         ref<FileResolver> fr = thread->file_resolver();
@@ -213,21 +440,55 @@ int main(int argc, char *argv[]) {
             if (*arg_output)
                 filename = arg_output->as_string();
 
+            if (*arg_compile) {
+                filename.replace_extension("mtsc");
+                MTS_INVOKE_VARIANT(mode, compile, arg_extra->as_string(), filename, params);
+                arg_extra = arg_extra->next();
+                continue;
+            }
+
+            // Statistics cover the loading and rendering of this scene
+            Statistics::reset();
+
             // Try and parse a scene from the passed file.
             ref<Object> parsed =
-                xml::load_file(arg_extra->as_string(), mode, params, *arg_update);
+                xml::load_file(arg_extra->as_string(), mode, params, *arg_update,
+                               *arg_report);
+
+            if (*arg_connect) {
+                MTS_INVOKE_VARIANT(mode, render_worker, parsed.get(),
+                                   arg_connect->as_string());
+                arg_extra = arg_extra->next();
+                continue;
+            }
 
             bool success = MTS_INVOKE_VARIANT(mode, render, parsed.get(),
-                                              sensor_i, filename);
+                                              sensors, filename);
             print_profile = print_profile || success;
+
+            if (success) {
+                Statistics::print_report();
+                if (*arg_stats) {
+                    filename.replace_extension("json");
+                    Statistics::write_json(filename);
+                }
+            }
             arg_extra = arg_extra->next();
         }
+
+        if (*arg_trace) {
+            Profiler::stop_tracing();
+            Profiler::write_trace(arg_trace->as_string());
+        }
     } catch (const std::exception &e) {
         error_msg = std::string("Caught a critical exception: ") + e.what();
     } catch (...) {
         error_msg = std::string("Caught a critical exception of unknown type!");
     }
 
+    // Tell the workers (if any) to shut down
+    RenderServer::set_instance(nullptr);
+
     if (!error_msg.empty()) {
         /* Strip zero-width spaces from the message (Mitsuba uses these
            to properly format chains of multiple exceptions) */
@@ -258,6 +519,7 @@ int main(int argc, char *argv[]) {
     Profiler::static_shutdown();
     if (print_profile)
         Profiler::print_report();
+    WriteQueue::static_shutdown();
     Bitmap::static_shutdown();
     Logger::static_shutdown();
     Thread::static_shutdown();
@@ -169,3 +169,46 @@ def traverse(node: 'mitsuba.core.Object') -> ParameterMap:
     node.traverse(cb)
 
     return ParameterMap(cb.properties, cb.hierarchy)
+
+
+def render_sequence(scene, frame_count, update, filename, sensor_index=0):
+    """
+    Render an animated sequence from a scene that is only loaded once.
+
+    Before rendering frame ``i``, the callback ``update(params, i)`` receives
+    the :py:class:`~mitsuba.python.util.ParameterMap` of the scene and can
+    modify parameters such as shape positions or light intensities. Cameras
+    and light sources can also be moved via ``Endpoint.set_world_transform()``.
+    The modified objects are then notified, and the scene only updates its
+    acceleration data structure for shapes whose geometry changed (i.e. that
+    marked themselves as dirty in ``parameters_changed()``, even if their
+    bounds stayed the same).
+
+    Each frame is written to ``filename % i`` (e.g. ``'frame_%03i.exr'``) on
+    the asynchronous write queue while the next frame is being rendered.
+
+    Returns the list of output filenames.
+    """
+    params = traverse(scene)
+    sensor = scene.sensors()[sensor_index]
+    film = sensor.film()
+    integrator = scene.integrator()
+
+    handles, filenames = [], []
+    for frame in range(frame_count):
+        update(params, frame)
+        params.update()
+
+        frame_filename = filename % frame
+        film.set_destination_file(frame_filename)
+        if not integrator.render(scene, sensor):
+            raise Exception('render_sequence(): rendering of frame %i failed!' % frame)
+
+        handles.append(film.develop_async())
+        filenames.append(frame_filename)
+
+    for handle in handles:
+        if handle is not None:
+            handle.wait()
+
+    return filenames
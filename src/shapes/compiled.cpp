@@ -0,0 +1,151 @@
+#include <mitsuba/render/mesh.h>
+#include <mitsuba/render/emitter.h>
+#include <mitsuba/render/sensor.h>
+#include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/mmap.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/statistics.h>
+#include <mitsuba/core/string.h>
+#include <mitsuba/core/util.h>
+#include <mitsuba/core/xml.h>
+#include <mutex>
+#include <unordered_map>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**!
+
+.. _shape-compiled:
+
+Compiled scene mesh (:monosp:`compiled`)
+----------------------------------------
+
+.. pluginparameters::
+
+ * - filename
+   - |string|
+   - Filename of the compiled scene file that contains the mesh data
+ * - vertex_blob, face_blob
+   - |int|
+   - Indices of the data blocks holding the vertex and face buffers
+ * - vertex_count, face_count
+   - |int|
+   - Number of vertices and faces
+ * - vertex_fields
+   - |string|
+   - Comma-separated names of the (single precision) vertex attributes
+ * - bbox_min, bbox_max
+   - |point|
+   - Bounding box of the mesh
+ * - face_normals, compact_vertices, half_texcoords
+   - |bool|
+   - See the :ref:`PLY <shape-ply>` plugin
+
+This plugin is not meant to be used directly: it is generated when a scene is
+compiled using ``mitsuba --compile``, which replaces PLY, OBJ and serialized
+meshes by references into the compiled scene file (extension ``.mtsc``). The
+vertex and face buffers are memory-mapped and used in place without decoding
+or copying them, and meshes that are stored in the same file share a single
+mapping. The mapping is read-only, hence the vertex positions of such meshes
+can't be modified (e.g. via :py:func:`mitsuba.python.util.traverse`), unless
+:monosp:`compact_vertices` is enabled.
+ */
+
+template <typename Float, typename Spectrum>
+class CompiledMesh final : public Mesh<Float, Spectrum> {
+public:
+    MTS_IMPORT_BASE(Mesh, m_vertices, m_faces, m_color_offset, m_name, m_bbox,
+                    m_vertex_count, m_face_count, m_vertex_struct, m_face_struct,
+                    m_vertex_size, m_face_size, m_external_owner, m_compact_requested,
+                    m_half_texcoords, init_structs, compact_vertices, is_emitter,
+                    emitter, is_sensor, sensor)
+    MTS_IMPORT_TYPES()
+
+    using typename Base::ScalarSize;
+    using typename Base::ScalarIndex;
+    using typename Base::VertexHolder;
+    using typename Base::FaceHolder;
+    using typename Base::BufferDeleter;
+    using typename Base::InputFloat;
+
+    using MappedFile = std::shared_ptr<ref<MemoryMappedFile>>;
+
+    CompiledMesh(const Properties &props) : Base(props) {
+        auto fs = Thread::thread()->file_resolver();
+        fs::path file_path = fs->resolve(props.string("filename"));
+        m_name = props.string("name", file_path.filename().string());
+
+        if (!fs::exists(file_path))
+            Throw("Error while loading compiled mesh \"%s\": file \"%s\" not found!",
+                  m_name, file_path);
+
+        MappedFile file = map_file(file_path);
+
+        m_vertex_struct = new Struct();
+        for (const std::string &name : string::tokenize(props.string("vertex_fields"), ","))
+            m_vertex_struct->append(name, struct_type_v<InputFloat>);
+
+        m_face_struct = new Struct();
+        for (size_t i = 0; i < 3; ++i)
+            m_face_struct->append(tfm::format("i%i", i), struct_type_v<ScalarIndex>);
+
+        init_structs();
+        if (m_vertex_struct->has_field("r"))
+            m_color_offset = (ScalarIndex) m_vertex_struct->offset("r");
+
+        m_vertex_count = (ScalarSize) props.size_("vertex_count");
+        m_face_count   = (ScalarSize) props.size_("face_count");
+
+        auto [vertices, vertices_size] = xml::compiled_blob(file->get(), props.size_("vertex_blob"));
+        auto [faces, faces_size]       = xml::compiled_blob(file->get(), props.size_("face_blob"));
+
+        if (vertices_size < (m_vertex_count + 1) * (size_t) m_vertex_size ||
+            faces_size < (m_face_count + 1) * (size_t) m_face_size)
+            Throw("Error while loading compiled mesh \"%s\": buffer sizes don't "
+                  "match the vertex/face layout!", m_name);
+
+        m_external_owner = file;
+        m_vertices = VertexHolder((uint8_t *) vertices, BufferDeleter{ false });
+        m_faces    = FaceHolder((uint8_t *) faces, BufferDeleter{ false });
+
+        // Stored in the file, which avoids touching all vertex pages here
+        m_bbox = ScalarBoundingBox3f(ScalarPoint3f(props.point3f("bbox_min")),
+                                     ScalarPoint3f(props.point3f("bbox_max")));
+
+        Log(Debug, "\"%s\": mapped %i faces, %i vertices (%s)", m_name, m_face_count,
+            m_vertex_count, util::mem_string(vertices_size + faces_size));
+
+        if (m_compact_requested)
+            compact_vertices(m_half_texcoords);
+
+        if (is_emitter())
+            emitter()->set_shape(this);
+        if (is_sensor())
+            sensor()->set_shape(this);
+    }
+
+    MTS_DECLARE_CLASS()
+
+private:
+    /// Map a compiled scene file, sharing the mapping among all meshes that refer to it
+    static MappedFile map_file(const fs::path &path) {
+        static std::mutex mutex;
+        static std::unordered_map<std::string, std::weak_ptr<ref<MemoryMappedFile>>> cache;
+
+        std::lock_guard<std::mutex> guard(mutex);
+        auto &entry = cache[fs::absolute(path).string()];
+        MappedFile file = entry.lock();
+        if (!file) {
+            file = std::make_shared<ref<MemoryMappedFile>>(new MemoryMappedFile(path));
+            entry = file;
+            statistics_add(StatisticsCounter::CompiledMeshCacheMisses);
+        } else {
+            statistics_add(StatisticsCounter::CompiledMeshCacheHits);
+        }
+        return file;
+    }
+};
+
+MTS_IMPLEMENT_CLASS_VARIANT(CompiledMesh, Shape)
+MTS_EXPORT_PLUGIN(CompiledMesh, "Compiled scene mesh")
+NAMESPACE_END(mitsuba)
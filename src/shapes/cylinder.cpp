@@ -231,6 +231,69 @@ public:
         return m_inv_surface_area;
     }
 
+    DirectionSample3f sample_direction(const Interaction3f &it, const Point2f &sample,
+                                       Mask active) const override {
+        MTS_MASK_ARGUMENT(active);
+
+        Point3f o = m_world_to_object.transform_affine(it.p);
+        Mask visible_arc = use_visible_arc_sampling(o);
+
+        DirectionSample3f ds = sample_position(it.time, sample, active);
+
+        if (any_or<true>(visible_arc)) {
+            /* Uniformly sample the angle subtended by the cross section of the
+               cylinder and intersect the resulting ray with the near side */
+            Float rho_2   = sqr(o.x()) + sqr(o.y()),
+                  inv_rho = rsqrt(rho_2),
+                  rho     = rho_2 * inv_rho,
+                  beta    = safe_asin(m_radius * inv_rho);
+
+            auto [sin_theta, cos_theta] = sincos(fmadd(2.f, sample.y(), -1.f) * beta);
+
+            Vector2f c(-o.x() * inv_rho, -o.y() * inv_rho),
+                     w(c.x() * cos_theta - c.y() * sin_theta,
+                       c.x() * sin_theta + c.y() * cos_theta);
+
+            Float t = rho * cos_theta - safe_sqrt(sqr(m_radius) - sqr(rho * sin_theta));
+            Point3f p(fmadd(w.x(), t, o.x()), fmadd(w.y(), t, o.y()),
+                      sample.x() * m_length);
+
+            Normal3f n(p.x(), p.y(), 0.f);
+            if (m_flip_normals)
+                n *= -1;
+
+            masked(ds.p, visible_arc)   = m_object_to_world.transform_affine(p);
+            masked(ds.n, visible_arc)   = normalize(m_object_to_world * n);
+            masked(ds.pdf, visible_arc) = visible_arc_pdf(o, p);
+        }
+
+        ds.d = ds.p - it.p;
+
+        Float dist_squared = squared_norm(ds.d);
+        ds.dist  = sqrt(dist_squared);
+        ds.d    /= ds.dist;
+
+        Float dp = abs_dot(ds.d, ds.n);
+        ds.pdf *= select(neq(dp, 0.f), dist_squared / dp, 0.f);
+        ds.object = (const Object *) this;
+
+        return ds;
+    }
+
+    Float pdf_direction(const Interaction3f &it, const DirectionSample3f &ds,
+                        Mask active) const override {
+        MTS_MASK_ARGUMENT(active);
+
+        Point3f o = m_world_to_object.transform_affine(it.p);
+
+        Float pdf = select(use_visible_arc_sampling(o),
+                           visible_arc_pdf(o, m_world_to_object.transform_affine(ds.p)),
+                           pdf_position(ds, active)),
+              dp  = abs_dot(ds.d, ds.n);
+
+        return pdf * select(neq(dp, 0.f), (ds.dist * ds.dist) / dp, 0.f);
+    }
+
     //! @}
     // =============================================================
 
@@ -385,6 +448,7 @@ public:
     void parameters_changed() override {
         Base::parameters_changed();
         m_inv_surface_area = 1.f / surface_area();
+        set_dirty();
     }
 
     std::string to_string() const override {
@@ -400,6 +464,37 @@ public:
     }
 
     MTS_DECLARE_CLASS()
+private:
+    /**
+     * \brief Decide whether to restrict sampling to the visible side of the
+     * cylinder, given the reference point \c o in object space
+     *
+     * When the reference point lies outside of the cylinder and between the
+     * planes of its two ends, the far side of the cylinder is entirely
+     * occluded by the near side. Otherwise, the far side can be seen through
+     * the open ends, and the whole surface is sampled by area.
+     */
+    Mask use_visible_arc_sampling(const Point3f &o) const {
+        return sqr(o.x()) + sqr(o.y()) > sqr(m_radius) &&
+               o.z() >= 0.f && o.z() <= m_length;
+    }
+
+    /**
+     * \brief Density per unit area of the visible arc sampling strategy
+     *
+     * Both the reference point \c o and the position \c p on the cylinder
+     * are given in object space.
+     */
+    Float visible_arc_pdf(const Point3f &o, const Point3f &p) const {
+        Vector2f v(p.x() - o.x(), p.y() - o.y());
+
+        Float dist      = norm(v),
+              cos_theta = -dot(v, Vector2f(p.x(), p.y())) / (dist * m_radius),
+              beta      = safe_asin(m_radius * rsqrt(sqr(o.x()) + sqr(o.y())));
+
+        return select(cos_theta > 0.f, cos_theta / (2.f * beta * dist * m_length), 0.f);
+    }
+
 private:
     ScalarTransform4f m_object_to_world;
     ScalarTransform4f m_world_to_object;
@@ -4,6 +4,7 @@
 #include <mitsuba/core/string.h>
 #include <mitsuba/core/transform.h>
 #include <mitsuba/core/util.h>
+#include <mitsuba/core/warp.h>
 #include <mitsuba/render/bsdf.h>
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/render/fwd.h>
@@ -144,7 +145,22 @@ public:
                                        Mask active) const override {
         MTS_MASK_ARGUMENT(active);
 
+        auto [p0, p1, z] = local_rectangle(it.p);
+        Float solid_angle = warp::spherical_rectangle_solid_angle(p0, p1, z);
+        Mask spherical = warp::use_spherical_sampling(solid_angle);
+
         DirectionSample3f ds = sample_position(it.time, sample, active);
+
+        if (any_or<true>(spherical)) {
+            // Sample the solid angle subtended by the rectangle
+            Point3f p = warp::square_to_spherical_rectangle(sample, p0, p1, z);
+            Point2f uv((p.x() - p0.x()) / m_du, (p.y() - p0.y()) / m_dv);
+
+            masked(ds.p, spherical) = m_object_to_world.transform_affine(
+                Point3f(fmadd(uv.x(), 2.f, -1.f), fmadd(uv.y(), 2.f, -1.f), 0.f));
+            masked(ds.uv, spherical) = uv;
+        }
+
         ds.d = ds.p - it.p;
 
         Float dist_squared = squared_norm(ds.d);
@@ -152,19 +168,24 @@ public:
         ds.d    /= ds.dist;
 
         Float dp = abs_dot(ds.d, ds.n);
-        ds.pdf *= select(neq(dp, 0.f), dist_squared / dp, Float(0.f));
+        ds.pdf = select(spherical, rcp(solid_angle),
+                        ds.pdf * select(neq(dp, 0.f), dist_squared / dp, Float(0.f)));
 
         return ds;
     }
 
-    Float pdf_direction(const Interaction3f & /*it*/, const DirectionSample3f &ds,
+    Float pdf_direction(const Interaction3f &it, const DirectionSample3f &ds,
                         Mask active) const override {
         MTS_MASK_ARGUMENT(active);
 
+        auto [p0, p1, z] = local_rectangle(it.p);
+        Float solid_angle = warp::spherical_rectangle_solid_angle(p0, p1, z);
+
         Float pdf = pdf_position(ds, active),
               dp  = abs_dot(ds.d, ds.n);
 
-        return pdf * select(neq(dp, 0.f), (ds.dist * ds.dist) / dp, 0.f);
+        return select(warp::use_spherical_sampling(solid_angle), rcp(solid_angle),
+                      pdf * select(neq(dp, 0.f), (ds.dist * ds.dist) / dp, 0.f));
     }
 
     //! @}
@@ -265,6 +286,7 @@ public:
                             ScalarTransform4f::scale(ScalarVector3f(0.5f * m_du, 0.5f * m_dv, 1.f));
         m_world_to_object = m_object_to_world.inverse();
         m_inv_surface_area = 1.f / surface_area();
+        set_dirty();
     }
 
     std::string to_string() const override {
@@ -279,6 +301,24 @@ public:
     }
 
     MTS_DECLARE_CLASS()
+private:
+    /**
+     * \brief Return the extent of the rectangle relative to the reference
+     * point \c p, expressed in the frame of the rectangle
+     *
+     * The result has the format expected by \ref warp::square_to_spherical_rectangle().
+     */
+    std::tuple<Point2f, Point2f, Float> local_rectangle(const Point3f &p) const {
+        Vector3f d = Point3f(m_object_to_world.translation()) - p;
+
+        Float x = dot(d, Vector3f(m_frame.s)),
+              y = dot(d, Vector3f(m_frame.t)),
+              z = dot(d, Vector3f(m_frame.n));
+
+        Vector2f extent(.5f * m_du, .5f * m_dv);
+        return { Point2f(x, y) - extent, Point2f(x, y) + extent, z };
+    }
+
 private:
     ScalarTransform4f m_object_to_world;
     ScalarTransform4f m_world_to_object;
@@ -34,6 +34,16 @@ Serialized mesh loader (:monosp:`serialized`)
    - |transform|
    - Specifies an optional linear object-to-world transformation.
      (Default: none, i.e. object space = world space)
+ * - compact_vertices
+   - |bool|
+   - When set to |true|, the vertex data is converted into a compact layout after
+     loading: positions are stored contiguously, vertex normals are octahedrally
+     encoded using 32 bits, and texture coordinates are kept in a separate buffer.
+     This reduces the memory usage of large meshes. (Default: |false|)
+ * - half_texcoords
+   - |bool|
+   - Store texture coordinates in half precision when :monosp:`compact_vertices`
+     is enabled. (Default: |false|)
 
 The serialized mesh format represents the most space and time-efficient way
 of getting geometry information into Mitsuba 2. It stores indexed triangle meshes
@@ -146,6 +156,7 @@ public:
     MTS_IMPORT_BASE(Mesh, m_vertices, m_faces, m_normal_offset, m_vertex_size, m_face_size,
                     m_texcoord_offset, m_color_offset, m_name, m_bbox, m_to_world, m_vertex_count,
                     m_face_count, m_vertex_struct, m_face_struct, m_disable_vertex_normals,
+                    m_compact_requested, m_half_texcoords, compact_vertices,
                     recompute_vertex_normals, is_emitter, emitter, is_sensor, sensor, 
                     vertex, has_vertex_normals, has_vertex_texcoords, vertex_texcoord, 
                     vertex_normal, vertex_position)
@@ -346,6 +357,9 @@ public:
         if (!m_disable_vertex_normals && !has_flag(flags, TriMeshFlags::HasNormals))
             recompute_vertex_normals();
 
+        if (m_compact_requested)
+            compact_vertices(m_half_texcoords);
+
         if (is_emitter())
             emitter()->set_shape(this);
         if (is_sensor())
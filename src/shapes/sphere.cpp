@@ -423,6 +423,7 @@ public:
         m_object_to_world = ScalarTransform4f::translate(m_center);
         m_world_to_object = m_object_to_world.inverse();
         m_inv_surface_area = 1.f / surface_area();
+        set_dirty();
     }
 
 #if defined(MTS_ENABLE_EMBREE)
@@ -1,6 +1,7 @@
 import mitsuba
 import pytest
 import enoki as ek
+import numpy as np
 from enoki.dynamic import Float32 as Float
 
 
@@ -108,3 +109,43 @@ def test03_ray_intersect(variant_scalar_rgb):
                             dn_dv = (si_v.n - si.n) / eps
                             assert ek.allclose(dp_dv, si.dp_dv, atol=2e-2)
                             assert ek.allclose(dn_dv, dn[1], atol=2e-2)
+
+
+def test04_sample_direction(variant_scalar_rgb):
+    from mitsuba.core import Ray3f
+    from mitsuba.render import Interaction3f
+
+    if mitsuba.core.MTS_ENABLE_EMBREE:
+        pytest.skip("EMBREE enabled")
+
+    s = example_disk()
+    it = Interaction3f.zero()
+    it.t = 0
+
+    n = 32
+    t = ek.linspace(Float, 0.5 / n, 1 - 0.5 / n, n)
+
+    # Reference points next to the cylinder only sample its visible side
+    for p in [[1.5, 0.5, 0.3], [0.3, -2, 0.9]]:
+        it.p = p
+        estimate = 0
+        for x in t:
+            for y in t:
+                ds = s.sample_direction(it, [x, y])
+                its = s.ray_intersect(Ray3f(it.p, ds.d, 0, []))
+                assert its.is_valid()
+                assert ek.allclose(its.t, ds.dist, rtol=1e-4)
+                assert ek.allclose(s.pdf_direction(it, ds), ds.pdf, rtol=1e-4)
+                estimate += 1 / ds.pdf
+        estimate /= n * n
+
+        # Reference: solid angle of the visible side by numerical integration
+        m = 512
+        phi, z = np.meshgrid(np.linspace(0, 2 * np.pi, m, endpoint=False),
+                             (np.arange(m) + 0.5) / m)
+        d = np.stack([np.cos(phi) - p[0], np.sin(phi) - p[1], z - p[2]])
+        dist = np.linalg.norm(d, axis=0)
+        cos_theta = -(d[0] * np.cos(phi) + d[1] * np.sin(phi)) / dist
+        ref = np.sum(np.maximum(cos_theta, 0) / dist**2) * 2 * np.pi / (m * m)
+
+        assert ek.allclose(estimate, ref, rtol=1e-2)
@@ -113,3 +113,36 @@ def test03_ray_intersect(variant_scalar_rgb):
                             assert ek.allclose(dp_dv, si.dp_dv, atol=2e-2)
                             assert ek.allclose(dn_dv, dn[1], atol=2e-2)
 
+
+def test04_sample_direction(variant_scalar_rgb):
+    from mitsuba.core import Ray3f
+    from mitsuba.render import Interaction3f
+
+    if mitsuba.core.MTS_ENABLE_EMBREE:
+        pytest.skip("EMBREE enabled")
+
+    s = example_disk()
+    it = Interaction3f.zero()
+    it.t = 0
+
+    n = 64
+    t = ek.linspace(Float, 0.5 / n, 1 - 0.5 / n, n)
+
+    # Nearby reference points sample the bounding square of the disk by solid
+    # angle, distant ones sample the disk by area
+    for h in [1, 20]:
+        it.p = [0, 0, h]
+        estimate = 0
+        for x in t:
+            for y in t:
+                ds = s.sample_direction(it, [x, y])
+                if ds.pdf == 0:
+                    continue
+                its = s.ray_intersect(Ray3f(it.p, ds.d, 0, []))
+                assert its.is_valid()
+                assert ek.allclose(its.t, ds.dist, rtol=1e-4)
+                assert ek.allclose(s.pdf_direction(it, ds), ds.pdf, rtol=1e-4)
+                estimate += 1 / ds.pdf
+        estimate /= n * n
+
+        assert ek.allclose(estimate, 2 * ek.pi * (1 - h / ek.sqrt(h * h + 1)), rtol=1e-2)
@@ -108,3 +108,32 @@ def test03_ray_intersect(variant_scalar_rgb):
 
     for i in range(n):
         assert ek.allclose(si_p.t[i], si_scalar[i].t)
+
+
+def test04_sample_direction(variant_scalar_rgb):
+    from mitsuba.core import Ray3f, warp
+    from mitsuba.render import Interaction3f
+
+    if mitsuba.core.MTS_ENABLE_EMBREE:
+        pytest.skip("EMBREE enabled")
+
+    s = example_rectangle((2, 0.5, 1), (0.3, 0.1, 0))
+    it = Interaction3f.zero()
+    it.t = 0
+
+    # Nearby reference points use spherical rectangle sampling, distant ones area sampling
+    for p in [[0.2, -0.3, 0.8], [1.5, 2.0, -0.4], [200, 100, 300]]:
+        it.p = p
+        solid_angle = warp.spherical_rectangle_solid_angle(
+            [-1.7 - p[0], -0.4 - p[1]], [2.3 - p[0], 0.6 - p[1]], -p[2])
+
+        for x in ek.linspace(Float, 0.05, 0.95, 5):
+            for y in ek.linspace(Float, 0.05, 0.95, 5):
+                ds = s.sample_direction(it, [x, y])
+                its = s.ray_intersect(Ray3f(it.p, ds.d, 0, []))
+                assert its.is_valid()
+                assert ek.allclose(its.t, ds.dist, rtol=1e-4)
+                assert ek.allclose(its.uv, ds.uv, atol=1e-4)
+                assert ek.allclose(s.pdf_direction(it, ds), ds.pdf, rtol=1e-4)
+                if p[2] < 1:
+                    assert ek.allclose(ds.pdf, 1 / solid_angle, rtol=1e-4)